@@ -0,0 +1,229 @@
+#include "DocumentGenerator.h"
+
+#include <algorithm>    // for clamp
+#include <cmath>        // for cos, sin, M_PI
+#include <fstream>      // for ofstream
+#include <iterator>     // for size
+#include <memory>       // for make_unique, make_shared
+#include <stdexcept>    // for runtime_error
+#include <string>       // for string, to_string
+#include <string_view>  // for string_view
+#include <utility>      // for move
+
+#include <cairo-pdf.h>  // for cairo_pdf_surface_create_for_stream
+#include <cairo.h>      // for cairo_t, cairo_surface_t
+
+#include "model/Image.h"    // for Image
+#include "model/Layer.h"    // for Layer
+#include "model/PageRef.h"  // for PageRef
+#include "model/Point.h"    // for Point
+#include "model/Stroke.h"   // for Stroke, StrokeTool
+#include "model/Text.h"     // for Text
+#include "model/XojPage.h"  // for XojPage
+#include "util/Color.h"     // for Color
+#include "util/PathUtil.h"  // for getTmpDirSubfolder
+
+#include "filesystem.h"  // for path
+
+namespace xoj::bench {
+
+namespace {
+auto appendToString(std::string* out, const unsigned char* data, unsigned int length) -> cairo_status_t {
+    out->append(reinterpret_cast<const char*>(data), length);
+    return CAIRO_STATUS_SUCCESS;
+}
+
+constexpr const char* LOREM = "Lorem ipsum dolor sit amet, consectetur adipiscing elit";
+
+auto randomColor(std::mt19937& rng) -> Color {
+    static constexpr uint32_t COLORS[] = {0x000000U, 0x3333ccU, 0xff0000U, 0x008000U, 0x808080U, 0xff8000U};
+    std::uniform_int_distribution<size_t> pick(0, std::size(COLORS) - 1);
+    return Color(COLORS[pick(rng)]);
+}
+}  // namespace
+
+auto generateStroke(std::mt19937& rng, size_t points) -> std::unique_ptr<Stroke> {
+    std::uniform_real_distribution<double> posX(20, PAGE_WIDTH - 20);
+    std::uniform_real_distribution<double> posY(20, PAGE_HEIGHT - 20);
+    std::uniform_real_distribution<double> unit(0, 1);
+    std::normal_distribution<double> turn(0, 0.25);
+
+    auto stroke = std::make_unique<Stroke>();
+    stroke->setToolType(StrokeTool::PEN);
+    stroke->setWidth(1.41);
+    stroke->setColor(randomColor(rng));
+
+    double x = posX(rng);
+    double y = posY(rng);
+    double heading = unit(rng) * 2 * M_PI;
+    double curvature = 0;
+    const double phase = unit(rng) * 2 * M_PI;
+
+    for (size_t i = 0; i < points; i++) {
+        // Pressure varies smoothly along the stroke, like handwriting
+        double pressure = 0.6 + 0.3 * std::sin(phase + static_cast<double>(i) * 0.05);
+        stroke->addPoint(Point(x, y, pressure));
+
+        curvature = std::clamp(curvature + turn(rng) * 0.1, -0.3, 0.3);
+        heading += curvature;
+        double step = 0.5 + 1.5 * unit(rng);
+        x += step * std::cos(heading);
+        y += step * std::sin(heading);
+
+        // Bounce on the page borders
+        if (x < 0 || x > PAGE_WIDTH) {
+            heading = M_PI - heading;
+            x = std::clamp(x, 0.0, PAGE_WIDTH);
+        }
+        if (y < 0 || y > PAGE_HEIGHT) {
+            heading = -heading;
+            y = std::clamp(y, 0.0, PAGE_HEIGHT);
+        }
+    }
+
+    return stroke;
+}
+
+auto generateSketchedRectangle(std::mt19937& rng, double x, double y, double width, double height)
+        -> std::unique_ptr<Stroke> {
+    std::normal_distribution<double> jitter(0, 0.8);
+
+    auto stroke = std::make_unique<Stroke>();
+    stroke->setWidth(1.41);
+
+    const Point corners[] = {{x, y}, {x + width, y}, {x + width, y + height}, {x, y + height}, {x, y}};
+    constexpr int STEPS_PER_SIDE = 30;
+    for (size_t side = 0; side + 1 < std::size(corners); side++) {
+        const Point& a = corners[side];
+        const Point& b = corners[side + 1];
+        for (int i = 0; i < STEPS_PER_SIDE; i++) {
+            double t = static_cast<double>(i) / STEPS_PER_SIDE;
+            stroke->addPoint(Point(a.x + t * (b.x - a.x) + jitter(rng), a.y + t * (b.y - a.y) + jitter(rng)));
+        }
+    }
+    stroke->addPoint(Point(x + jitter(rng), y + jitter(rng)));
+
+    return stroke;
+}
+
+auto generateSketchedCircle(std::mt19937& rng, double cx, double cy, double radius) -> std::unique_ptr<Stroke> {
+    std::normal_distribution<double> jitter(0, radius * 0.02);
+
+    auto stroke = std::make_unique<Stroke>();
+    stroke->setWidth(1.41);
+
+    constexpr int STEPS = 120;
+    for (int i = 0; i <= STEPS; i++) {
+        double angle = 2 * M_PI * i / STEPS;
+        double r = radius + jitter(rng);
+        stroke->addPoint(Point(cx + r * std::cos(angle), cy + r * std::sin(angle)));
+    }
+
+    return stroke;
+}
+
+auto generatePdf(size_t pages) -> std::string {
+    std::string data;
+    cairo_surface_t* surface = cairo_pdf_surface_create_for_stream(
+            reinterpret_cast<cairo_write_func_t>(appendToString), &data, PAGE_WIDTH, PAGE_HEIGHT);
+    cairo_t* cr = cairo_create(surface);
+
+    for (size_t p = 0; p < pages; p++) {
+        cairo_set_source_rgb(cr, 0, 0, 0);
+        cairo_select_font_face(cr, "Sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+        cairo_set_font_size(cr, 10);
+        for (int line = 0; line < 60; line++) {
+            cairo_move_to(cr, 40, 60 + line * 12);
+            cairo_show_text(cr, LOREM);
+        }
+
+        cairo_set_line_width(cr, 0.5);
+        for (int i = 0; i < 20; i++) {
+            cairo_rectangle(cr, 40 + i * 5, 40 + i * 5, PAGE_WIDTH - 80 - i * 10, 20);
+        }
+        cairo_stroke(cr);
+
+        cairo_show_page(cr);
+    }
+
+    cairo_destroy(cr);
+    cairo_surface_finish(surface);
+    cairo_surface_destroy(surface);
+
+    return data;
+}
+
+auto generatePng(int width, int height) -> std::string {
+    cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+    cairo_t* cr = cairo_create(surface);
+
+    cairo_pattern_t* gradient = cairo_pattern_create_linear(0, 0, width, height);
+    cairo_pattern_add_color_stop_rgb(gradient, 0, 0.2, 0.4, 0.8);
+    cairo_pattern_add_color_stop_rgb(gradient, 1, 0.9, 0.6, 0.1);
+    cairo_set_source(cr, gradient);
+    cairo_paint(cr);
+    cairo_pattern_destroy(gradient);
+    cairo_destroy(cr);
+
+    std::string data;
+    cairo_surface_write_to_png_stream(surface, reinterpret_cast<cairo_write_func_t>(appendToString), &data);
+    cairo_surface_destroy(surface);
+
+    return data;
+}
+
+auto generateDocument(const DocumentParameters& params) -> std::unique_ptr<GeneratedDocument> {
+    auto result = std::make_unique<GeneratedDocument>();
+    result->doc = std::make_unique<Document>(&result->handler);
+    Document* doc = result->doc.get();
+
+    if (params.pdfBackground) {
+        // The PDF is written to a file, so that saving and loading the document behave as with a real background
+        fs::path pdf = Util::getTmpDirSubfolder("bench") / ("background-" + std::to_string(params.pages) + ".pdf");
+        {
+            std::ofstream out(pdf, std::ios::binary);
+            out << generatePdf(params.pages);
+        }
+        if (!doc->readPdf(pdf, true, false)) {
+            throw std::runtime_error("Could not load the generated PDF: " + doc->getLastErrorMsg());
+        }
+    } else {
+        for (size_t p = 0; p < params.pages; p++) {
+            doc->addPage(std::make_shared<XojPage>(PAGE_WIDTH, PAGE_HEIGHT));
+        }
+    }
+
+    std::mt19937 rng(params.seed);
+    std::uniform_real_distribution<double> posX(0, PAGE_WIDTH - 100);
+    std::uniform_real_distribution<double> posY(0, PAGE_HEIGHT - 100);
+    const std::string png = params.imagesPerPage ? generatePng(256, 256) : std::string();
+
+    for (size_t p = 0; p < doc->getPageCount(); p++) {
+        Layer* layer = doc->getPage(p)->getSelectedLayer();
+
+        for (size_t i = 0; i < params.strokesPerPage; i++) {
+            layer->addElement(generateStroke(rng, params.pointsPerStroke));
+        }
+        for (size_t i = 0; i < params.imagesPerPage; i++) {
+            auto image = std::make_unique<Image>();
+            image->setImage(std::string_view(png));
+            image->setX(posX(rng));
+            image->setY(posY(rng));
+            image->setWidth(100);
+            image->setHeight(100);
+            layer->addElement(std::move(image));
+        }
+        for (size_t i = 0; i < params.textsPerPage; i++) {
+            auto text = std::make_unique<Text>();
+            text->setText(LOREM);
+            text->setX(posX(rng));
+            text->setY(posY(rng));
+            text->setColor(randomColor(rng));
+            layer->addElement(std::move(text));
+        }
+    }
+
+    return result;
+}
+
+}  // namespace xoj::bench
@@ -0,0 +1,84 @@
+/*
+ * Xournal++
+ *
+ * Synthetic documents for the benchmarks
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint32_t
+#include <memory>   // for unique_ptr
+#include <random>   // for mt19937
+#include <string>   // for string
+
+#include "model/Document.h"         // for Document
+#include "model/DocumentHandler.h"  // for DocumentHandler
+
+class Stroke;
+
+namespace xoj::bench {
+
+struct DocumentParameters {
+    size_t pages = 1;
+    size_t strokesPerPage = 100;
+    size_t pointsPerStroke = 100;
+    size_t imagesPerPage = 0;
+    size_t textsPerPage = 0;
+    /// Use the pages of a generated PDF as backgrounds
+    bool pdfBackground = false;
+    /// The same seed always generates the same document
+    uint32_t seed = 42;
+};
+
+/**
+ * @brief A generated Document, together with the DocumentHandler it needs
+ */
+struct GeneratedDocument {
+    DocumentHandler handler;
+    std::unique_ptr<Document> doc;
+};
+
+/// Size of the generated pages (A4, in points)
+constexpr double PAGE_WIDTH = 595.275591;
+constexpr double PAGE_HEIGHT = 841.889764;
+
+/**
+ * @brief Generates a document with the given number of pages and elements. Strokes are smooth random walks with
+ * pressure, looking like handwriting.
+ */
+std::unique_ptr<GeneratedDocument> generateDocument(const DocumentParameters& params);
+
+/**
+ * @brief Generates a stroke of the given number of points, starting at a random position of the page
+ */
+std::unique_ptr<Stroke> generateStroke(std::mt19937& rng, size_t points);
+
+/**
+ * @brief Generates a hand drawn looking rectangle, as input for the shape recognizer
+ */
+std::unique_ptr<Stroke> generateSketchedRectangle(std::mt19937& rng, double x, double y, double width, double height);
+
+/**
+ * @brief Generates a hand drawn looking circle, as input for the shape recognizer
+ */
+std::unique_ptr<Stroke> generateSketchedCircle(std::mt19937& rng, double cx, double cy, double radius);
+
+/**
+ * @brief Renders a PDF with the given number of pages containing some text and vector graphics
+ * @return The PDF data
+ */
+std::string generatePdf(size_t pages);
+
+/**
+ * @brief Renders a PNG image of the given size
+ * @return The PNG data
+ */
+std::string generatePng(int width, int height);
+
+}  // namespace xoj::bench
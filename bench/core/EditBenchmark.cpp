@@ -0,0 +1,192 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal Benchmarks
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "control/ToolEnums.h"
+#include "control/ToolHandler.h"
+#include "control/shaperecognizer/ShapeRecognizer.h"
+#include "control/tools/EraseHandler.h"
+#include "control/tools/Selection.h"
+#include "gui/LegacyRedrawable.h"
+#include "model/Layer.h"
+#include "model/Stroke.h"
+#include "model/XojPage.h"
+#include "model/eraser/PaddedBox.h"
+#include "undo/UndoRedoHandler.h"
+
+#include "DocumentGenerator.h"
+
+using namespace xoj::bench;
+
+namespace {
+/**
+ * @brief Redrawable ignoring all the rerender requests, as there is no view in the benchmarks
+ */
+class NullRedrawable: public LegacyRedrawable {
+public:
+    void repaintArea(double x1, double y1, double x2, double y2) const override {}
+    void repaintPage() const override {}
+    void rerenderPage() override {}
+    void rerenderRect(double x, double y, double width, double height) override {}
+    GdkRGBA getSelectionColor() override { return {}; }
+    void deleteViewBuffer() override {}
+    int getX() const override { return 0; }
+    int getY() const override { return 0; }
+};
+
+auto pageParameters(const benchmark::State& state) -> DocumentParameters {
+    DocumentParameters params;
+    params.strokesPerPage = static_cast<size_t>(state.range(0));
+    params.pointsPerStroke = static_cast<size_t>(state.range(1));
+    return params;
+}
+}  // namespace
+
+static void BM_StrokeIntersectWithPaddedBox(benchmark::State& state) {
+    std::mt19937 rng(42);
+    auto stroke = generateStroke(rng, static_cast<size_t>(state.range(0)));
+    const auto& points = stroke->getPointVector();
+    std::uniform_int_distribution<size_t> pick(0, points.size() - 1);
+
+    for (auto _: state) {
+        const Point& p = points[pick(rng)];
+        PaddedBox box{p, 5.0, 5.0 + 0.4 * stroke->getWidth()};
+        benchmark::DoNotOptimize(stroke->intersectWithPaddedBox(box));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StrokeIntersectWithPaddedBox)->ArgName("points")->RangeMultiplier(10)->Range(100, 100000);
+
+/**
+ * Standard eraser dragged across the page, through the EraseHandler (including the undo action)
+ */
+static void BM_Erase(benchmark::State& state) {
+    auto gen = generateDocument(pageParameters(state));
+    Document* doc = gen->doc.get();
+    const XojPage& original = *doc->getPage(0);
+
+    ToolHandler toolHandler(nullptr, nullptr, nullptr);
+    toolHandler.selectTool(TOOL_ERASER);
+    NullRedrawable view;
+
+    for (auto _: state) {
+        state.PauseTiming();
+        auto page = std::make_shared<XojPage>(original);
+        UndoRedoHandler undo(nullptr);
+        state.ResumeTiming();
+
+        EraseHandler handler(&undo, doc, page, &toolHandler, &view);
+        // Zigzag over the middle of the page
+        for (int i = 0; i < 400; i++) {
+            double x = 50 + (PAGE_WIDTH - 100) * (i % 100) / 100.;
+            double y = PAGE_HEIGHT / 2 + 20 * std::sin(i * 0.3) + (i / 100) * 40;
+            handler.erase(x, y);
+        }
+        handler.finalize();
+
+        state.PauseTiming();
+        page.reset();
+        state.ResumeTiming();
+    }
+}
+BENCHMARK(BM_Erase)
+        ->ArgNames({"strokes", "points"})
+        ->Args({100, 100})
+        ->Args({1000, 100})
+        ->Args({100, 1000})
+        ->Unit(benchmark::kMillisecond);
+
+/**
+ * Lasso drawn around the middle of the page, then finalized (i.e. the elements inside are looked up)
+ */
+static void BM_LassoSelect(benchmark::State& state) {
+    auto gen = generateDocument(pageParameters(state));
+    Document* doc = gen->doc.get();
+    PageRef page = doc->getPage(0);
+
+    constexpr int LASSO_POINTS = 200;
+    const double radius = PAGE_WIDTH / 3;
+
+    for (auto _: state) {
+        RegionSelect selection(PAGE_WIDTH / 2 + radius, PAGE_HEIGHT / 2);
+        for (int i = 1; i <= LASSO_POINTS; i++) {
+            double angle = 2 * M_PI * i / LASSO_POINTS;
+            selection.currentPos(PAGE_WIDTH / 2 + radius * std::cos(angle), PAGE_HEIGHT / 2 + radius * std::sin(angle));
+        }
+        benchmark::DoNotOptimize(selection.finalize(page, true, doc));
+        benchmark::DoNotOptimize(selection.releaseElements());
+    }
+}
+BENCHMARK(BM_LassoSelect)
+        ->ArgNames({"strokes", "points"})
+        ->Args({100, 100})
+        ->Args({1000, 100})
+        ->Args({100, 1000})
+        ->Unit(benchmark::kMicrosecond);
+
+static void BM_ShapeRecognizer(benchmark::State& state) {
+    std::mt19937 rng(42);
+    auto rectangle = generateSketchedRectangle(rng, 100, 100, 200, 120);
+    auto circle = generateSketchedCircle(rng, 300, 400, 80);
+    auto scribble = generateStroke(rng, 150);
+
+    for (auto _: state) {
+        // The recognizer keeps the previous strokes to recognize shapes drawn in several strokes
+        ShapeRecognizer recognizer;
+        benchmark::DoNotOptimize(recognizer.recognizePatterns(rectangle.get(), 10));
+        benchmark::DoNotOptimize(recognizer.recognizePatterns(circle.get(), 10));
+        benchmark::DoNotOptimize(recognizer.recognizePatterns(scribble.get(), 10));
+    }
+}
+BENCHMARK(BM_ShapeRecognizer)->Unit(benchmark::kMicrosecond);
+
+/**
+ * The recognizer as run by the ShapeRecognizerJob on each released stroke, over a corpus of sketched rectangles,
+ * circles and handwriting of various sizes
+ */
+static void BM_ShapeRecognizerCorpus(benchmark::State& state) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> position(100, 450);
+    std::uniform_real_distribution<double> size(20, 300);
+    std::uniform_int_distribution<size_t> points(20, 500);
+
+    std::vector<std::unique_ptr<Stroke>> corpus;
+    for (size_t i = 0; corpus.size() < static_cast<size_t>(state.range(0)); i++) {
+        switch (i % 3) {
+            case 0:
+                corpus.push_back(generateSketchedRectangle(rng, position(rng), position(rng), size(rng), size(rng)));
+                break;
+            case 1:
+                corpus.push_back(generateSketchedCircle(rng, position(rng), position(rng), size(rng) / 2));
+                break;
+            default:
+                corpus.push_back(generateStroke(rng, points(rng)));
+        }
+    }
+
+    for (auto _: state) {
+        for (const auto& stroke: corpus) {
+            // The job uses a new recognizer for each stroke
+            ShapeRecognizer recognizer;
+            benchmark::DoNotOptimize(recognizer.recognizePatterns(stroke.get(), 10));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ShapeRecognizerCorpus)->ArgName("strokes")->Arg(300)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,83 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal Benchmarks
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "control/jobs/BaseExportJob.h"
+#include "control/jobs/ImageExport.h"
+#include "control/jobs/ProgressListener.h"
+#include "pdf/base/XojPdfExport.h"
+#include "pdf/base/XojPdfExportFactory.h"
+#include "util/ElementRange.h"
+#include "util/PathUtil.h"
+
+#include "DocumentGenerator.h"
+#include "filesystem.h"
+
+using namespace xoj::bench;
+
+static void BM_ExportPdf(benchmark::State& state) {
+    DocumentParameters params;
+    params.pages = static_cast<size_t>(state.range(0));
+    params.strokesPerPage = static_cast<size_t>(state.range(1));
+    params.pdfBackground = state.range(2) != 0;
+    auto gen = generateDocument(params);
+    auto file = Util::getTmpDirSubfolder("bench") / "export.pdf";
+    DummyProgressListener listener;
+
+    for (auto _: state) {
+        auto pdfExport = XojPdfExportFactory::createExport(gen->doc.get(), &listener);
+        if (!pdfExport->createPdf(file, false)) {
+            auto error = pdfExport->getLastError();
+            state.SkipWithError(error.c_str());
+            break;
+        }
+    }
+
+    if (fs::exists(file)) {
+        state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(fs::file_size(file)));
+        fs::remove(file);
+    }
+}
+BENCHMARK(BM_ExportPdf)
+        ->ArgNames({"pages", "strokes", "pdf"})
+        ->Args({10, 100, 0})
+        ->Args({10, 1000, 0})
+        ->Args({10, 100, 1})
+        ->Unit(benchmark::kMillisecond);
+
+static void BM_ExportPng(benchmark::State& state) {
+    DocumentParameters params;
+    params.strokesPerPage = static_cast<size_t>(state.range(0));
+    auto gen = generateDocument(params);
+    auto file = Util::getTmpDirSubfolder("bench") / "export.png";
+    const int dpi = static_cast<int>(state.range(1));
+    DummyProgressListener listener;
+
+    for (auto _: state) {
+        ImageExport imageExport(gen->doc.get(), file, EXPORT_GRAPHICS_PNG, EXPORT_BACKGROUND_ALL,
+                                PageRangeVector{PageRangeEntry(0, 0)});
+        imageExport.setQualityParameter(EXPORT_QUALITY_DPI, dpi);
+        imageExport.exportGraphics(&listener);
+        if (auto error = imageExport.getLastErrorMsg(); !error.empty()) {
+            state.SkipWithError(error.c_str());
+            break;
+        }
+    }
+
+    fs::remove(file);
+}
+BENCHMARK(BM_ExportPng)
+        ->ArgNames({"strokes", "dpi"})
+        ->Args({100, 150})
+        ->Args({1000, 150})
+        ->Args({100, 300})
+        ->Unit(benchmark::kMillisecond);
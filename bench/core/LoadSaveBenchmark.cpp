@@ -0,0 +1,117 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal Benchmarks
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "control/xojfile/LoadHandler.h"
+#include "control/xojfile/SaveHandler.h"
+#include "util/PathUtil.h"
+
+#include "DocumentGenerator.h"
+#include "filesystem.h"
+
+using namespace xoj::bench;
+
+namespace {
+/// Arguments: pages, strokes per page, points per stroke
+void documentSizes(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"pages", "strokes", "points"});
+    b->Args({1, 100, 100});
+    b->Args({10, 100, 100});
+    b->Args({10, 1000, 100});
+    b->Args({50, 200, 400});
+    b->Unit(benchmark::kMillisecond);
+}
+
+auto parameters(const benchmark::State& state) -> DocumentParameters {
+    DocumentParameters params;
+    params.pages = static_cast<size_t>(state.range(0));
+    params.strokesPerPage = static_cast<size_t>(state.range(1));
+    params.pointsPerStroke = static_cast<size_t>(state.range(2));
+    return params;
+}
+
+void setPointCounters(benchmark::State& state, const DocumentParameters& params) {
+    auto points = static_cast<int64_t>(params.pages * params.strokesPerPage * params.pointsPerStroke);
+    state.SetItemsProcessed(state.iterations() * points);
+}
+}  // namespace
+
+static void BM_Save(benchmark::State& state) {
+    auto params = parameters(state);
+    auto gen = generateDocument(params);
+    auto file = Util::getTmpDirSubfolder("bench") / "save.xopp";
+
+    for (auto _: state) {
+        SaveHandler handler;
+        handler.prepareSave(gen->doc.get());
+        handler.saveTo(file);
+    }
+
+    setPointCounters(state, params);
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(fs::file_size(file)));
+    fs::remove(file);
+}
+BENCHMARK(BM_Save)->Apply(documentSizes);
+
+static void BM_Load(benchmark::State& state) {
+    auto params = parameters(state);
+    auto file = Util::getTmpDirSubfolder("bench") / "load.xopp";
+    {
+        auto gen = generateDocument(params);
+        SaveHandler handler;
+        handler.prepareSave(gen->doc.get());
+        handler.saveTo(file);
+    }
+
+    for (auto _: state) {
+        LoadHandler handler;
+        auto doc = handler.loadDocument(file);
+        if (!doc) {
+            auto error = handler.getLastError();
+            state.SkipWithError(error.c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(doc);
+    }
+
+    setPointCounters(state, params);
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(fs::file_size(file)));
+    fs::remove(file);
+}
+BENCHMARK(BM_Load)->Apply(documentSizes);
+
+static void BM_LoadWithPdfBackground(benchmark::State& state) {
+    DocumentParameters params;
+    params.pages = static_cast<size_t>(state.range(0));
+    params.pdfBackground = true;
+    auto file = Util::getTmpDirSubfolder("bench") / "load-pdf.xopp";
+    {
+        auto gen = generateDocument(params);
+        SaveHandler handler;
+        handler.prepareSave(gen->doc.get());
+        handler.saveTo(file);
+    }
+
+    for (auto _: state) {
+        LoadHandler handler;
+        auto doc = handler.loadDocument(file);
+        if (!doc) {
+            auto error = handler.getLastError();
+            state.SkipWithError(error.c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(doc);
+    }
+
+    fs::remove(file);
+}
+BENCHMARK(BM_LoadWithPdfBackground)->ArgName("pages")->Arg(10)->Arg(100)->Unit(benchmark::kMillisecond);
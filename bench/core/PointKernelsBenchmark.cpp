@@ -0,0 +1,94 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal Benchmarks
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <cairo.h>
+
+#include "model/Point.h"
+#include "model/PointKernels.h"
+
+namespace {
+auto randomPoints(size_t n) -> std::vector<Point> {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> coord(-500.0, 1500.0);
+    std::uniform_real_distribution<double> width(0.1, 5.0);
+    std::vector<Point> pts;
+    pts.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        pts.emplace_back(coord(gen), coord(gen), width(gen));
+    }
+    return pts;
+}
+
+auto scaleRotateMatrix() -> cairo_matrix_t {
+    cairo_matrix_t m;
+    cairo_matrix_init_identity(&m);
+    cairo_matrix_translate(&m, 120.5, -33.25);
+    cairo_matrix_rotate(&m, 0.3);
+    cairo_matrix_scale(&m, 1.7, 0.6);
+    cairo_matrix_rotate(&m, -0.3);
+    cairo_matrix_translate(&m, -120.5, 33.25);
+    return m;
+}
+}  // namespace
+
+/*
+ * Each kernel is benchmarked against its scalar version, which is used on the architectures without a vectorized one
+ */
+
+template <typename Kernel>
+static void BM_PointTranslate(benchmark::State& state, Kernel translate) {
+    auto n = static_cast<size_t>(state.range(0));
+    std::vector<Point> pts = randomPoints(n);
+
+    for (auto _: state) {
+        translate(pts.data(), n, 0.5, -0.5);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_CAPTURE(BM_PointTranslate, scalar, PointKernels::scalar::translate)->ArgName("points")->Arg(100000);
+BENCHMARK_CAPTURE(BM_PointTranslate, dispatched, PointKernels::translate)->ArgName("points")->Arg(100000);
+
+template <typename Kernel>
+static void BM_PointTransform(benchmark::State& state, Kernel transform) {
+    auto n = static_cast<size_t>(state.range(0));
+    std::vector<Point> pts = randomPoints(n);
+    const cairo_matrix_t m = scaleRotateMatrix();
+
+    for (auto _: state) {
+        transform(pts.data(), n, m, 1.0);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_CAPTURE(BM_PointTransform, scalar, PointKernels::scalar::transform)->ArgName("points")->Arg(100000);
+BENCHMARK_CAPTURE(BM_PointTransform, dispatched, PointKernels::transform)->ArgName("points")->Arg(100000);
+
+template <typename Kernel>
+static void BM_PointBounds(benchmark::State& state, Kernel bounds) {
+    auto n = static_cast<size_t>(state.range(0));
+    std::vector<Point> pts = randomPoints(n);
+
+    for (auto _: state) {
+        benchmark::DoNotOptimize(bounds(pts.data(), n));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_CAPTURE(BM_PointBounds, scalar, PointKernels::scalar::bounds)->ArgName("points")->Arg(100000);
+BENCHMARK_CAPTURE(BM_PointBounds, dispatched, PointKernels::bounds)->ArgName("points")->Arg(100000);
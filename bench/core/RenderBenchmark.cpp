@@ -0,0 +1,148 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal Benchmarks
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <cmath>
+
+#include <benchmark/benchmark.h>
+#include <cairo.h>
+
+#include "model/XojPage.h"
+#include "view/DocumentView.h"
+
+#include "DocumentGenerator.h"
+
+using namespace xoj::bench;
+
+namespace {
+/**
+ * @brief Image surface the size of a page at the given zoom, as the page buffers of the XojPageView
+ */
+class PageSurface {
+public:
+    explicit PageSurface(double zoom):
+            zoom(zoom),
+            surface(cairo_image_surface_create(CAIRO_FORMAT_ARGB32, static_cast<int>(std::ceil(PAGE_WIDTH * zoom)),
+                                               static_cast<int>(std::ceil(PAGE_HEIGHT * zoom)))) {}
+    ~PageSurface() { cairo_surface_destroy(surface); }
+
+    PageSurface(const PageSurface&) = delete;
+    PageSurface& operator=(const PageSurface&) = delete;
+
+    cairo_t* createContext() const {
+        cairo_t* cr = cairo_create(surface);
+        cairo_scale(cr, zoom, zoom);
+        return cr;
+    }
+
+    void flush() const { cairo_surface_flush(surface); }
+
+private:
+    double zoom;
+    cairo_surface_t* surface;
+};
+
+/// Arguments: strokes on the page, points per stroke, zoom in percent
+void renderSizes(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"strokes", "points", "zoom"});
+    for (int64_t strokes: {10, 100, 1000}) {
+        b->Args({strokes, 100, 100});
+    }
+    b->Args({100, 1000, 100});
+    b->Args({100, 100, 300});
+    b->Unit(benchmark::kMillisecond);
+}
+
+auto strokeParameters(const benchmark::State& state) -> DocumentParameters {
+    DocumentParameters params;
+    params.strokesPerPage = static_cast<size_t>(state.range(0));
+    params.pointsPerStroke = static_cast<size_t>(state.range(1));
+    return params;
+}
+}  // namespace
+
+static void BM_RenderFullPage(benchmark::State& state) {
+    auto gen = generateDocument(strokeParameters(state));
+    PageRef page = gen->doc->getPage(0);
+    PageSurface surface(static_cast<double>(state.range(2)) / 100.);
+    DocumentView view;
+
+    for (auto _: state) {
+        cairo_t* cr = surface.createContext();
+        view.drawPage(page, cr, false);
+        cairo_destroy(cr);
+        surface.flush();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1));
+}
+BENCHMARK(BM_RenderFullPage)->Apply(renderSizes);
+
+/**
+ * Rerendering of a small area of the page, as done after each eraser or selection move
+ */
+static void BM_RenderPartialPage(benchmark::State& state) {
+    auto gen = generateDocument(strokeParameters(state));
+    PageRef page = gen->doc->getPage(0);
+    PageSurface surface(static_cast<double>(state.range(2)) / 100.);
+    DocumentView view;
+
+    for (auto _: state) {
+        cairo_t* cr = surface.createContext();
+        cairo_rectangle(cr, PAGE_WIDTH / 2 - 50, PAGE_HEIGHT / 2 - 50, 100, 100);
+        cairo_clip(cr);
+        view.drawPage(page, cr, false);
+        cairo_destroy(cr);
+        surface.flush();
+    }
+}
+BENCHMARK(BM_RenderPartialPage)->Apply(renderSizes);
+
+static void BM_RenderPdfBackground(benchmark::State& state) {
+    DocumentParameters params;
+    params.strokesPerPage = 0;
+    params.pdfBackground = true;
+    auto gen = generateDocument(params);
+    PageRef page = gen->doc->getPage(0);
+    PageSurface surface(static_cast<double>(state.range(0)) / 100.);
+    DocumentView view;
+
+    for (auto _: state) {
+        cairo_t* cr = surface.createContext();
+        view.drawPage(page, cr, false);
+        cairo_destroy(cr);
+        surface.flush();
+    }
+}
+BENCHMARK(BM_RenderPdfBackground)->ArgName("zoom")->Arg(100)->Arg(300)->Unit(benchmark::kMillisecond);
+
+static void BM_RenderImagesAndText(benchmark::State& state) {
+    DocumentParameters params;
+    params.strokesPerPage = 0;
+    params.imagesPerPage = static_cast<size_t>(state.range(0));
+    params.textsPerPage = static_cast<size_t>(state.range(1));
+    auto gen = generateDocument(params);
+    PageRef page = gen->doc->getPage(0);
+    PageSurface surface(1.0);
+    DocumentView view;
+
+    for (auto _: state) {
+        cairo_t* cr = surface.createContext();
+        view.drawPage(page, cr, false);
+        cairo_destroy(cr);
+        surface.flush();
+    }
+}
+BENCHMARK(BM_RenderImagesAndText)
+        ->ArgNames({"images", "texts"})
+        ->Args({10, 0})
+        ->Args({0, 100})
+        ->Args({10, 100})
+        ->Unit(benchmark::kMillisecond);
@@ -389,6 +389,96 @@ function app.getTexts(type) end
 --- }
 function app.getStrokes(type) end
 
+--- Puts a Lua Table of the Strokes (from the selection tool / selected layer / current page) onto the stack, with the
+--- points of each stroke packed in a single binary string. This is much faster than app.getStrokes for strokes with many
+--- points. Is inverse to app.addStrokesPacked
+--- 
+--- Each point is packed as three native-endian doubles: x, y and pressure, the latter being -1 for strokes without
+--- pressure. The points can be read with string.unpack("ddd", points, pos).
+--- 
+--- The second return value identifies the state of the current page, or of the selection for "selection". It must be
+--- passed to app.setStrokesPacked, which fails if the page was modified, or the selection moved, transformed or replaced
+--- in the meantime, as the strokes may not be at the same positions anymore.
+--- 
+--- @param type string "selection", "layer" or "page"
+--- @return {points:string, tool:string, width:number, color:integer, fill:number, lineStyle:string, layer:integer}[]
+--- strokes
+--- @return integer revision
+--- 
+--- Required argument: type ("selection", "layer" or "page" for the strokes of all the layers of the current page)
+--- 
+--- Example:
+--- 
+--- local strokes, revision = app.getStrokesPacked("page")
+--- for _, stroke in ipairs(strokes) do
+---   for pos = 1, #stroke.points, 24 do
+---     local x, y, pressure = string.unpack("ddd", stroke.points, pos)
+---   end
+--- end
+--- 
+--- possible return value:
+--- {
+---         {
+---             ["points"]    = "...", -- 24 bytes per point
+---             ["tool"]      = "pen",
+---             ["width"]     = 0.85,
+---             ["color"]     = 16744448,
+---             ["fill"]      = -1,
+---             ["lineStyle"] = "plain",
+---             ["layer"]     = 1, -- number of the layer of the stroke, as in app.getDocumentStructure()
+---         },
+--- }
+function app.getStrokesPacked(type) end
+
+--- Given a table containing strokes with packed points (as returned by app.getStrokesPacked), adds them to the current
+--- layer. The pen settings are handled as in app.addStrokes. The page is rerendered once for all the strokes.
+--- 
+--- Each point is packed as three native-endian doubles: x, y and pressure, the latter being -1 for strokes without
+--- pressure. Strokes with less than two points are discarded.
+--- 
+--- @param opts {strokes:{points:string, tool:string, width:number, color:integer, fill:number, lineStyle:string}[],
+--- allowUndoRedoAction:string}
+--- 
+--- Required Arguments: points
+--- Optional Arguments: tool, width, color, fill, lineStyle
+--- 
+--- Example:
+--- 
+--- local points = {}
+--- for i = 0, 100 do
+---   points[#points + 1] = string.pack("ddd", 100 + i, 100 + 10 * math.sin(i / 10), -1)
+--- end
+--- app.addStrokesPacked({
+---   strokes = {
+---     { points = table.concat(points), color = 0x0000ff, width = 1.41 },
+---   },
+---   allowUndoRedoAction = "grouped", -- each call creates one undo action, or "individual" or "none"
+--- })
+function app.addStrokesPacked(opts) end
+
+--- Replaces the points of strokes from the selection tool / selected layer / current page by packed points, as returned
+--- by app.getStrokesPacked. All the modified strokes are restored by a single undo action, and the page is rerendered
+--- once. With "selection", the selection is cleared before the strokes are modified.
+--- 
+--- Fails if the current page was modified, or with "selection" if the selection was moved, transformed or replaced,
+--- since app.getStrokesPacked was called, e.g. by the user while the new points were computed in the background: the
+--- strokes may not be at the same positions anymore.
+--- 
+--- @param type string "selection", "layer" or "page"
+--- @param points table<integer, string> the new packed points, indexed by the position of the stroke in the table
+--- returned by app.getStrokesPacked(type). Strokes without new points are left untouched.
+--- @param revision integer the revision returned by app.getStrokesPacked(type)
+--- 
+--- Required arguments: type, points, revision
+--- 
+--- Example: local strokes, revision = app.getStrokesPacked("page")
+---          local newPoints = {}
+---          for i, stroke in ipairs(strokes) do
+---            newPoints[i] = smooth(stroke.points) -- a string of packed points
+---          end
+---          app.setStrokesPacked("page", newPoints, revision)
+function app.setStrokesPacked(type, points, revision) end
+
 --- Notifies program of any updates to the working document caused
 --- by the API.
 --- 
@@ -814,3 +904,60 @@ function app.addImages(opts) end
 --- }
 function app.getImages(type) end
 
+--- Runs a Lua script of the plugin on a background thread, so that long computations do not freeze the user interface.
+--- 
+--- The script runs in a separate Lua state, without the app library: the document and the user interface can only be
+--- accessed from the main thread. Instead, the script receives a copy of `input` as argument (`...`) and returns its
+--- result, which is passed to the callback on the main thread. The callback applies the changes to the document, e.g.
+--- with app.setStrokesPacked, so that they are undone at once.
+--- 
+--- The script can use the job library:
+---  - job.progress(fraction:number, message:string) reports the progress, passed to `progressCallback`;
+---  - job.post(fnc:string, ...) calls the global function `fnc` of the plugin on the main thread;
+---  - job.isCancelled() returns true if the job was cancelled. The script is interrupted anyway.
+--- 
+--- Only nil, booleans, numbers, strings and tables of those can be passed between the plugin and the script.
+--- 
+--- @param opts {script:string, input:any, callback:string, progressCallback:string}
+--- @return integer id of the job, to be passed to app.cancelBackgroundJob
+--- 
+--- Required arguments: script (path relative to the plugin folder), callback
+--- Optional arguments: input, progressCallback
+--- 
+--- Example:
+--- 
+--- -- main.lua
+--- local revision
+--- function smooth()
+---   local strokes
+---   strokes, revision = app.getStrokesPacked("page")
+---   app.runInBackground({
+---     script = "smooth.lua",
+---     input = strokes,
+---     callback = "onSmoothed",
+---     progressCallback = "onProgress",
+---   })
+--- end
+--- function onSmoothed(points, err) -- points is nil and err is set if the script failed or was cancelled
+---   -- Fails if the page was modified while smoothing
+---   if points then app.setStrokesPacked("page", points, revision) end
+--- end
+--- 
+--- -- smooth.lua
+--- local strokes = ...
+--- local points = {}
+--- for i, stroke in ipairs(strokes) do
+---   points[i] = smoothPoints(stroke.points)
+---   job.progress(i / #strokes)
+--- end
+--- return points
+function app.runInBackground(opts) end
+
+--- Cancels a job started with app.runInBackground. Its callback is still called, with nil and the error "Cancelled".
+--- 
+--- @param id integer id of the job
+--- @return boolean false if the job already finished
+--- 
+--- Example: app.cancelBackgroundJob(jobId)
+function app.cancelBackgroundJob(id) end
+
@@ -1,29 +1,45 @@
 #include "ClipboardHandler.h"
 
-#include <set>      // for multiset, operator!=
-#include <utility>  // for move
-#include <vector>   // for vector
+#include <cstdint>     // for uint32_t
+#include <functional>  // for function
+#include <memory>      // for make_unique
+#include <optional>    // for optional
+#include <set>         // for multiset, operator!=
+#include <utility>     // for move
+#include <vector>      // for vector
 
 #include <cairo-svg.h>      // for cairo_svg_surface_c...
 #include <cairo.h>          // for cairo_create, cairo...
 #include <gdk/gdkpixbuf.h>  // for gdk_pixbuf_get_from_surface
 #include <glib-object.h>    // for g_object_unref, g_s...
 
-#include "control/tools/EditSelection.h"          // for EditSelection
-#include "model/Element.h"                        // for Element, ELEMENT_TEXT
-#include "model/Text.h"                           // for Text
-#include "util/Util.h"                            // for DPI_NORMALIZATION_F...
-#include "util/gtk4_helper.h"                     // for gtk_widget_get_clipboard
-#include "util/safe_casts.h"                      // for as_unsigned
-#include "util/serializing/BinObjectEncoding.h"   // for BinObjectEncoding
-#include "util/serializing/ObjectInputStream.h"   // for ObjectInputStream
-#include "util/serializing/ObjectOutputStream.h"  // for ObjectOutputStream
-#include "view/ElementContainerView.h"            // for ElementContainerView
-#include "view/View.h"                            // for Context
+#include "control/tools/EditSelection.h"            // for EditSelection
+#include "model/Element.h"                          // for Element, ELEMENT_TEXT
+#include "model/ElementContainer.h"                 // for ElementContainer
+#include "model/Image.h"                            // for Image
+#include "model/Stroke.h"                           // for Stroke
+#include "model/TexImage.h"                         // for TexImage
+#include "model/Text.h"                             // for Text
+#include "util/Rectangle.h"                         // for Rectangle
+#include "util/Util.h"                              // for DPI_NORMALIZATION_F...
+#include "util/gtk4_helper.h"                       // for gtk_widget_get_clipboard
+#include "util/i18n.h"                              // for FS, FORMAT_STR
+#include "util/raii/CairoWrappers.h"                // for CairoSurfaceSPtr, CairoSPtr
+#include "util/raii/GObjectSPtr.h"                  // for GObjectSPtr
+#include "util/safe_casts.h"                        // for as_unsigned
+#include "util/serializing/BinObjectEncoding.h"     // for BinObjectEncoding
+#include "util/serializing/CompactInputStream.h"    // for CompactInputStream
+#include "util/serializing/CompactOutputStream.h"   // for CompactOutputStream
+#include "util/serializing/InputStreamException.h"  // for InputStreamException
+#include "util/serializing/ObjectInputStream.h"     // for ObjectInputStream
+#include "util/serializing/ObjectOutputStream.h"    // for ObjectOutputStream
+#include "view/ElementContainerView.h"              // for ElementContainerView
+#include "view/View.h"                              // for Context
 
 #include "config.h"  // for PROJECT_STRING
 
 using std::string;
+using xoj::util::Rectangle;
 
 ClipboardListener::~ClipboardListener() = default;
 
@@ -42,6 +58,13 @@ ClipboardHandler::ClipboardHandler(ClipboardListener* listener, GtkWidget* widge
 ClipboardHandler::~ClipboardHandler() { g_signal_handler_disconnect(this->clipboard, this->handlerId); }
 
 static GdkAtom atomXournal = gdk_atom_intern_static_string("application/xournal");
+/**
+ * Same contents as atomXournal, in the compact layout of CompactOutputStream: faster to write and to read back.
+ * atomXournal is still offered, for older versions.
+ */
+static GdkAtom atomXournalCompact = gdk_atom_intern_static_string("application/xournal-compact");
+/// To be increased whenever the compact layout of the selection or of an element changes
+constexpr uint32_t COMPACT_CLIPBOARD_VERSION = 1;
 
 auto ClipboardHandler::paste() -> bool {
     /* Request targets again, since the owner-change signal is not emitted on MacOS and under X11 with no XFIXES
@@ -50,6 +73,12 @@ auto ClipboardHandler::paste() -> bool {
     gtk_clipboard_request_contents(clipboard, gdk_atom_intern_static_string("TARGETS"),
                                    reinterpret_cast<GtkClipboardReceivedFunc>(receivedClipboardContents), this);
 
+    if (this->containsXournalCompact) {
+        gtk_clipboard_request_contents(this->clipboard, atomXournalCompact,
+                                       reinterpret_cast<GtkClipboardReceivedFunc>(pasteClipboardCompactContents),
+                                       this);
+        return true;
+    }
     if (this->containsXournal) {
         gtk_clipboard_request_contents(this->clipboard, atomXournal,
                                        reinterpret_cast<GtkClipboardReceivedFunc>(pasteClipboardContents), this);
@@ -86,21 +115,30 @@ auto ElementCompareFunc(Element* a, Element* b) -> bool {
 static GdkAtom atomSvg1 = gdk_atom_intern_static_string("image/svg");
 static GdkAtom atomSvg2 = gdk_atom_intern_static_string("image/svg+xml");
 
-// The contents of the clipboard
-class ClipboardContents {
+/**
+ * The contents of the clipboard.
+ * The images are only rendered when a target requests them (most pastes are xournal-to-xournal pastes or do not
+ * happen at all). They are rendered from the elements read back from the serialized selection, so the selection may
+ * change in the meantime.
+ */
+class ClipboardContents: public ElementContainer {
 public:
-    ClipboardContents(string text, GdkPixbuf* image, string svg, GString* str) {
-        this->text = std::move(text);
-        this->image = image;
-        this->svg = std::move(svg);
-        this->str = str;
-    }
+    ClipboardContents(string text, GString* str, string compact, const Rectangle<double>& bounds):
+            text(std::move(text)), str(str), compact(std::move(compact)), bounds(bounds) {}
 
-    ~ClipboardContents() {
-        g_object_unref(this->image);
-        g_string_free(this->str, true);
-    }
+    ~ClipboardContents() { g_string_free(this->str, true); }
 
+    ClipboardContents(const ClipboardContents&) = delete;
+    ClipboardContents& operator=(const ClipboardContents&) = delete;
+
+    void forEachElement(std::function<void(Element*)> f) const override {
+        if (!this->elements) {
+            return;
+        }
+        for (const auto& e: *this->elements) {
+            f(e.get());
+        }
+    }
 
     static void getFunction(GtkClipboard* clipboard, GtkSelectionData* selection, guint info,
                             ClipboardContents* contents) {
@@ -111,10 +149,14 @@ public:
         } else if (target == gdk_atom_intern_static_string("image/png") ||
                    target == gdk_atom_intern_static_string("image/jpeg") ||
                    target == gdk_atom_intern_static_string("image/gif")) {
-            gtk_selection_data_set_pixbuf(selection, contents->image);
+            gtk_selection_data_set_pixbuf(selection, contents->getImage());
         } else if (atomSvg1 == target || atomSvg2 == target) {
-            gtk_selection_data_set(selection, target, 8, reinterpret_cast<guchar const*>(contents->svg.c_str()),
-                                   static_cast<gint>(contents->svg.length()));
+            const string& svg = contents->getSvg();
+            gtk_selection_data_set(selection, target, 8, reinterpret_cast<guchar const*>(svg.c_str()),
+                                   static_cast<gint>(svg.length()));
+        } else if (atomXournalCompact == target) {
+            gtk_selection_data_set(selection, target, 8, reinterpret_cast<guchar const*>(contents->compact.data()),
+                                   static_cast<gint>(contents->compact.length()));
         } else if (atomXournal == target) {
             gtk_selection_data_set(selection, target, 8, reinterpret_cast<guchar*>(contents->str->str),
                                    static_cast<gint>(contents->str->len));
@@ -123,17 +165,101 @@ public:
 
     static void clearFunction(GtkClipboard* clipboard, ClipboardContents* contents) { delete contents; }
 
+private:
+    /**
+     * Reads the elements back from the serialized selection, on the first call
+     */
+    void loadElements() {
+        if (this->elements) {
+            return;
+        }
+        this->elements.emplace();
+
+        ObjectInputStream in;
+        if (!in.read(this->str->str, this->str->len)) {
+            return;
+        }
+        try {
+            in.readString();  // PROJECT_STRING
+            in.skipObject();  // EditSelection
+            this->elements = ClipboardHandler::readSerializedElements(in);
+        } catch (const InputStreamException& e) {
+            g_warning("InputStreamException: %s", e.what());
+        }
+    }
+
+    /**
+     * @return The contents rendered as a 300 DPI image. Rendered on the first call.
+     */
+    GdkPixbuf* getImage() {
+        if (this->image) {
+            return this->image.get();
+        }
+        loadElements();
+
+        double dpiFactor = 1.0 / Util::DPI_NORMALIZATION_FACTOR * 300.0;
+
+        int width = static_cast<int>(this->bounds.width * dpiFactor);
+        int height = static_cast<int>(this->bounds.height * dpiFactor);
+        xoj::util::CairoSurfaceSPtr surface(cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height),
+                                            xoj::util::adopt);
+        xoj::util::CairoSPtr cr(cairo_create(surface.get()), xoj::util::adopt);
+        cairo_scale(cr.get(), dpiFactor, dpiFactor);
+        cairo_translate(cr.get(), -this->bounds.x, -this->bounds.y);
+
+        xoj::view::ElementContainerView view(this);
+        view.draw(xoj::view::Context::createDefault(cr.get()));
+
+        this->image.reset(gdk_pixbuf_get_from_surface(surface.get(), 0, 0, width, height), xoj::util::adopt);
+        return this->image.get();
+    }
+
+    /**
+     * @return The contents as a SVG document. Generated on the first call.
+     */
+    const string& getSvg() {
+        if (this->svg) {
+            return *this->svg;
+        }
+        loadElements();
+
+        this->svg.emplace();
+        xoj::util::CairoSurfaceSPtr surface(
+                cairo_svg_surface_create_for_stream(reinterpret_cast<cairo_write_func_t>(svgWriteFunction),
+                                                    &*this->svg, this->bounds.width, this->bounds.height),
+                xoj::util::adopt);
+        {
+            xoj::util::CairoSPtr cr(cairo_create(surface.get()), xoj::util::adopt);
+            cairo_translate(cr.get(), -this->bounds.x, -this->bounds.y);
+
+            xoj::view::ElementContainerView view(this);
+            view.draw(xoj::view::Context::createDefault(cr.get()));
+        }
+        // Flush the SVG document to the string
+        cairo_surface_finish(surface.get());
+
+        return *this->svg;
+    }
+
+    static auto svgWriteFunction(string* svg, const unsigned char* data, unsigned int length) -> cairo_status_t {
+        svg->append(reinterpret_cast<const char*>(data), length);
+        return CAIRO_STATUS_SUCCESS;
+    }
+
 private:
     string text;
-    GdkPixbuf* image;
-    string svg;
     GString* str;
-};
+    string compact;
 
-static auto svgWriteFunction(GString* string, const unsigned char* data, unsigned int length) -> cairo_status_t {
-    g_string_append_len(string, reinterpret_cast<const gchar*>(data), length);
-    return CAIRO_STATUS_SUCCESS;
-}
+    /**
+     * The area covered by the selected elements, and the elements once read back from str
+     */
+    Rectangle<double> bounds;
+    std::optional<std::vector<ElementPtr>> elements;
+
+    xoj::util::GObjectSPtr<GdkPixbuf> image;
+    std::optional<string> svg;
+};
 
 auto ClipboardHandler::copy() -> bool {
     if (!this->selection) {
@@ -150,6 +276,10 @@ auto ClipboardHandler::copy() -> bool {
 
     this->selection->serialize(out);
 
+    CompactOutputStream compactOut(COMPACT_CLIPBOARD_VERSION);
+    compactOut.writeString(PROJECT_STRING);
+    this->selection->writeCompact(compactOut);
+
     /////////////////////////////////////////////////////////////////
     // prepare text contents
     /////////////////////////////////////////////////////////////////
@@ -171,44 +301,11 @@ auto ClipboardHandler::copy() -> bool {
     }
 
     /////////////////////////////////////////////////////////////////
-    // prepare image contents: PNG
+    // prepare image contents: the PNG/SVG are rendered on request, from the xournal contents
     /////////////////////////////////////////////////////////////////
 
-    double dpiFactor = 1.0 / Util::DPI_NORMALIZATION_FACTOR * 300.0;
-
-    int width = static_cast<int>(selection->getWidth() * dpiFactor);
-    int height = static_cast<int>(selection->getHeight() * dpiFactor);
-    cairo_surface_t* surfacePng = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
-    cairo_t* crPng = cairo_create(surfacePng);
-    cairo_scale(crPng, dpiFactor, dpiFactor);
-
-    cairo_translate(crPng, -selection->getOriginalXOnView(), -selection->getOriginalYOnView());
-
-    xoj::view::ElementContainerView view(this->selection);
-    view.draw(xoj::view::Context::createDefault(crPng));
-
-    cairo_destroy(crPng);
-
-    GdkPixbuf* image = gdk_pixbuf_get_from_surface(surfacePng, 0, 0, width, height);
-
-    cairo_surface_destroy(surfacePng);
-
-    /////////////////////////////////////////////////////////////////
-    // prepare image contents: SVG
-    /////////////////////////////////////////////////////////////////
-
-    GString* svgString = g_string_sized_new(1048576);  // 1MB
-
-    cairo_surface_t* surfaceSVG =
-            cairo_svg_surface_create_for_stream(reinterpret_cast<cairo_write_func_t>(svgWriteFunction), svgString,
-                                                selection->getWidth(), selection->getHeight());
-    cairo_t* crSVG = cairo_create(surfaceSVG);
-
-    cairo_translate(crSVG, -selection->getOriginalXOnView(), -selection->getOriginalYOnView());
-    view.draw(xoj::view::Context::createDefault(crSVG));
-
-    cairo_surface_destroy(surfaceSVG);
-    cairo_destroy(crSVG);
+    Rectangle<double> bounds(selection->getOriginalXOnView(), selection->getOriginalYOnView(), selection->getWidth(),
+                             selection->getHeight());
 
     /////////////////////////////////////////////////////////////////
     // copy to clipboard
@@ -226,11 +323,12 @@ auto ClipboardHandler::copy() -> bool {
     gtk_target_list_add_image_targets(list, 0, true);
     gtk_target_list_add(list, atomSvg1, 0, 0);
     gtk_target_list_add(list, atomSvg2, 0, 0);
+    gtk_target_list_add(list, atomXournalCompact, 0, 0);
     gtk_target_list_add(list, atomXournal, 0, 0);
 
     targets = gtk_target_table_new_from_list(list, &n_targets);
 
-    auto* contents = new ClipboardContents(text, image, svgString->str, out.getStr());
+    auto* contents = new ClipboardContents(std::move(text), out.getStr(), compactOut.takeData(), bounds);
 
     gtk_clipboard_set_with_data(this->clipboard, targets, static_cast<guint>(n_targets),
                                 reinterpret_cast<GtkClipboardGetFunc>(ClipboardContents::getFunction),
@@ -240,8 +338,6 @@ auto ClipboardHandler::copy() -> bool {
     gtk_target_table_free(targets, n_targets);
     gtk_target_list_unref(list);
 
-    g_string_free(svgString, true);
-
     return true;
 }
 
@@ -259,6 +355,32 @@ void ClipboardHandler::setCopyCutEnabled(bool enabled) {
     }
 }
 
+auto ClipboardHandler::readSerializedElements(ObjectInputStream& in) -> std::vector<ElementPtr> {
+    std::vector<ElementPtr> elements;
+
+    int count = in.readInt();
+    for (int i = 0; i < count; i++) {
+        std::string name = in.getNextObjectName();
+        ElementPtr element;
+
+        if (name == "Stroke") {
+            element = std::make_unique<Stroke>();
+        } else if (name == "Image") {
+            element = std::make_unique<Image>();
+        } else if (name == "TexImage") {
+            element = std::make_unique<TexImage>();
+        } else if (name == "Text") {
+            element = std::make_unique<Text>();
+        } else {
+            throw InputStreamException(FS(FORMAT_STR("Get unknown object {1}") % name), __FILE__, __LINE__);
+        }
+
+        element->readSerialized(in);
+        elements.emplace_back(std::move(element));
+    }
+    return elements;
+}
+
 void ClipboardHandler::ownerChangedCallback(GtkClipboard* clip, GdkEvent* event, ClipboardHandler* handler) {
     if (gdk_event_get_event_type(event) == GDK_OWNER_CHANGE) {
         handler->clipboardUpdated(event->owner_change.selection);
@@ -288,20 +410,46 @@ void ClipboardHandler::pasteClipboardContents(GtkClipboard* clipboard, GtkSelect
     }
 }
 
+void ClipboardHandler::pasteClipboardCompactContents(GtkClipboard* clipboard, GtkSelectionData* selectionData,
+                                                     ClipboardHandler* handler) {
+    const auto* data = reinterpret_cast<const char*>(gtk_selection_data_get_data(selectionData));
+    gint length = gtk_selection_data_get_length(selectionData);
+
+    if (data && length > 0) {
+        try {
+            CompactInputStream in(data, as_unsigned(length));
+            if (in.getVersion() == COMPACT_CLIPBOARD_VERSION) {
+                handler->listener->clipboardPasteXournal(in);
+                return;
+            }
+            g_warning("Compact clipboard version mismatch (%u / %u), pasting the legacy format", in.getVersion(),
+                      COMPACT_CLIPBOARD_VERSION);
+        } catch (const InputStreamException& e) {
+            g_warning("InputStreamException: %s", e.what());
+        }
+    }
+
+    // Written by a different version: fall back to the tagged format, which tolerates version differences
+    if (handler->containsXournal) {
+        gtk_clipboard_request_contents(clipboard, atomXournal,
+                                       reinterpret_cast<GtkClipboardReceivedFunc>(pasteClipboardContents), handler);
+    }
+}
+
 void ClipboardHandler::pasteClipboardText(GtkClipboard* clipboard, const gchar* text, ClipboardHandler* handler) {
     if (text) {
         handler->listener->clipboardPasteText(text);
     }
 }
 
-auto gtk_selection_data_targets_include_xournal(GtkSelectionData* selection_data) -> gboolean {
+auto gtk_selection_data_targets_include_atom(GtkSelectionData* selection_data, GdkAtom atom) -> gboolean {
     GdkAtom* targets = nullptr;
     gint n_targets = 0;
     gboolean result = false;
 
     if (gtk_selection_data_get_targets(selection_data, &targets, &n_targets)) {
         for (int i = 0; i < n_targets; i++) {
-            if (targets[i] == atomXournal) {
+            if (targets[i] == atom) {
                 result = true;
                 break;
             }
@@ -315,7 +463,8 @@ auto gtk_selection_data_targets_include_xournal(GtkSelectionData* selection_data
 void ClipboardHandler::receivedClipboardContents(GtkClipboard* clipboard, GtkSelectionData* selectionData,
                                                  ClipboardHandler* handler) {
     handler->containsText = gtk_selection_data_targets_include_text(selectionData);
-    handler->containsXournal = gtk_selection_data_targets_include_xournal(selectionData);
+    handler->containsXournal = gtk_selection_data_targets_include_atom(selectionData, atomXournal);
+    handler->containsXournalCompact = gtk_selection_data_targets_include_atom(selectionData, atomXournalCompact);
     handler->containsImage = gtk_selection_data_targets_include_image(selectionData, false);
 
     handler->listener->clipboardPasteEnabled(handler->containsText || handler->containsXournal ||
@@ -13,12 +13,16 @@
 
 #include <limits>  // for numeric_limits
 #include <string>  // for string
+#include <vector>  // for vector
 
 #include <gdk-pixbuf/gdk-pixbuf.h>  // for GdkPixbuf
 #include <gdk/gdk.h>                // for GdkAtom, GdkEvent
 #include <glib.h>                   // for gchar, gulong
 #include <gtk/gtk.h>                // for GtkClipboard, GtkSelectionData
 
+#include "model/Element.h"  // for ElementPtr
+
+class CompactInputStream;
 class ObjectInputStream;
 class EditSelection;
 
@@ -29,6 +33,7 @@ public:
     virtual void clipboardPasteText(std::string text) = 0;
     virtual void clipboardPasteImage(GdkPixbuf* img) = 0;
     virtual void clipboardPasteXournal(ObjectInputStream& in) = 0;
+    virtual void clipboardPasteXournal(CompactInputStream& in) = 0;
     virtual void deleteSelection() = 0;
 
     virtual ~ClipboardListener();
@@ -48,6 +53,11 @@ public:
 
     void setCopyCutEnabled(bool enabled);
 
+    /**
+     * Reads the elements which follow the selection in the clipboard contents
+     */
+    static std::vector<ElementPtr> readSerializedElements(ObjectInputStream& in);
+
 private:
     static void ownerChangedCallback(GtkClipboard* clip, GdkEvent* event, ClipboardHandler* handler);
     void clipboardUpdated(GdkAtom atom);
@@ -56,6 +66,8 @@ private:
 
     static void pasteClipboardContents(GtkClipboard* clipboard, GtkSelectionData* selectionData,
                                        ClipboardHandler* handler);
+    static void pasteClipboardCompactContents(GtkClipboard* clipboard, GtkSelectionData* selectionData,
+                                              ClipboardHandler* handler);
     static void pasteClipboardImage(GtkClipboard* clipboard, GdkPixbuf* pixbuf, ClipboardHandler* handler);
 
     static void pasteClipboardText(GtkClipboard* clipboard, const gchar* text, ClipboardHandler* handler);
@@ -69,5 +81,6 @@ private:
 
     bool containsText = false;
     bool containsXournal = false;
+    bool containsXournalCompact = false;
     bool containsImage = false;
 };
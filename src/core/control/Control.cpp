@@ -1,20 +1,25 @@
 #include "Control.h"
 
-#include <algorithm>   // for max
-#include <cstdlib>     // for size_t
-#include <exception>   // for exce...
-#include <functional>  // for bind
-#include <iterator>    // for end
+#include <algorithm>    // for max, find_if
+#include <chrono>       // for steady_clock, seconds
+#include <cstdint>      // for uint8_t, uint64_t
+#include <cstdlib>      // for size_t
+#include <ctime>        // for localtime, strftime, time
+#include <exception>    // for exce...
+#include <functional>   // for bind
+#include <iterator>     // for end
 #include <locale>
-#include <memory>    // for make...
-#include <numeric>   // for accu...
-#include <optional>  // for opti...
-#include <regex>     // for regex
-#include <utility>   // for move
+#include <memory>       // for make...
+#include <numeric>      // for accu...
+#include <optional>     // for opti...
+#include <regex>        // for regex
+#include <string_view>  // for string_view
+#include <utility>      // for move
 
 #include "control/AudioController.h"                             // for Audi...
 #include "control/ClipboardHandler.h"                            // for Clip...
 #include "control/CompassController.h"                           // for Comp...
+#include "control/PerformanceMonitor.h"                          // for Perf...
 #include "control/RecentManager.h"                               // for Rece...
 #include "control/ScrollHandler.h"                               // for Scro...
 #include "control/SetsquareController.h"                         // for Sets...
@@ -28,6 +33,7 @@
 #include "control/jobs/SaveJob.h"                                // for SaveJob
 #include "control/jobs/Scheduler.h"                              // for JOB_...
 #include "control/jobs/XournalScheduler.h"                       // for Xour...
+#include "control/latex/LatexCachePrewarmer.h"                   // for Late...
 #include "control/layer/LayerController.h"                       // for Laye...
 #include "control/pagetype/PageTypeHandler.h"                    // for Page...
 #include "control/settings/ButtonConfig.h"                       // for Butt...
@@ -95,11 +101,13 @@
 #include "util/PlaceholderString.h"                              // for Plac...
 #include "util/PopupWindowWrapper.h"                             // for PopupWindowWrapper
 #include "util/Stacktrace.h"                                     // for Stac...
+#include "util/Tracing.h"                                        // for start, stop
 #include "util/Util.h"                                           // for exec...
 #include "util/XojMsgBox.h"                                      // for XojM...
 #include "util/glib_casts.h"                                     // for wrap_v
 #include "util/i18n.h"                                           // for _, FS
 #include "util/safe_casts.h"                                     // for as_unsigned
+#include "util/serializing/CompactInputStream.h"                 // for Comp...
 #include "util/serializing/InputStreamException.h"               // for Inpu...
 #include "util/serializing/ObjectInputStream.h"                  // for Obje...
 #include "view/CompassView.h"                                    // for Comp...
@@ -130,6 +138,7 @@ Control::Control(GApplication* gtkApp, GladeSearchpath* gladeSearchPath, bool di
     this->settings = new Settings(std::move(name));
     this->settings->load();
     this->loadPaletteFromSettings();
+    this->undoRedo->setMemoryBudget(static_cast<size_t>(this->settings->getUndoMemoryBudget()) * 1024 * 1024);
 
     this->pageTypes = new PageTypeHandler(gladeSearchPath);
 
@@ -139,6 +148,7 @@ Control::Control(GApplication* gtkApp, GladeSearchpath* gladeSearchPath, bool di
     this->scrollHandler = new ScrollHandler(this);
 
     this->scheduler = new XournalScheduler();
+    this->performanceMonitor = std::make_unique<PerformanceMonitor>();
 
     this->doc = new Document(this);
 
@@ -173,6 +183,7 @@ Control::~Control() {
     this->enableAutosave(false);
 
     deleteLastAutosaveFile();
+    this->latexCachePrewarmer.reset();
     this->scheduler->stop();
     this->changedPages.clear();  // can be removed, will be done by implicit destructor
 
@@ -244,19 +255,35 @@ void Control::deleteLastAutosaveFile() {
 }
 
 auto Control::checkChangedDocument(Control* control) -> bool {
+    // Updating the preview of a page while the user writes on it would render it again after every stroke
+    constexpr auto PREVIEW_UPDATE_DELAY = std::chrono::seconds(1);
+    const auto now = std::chrono::steady_clock::now();
+
     if (!control->doc->tryLock()) {
         // call again later
         return true;
     }
-    for (auto const& page: control->changedPages) {
-        auto p = control->doc->indexOf(page);
-        if (p != npos) {
-            for (DocumentListener* dl: control->changedDocumentListeners) {
-                dl->pageChanged(p);
-            }
+    std::vector<ChangedPage> postponedPages;
+    for (auto const& changed: control->changedPages) {
+        auto p = control->doc->indexOf(changed.page);
+        if (p == npos) {
+            continue;
+        }
+        if (now - changed.lastChange < PREVIEW_UPDATE_DELAY) {
+            postponedPages.push_back(changed);
+            continue;
+        }
+        if (XojPageView* view = control->win ? control->win->getXournal()->getViewFor(p) : nullptr;
+            view && view->isInputInProgress()) {
+            // Still being drawn on
+            postponedPages.push_back(changed);
+            continue;
+        }
+        for (DocumentListener* dl: control->changedDocumentListeners) {
+            dl->pageChanged(p);
         }
     }
-    control->changedPages.clear();
+    control->changedPages = std::move(postponedPages);
     control->doc->unlock();
 
     // Call again
@@ -640,6 +667,41 @@ void Control::setShowMenubar(bool enabled) {
     actionDB->setActionState(Action::SHOW_MENUBAR, enabled);
 }
 
+void Control::setShowPerformanceOverlay(bool enabled) {
+    if (enabled) {
+        this->performanceMonitor->clear();
+    }
+    this->performanceMonitor->setEnabled(enabled);
+    win->setPerformanceOverlayVisible(enabled);
+    actionDB->setActionState(Action::SHOW_PERFORMANCE_OVERLAY, enabled);
+}
+
+void Control::setRecordTrace(bool enabled) {
+    if (enabled == xoj::util::trace::isEnabled()) {
+        actionDB->setActionState(Action::RECORD_TRACE, enabled);
+        return;
+    }
+
+    if (enabled) {
+        char filename[50];
+        time_t curtime = time(nullptr);
+        strftime(filename, sizeof(filename), "xournalpp-%Y%m%d-%H%M%S.json", localtime(&curtime));
+        xoj::util::trace::setThreadName("UI");
+        xoj::util::trace::start(Util::getCacheSubfolder("traces") / filename);
+    } else {
+        // May be the file given with --trace
+        fs::path file = xoj::util::trace::getFile();
+        if (xoj::util::trace::stop()) {
+            XojMsgBox::showMessageToUser(getGtkWindow(), FS(_F("The trace was written to \"{1}\"") % file.u8string()),
+                                         GTK_MESSAGE_INFO);
+        } else {
+            XojMsgBox::showErrorToUser(getGtkWindow(),
+                                       FS(_F("Could not write the trace to \"{1}\"") % file.u8string()));
+        }
+    }
+    actionDB->setActionState(Action::RECORD_TRACE, enabled);
+}
+
 void Control::disableSidebarTmp(bool disabled) { this->sidebar->setTmpDisabled(disabled); }
 
 void Control::addDefaultPage(const std::optional<std::string>& pageTemplate, Document* doc) {
@@ -1096,8 +1158,13 @@ void Control::undoRedoChanged() {
 }
 
 void Control::undoRedoPageChanged(PageRef page) {
-    if (std::find(begin(this->changedPages), end(this->changedPages), page) == end(this->changedPages)) {
-        this->changedPages.emplace_back(std::move(page));
+    auto now = std::chrono::steady_clock::now();
+    auto it = std::find_if(begin(this->changedPages), end(this->changedPages),
+                           [&page](const ChangedPage& changed) { return changed.page == page; });
+    if (it != end(this->changedPages)) {
+        it->lastChange = now;
+    } else {
+        this->changedPages.push_back({std::move(page), now});
     }
 }
 
@@ -1379,6 +1446,8 @@ void Control::showSettings() {
                     win->getLayout()->scrollRelative(xChange, yChange);
                 }
 
+                ctrl->undoRedo->setMemoryBudget(static_cast<size_t>(settings->getUndoMemoryBudget()) * 1024 * 1024);
+
                 if (settingsBeforeDialog.stylusCursorType != settings->getStylusCursorType() ||
                     settingsBeforeDialog.highlightPosition != settings->isHighlightPosition()) {
                     ctrl->getCursor()->updateCursor();
@@ -1631,6 +1700,16 @@ void Control::fileLoaded(int scrollToPage) {
     win->getXournal()->forceUpdatePagenumbers();
     getCursor()->updateCursor();
     updatePageActions();
+
+    // The formulas of the previous document are not needed any more
+    this->latexCachePrewarmer.reset();
+    if (settings->latexSettings.prewarmCache) {
+        this->latexCachePrewarmer = LatexCachePrewarmer::forDocument(this->doc, settings->latexSettings,
+                                                                     toolHandler->getTool(TOOL_TEXT).getColor());
+        if (this->latexCachePrewarmer) {
+            this->latexCachePrewarmer->start();
+        }
+    }
 }
 
 enum class MissingPdfDialogOptions : gint { USE_PROPOSED, SELECT_OTHER, REMOVE, CANCEL };
@@ -1765,9 +1844,9 @@ void Control::askToAnnotatePdf() {
 }
 
 void Control::print() {
-    this->doc->lock();
+    // Not locked here: the print dialog runs a main loop, and the pages are rendered on worker threads which lock the
+    // document for each page
     PrintHandler::print(this->doc, getCurrentPageNo(), this->getGtkWindow());
-    this->doc->unlock();
 }
 
 void Control::block(const string& name) {
@@ -2172,6 +2251,60 @@ void Control::registerPluginToolButtons(ToolMenuHandler* toolMenuHandler) {
 }
 
 void Control::clipboardPasteXournal(ObjectInputStream& in) {
+    clipboardPasteSelection([&in](EditSelection& selection) {
+        std::string version = in.readString();
+        if (version != PROJECT_STRING) {
+            g_warning("Paste from Xournal Version %s to Xournal Version %s", version.c_str(), PROJECT_STRING);
+        }
+
+        selection.readSerialized(in);
+
+        for (ElementPtr& element: ClipboardHandler::readSerializedElements(in)) {
+            selection.addElement(std::move(element), std::numeric_limits<Element::Index>::max());
+        }
+    });
+}
+
+void Control::clipboardPasteXournal(CompactInputStream& in) {
+    clipboardPasteSelection([&in](EditSelection& selection) {
+        std::string_view version = in.readStringView();
+        if (version != PROJECT_STRING) {
+            g_warning("Paste from Xournal Version %.*s to Xournal Version %s", static_cast<int>(version.length()),
+                      version.data(), PROJECT_STRING);
+        }
+
+        selection.readCompact(in);
+
+        auto count = in.read<uint64_t>();
+        for (uint64_t i = 0; i < count; i++) {
+            auto type = in.read<uint8_t>();
+            ElementPtr element;
+
+            switch (type) {
+                case ELEMENT_STROKE:
+                    element = std::make_unique<Stroke>();
+                    break;
+                case ELEMENT_IMAGE:
+                    element = std::make_unique<Image>();
+                    break;
+                case ELEMENT_TEXIMAGE:
+                    element = std::make_unique<TexImage>();
+                    break;
+                case ELEMENT_TEXT:
+                    element = std::make_unique<Text>();
+                    break;
+                default:
+                    throw InputStreamException(FS(FORMAT_STR("Get unknown element type {1}") % int(type)), __FILE__,
+                                               __LINE__);
+            }
+
+            element->readCompact(in);
+            selection.addElement(std::move(element), std::numeric_limits<Element::Index>::max());
+        }
+    });
+}
+
+void Control::clipboardPasteSelection(const std::function<void(EditSelection&)>& readSelection) {
     auto pNr = getCurrentPageNo();
     if (pNr == npos && win != nullptr) {
         return;
@@ -2192,41 +2325,13 @@ void Control::clipboardPasteXournal(ObjectInputStream& in) {
     this->doc->unlock();
 
     try {
-        ElementPtr element;
-        std::string version = in.readString();
-        if (version != PROJECT_STRING) {
-            g_warning("Paste from Xournal Version %s to Xournal Version %s", version.c_str(), PROJECT_STRING);
-        }
-
-        selection->readSerialized(in);
-
         // document lock not needed anymore, because we don't change the document, we only change the selection
+        readSelection(*selection);
 
-        int count = in.readInt();
-        auto pasteAddUndoAction = std::make_unique<AddUndoAction>(page, false);
         // this will undo a group of elements that are inserted
-
-        for (int i = 0; i < count; i++) {
-            std::string name = in.getNextObjectName();
-            element.reset();
-
-            if (name == "Stroke") {
-                element = std::make_unique<Stroke>();
-            } else if (name == "Image") {
-                element = std::make_unique<Image>();
-            } else if (name == "TexImage") {
-                element = std::make_unique<TexImage>();
-            } else if (name == "Text") {
-                element = std::make_unique<Text>();
-            } else {
-                throw InputStreamException(FS(FORMAT_STR("Get unknown object {1}") % name), __FILE__, __LINE__);
-            }
-
-            element->readSerialized(in);
-
-            pasteAddUndoAction->addElement(layer, element.get(), layer->indexOf(element.get()));
-            // Todo: unique_ptr
-            selection->addElement(std::move(element), std::numeric_limits<Element::Index>::max());
+        auto pasteAddUndoAction = std::make_unique<AddUndoAction>(page, false);
+        for (Element* e: selection->getElements()) {
+            pasteAddUndoAction->addElement(layer, e, layer->indexOf(e));
         }
         undoRedo->addUndoAction(std::move(pasteAddUndoAction));
 
@@ -2437,6 +2542,8 @@ auto Control::getLayerController() const -> LayerController* { return this->laye
 
 auto Control::getPluginController() const -> PluginController* { return this->pluginController; }
 
+auto Control::getPerformanceMonitor() const -> PerformanceMonitor* { return this->performanceMonitor.get(); }
+
 auto Control::getPalette() const -> const Palette& { return *(this->palette); }
 
 auto Control::loadPaletteFromSettings() -> void {
@@ -11,11 +11,13 @@
 
 #pragma once
 
-#include <cstddef>   // for size_t
-#include <memory>    // for unique_ptr
-#include <optional>  // for optional
-#include <string>    // for string, allocator
-#include <vector>    // for vector
+#include <chrono>      // for steady_clock
+#include <cstddef>     // for size_t
+#include <functional>  // for function
+#include <memory>      // for unique_ptr
+#include <optional>    // for optional
+#include <string>      // for string, allocator
+#include <vector>      // for vector
 
 #include <gdk-pixbuf/gdk-pixbuf.h>  // for GdkPixbuf
 #include <gio/gio.h>                // for GApplication
@@ -50,14 +52,17 @@ class ToolbarDragDropHandler;
 class MetadataEntry;
 class MetadataCallbackData;
 class PageBackgroundChangeController;
+class PerformanceMonitor;
 class PageTypeHandler;
 class BaseExportJob;
 class LayerController;
+class LatexCachePrewarmer;
 class PluginController;
 class Document;
 class EditSelection;
 class Element;
 class MainWindow;
+class CompactInputStream;
 class ObjectInputStream;
 class ScrollHandler;
 class SearchBar;
@@ -196,6 +201,9 @@ public:
     void setShowSidebar(bool enabled);
     void setShowToolbar(bool enabled);
     void setShowMenubar(bool enabled);
+    void setShowPerformanceOverlay(bool enabled);
+    /// Starts tracing to a new file in the cache folder, or stops tracing and tells the user where the trace is
+    void setRecordTrace(bool enabled);
 
     void gotoPage();
 
@@ -316,6 +324,7 @@ public:
     PageBackgroundChangeController* getPageBackgroundChangeController() const;
     LayerController* getLayerController() const;
     PluginController* getPluginController() const;
+    PerformanceMonitor* getPerformanceMonitor() const;
     const Palette& getPalette() const;
 
 
@@ -351,10 +360,17 @@ public:
     void clipboardPasteText(std::string text) override;
     void clipboardPasteImage(GdkPixbuf* img) override;
     void clipboardPasteXournal(ObjectInputStream& in) override;
+    void clipboardPasteXournal(CompactInputStream& in) override;
     void deleteSelection() override;
 
     void clipboardPaste(ElementPtr e);
 
+private:
+    /**
+     * Creates a selection on the current page, fills it with readSelection and moves it to the paste target
+     */
+    void clipboardPasteSelection(const std::function<void(EditSelection&)>& readSelection);
+
 public:
     void registerPluginToolButtons(ToolMenuHandler* toolMenuHandler);
     inline ActionDatabase* getActionDatabase() const { return actionDB.get(); }
@@ -495,10 +511,16 @@ private:
      */
     guint changeTimout;
 
+    struct ChangedPage {
+        PageRef page;
+        /// The preview of a page is only updated once the user paused editing it
+        std::chrono::steady_clock::time_point lastChange;
+    };
+
     /**
      * The pages wihch has changed since the last update (for preview update)
      */
-    std::vector<PageRef> changedPages;
+    std::vector<ChangedPage> changedPages;
 
     /**
      * DocumentListener instances that are to be updated by checkChangedDocument.
@@ -518,6 +540,11 @@ private:
 
     XournalScheduler* scheduler;
 
+    /**
+     * Timings shown in the performance overlay
+     */
+    std::unique_ptr<PerformanceMonitor> performanceMonitor;
+
     /**
      * State / Blocking attributes
      */
@@ -535,6 +562,11 @@ private:
 
     std::unique_ptr<PageBackgroundChangeController> pageBackgroundChangeController;
 
+    /**
+     * Compiles the formulas of the last loaded document in the background, if enabled in the settings
+     */
+    std::unique_ptr<LatexCachePrewarmer> latexCachePrewarmer;
+
     LayerController* layerController;
 
     std::unique_ptr<GeometryTool> geometryTool;
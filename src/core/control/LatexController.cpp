@@ -1,5 +1,6 @@
 #include "LatexController.h"
 
+#include <chrono>    // for steady_clock, milliseconds
 #include <cstdlib>   // for free
 #include <fstream>   // for ifstream, basic_istream
 #include <iterator>  // for istreambuf_iterator, ope...
@@ -7,7 +8,7 @@
 #include <memory>    // for unique_ptr, allocator
 #include <optional>  // for optional
 #include <utility>   // for move
-#include <variant>   // for get_if
+#include <variant>   // for get_if, get
 
 #include <glib.h>  // for g_error_free, g_error_ma...
 
@@ -49,12 +50,18 @@ using std::string;
 constexpr Color LIGHT_PREVIEW_BACKGROUND = Colors::white;
 constexpr Color DARK_PREVIEW_BACKGROUND = Colors::black;
 
+/// Number of failures of the LaTeX worker confirmed with the generation command, in this session
+static int checkedWorkerFailures = 0;
+/// Past this number, formulas the worker cannot compile are only compiled again if the log blames the preamble
+constexpr int MAX_CHECKED_WORKER_FAILURES = 3;
+
 LatexController::LatexController(Control* control):
         control(control),
         settings(control->getSettings()->latexSettings),
         doc(control->getDocument()),
         texTmpDir(Util::getTmpDirSubfolder("tex")),
-        generator(settings) {
+        generator(settings),
+        cache(LatexCache::fromSettings(settings)) {
     Util::ensureFolderExists(this->texTmpDir);
 }
 
@@ -177,15 +184,53 @@ void LatexController::triggerImageUpdate(const string& texString) {
 
     this->lastPreviewedTex = texString;
     const std::string texContents = LatexGenerator::templateSub(texString, this->latexTemplate, textColor);
-    auto result = generator.asyncRun(this->texTmpDir, texContents);
-    if (auto* err = std::get_if<LatexGenerator::GenError>(&result)) {
-        XojMsgBox::showErrorToUser(this->control->getGtkWindow(), err->message);
-    } else if (auto** proc = std::get_if<GSubprocess*>(&result)) {
+
+    // A formula which was already compiled is shown without running LaTeX
+    this->renderedCacheKey = LatexCache::computeKey(texContents, this->settings.genCmd);
+    if (auto pdf = this->cache.lookup(this->renderedCacheKey)) {
+        this->isValidTex = true;
+        this->texProcessOutput.clear();
+        this->temporaryRender = loadRendered(texString, std::move(*pdf));
+        if (this->temporaryRender != nullptr) {
+            this->dlg->setTempRender(this->temporaryRender->getPdf());
+            updateStatus();
+            return;
+        }
+    }
+
+    startCompilation(texContents, true);
+}
+
+void LatexController::startCompilation(const std::string& texContents, bool allowWorker) {
+    this->compiledTexContents = texContents;
+    this->compilationStart = std::chrono::steady_clock::now();
+
+    GSubprocess* proc = nullptr;
+    std::string input;
+    std::optional<LatexWorker::Run> run;
+    if (allowWorker && this->worker && (run = this->worker->run(texContents))) {
+        proc = run->proc;
+        input = std::move(run->input);
+    } else {
+        auto result = generator.asyncRun(this->texTmpDir, texContents);
+        if (auto* err = std::get_if<LatexGenerator::GenError>(&result)) {
+            XojMsgBox::showErrorToUser(this->control->getGtkWindow(), err->message);
+        } else {
+            proc = std::get<GSubprocess*>(result);
+        }
+        if (allowWorker && this->worker) {
+            // The worker is not ready yet: it will be for the next preview
+            this->worker->prepare();
+        }
+    }
+    this->compiledByWorker = run.has_value();
+
+    if (proc) {
         // Render the TeX and capture the process' output.
         updating_cancellable = g_cancellable_new();
-        char* stdinBuff = nullptr;  // No stdin
+        const char* stdinBuff = input.empty() ? nullptr : input.c_str();
 
-        g_subprocess_communicate_utf8_async(*proc, stdinBuff, updating_cancellable,
+        g_subprocess_communicate_utf8_async(proc, stdinBuff, updating_cancellable,
                                             reinterpret_cast<GAsyncReadyCallback>(onPdfRenderComplete), this);
     }
 
@@ -247,6 +292,31 @@ void LatexController::onPdfRenderComplete(GObject* procObj, GAsyncResult* res, L
         self->isValidTex = true;
     }
 
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() -
+                                                                          self->compilationStart);
+    g_debug("LaTeX preview compiled in %lld ms (%s)", static_cast<long long>(duration.count()),
+            self->compiledByWorker ? "LaTeX worker" : "generation command");
+
+    if (self->compiledByWorker && !self->isValidTex &&
+        (LatexWorker::isPreambleFailure(self->texProcessOutput) ||
+         checkedWorkerFailures < MAX_CHECKED_WORKER_FAILURES)) {
+        // The worker skips the beginning of the template: make sure the formula is invalid with the whole command.
+        // Once the first failures are confirmed, the other ones are only checked if the log blames the preamble.
+        checkedWorkerFailures++;
+        g_clear_object(&self->updating_cancellable);
+        g_clear_object(&proc);
+        self->retryWithoutWorker = true;
+        self->startCompilation(self->compiledTexContents, false);
+        return;
+    }
+    if (self->retryWithoutWorker) {
+        self->retryWithoutWorker = false;
+        if (self->isValidTex && self->worker) {
+            g_warning("The LaTeX worker failed to compile a valid formula, the generation command will be used");
+            self->worker->disable();
+        }
+    }
+
     // Delete the PDF if the TeX is invalid.
     if (!self->isValidTex) {
         fs::path pdfPath = self->texTmpDir / "tex.pdf";
@@ -256,7 +326,13 @@ void LatexController::onPdfRenderComplete(GObject* procObj, GAsyncResult* res, L
     const string currentTex = self->dlg->getBufferContents();
     bool shouldUpdate = self->lastPreviewedTex != currentTex;
     if (self->isValidTex) {
-        self->temporaryRender = self->loadRendered(currentTex);
+        auto contents = Util::readString(self->texTmpDir / "tex.pdf", true, std::ios::binary);
+        if (contents) {
+            self->cache.store(self->renderedCacheKey, *contents);
+            self->temporaryRender = self->loadRendered(currentTex, std::move(*contents));
+        } else {
+            self->temporaryRender.reset();
+        }
         if (self->temporaryRender != nullptr) {
             self->dlg->setTempRender(self->temporaryRender->getPdf());
         }
@@ -283,20 +359,14 @@ void LatexController::deleteOldImage() {
     }
 }
 
-auto LatexController::loadRendered(string renderedTex) -> std::unique_ptr<TexImage> {
+auto LatexController::loadRendered(string renderedTex, string pdfContents) -> std::unique_ptr<TexImage> {
     if (!this->isValidTex) {
         return nullptr;
     }
 
-    fs::path pdfPath = texTmpDir / "tex.pdf";
-    auto contents = Util::readString(pdfPath, true, std::ios::binary);
-    if (!contents) {
-        return nullptr;
-    }
-
     auto img = std::make_unique<TexImage>();
     GError* err{};
-    bool loaded = img->loadData(std::move(*contents), &err);
+    bool loaded = img->loadData(std::move(pdfContents), &err);
 
     if (err != nullptr) {
         string message = FS(_F("Could not load LaTeX PDF file: {1}") % err->message);
@@ -353,6 +423,16 @@ void LatexController::run(Control* ctrl) {
         return;
     }
 
+    if (self->settings.useWorker) {
+        self->worker = std::make_unique<LatexWorker>(self->settings, self->texTmpDir, self->latexTemplate);
+        if (self->worker->isSupported()) {
+            // Preload the template while the user types the formula
+            self->worker->prepare();
+        } else {
+            self->worker.reset();
+        }
+    }
+
     self->findSelectedTexElement();
     showTexEditDialog(std::move(self));
 }
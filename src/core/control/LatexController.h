@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <chrono>  // for steady_clock
 #include <memory>  // for unique_ptr
 #include <string>  // for string
 
@@ -21,7 +22,9 @@
 #include <gtk/gtk.h>  // for GtkTextBuffer
 #include <poppler.h>  // for GObject
 
+#include "control/latex/LatexCache.h"      // for LatexCache
 #include "control/latex/LatexGenerator.h"  // for LatexGenerator
+#include "control/latex/LatexWorker.h"     // for LatexWorker
 #include "model/PageRef.h"                 // for PageRef
 
 #include "filesystem.h"  // for path
@@ -84,6 +87,12 @@ private:
      */
     void triggerImageUpdate(const std::string& texString);
 
+    /**
+     * Starts the compilation of the substituted template, with the LaTeX worker if it is ready and allowed, or with
+     * the generation command.
+     */
+    void startCompilation(const std::string& texContents, bool allowWorker);
+
     /**
      * Show the LaTex Editor dialog and process its output
      */
@@ -107,9 +116,9 @@ private:
     bool isUpdating();
 
     /**
-     * Load the preview PDF from disk and create a TexImage object.
+     * Create a TexImage object from the contents of the preview PDF.
      */
-    std::unique_ptr<TexImage> loadRendered(std::string renderedTex);
+    std::unique_ptr<TexImage> loadRendered(std::string renderedTex, std::string pdfContents);
 
     /**
      * Insert the generated preview TexImage into the current page.
@@ -150,6 +159,27 @@ private:
      */
     std::string lastPreviewedTex;
 
+    /**
+     * The cache key of the preview being generated
+     */
+    std::string renderedCacheKey;
+
+    /**
+     * The LaTeX file being compiled, when the preview is being generated
+     */
+    std::string compiledTexContents;
+    std::chrono::steady_clock::time_point compilationStart;
+
+    /**
+     * Whether the preview being generated is compiled by the worker
+     */
+    bool compiledByWorker = false;
+
+    /**
+     * Whether the preview being generated is compiled again with the generation command, after the worker failed
+     */
+    bool retryWithoutWorker = false;
+
     /**
      * Whether a preview is currently being generated.
      */
@@ -224,4 +254,11 @@ private:
     std::unique_ptr<TexImage> temporaryRender;
 
     LatexGenerator generator;
+
+    LatexCache cache;
+
+    /**
+     * Compiles the previews faster, if enabled in the settings
+     */
+    std::unique_ptr<LatexWorker> worker;
 };
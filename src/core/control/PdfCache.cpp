@@ -12,6 +12,7 @@
 #include "control/settings/Settings.h"  // for Settings
 #include "pdf/base/XojPdfDocument.h"    // for XojPdfDocument
 #include "util/Range.h"                 // for Range
+#include "util/Tracing.h"               // for XOJ_TRACE_SCOPE
 #include "util/i18n.h"                  // for _
 #include "util/safe_casts.h"            // for as_unsigned
 #include "view/Mask.h"                  // for Mask
@@ -79,6 +80,7 @@ auto PdfCache::cache(XojPdfPageSPtr popplerPage, xoj::view::Mask&& buffer) -> co
 }
 
 void PdfCache::render(cairo_t* cr, size_t pdfPageNo, double zoom, double pageWidth, double pageHeight) {
+    XOJ_TRACE_SCOPE("PdfCache::render");
     std::lock_guard<std::mutex> lock(this->renderMutex);
 
     const PdfCacheEntry* cacheResult = lookup(pdfPageNo);
@@ -95,6 +97,7 @@ void PdfCache::render(cairo_t* cr, size_t pdfPageNo, double zoom, double pageWid
     }
 
     if (needsRefresh) {
+        this->misses++;
         double renderZoom = std::max(zoom, 1.0);
 
         auto popplerPage = cacheResult ? cacheResult->popplerPage : pdfDocument.getPage(pdfPageNo);
@@ -109,11 +112,22 @@ void PdfCache::render(cairo_t* cr, size_t pdfPageNo, double zoom, double pageWid
                                renderZoom, CAIRO_CONTENT_COLOR_ALPHA);
         popplerPage->render(buffer.get());
         cacheResult = cache(popplerPage, std::move(buffer));
+    } else {
+        this->hits++;
     }
 
     cacheResult->buffer.paintTo(cr);
 }
 
+auto PdfCache::getStatistics() -> Statistics {
+    std::lock_guard<std::mutex> lock(this->renderMutex);
+    size_t memoryUsage = 0;
+    for (auto& e: this->data) {
+        memoryUsage += e->buffer.getMemoryUsage();
+    }
+    return {this->hits, this->misses, this->data.size(), memoryUsage};
+}
+
 void PdfCache::renderMissingPdfPage(cairo_t* cr, double pageWidth, double pageHeight) {
     cairo_select_font_face(cr, "Sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_BOLD);
     cairo_set_font_size(cr, 26);
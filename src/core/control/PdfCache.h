@@ -60,6 +60,15 @@ public:
 
     void updateSettings(Settings* settings);
 
+    struct Statistics {
+        size_t hits;
+        size_t misses;  ///< Including the entries re-rendered because the zoom changed
+        size_t entries;
+        size_t memoryUsage;  ///< In bytes
+    };
+
+    Statistics getStatistics();
+
     /**
      * @brief Renders an error background, for when the pdf page cannot be rendered
      */
@@ -84,4 +93,7 @@ private:
     decltype(data)::size_type maxSize = 0;
 
     double zoomRefreshThreshold;
+
+    size_t hits = 0;
+    size_t misses = 0;
 };
@@ -0,0 +1,147 @@
+#include "PerformanceMonitor.h"
+
+#include <algorithm>  // for max, find_if
+
+namespace {
+auto toMs(PerformanceMonitor::Duration duration) -> double {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+}  // namespace
+
+void PerformanceMonitor::TimingWindow::add(double ms) {
+    samples[next] = ms;
+    next = (next + 1) % WINDOW_SIZE;
+    count = std::min(count + 1, WINDOW_SIZE);
+}
+
+auto PerformanceMonitor::TimingWindow::summarize() const -> TimingSummary {
+    TimingSummary summary;
+    if (count == 0) {
+        return summary;
+    }
+    double sum = 0;
+    for (size_t i = 0; i < count; i++) {
+        sum += samples[i];
+        summary.maxMs = std::max(summary.maxMs, samples[i]);
+    }
+    summary.lastMs = samples[(next + WINDOW_SIZE - 1) % WINDOW_SIZE];
+    summary.averageMs = sum / static_cast<double>(count);
+    summary.samples = count;
+    return summary;
+}
+
+void PerformanceMonitor::TimingWindow::clear() {
+    count = 0;
+    next = 0;
+}
+
+void PerformanceMonitor::setEnabled(bool enabled) { this->enabled.store(enabled, std::memory_order_relaxed); }
+
+auto PerformanceMonitor::isEnabled() const -> bool { return this->enabled.load(std::memory_order_relaxed); }
+
+void PerformanceMonitor::clear() {
+    std::lock_guard lock(this->mutex);
+    this->drawTimes.clear();
+    this->renderLatencies.clear();
+    this->inkLatencies.clear();
+    this->recentPages.clear();
+    this->predictionSamples = 0;
+    this->predictionTotalError = 0;
+    this->predictionMaxError = 0;
+    this->recognitionTimes = {};
+    this->recognitionTotalMs = 0;
+}
+
+void PerformanceMonitor::recordDrawTime(Duration duration) {
+    if (!isEnabled()) {
+        return;
+    }
+    std::lock_guard lock(this->mutex);
+    this->drawTimes.add(toMs(duration));
+}
+
+void PerformanceMonitor::recordRenderLatency(size_t page, Duration duration) {
+    if (!isEnabled()) {
+        return;
+    }
+    const double ms = toMs(duration);
+
+    std::lock_guard lock(this->mutex);
+    this->renderLatencies.add(ms);
+
+    auto it = std::find_if(this->recentPages.begin(), this->recentPages.end(),
+                           [page](const auto& entry) { return entry.first == page; });
+    if (it != this->recentPages.end()) {
+        this->recentPages.erase(it);
+    } else if (this->recentPages.size() == RECENT_PAGES) {
+        this->recentPages.pop_back();
+    }
+    this->recentPages.emplace_front(page, ms);
+}
+
+void PerformanceMonitor::recordInkLatency(Duration duration) {
+    if (!isEnabled()) {
+        return;
+    }
+    std::lock_guard lock(this->mutex);
+    this->inkLatencies.add(toMs(duration));
+}
+
+void PerformanceMonitor::recordPredictionErrors(size_t samples, double total, double max) {
+    if (!isEnabled() || samples == 0) {
+        return;
+    }
+    std::lock_guard lock(this->mutex);
+    this->predictionSamples += samples;
+    this->predictionTotalError += total;
+    this->predictionMaxError = std::max(this->predictionMaxError, max);
+}
+
+void PerformanceMonitor::recordRecognitionTime(Duration duration) {
+    if (!isEnabled()) {
+        return;
+    }
+    const double ms = toMs(duration);
+    std::lock_guard lock(this->mutex);
+    this->recognitionTotalMs += ms;
+    this->recognitionTimes.samples++;
+    this->recognitionTimes.lastMs = ms;
+    this->recognitionTimes.maxMs = std::max(this->recognitionTimes.maxMs, ms);
+    this->recognitionTimes.averageMs = this->recognitionTotalMs / static_cast<double>(this->recognitionTimes.samples);
+}
+
+auto PerformanceMonitor::getDrawTimes() const -> TimingSummary {
+    std::lock_guard lock(this->mutex);
+    return this->drawTimes.summarize();
+}
+
+auto PerformanceMonitor::getRenderLatencies() const -> TimingSummary {
+    std::lock_guard lock(this->mutex);
+    return this->renderLatencies.summarize();
+}
+
+auto PerformanceMonitor::getRecentPageLatencies() const -> std::vector<std::pair<size_t, double>> {
+    std::lock_guard lock(this->mutex);
+    return {this->recentPages.begin(), this->recentPages.end()};
+}
+
+auto PerformanceMonitor::getInkLatencies() const -> TimingSummary {
+    std::lock_guard lock(this->mutex);
+    return this->inkLatencies.summarize();
+}
+
+auto PerformanceMonitor::getPredictionErrors() const -> ErrorSummary {
+    std::lock_guard lock(this->mutex);
+    ErrorSummary summary;
+    if (this->predictionSamples > 0) {
+        summary.averageError = this->predictionTotalError / static_cast<double>(this->predictionSamples);
+        summary.maxError = this->predictionMaxError;
+        summary.samples = this->predictionSamples;
+    }
+    return summary;
+}
+
+auto PerformanceMonitor::getRecognitionTimes() const -> TimingSummary {
+    std::lock_guard lock(this->mutex);
+    return this->recognitionTimes;
+}
@@ -0,0 +1,124 @@
+/*
+ * Xournal++
+ *
+ * Collects the timings shown in the performance overlay
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <array>    // for array
+#include <atomic>   // for atomic
+#include <chrono>   // for steady_clock
+#include <cstddef>  // for size_t
+#include <deque>    // for deque
+#include <mutex>    // for mutex
+#include <utility>  // for pair
+#include <vector>   // for vector
+
+/**
+ * @brief Timings of the rendering, fed by the drawing code and the render jobs, and read by the performance overlay.
+ * Nothing is recorded while the monitor is disabled. All methods are thread safe.
+ */
+class PerformanceMonitor {
+public:
+    using Duration = std::chrono::steady_clock::duration;
+
+    /// Statistics over the last WINDOW_SIZE samples, in milliseconds
+    struct TimingSummary {
+        double lastMs = 0;
+        double averageMs = 0;
+        double maxMs = 0;
+        size_t samples = 0;
+    };
+
+    /// Distances between the predicted and the real tips of the strokes, since the last clear()
+    struct ErrorSummary {
+        double averageError = 0;
+        double maxError = 0;
+        size_t samples = 0;
+    };
+
+    static constexpr size_t WINDOW_SIZE = 60;
+    static constexpr size_t RECENT_PAGES = 5;
+
+public:
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    /**
+     * @brief Drops all the recorded samples
+     */
+    void clear();
+
+    /**
+     * @brief Time spent painting the main canvas once
+     */
+    void recordDrawTime(Duration duration);
+
+    /**
+     * @brief Time between the creation of a render job and the end of the rendering
+     * @param page The index of the rendered page
+     */
+    void recordRenderLatency(size_t page, Duration duration);
+
+    /**
+     * @brief Time between an input event adding points to a stroke and the points appearing on the stroke's mask
+     */
+    void recordInkLatency(Duration duration);
+
+    /**
+     * @brief Errors of the ink prediction over a stroke (see StrokePredictor)
+     * @param total The sum of the errors, in document coordinates
+     */
+    void recordPredictionErrors(size_t samples, double total, double max);
+
+    /**
+     * @brief Time spent recognizing the shape of a finished stroke (see ShapeRecognizerJob)
+     */
+    void recordRecognitionTime(Duration duration);
+
+    TimingSummary getDrawTimes() const;
+    TimingSummary getRenderLatencies() const;
+    TimingSummary getInkLatencies() const;
+    ErrorSummary getPredictionErrors() const;
+    /// Unlike the other timings, the shape recognitions are summarized since the last clear()
+    TimingSummary getRecognitionTimes() const;
+
+    /**
+     * @return (page index, latency in ms) of the last render of the most recently rendered pages, most recent first
+     */
+    std::vector<std::pair<size_t, double>> getRecentPageLatencies() const;
+
+private:
+    class TimingWindow {
+    public:
+        void add(double ms);
+        TimingSummary summarize() const;
+        void clear();
+
+    private:
+        std::array<double, WINDOW_SIZE> samples{};
+        size_t count = 0;
+        size_t next = 0;
+    };
+
+    std::atomic<bool> enabled{false};
+
+    mutable std::mutex mutex;
+    TimingWindow drawTimes;
+    TimingWindow renderLatencies;
+    TimingWindow inkLatencies;
+    std::deque<std::pair<size_t, double>> recentPages;
+
+    size_t predictionSamples = 0;
+    double predictionTotalError = 0;
+    double predictionMaxError = 0;
+
+    TimingSummary recognitionTimes;
+    double recognitionTotalMs = 0;
+};
@@ -2,6 +2,7 @@
 
 #include <cmath>   // for M_PI_2
 #include <memory>  // for __shared_ptr_access
+#include <mutex>   // for lock_guard
 #include <string>  // for string
 
 #include <cairo.h>        // for cairo_rotate, cairo_translate, cairo_t
@@ -11,60 +12,97 @@
 
 #include "model/Document.h"       // for Document
 #include "model/PageRef.h"        // for PageRef
-#include "model/PageType.h"       // for PageType
 #include "model/XojPage.h"        // for XojPage
-#include "pdf/base/XojPdfPage.h"  // for XojPdfPageSPtr, XojPdfPage
 #include "util/Assert.h"          // for xoj_assert
 #include "util/PathUtil.h"        // for getConfigFile
 #include "util/XojMsgBox.h"       // for XojMsgBox
 #include "util/i18n.h"            // for _
 #include "util/safe_casts.h"      // for strict_cast
-#include "view/DocumentView.h"    // for DocumentView
+
+#include "PrintSpooler.h"  // for PrintSpooler
 
 #include "filesystem.h"  // for exists, remove, path
 
 namespace {
-void drawPage(GtkPrintOperation* /*operation*/, GtkPrintContext* context, int pageNr, Document* doc) {
-    cairo_t* cr = gtk_print_context_get_cairo_context(context);
-
-    PageRef page = doc->getPage(static_cast<size_t>(pageNr));
-    if (!page) {
+/**
+ * Number of pages rendered ahead of the page GTK is currently printing
+ */
+constexpr size_t PRINT_LOOKAHEAD = 8;
+
+struct PrintData {
+    PrintData(Document* doc, size_t currentPage): doc(doc), currentPage(currentPage), spooler(doc, PRINT_LOOKAHEAD) {}
+
+    Document* doc;
+    size_t currentPage;
+    PrintSpooler spooler;
+};
+
+void beginPrint(GtkPrintOperation* op, GtkPrintContext* /*context*/, PrintData* data) {
+    GtkPrintSettings* settings = gtk_print_operation_get_print_settings(op);
+    if (gtk_print_settings_get_reverse(settings)) {
+        // The spooler predicts the pages in ascending order: don't waste any work
         return;
     }
 
-    double width = page->getWidth();
-    double height = page->getHeight();
-
-    if (width > height) {
-        cairo_rotate(cr, M_PI_2);
-        cairo_translate(cr, 0, -height);
+    size_t firstPage = 0;
+    switch (gtk_print_settings_get_print_pages(settings)) {
+        case GTK_PRINT_PAGES_CURRENT:
+            firstPage = data->currentPage;
+            break;
+        case GTK_PRINT_PAGES_RANGES: {
+            int nRanges = 0;
+            GtkPageRange* ranges = gtk_print_settings_get_page_ranges(settings, &nRanges);
+            if (nRanges > 0 && ranges[0].start >= 0) {
+                firstPage = static_cast<size_t>(ranges[0].start);
+            }
+            g_free(ranges);
+            break;
+        }
+        default:
+            break;
     }
+    data->spooler.start(firstPage);
+}
+
+void endPrint(GtkPrintOperation* /*op*/, GtkPrintContext* /*context*/, PrintData* data) { data->spooler.stop(); }
 
-    // For better quality printing, we use a dedicated pdf-renderer in this case
-    if (page->getBackgroundType().isPdfPage()) {
-        XojPdfPageSPtr popplerPage = doc->getPdfPage(page->getPdfPageNr());
-        if (popplerPage) {
-            popplerPage->renderForPrinting(cr);
+void drawPage(GtkPrintOperation* /*operation*/, GtkPrintContext* context, int pageNr, PrintData* data) {
+    cairo_t* cr = gtk_print_context_get_cairo_context(context);
+
+    double width = 0;
+    double height = 0;
+    {
+        std::lock_guard<Document> lock(*data->doc);
+        PageRef page = data->doc->getPage(static_cast<size_t>(pageNr));
+        if (!page) {
+            return;
         }
+        width = page->getWidth();
+        height = page->getHeight();
     }
 
-    xoj::view::BackgroundFlags flags = xoj::view::BACKGROUND_SHOW_ALL;
-    flags.showPDF = xoj::view::HIDE_PDF_BACKGROUND;  // Already printed (if any)
+    if (width > height) {
+        cairo_rotate(cr, M_PI_2);
+        cairo_translate(cr, 0, -height);
+    }
 
-    DocumentView view;
-    view.drawPage(page, cr, true /* dont render eraseable */, flags);
+    data->spooler.drawPage(static_cast<size_t>(pageNr), cr);
 }
 
 void requestPageSetup(GtkPrintOperation* /*op*/, GtkPrintContext* /*ctx*/, int pageNr, GtkPageSetup* setup,
-                      Document* doc) {
-    PageRef page = doc->getPage(static_cast<size_t>(pageNr));  // Can't be negative
-    if (!page) {
-        return;
+                      PrintData* data) {
+    double width = 0;
+    double height = 0;
+    {
+        std::lock_guard<Document> lock(*data->doc);
+        PageRef page = data->doc->getPage(static_cast<size_t>(pageNr));  // Can't be negative
+        if (!page) {
+            return;
+        }
+        width = page->getWidth();
+        height = page->getHeight();
     }
 
-    double width = page->getWidth();
-    double height = page->getHeight();
-
     if (width > height) {
         gtk_page_setup_set_orientation(setup, GTK_PAGE_ORIENTATION_LANDSCAPE);
     } else {
@@ -101,13 +139,19 @@ void PrintHandler::print(Document* doc, size_t currentPage, GtkWindow* parent) {
 
     GtkPrintOperation* op = gtk_print_operation_new();
     gtk_print_operation_set_print_settings(op, settings);
-    gtk_print_operation_set_n_pages(op, strict_cast<int>(doc->getPageCount()));
+    {
+        std::lock_guard<Document> lock(*doc);
+        gtk_print_operation_set_n_pages(op, strict_cast<int>(doc->getPageCount()));
+    }
     gtk_print_operation_set_current_page(op, strict_cast<int>(currentPage));
     gtk_print_operation_set_job_name(op, "Xournal++");
     gtk_print_operation_set_unit(op, GTK_UNIT_POINTS);
     gtk_print_operation_set_use_full_page(op, true);
-    g_signal_connect(op, "draw_page", G_CALLBACK(drawPage), doc);
-    g_signal_connect(op, "request-page-setup", G_CALLBACK(requestPageSetup), doc);
+    PrintData data(doc, currentPage);
+    g_signal_connect(op, "begin-print", G_CALLBACK(beginPrint), &data);
+    g_signal_connect(op, "end-print", G_CALLBACK(endPrint), &data);
+    g_signal_connect(op, "draw_page", G_CALLBACK(drawPage), &data);
+    g_signal_connect(op, "request-page-setup", G_CALLBACK(requestPageSetup), &data);
 
     GError* error{};
     GtkPrintOperationResult res = gtk_print_operation_run(op, GTK_PRINT_OPERATION_ACTION_PRINT_DIALOG, parent, &error);
@@ -0,0 +1,192 @@
+#include "PrintSpooler.h"
+
+#include <algorithm>  // for clamp, find
+#include <memory>     // for shared_ptr
+#include <utility>    // for move
+
+#include "model/Document.h"                   // for Document
+#include "model/PageRef.h"                    // for PageRef
+#include "model/PageType.h"                   // for PageType
+#include "model/XojPage.h"                    // for XojPage
+#include "pdf/base/XojPdfPage.h"              // for XojPdfPageSPtr, XojPdfPage
+#include "util/Tracing.h"                     // for setThreadName, XOJ_TRACE_SCOPE
+#include "view/DocumentView.h"                // for DocumentView
+#include "view/background/BackgroundFlags.h"  // for BackgroundFlags, BACKGROUND_SHOW_ALL
+
+using xoj::util::CairoSurfaceSPtr;
+
+PrintSpooler::PrintSpooler(Document* doc, size_t lookahead): doc(doc), lookahead(lookahead), pageCount(0) {}
+
+PrintSpooler::~PrintSpooler() { stop(); }
+
+void PrintSpooler::start(size_t firstPage) {
+    if (this->running) {
+        return;
+    }
+
+    {
+        std::lock_guard<Document> lock(*this->doc);
+        this->pageCount = this->doc->getPageCount();
+    }
+
+    // Keep one core for the UI thread, which replays the recordings
+    unsigned int nbThreads = std::clamp(std::thread::hardware_concurrency(), 2U, 5U) - 1;
+
+    std::lock_guard lock(this->mutex);
+    this->running = true;
+    queueFromUnlocked(firstPage);
+    for (unsigned int i = 0; i < nbThreads; i++) {
+        this->workers.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+void PrintSpooler::stop() {
+    {
+        std::lock_guard lock(this->mutex);
+        this->running = false;
+    }
+    this->workAvailable.notify_all();
+
+    for (auto& t: this->workers) {
+        t.join();
+    }
+    this->workers.clear();
+
+    std::lock_guard lock(this->mutex);
+    this->queue.clear();
+    this->slots.clear();
+}
+
+void PrintSpooler::queueFromUnlocked(size_t from) {
+    if (!this->running) {
+        return;
+    }
+
+    size_t end = std::min(from + this->lookahead, this->pageCount);
+    for (size_t p = from; p < end; p++) {
+        if (this->slots.try_emplace(p).second) {
+            this->queue.push_back(p);
+        }
+    }
+    this->workAvailable.notify_all();
+}
+
+void PrintSpooler::drawPage(size_t pageNr, cairo_t* cr) {
+    CairoSurfaceSPtr recording;
+    {
+        std::unique_lock lock(this->mutex);
+
+        // Pages before the requested one were skipped (page ranges): drop them to bound the memory use.
+        for (auto it = this->slots.begin(); it != this->slots.end() && it->first < pageNr;) {
+            if (it->second.state == SlotState::RENDERING) {
+                it->second.abandoned = true;
+                ++it;
+                continue;
+            }
+            if (it->second.state == SlotState::QUEUED) {
+                this->queue.erase(std::find(this->queue.begin(), this->queue.end(), it->first));
+            }
+            it = this->slots.erase(it);
+        }
+
+        auto it = this->slots.find(pageNr);
+        if (it != this->slots.end() && it->second.state == SlotState::QUEUED) {
+            // No worker picked it up yet: render it here rather than waiting
+            this->queue.erase(std::find(this->queue.begin(), this->queue.end(), pageNr));
+            this->slots.erase(it);
+            it = this->slots.end();
+        }
+
+        if (it != this->slots.end()) {
+            // Requested again after having been skipped: the worker must keep it
+            it->second.abandoned = false;
+            // The workers only erase abandoned slots: it stays valid
+            this->pageDone.wait(lock, [&it]() { return it->second.state == SlotState::DONE; });
+            recording = std::move(it->second.recording);
+            this->slots.erase(it);
+        }
+
+        queueFromUnlocked(pageNr + 1);
+    }
+
+    if (!recording) {
+        recording = renderPage(pageNr);
+    }
+
+    if (recording) {
+        cairo_set_source_surface(cr, recording.get(), 0, 0);
+        cairo_paint(cr);
+    }
+}
+
+void PrintSpooler::workerLoop() {
+    xoj::util::trace::setThreadName("Print worker");
+
+    while (true) {
+        size_t pageNr = 0;
+        {
+            std::unique_lock lock(this->mutex);
+            this->workAvailable.wait(lock, [this]() { return !this->running || !this->queue.empty(); });
+            if (!this->running) {
+                return;
+            }
+            pageNr = this->queue.front();
+            this->queue.pop_front();
+            this->slots[pageNr].state = SlotState::RENDERING;
+        }
+
+        CairoSurfaceSPtr recording = renderPage(pageNr);
+
+        {
+            std::lock_guard lock(this->mutex);
+            auto it = this->slots.find(pageNr);
+            if (it == this->slots.end()) {
+                continue;
+            }
+            if (it->second.abandoned) {
+                this->slots.erase(it);
+                continue;
+            }
+            it->second.recording = std::move(recording);
+            it->second.state = SlotState::DONE;
+        }
+        this->pageDone.notify_all();
+    }
+}
+
+auto PrintSpooler::renderPage(size_t pageNr) -> CairoSurfaceSPtr {
+    XOJ_TRACE_SCOPE("PrintSpooler::renderPage");
+
+    PageRef page;
+    XojPdfPageSPtr pdfPage;
+    {
+        std::lock_guard<Document> lock(*this->doc);
+        PageRef original = this->doc->getPage(pageNr);
+        if (!original) {
+            return nullptr;
+        }
+        // Draw from a copy, so that the document lock is not held while rendering
+        page.reset(original->clone());
+        if (page->getBackgroundType().isPdfPage()) {
+            pdfPage = this->doc->getPdfPage(page->getPdfPageNr());
+        }
+    }
+
+    cairo_rectangle_t extents = {0, 0, page->getWidth(), page->getHeight()};
+    CairoSurfaceSPtr recording(cairo_recording_surface_create(CAIRO_CONTENT_COLOR_ALPHA, &extents),
+                               xoj::util::adopt);
+    xoj::util::CairoSPtr cr(cairo_create(recording.get()), xoj::util::adopt);
+
+    // For better quality printing, we use a dedicated pdf-renderer in this case
+    if (pdfPage) {
+        pdfPage->renderForPrinting(cr.get());
+    }
+
+    xoj::view::BackgroundFlags flags = xoj::view::BACKGROUND_SHOW_ALL;
+    flags.showPDF = xoj::view::HIDE_PDF_BACKGROUND;  // Already printed (if any)
+
+    DocumentView view;
+    view.drawPage(page, cr.get(), true /* dont render eraseable */, flags);
+
+    return recording;
+}
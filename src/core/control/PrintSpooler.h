@@ -0,0 +1,106 @@
+/*
+ * Xournal++
+ *
+ * Renders pages ahead of the print operation on worker threads
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <condition_variable>  // for condition_variable
+#include <cstddef>             // for size_t
+#include <deque>               // for deque
+#include <map>                 // for map
+#include <mutex>               // for mutex
+#include <thread>              // for thread
+#include <vector>              // for vector
+
+#include <cairo.h>  // for cairo_t
+
+#include "util/raii/CairoWrappers.h"  // for CairoSurfaceSPtr
+
+class Document;
+
+/**
+ * @brief Pre-renders the pages of a print operation into cairo recording surfaces.
+ *
+ * GTK emits "draw-page" on the UI thread, one page after the other. Rendering a page there stalls the UI, in
+ * particular when printing to a file. The spooler keeps a window of upcoming pages rendered by worker threads, so that
+ * drawPage() only has to replay the recorded drawing operations (which keeps the output vectorial).
+ *
+ * Pages are rendered from a clone taken under the document lock, so the workers run in parallel and never hold the
+ * lock while drawing. The caller must not hold the document lock. Pages that have not been predicted are rendered
+ * synchronously.
+ */
+class PrintSpooler {
+public:
+    /**
+     * @param doc The document to print
+     * @param lookahead Number of pages rendered ahead of the last requested page. Bounds the memory used.
+     */
+    PrintSpooler(Document* doc, size_t lookahead);
+    ~PrintSpooler();
+
+    PrintSpooler(const PrintSpooler&) = delete;
+    PrintSpooler& operator=(const PrintSpooler&) = delete;
+
+    /**
+     * @brief Starts the worker threads and queues the first pages. Call it when the print operation begins.
+     * @param firstPage The first page GTK is expected to request
+     */
+    void start(size_t firstPage);
+
+    /**
+     * @brief Stops the worker threads and releases all the pending recordings.
+     */
+    void stop();
+
+    /**
+     * @brief Draws the page pageNr on cr (in page coordinates) and queues the following pages.
+     * Blocks if the page is currently being rendered by a worker.
+     */
+    void drawPage(size_t pageNr, cairo_t* cr);
+
+private:
+    enum class SlotState { QUEUED, RENDERING, DONE };
+    struct Slot {
+        SlotState state = SlotState::QUEUED;
+        /// The page was skipped while being rendered: the worker erases the slot once done
+        bool abandoned = false;
+        xoj::util::CairoSurfaceSPtr recording;
+    };
+
+    /**
+     * @brief Queues the pages [from, from + lookahead) that are not yet known to the spooler.
+     * Must be called with the mutex locked.
+     */
+    void queueFromUnlocked(size_t from);
+
+    void workerLoop();
+
+    /**
+     * @brief Renders a page into a new recording surface. Thread safe.
+     */
+    xoj::util::CairoSurfaceSPtr renderPage(size_t pageNr);
+
+private:
+    Document* doc;
+    size_t lookahead;
+    size_t pageCount;
+
+    std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable pageDone;
+
+    /// Pages waiting for a worker, in the order they will be requested
+    std::deque<size_t> queue;
+    /// Pages queued, rendering or rendered but not yet printed
+    std::map<size_t, Slot> slots;
+    bool running = false;
+
+    std::vector<std::thread> workers;
+};
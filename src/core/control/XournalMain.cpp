@@ -21,26 +21,31 @@
 #include <glib.h>         // for GOptionEntry, gchar, G_O...
 #include <libintl.h>      // for bindtextdomain, textdomain
 
-#include "control/RecentManager.h"           // for RecentManager
-#include "control/jobs/BaseExportJob.h"      // for ExportBackgroundType
-#include "control/jobs/XournalScheduler.h"   // for XournalScheduler
-#include "control/settings/LatexSettings.h"  // for LatexSettings
-#include "control/settings/Settings.h"       // for Settings
-#include "control/settings/SettingsEnums.h"  // for ICON_THEME_COLOR, ICON_T...
-#include "control/xojfile/LoadHandler.h"     // for LoadHandler
-#include "control/xojfile/SaveHandler.h"     // for SaveHandler
-#include "gui/GladeSearchpath.h"             // for GladeSearchpath
-#include "gui/MainWindow.h"                  // for MainWindow
-#include "gui/XournalView.h"                 // for XournalView
-#include "model/Document.h"                  // for Document
-#include "undo/EmergencySaveRestore.h"       // for EmergencySaveRestore
-#include "undo/UndoRedoHandler.h"            // for UndoRedoHandler
-#include "util/PathUtil.h"                   // for getConfigFolder, openFil...
-#include "util/PlaceholderString.h"          // for PlaceholderString
-#include "util/Stacktrace.h"                 // for Stacktrace
-#include "util/Util.h"                       // for execInUiThread
-#include "util/XojMsgBox.h"                  // for XojMsgBox
-#include "util/i18n.h"                       // for _, FS, _F
+#include "control/RecentManager.h"            // for RecentManager
+#include "control/jobs/BaseExportJob.h"       // for ExportBackgroundType
+#include "control/jobs/XournalScheduler.h"    // for XournalScheduler
+#include "control/settings/LatexSettings.h"   // for LatexSettings
+#include "control/settings/Settings.h"        // for Settings
+#include "control/settings/SettingsEnums.h"   // for ICON_THEME_COLOR, ICON_T...
+#include "control/xojfile/LoadHandler.h"      // for LoadHandler
+#include "control/xojfile/SaveHandler.h"      // for SaveHandler
+#include "gui/GladeSearchpath.h"              // for GladeSearchpath
+#include "gui/MainWindow.h"                   // for MainWindow
+#include "gui/XournalView.h"                  // for XournalView
+#include "gui/inputdevices/InputContext.h"    // for InputContext
+#include "gui/inputdevices/InputRecording.h"  // for InputRecording
+#include "gui/inputdevices/InputReplay.h"     // for InputReplay
+#include "gui/widgets/XournalWidget.h"        // for GtkXournal
+#include "model/Document.h"                   // for Document
+#include "undo/EmergencySaveRestore.h"        // for EmergencySaveRestore
+#include "undo/UndoRedoHandler.h"             // for UndoRedoHandler
+#include "util/PathUtil.h"                    // for getConfigFolder, openFil...
+#include "util/PlaceholderString.h"           // for PlaceholderString
+#include "util/Stacktrace.h"                  // for Stacktrace
+#include "util/Tracing.h"                     // for start, stop, setThreadName
+#include "util/Util.h"                        // for execInUiThread
+#include "util/XojMsgBox.h"                   // for XojMsgBox
+#include "util/i18n.h"                        // for _, FS, _F
 
 #include "Control.h"       // for Control
 #include "ExportHelper.h"  // for exportImg, exportPdf
@@ -356,6 +361,9 @@ struct XournalMainPrivate {
         g_free(pdfFilename);
         g_free(imgFilename);
         g_free(docFilename);
+        g_free(recordInputFilename);
+        g_free(replayInputFilename);
+        g_free(traceFilename);
     }
 
     gchar** optFilename{};
@@ -374,9 +382,13 @@ struct XournalMainPrivate {
     gboolean progressiveMode = false;
     gboolean disableAudio = false;
     gboolean attachMode = false;
+    gchar* recordInputFilename{};
+    gchar* replayInputFilename{};
+    gchar* traceFilename{};
     std::unique_ptr<GladeSearchpath> gladePath;
     std::unique_ptr<Control> control;
     std::unique_ptr<MainWindow> win;
+    std::unique_ptr<InputReplay> inputReplay;
 };
 using XMPtr = XournalMainPrivate*;
 
@@ -489,6 +501,37 @@ void on_open_files(GApplication* application, GFile** files, gint numFiles, gcha
     gtk_window_present(GTK_WINDOW(app_data->win->getWindow()));
 }
 
+/**
+ * Handles --record-input and --replay-input, once the document is loaded
+ */
+void startInputRecordingOrReplay(GApplication* application, XMPtr app_data) {
+    InputContext* inputContext = GTK_XOURNAL(app_data->win->getXournal()->getWidget())->input;
+
+    try {
+        if (app_data->recordInputFilename) {
+            inputContext->startRecording(Util::fromGFilename(app_data->recordInputFilename, false));
+        }
+        if (app_data->replayInputFilename) {
+            auto recording = InputRecording::load(Util::fromGFilename(app_data->replayInputFilename, false));
+            app_data->inputReplay =
+                    std::make_unique<InputReplay>(app_data->control.get(), inputContext, std::move(recording));
+        }
+    } catch (const std::runtime_error& e) {
+        g_warning("%s", e.what());
+        return;
+    }
+
+    if (app_data->inputReplay) {
+        // Queued after the layout of the pages, the recorded coordinates are relative to it
+        Util::execInUiThread([application, app_data]() {
+            app_data->inputReplay->start([application, app_data]() {
+                app_data->inputReplay->writeReport(std::cout);
+                g_application_quit(application);
+            });
+        });
+    }
+}
+
 void on_startup(GApplication* application, XMPtr app_data) {
     initLocalisation();
     ensure_input_model_compatibility();
@@ -541,7 +584,7 @@ void on_startup(GApplication* application, XMPtr app_data) {
     }
     app_data->control->openFileWithoutSavingTheCurrentDocument(
             std::move(p), app_data->attachMode, app_data->openAtPageNumber - 1,
-            [ctrl = app_data->control.get(), app = GTK_APPLICATION(application)](bool) {
+            [ctrl = app_data->control.get(), app = GTK_APPLICATION(application), app_data](bool) {
                 ctrl->getScheduler()->start();
 
                 checkForErrorlog();
@@ -551,12 +594,20 @@ void on_startup(GApplication* application, XMPtr app_data) {
                 // This fixes it, see #405
                 Util::execInUiThread([=]() { ctrl->getWindow()->getXournal()->layoutPages(); });
                 gtk_application_add_window(app, ctrl->getGtkWindow());
+
+                startInputRecordingOrReplay(G_APPLICATION(app), app_data);
             });
 }
 
 auto on_handle_local_options(GApplication*, GVariantDict*, XMPtr app_data) -> gint {
     initCAndCoutLocales();
 
+    if (app_data->traceFilename) {
+        // Started as early as possible, so that the command line exports are traced too
+        xoj::util::trace::setThreadName("UI");
+        xoj::util::trace::start(Util::fromGFilename(app_data->traceFilename, false));
+    }
+
     auto print_version = [&] {
         if (!std::string(GIT_COMMIT_ID).empty()) {
             std::cout << PROJECT_NAME << " " << PROJECT_VERSION << " (" << GIT_COMMIT_ID << ")" << std::endl;
@@ -620,7 +671,12 @@ auto on_handle_local_options(GApplication*, GVariantDict*, XMPtr app_data) -> gi
 }
 
 void on_shutdown(GApplication*, XMPtr app_data) {
-    app_data->control->saveSettings();
+    if (app_data->inputReplay) {
+        // The replay changes the tool and the zoom: do not keep them
+        app_data->inputReplay.reset();
+    } else {
+        app_data->control->saveSettings();
+    }
     app_data->win->getXournal()->clearSelection();
     app_data->control->getScheduler()->stop();
 }
@@ -713,7 +769,30 @@ auto XournalMain::run(int argc, char** argv) -> int {
     g_option_group_add_entries(exportGroup, exportOptions.data());
     g_application_add_option_group(G_APPLICATION(app), exportGroup);
 
+    /**
+     * Performance analysis options
+     */
+    std::array perfOptions = {
+            GOptionEntry{"record-input", 0, 0, G_OPTION_ARG_FILENAME, &app_data.recordInputFilename,
+                         _("Record the input events to FILE"), "FILE"},
+            GOptionEntry{"replay-input", 0, 0, G_OPTION_ARG_FILENAME, &app_data.replayInputFilename,
+                         _("Replay the input events recorded in FILE on the document, print the time spent handling "
+                           "them and quit.\n"
+                           "                                 The document is not saved."),
+                         "FILE"},
+            GOptionEntry{"trace", 0, 0, G_OPTION_ARG_FILENAME, &app_data.traceFilename,
+                         _("Write a trace of the rendering, loading, saving and input handling to FILE\n"
+                           "                                 The trace is written on exit, in the Chrome trace format,\n"
+                           "                                 and can be opened in Perfetto (https://ui.perfetto.dev)"),
+                         "FILE"},
+            GOptionEntry{nullptr}};  // Must be terminated by a nullptr. See gtk doc
+    GOptionGroup* perfGroup = g_option_group_new("perf", _("Performance analysis options"),
+                                                 _("Display performance analysis options"), nullptr, nullptr);
+    g_option_group_add_entries(perfGroup, perfOptions.data());
+    g_application_add_option_group(G_APPLICATION(app), perfGroup);
+
     auto rv = g_application_run(G_APPLICATION(app), argc, argv);
+    xoj::util::trace::stop();
     g_object_unref(app);
     return rv;
 }
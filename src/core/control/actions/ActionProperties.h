@@ -27,6 +27,7 @@
 #include "plugin/PluginController.h"
 #include "util/Assert.h"
 #include "util/PopupWindowWrapper.h"
+#include "util/Tracing.h"
 #include "util/Util.h"
 #include "util/XojMsgBox.h"
 #include "util/i18n.h"
@@ -375,6 +376,22 @@ struct ActionProperties<Action::SHOW_MENUBAR> {
     static void callback(GSimpleAction*, GVariant* p, Control* ctrl) { ctrl->setShowMenubar(g_variant_get_boolean(p)); }
 };
 
+template <>
+struct ActionProperties<Action::SHOW_PERFORMANCE_OVERLAY> {
+    using state_type = bool;
+    static constexpr state_type initialState(Control*) { return false; }
+    static void callback(GSimpleAction*, GVariant* p, Control* ctrl) {
+        ctrl->setShowPerformanceOverlay(g_variant_get_boolean(p));
+    }
+};
+
+template <>
+struct ActionProperties<Action::RECORD_TRACE> {
+    using state_type = bool;
+    static state_type initialState(Control*) { return xoj::util::trace::isEnabled(); }
+    static void callback(GSimpleAction*, GVariant* p, Control* ctrl) { ctrl->setRecordTrace(g_variant_get_boolean(p)); }
+};
+
 
 /*
  * Zoom callbacks are postponed to later in the UI Thread
@@ -120,8 +120,8 @@ void CustomExportJob::exportGraphics() {
 
 void CustomExportJob::run() {
     if (exportTypeXoj) {
-        SaveJob::updatePreview(control);
         Document* doc = this->control->getDocument();
+        SaveJob::updatePreview(doc);
 
         XojExportHandler h;
         doc->lock();
@@ -1,29 +1,43 @@
 #include "PreviewJob.h"
 
-#include <memory>  // for __s...
-#include <mutex>   // for mutex
-#include <vector>  // for vector
+#include <algorithm>  // for min
+#include <memory>     // for __s...
+#include <mutex>      // for mutex
+#include <vector>     // for vector
 
 #include <glib-object.h>  // for g_o...
 #include <gtk/gtk.h>      // for Gtk...
 
 #include "control/Control.h"                                      // for Con...
 #include "control/jobs/Job.h"                                     // for JOB...
+#include "gui/MainWindow.h"                                       // for MainWindow
+#include "gui/PageView.h"                                         // for XojPageView
 #include "gui/Shadow.h"                                           // for Shadow
+#include "gui/XournalView.h"                                      // for XournalView
 #include "gui/sidebar/previews/base/SidebarPreviewBase.h"         // for Sid...
 #include "gui/sidebar/previews/base/SidebarPreviewBaseEntry.h"    // for Sid...
 #include "gui/sidebar/previews/layer/SidebarPreviewLayerEntry.h"  // for Sid...
+#include "gui/sidebar/previews/page/SidebarPreviewPageEntry.h"    // for SidebarPreviewPageEntry
 #include "model/Document.h"                                       // for Doc...
 #include "model/Layer.h"                                          // for Layer
 #include "model/PageRef.h"                                        // for Pag...
 #include "model/XojPage.h"                                        // for Xoj...
 #include "util/Util.h"                                            // for exe...
+#include "util/safe_casts.h"                                      // for floor_cast
 #include "view/DocumentView.h"                                    // for Doc...
+#include "view/ImageKernels.h"                                    // for downsampleBox
 #include "view/LayerView.h"                                       // for Lay...
 #include "view/View.h"                                            // for Con...
 #include "view/background/BackgroundFlags.h"                      // for BAC...
 
-PreviewJob::PreviewJob(SidebarPreviewBaseEntry* sidebar): sidebarPreview(sidebar) {}
+PreviewJob::PreviewJob(SidebarPreviewBaseEntry* sidebar): sidebarPreview(sidebar) {
+    // The job is created in the UI thread, where the page views can be looked up
+    auto* pageEntry = dynamic_cast<SidebarPreviewPageEntry*>(sidebar);
+    MainWindow* win = sidebar->sidebar->getControl()->getWindow();
+    if (pageEntry && win) {
+        this->pageView = win->getXournal()->getViewFor(pageEntry->getIndex());
+    }
+}
 
 PreviewJob::~PreviewJob() { this->sidebarPreview = nullptr; }
 
@@ -33,6 +47,12 @@ auto PreviewJob::getSource() -> void* { return this->sidebarPreview; }
 
 auto PreviewJob::getType() -> JobType { return JOB_TYPE_PREVIEW; }
 
+void PreviewJob::forgetPageView(XojPageView* view) {
+    if (this->pageView == view) {
+        this->pageView = nullptr;
+    }
+}
+
 void PreviewJob::initGraphics() {
     auto w = this->sidebarPreview->imageWidth;
     auto h = this->sidebarPreview->imageHeight;
@@ -48,6 +68,7 @@ void PreviewJob::initGraphics() {
 void PreviewJob::finishPaint() {
     auto lock = std::lock_guard(this->sidebarPreview->drawingMutex);
     this->sidebarPreview->buffer = std::move(this->buffer);
+    this->sidebarPreview->bufferRendered = true;
     Util::execInUiThread([btn = this->sidebarPreview->button]() { gtk_widget_queue_draw(btn.get()); });
 }
 
@@ -112,6 +133,61 @@ void PreviewJob::drawPage() {
     doc->unlock();
 }
 
+auto PreviewJob::downsamplePageBuffer() -> bool {
+    XojPageView* view = this->pageView;
+    if (view == nullptr || view->getPage() != this->sidebarPreview->page) {
+        return false;
+    }
+
+    std::lock_guard bufferLock(view->drawingMutex);
+    {
+        std::lock_guard lock(view->repaintRectMutex);
+        if (view->rerenderComplete || !view->rerenderRects.empty() || view->renderInProgress) {
+            // The buffer does not show the last changes yet
+            return false;
+        }
+    }
+    if (!view->buffer.isInitialized()) {
+        return false;
+    }
+
+    cairo_surface_t* src = cairo_get_target(view->buffer.get());
+    if (cairo_surface_get_type(src) != CAIRO_SURFACE_TYPE_IMAGE ||
+        cairo_image_surface_get_format(src) != CAIRO_FORMAT_ARGB32) {
+        return false;
+    }
+
+    const PageRef& page = this->sidebarPreview->page;
+    double srcDeviceScale = 1;
+    cairo_surface_get_device_scale(src, &srcDeviceScale, nullptr);
+    const double srcScale = view->buffer.getZoom() * srcDeviceScale;
+    const int srcWidth = std::min(cairo_image_surface_get_width(src), floor_cast<int>(page->getWidth() * srcScale));
+    const int srcHeight = std::min(cairo_image_surface_get_height(src), floor_cast<int>(page->getHeight() * srcScale));
+
+    cairo_surface_t* dst = this->buffer.get();
+    const int DPIscaling = this->sidebarPreview->DPIscaling;
+    const int offset = (Shadow::getShadowTopLeftSize() + 2) * DPIscaling;
+    const double dstScale = this->sidebarPreview->sidebar->getZoom() * DPIscaling;
+    const int dstWidth =
+            std::min(cairo_image_surface_get_width(dst) - offset, floor_cast<int>(page->getWidth() * dstScale));
+    const int dstHeight =
+            std::min(cairo_image_surface_get_height(dst) - offset, floor_cast<int>(page->getHeight() * dstScale));
+
+    if (dstWidth <= 0 || dstHeight <= 0 || srcWidth < dstWidth || srcHeight < dstHeight) {
+        // Zoomed out further than the sidebar: the vector rendering is sharper
+        return false;
+    }
+
+    cairo_surface_flush(src);
+    cairo_surface_flush(dst);
+    const int dstStride = cairo_image_surface_get_stride(dst);
+    unsigned char* dstData = cairo_image_surface_get_data(dst) + offset * dstStride + 4 * offset;
+    ImageKernels::downsampleBox(cairo_image_surface_get_data(src), srcWidth, srcHeight,
+                                cairo_image_surface_get_stride(src), dstData, dstWidth, dstHeight, dstStride);
+    cairo_surface_mark_dirty(dst);
+    return true;
+}
+
 void PreviewJob::clipToPage() {
     // Only render within the preview page. Without this, the when preview jobs attempt
     // to clear the display, we fill a region larger than the inside of the preview page!
@@ -125,7 +201,9 @@ void PreviewJob::run() {
     }
 
     initGraphics();
-    clipToPage();
-    drawPage();
+    if (!downsamplePageBuffer()) {
+        clipToPage();
+        drawPage();
+    }
     finishPaint();
 }
@@ -18,6 +18,7 @@
 #include "Job.h"  // for Job, JobType
 
 class SidebarPreviewBaseEntry;
+class XojPageView;
 
 /**
  * @brief A Job which renders a SidebarPreviewPage
@@ -37,12 +38,23 @@ public:
 
     JobType getType() override;
 
+    /**
+     * The page view is being destroyed: its buffer cannot be used anymore
+     */
+    void forgetPageView(XojPageView* view);
+
 private:
     void initGraphics();
     void clipToPage();
     void finishPaint();
     void drawPage();
 
+    /**
+     * Shrinks the buffer of the page view, instead of rendering the page again
+     * @return false if the page view has no up to date buffer (or one too small)
+     */
+    bool downsamplePageBuffer();
+
 private:
     /**
      * Graphics buffer
@@ -58,4 +70,9 @@ private:
      * Sidebar preview
      */
     SidebarPreviewBaseEntry* sidebarPreview = nullptr;
+
+    /**
+     * The main view of the page, if the preview is a page preview
+     */
+    XojPageView* pageView = nullptr;
 };
@@ -1,27 +1,30 @@
 #include "RenderJob.h"
 
+#include <chrono>   // for steady_clock
+#include <cstddef>  // for size_t
 #include <mutex>    // for mutex
 #include <utility>  // for move
 #include <vector>   // for vector
 
 #include <cairo.h>  // for cairo_create, cairo_destroy, cairo_...
 
-#include "control/Control.h"            // for Control
-#include "control/ToolEnums.h"          // for TOOL_PLAY_OBJECT
-#include "control/ToolHandler.h"        // for ToolHandler
-#include "control/jobs/Job.h"           // for JOB_TYPE_RENDER, JobType
-#include "gui/PageView.h"               // for XojPageView
-#include "gui/XournalView.h"            // for XournalView
-#include "gui/widgets/XournalWidget.h"  // for gtk_xournal_repaint_area
-#include "model/Document.h"             // for Document
-#include "model/XojPage.h"              // for Page
-#include "util/Assert.h"                // for xoj_assert
-#include "util/Rectangle.h"             // for Rectangle
-#include "util/Util.h"                  // for execInUiThread
-#include "util/raii/CairoWrappers.h"    // for CairoSurfaceSPtr, CairoSPtr
-#include "util/safe_casts.h"            // for strict_cast, as_signed, as_si...
-#include "view/DocumentView.h"          // for DocumentView
-#include "view/Mask.h"                  // for Mask
+#include "control/Control.h"             // for Control
+#include "control/PerformanceMonitor.h"  // for PerformanceMonitor
+#include "control/ToolEnums.h"           // for TOOL_PLAY_OBJECT
+#include "control/ToolHandler.h"         // for ToolHandler
+#include "control/jobs/Job.h"            // for JOB_TYPE_RENDER, JobType
+#include "gui/PageView.h"                // for XojPageView
+#include "gui/RepaintHandler.h"          // for RepaintHandler
+#include "gui/XournalView.h"             // for XournalView
+#include "model/Document.h"              // for Document
+#include "model/XojPage.h"               // for Page
+#include "util/Assert.h"                 // for xoj_assert
+#include "util/Rectangle.h"              // for Rectangle
+#include "util/Tracing.h"                // for XOJ_TRACE_SCOPE
+#include "util/raii/CairoWrappers.h"     // for CairoSurfaceSPtr, CairoSPtr
+#include "util/safe_casts.h"             // for strict_cast, as_signed, as_si...
+#include "view/DocumentView.h"           // for DocumentView
+#include "view/Mask.h"                   // for Mask
 
 #if defined(__has_cpp_attribute) && __has_cpp_attribute(likely)
 #define XOJ_CPP20_UNLIKELY [[unlikely]]
@@ -31,7 +34,7 @@
 
 using xoj::util::Rectangle;
 
-RenderJob::RenderJob(XojPageView* view): view(view) {}
+RenderJob::RenderJob(XojPageView* view): view(view), creationTime(std::chrono::steady_clock::now()) {}
 
 auto RenderJob::getSource() -> void* { return this->view; }
 
@@ -61,12 +64,15 @@ void RenderJob::rerenderRectangle(Rectangle<double> const& rect) {
 }
 
 void RenderJob::run() {
+    XOJ_TRACE_SCOPE("RenderJob::run");
+
     this->view->repaintRectMutex.lock();
 
     bool rerenderComplete = this->view->rerenderComplete;
     auto rerenderRects = std::move(this->view->rerenderRects);
 
     this->view->rerenderComplete = false;
+    this->view->renderInProgress = true;
 
     this->view->repaintRectMutex.unlock();
 
@@ -87,20 +93,37 @@ void RenderJob::run() {
             repaintPageArea(rect.x, rect.y, rect.x + rect.width, rect.y + rect.height);
         }
     }
+
+    {
+        std::lock_guard lock(this->view->repaintRectMutex);
+        this->view->renderInProgress = false;
+    }
+
+    recordLatency();
 }
 
-static void repaintWidgetArea(GtkWidget* widget, int x1, int y1, int x2, int y2) {
-    Util::execInUiThread([=]() { gtk_xournal_repaint_area(widget, x1, y1, x2, y2); });
+void RenderJob::recordLatency() const {
+    PerformanceMonitor* monitor = this->view->getXournal()->getControl()->getPerformanceMonitor();
+    if (!monitor->isEnabled()) {
+        return;
+    }
+    const auto latency = std::chrono::steady_clock::now() - this->creationTime;
+
+    size_t page = 0;
+    {
+        std::lock_guard<Document> lock(*this->view->xournal->getDocument());
+        page = this->view->xournal->getDocument()->indexOf(this->view->page);
+    }
+    monitor->recordRenderLatency(page, latency);
 }
 
 void RenderJob::repaintPage() const { repaintPageArea(0, 0, view->getWidth(), view->getHeight()); }
 
 void RenderJob::repaintPageArea(double x1, double y1, double x2, double y2) const {
     double zoom = view->xournal->getZoom();
-    int x = view->getX();
-    int y = view->getY();
-    repaintWidgetArea(view->xournal->getWidget(), x + floor_cast<int>(zoom * x1), y + floor_cast<int>(zoom * y1),
-                      x + ceil_cast<int>(zoom * x2), y + ceil_cast<int>(zoom * y2));
+    // The repaint handler is thread safe and merges the areas until the next frame
+    view->xournal->getRepaintHandler()->repaintPageArea(view, floor_cast<int>(zoom * x1), floor_cast<int>(zoom * y1),
+                                                        ceil_cast<int>(zoom * x2), ceil_cast<int>(zoom * y2));
 }
 
 void RenderJob::renderToBuffer(cairo_t* cr) const {
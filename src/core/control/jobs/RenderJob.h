@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <chrono>  // for steady_clock
+
 #include <cairo.h>    // for cairo_surface_t
 #include <gtk/gtk.h>  // for GtkWidget
 
@@ -45,6 +47,13 @@ private:
 
     void renderToBuffer(cairo_t* cr) const;
 
+    /**
+     * @brief Reports the time since the creation of the job to the performance monitor, if it is enabled
+     */
+    void recordLatency() const;
+
 private:
     XojPageView* view;
+
+    std::chrono::steady_clock::time_point creationTime;
 };
@@ -1,8 +1,12 @@
 #include "SaveJob.h"
 
-#include <memory>  // for __shared_ptr_access
+#include <cstdint>  // for uint64_t
+#include <memory>   // for __shared_ptr_access
+#include <mutex>    // for lock_guard
+#include <string>   // for string
+#include <utility>  // for move
 
-#include <cairo.h>  // for cairo_create, cairo_destroy
+#include <cairo.h>  // for cairo_surface_write_to_png_stream
 #include <glib.h>   // for g_warning, g_error
 
 #include "control/Control.h"              // for Control
@@ -16,7 +20,7 @@
 #include "util/PathUtil.h"                // for clearExtensions, safeRename...
 #include "util/XojMsgBox.h"               // for XojMsgBox
 #include "util/i18n.h"                    // for FS, _, _F
-#include "view/DocumentView.h"            // for DocumentView
+#include "view/PageThumbnail.h"           // for renderPageThumbnail
 
 #include "filesystem.h"  // for path, filesystem_error, remove
 
@@ -44,65 +48,58 @@ void SaveJob::afterRun() {
     }
 }
 
-void SaveJob::updatePreview(Control* control) {
-    const int previewSize = 128;
-
-    Document* doc = control->getDocument();
-
-    doc->lock();
-
-    if (doc->getPageCount() > 0) {
-        PageRef page = doc->getPage(0);
+namespace {
+auto encodePng(cairo_surface_t* surface) -> std::string {
+    std::string png;
+    cairo_surface_write_to_png_stream(
+            surface,
+            [](void* closure, const unsigned char* data, unsigned int length) {
+                static_cast<std::string*>(closure)->append(reinterpret_cast<const char*>(data), length);
+                return CAIRO_STATUS_SUCCESS;
+            },
+            &png);
+    return png;
+}
+}  // namespace
 
-        double width = page->getWidth();
-        double height = page->getHeight();
+void SaveJob::updatePreview(Document* doc) {
+    const int previewSize = 128;
 
-        double zoom = 1;
+    PageRef page;
+    PageRef snapshot;
+    XojPdfPageSPtr pdfPage;
+    uint64_t revision = 0;
+    {
+        std::lock_guard<Document> lock(*doc);
 
-        if (width < height) {
-            zoom = previewSize / height;
-        } else {
-            zoom = previewSize / width;
+        if (doc->getPageCount() == 0) {
+            doc->setPreview(nullptr);
+            return;
         }
-        width *= zoom;
-        height *= zoom;
-
-        cairo_surface_t* crBuffer =
-                cairo_image_surface_create(CAIRO_FORMAT_ARGB32, ceil_cast<int>(width), ceil_cast<int>(height));
 
-        cairo_t* cr = cairo_create(crBuffer);
-        cairo_scale(cr, zoom, zoom);
-
-        xoj::view::BackgroundFlags flags = xoj::view::BACKGROUND_SHOW_ALL;
-
-        // We don't have access to a PdfCache on which DocumentView relies for PDF backgrounds.
-        // We thus print the PDF background by hand.
-        if (page->getBackgroundType().isPdfPage()) {
-            auto pgNo = page->getPdfPageNr();
-            XojPdfPageSPtr popplerPage = doc->getPdfPage(pgNo);
-            if (popplerPage) {
-                popplerPage->render(cr);
-            }
-            flags.showPDF = xoj::view::HIDE_PDF_BACKGROUND;  // Already printed (if any)
-        } else {
-            flags.forceBackgroundColor = xoj::view::FORCE_AT_LEAST_BACKGROUND_COLOR;
+        page = doc->getPage(0);
+        if (doc->isPreviewUpToDate(page)) {
+            return;
         }
 
-        DocumentView view;
-        view.drawPage(page, cr, true /* don't render erasable */, flags);
-        cairo_destroy(cr);
-        doc->setPreview(crBuffer);
-        cairo_surface_destroy(crBuffer);
-    } else {
-        doc->setPreview(nullptr);
+        // Render from a copy, so that the document is not locked while rendering and encoding the preview
+        revision = page->getRevision();
+        snapshot.reset(page->clone());
+        if (snapshot->getBackgroundType().isPdfPage()) {
+            pdfPage = doc->getPdfPage(snapshot->getPdfPageNr());
+        }
     }
 
-    doc->unlock();
+    auto preview = xoj::view::renderPageThumbnail(snapshot, pdfPage, previewSize);
+    std::string png = encodePng(preview.get());
+
+    std::lock_guard<Document> lock(*doc);
+    doc->setPreview(preview.get(), std::move(png), page, revision);
 }
 
 auto SaveJob::save() -> bool {
-    updatePreview(control);
     Document* doc = this->control->getDocument();
+    updatePreview(doc);
     SaveHandler h;
 
     doc->lock();
@@ -17,6 +17,7 @@
 #include "BlockingJob.h"  // for BlockingJob
 
 class Control;
+class Document;
 
 
 class SaveJob: public BlockingJob {
@@ -31,7 +32,10 @@ public:
 
     bool save();
 
-    static void updatePreview(Control* control);
+    /**
+     * Renders the preview of the document from its first page, unless the preview is already up to date
+     */
+    static void updatePreview(Document* doc);
 
 protected:
     void afterRun() override;
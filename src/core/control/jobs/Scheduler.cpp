@@ -5,6 +5,7 @@
 
 #include "control/jobs/Job.h"  // for Job, JOB_TYPE_RENDER
 #include "util/Assert.h"       // for xoj_assert
+#include "util/Tracing.h"      // for Span, setThreadName
 #include "util/glib_casts.h"   // for wrap_for_once_v
 
 #include "config-debug.h"  // for DEBUG_SHEDULER
@@ -15,6 +16,24 @@
 #define SDEBUG(msg, ...)
 #endif
 
+namespace {
+auto jobTraceName(JobType type) -> const char* {
+    switch (type) {
+        case JOB_TYPE_BLOCKING:
+            return "Blocking job";
+        case JOB_TYPE_PREVIEW:
+            return "Preview job";
+        case JOB_TYPE_RENDER:
+            return "Render job";
+        case JOB_TYPE_AUTOSAVE:
+            return "Autosave job";
+        case JOB_TYPE_RECOGNIZER:
+            return "Shape recognition job";
+    }
+    return "Job";
+}
+}  // namespace
+
 Scheduler::Scheduler() {
     this->name = "Scheduler";
 
@@ -109,6 +128,15 @@ auto Scheduler::getNextJobUnlocked(bool onlyNotRender, bool* hasRenderJobs) -> J
     return nullptr;
 }
 
+auto Scheduler::getQueueLengths() -> std::array<size_t, JOB_N_PRIORITIES> {
+    std::lock_guard lock{this->jobQueueMutex};
+    std::array<size_t, JOB_N_PRIORITIES> lengths{};
+    for (size_t i = JOB_PRIORITY_URGENT; i < JOB_N_PRIORITIES; i++) {
+        lengths[i] = this->jobQueue[i]->size();
+    }
+    return lengths;
+}
+
 /**
  * Locks the complete scheduler
  */
@@ -184,6 +212,8 @@ auto Scheduler::jobRenderThreadTimer(Scheduler* scheduler) -> bool {
 }
 
 auto Scheduler::jobThreadCallback(Scheduler* scheduler) -> gpointer {
+    xoj::util::trace::setThreadName(scheduler->name.c_str());
+
     while (scheduler->threadRunning) {
         // lock the whole scheduler
         std::unique_lock schedulerLock{scheduler->schedulerMutex};
@@ -244,6 +274,7 @@ auto Scheduler::jobThreadCallback(Scheduler* scheduler) -> gpointer {
         {
             std::lock_guard lock{scheduler->jobRunningMutex};
             SDEBUG("do job: %" PRId64, (uint64_t)job);
+            xoj::util::trace::Span span(jobTraceName(job->getType()));
             job->execute();
             job->unref();
         }
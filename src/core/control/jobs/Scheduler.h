@@ -15,6 +15,7 @@
 
 #include <array>               // for array
 #include <condition_variable>  // for condition_variable
+#include <cstddef>             // for size_t
 #include <deque>               // for deque
 #include <mutex>               // for mutex
 #include <string>              // for string
@@ -102,6 +103,11 @@ public:
      */
     void unblockRerenderZoom();
 
+    /**
+     * @return The number of waiting jobs, for each JobPriority
+     */
+    std::array<size_t, JOB_N_PRIORITIES> getQueueLengths();
+
 private:
     static auto jobThreadCallback(Scheduler* scheduler) -> gpointer;
     auto getNextJobUnlocked(bool onlyNotRender = false, bool* hasRenderJobs = nullptr) -> Job*;
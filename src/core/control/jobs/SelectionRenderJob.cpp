@@ -0,0 +1,189 @@
+#include "SelectionRenderJob.h"
+
+#include <algorithm>   // for max
+#include <cmath>       // for abs, sqrt
+#include <functional>  // for function
+#include <utility>     // for move
+
+#include "control/jobs/Job.h"           // for JOB_TYPE_RENDER
+#include "gui/XournalView.h"            // for XournalView
+#include "model/ElementContainer.h"     // for ElementContainer
+#include "util/Util.h"                  // for execInUiThread
+#include "view/ElementContainerView.h"  // for ElementContainerView
+#include "view/View.h"                  // for Context
+
+namespace {
+class ElementCopies: public ElementContainer {
+public:
+    explicit ElementCopies(const std::vector<ElementPtr>& elements): elements(elements) {}
+
+    void forEachElement(std::function<void(Element*)> f) const override {
+        for (const ElementPtr& e: elements) {
+            f(e.get());
+        }
+    }
+
+private:
+    const std::vector<ElementPtr>& elements;
+};
+}  // namespace
+
+auto SelectionBufferPolicy::onPaint(const SelectionBufferParams& params) -> Action {
+    this->paintedParams = params;
+    if (!this->buffered || this->outdated) {
+        return Action::RENDER;
+    }
+    if (this->bufferParams != params && !this->settling) {
+        this->settling = true;
+        this->settleParams = params;
+        return Action::START_SETTLE_TIMER;
+    }
+    if (this->preview && !this->settling) {
+        return Action::RENDER;
+    }
+    return Action::NONE;
+}
+
+auto SelectionBufferPolicy::needsPreview(const SelectionBufferParams& params) const -> bool {
+    if (!this->buffered) {
+        return true;
+    }
+    if (params.zoom == this->bufferParams.zoom || params.width == 0) {
+        // Resizing scales the buffer until the size settles
+        return false;
+    }
+
+    // Pixels of the buffer per painted pixel, horizontally
+    double bufferSharpness = std::abs(this->bufferParams.width) * this->bufferParams.zoom * this->bufferReduction /
+                             (std::abs(params.width) * params.zoom);
+    return SelectionRenderJob::getReduction(params, SelectionRenderJob::MAX_PREVIEW_PIXELS) > bufferSharpness;
+}
+
+auto SelectionBufferPolicy::onSettleTimeout() -> Action {
+    if (this->paintedParams != this->settleParams) {
+        // Still resizing or zooming
+        this->settleParams = this->paintedParams;
+        return Action::KEEP_WAITING;
+    }
+
+    this->settling = false;
+    return this->paintedParams != this->bufferParams || this->preview ? Action::RENDER : Action::NONE;
+}
+
+void SelectionBufferPolicy::onBufferReady(const SelectionBufferParams& params) {
+    this->buffered = true;
+    this->outdated = false;
+    this->preview = false;
+    this->bufferParams = params;
+    this->bufferReduction = SelectionRenderJob::getReduction(params, SelectionRenderJob::MAX_BUFFER_PIXELS);
+}
+
+void SelectionBufferPolicy::onPreviewReady(const SelectionBufferParams& params) {
+    this->buffered = true;
+    this->outdated = false;
+    this->preview = true;
+    this->bufferParams = params;
+    this->bufferReduction = SelectionRenderJob::getReduction(params, SelectionRenderJob::MAX_PREVIEW_PIXELS);
+}
+
+void SelectionBufferPolicy::invalidate() { this->outdated = true; }
+
+auto SelectionBufferPolicy::hasBuffer() const -> bool { return this->buffered; }
+
+auto SelectionBufferPolicy::getPaintedParams() const -> const SelectionBufferParams& { return this->paintedParams; }
+
+SelectionRenderJob::SelectionRenderJob(std::shared_ptr<SelectionBufferSlot> slot, unsigned int generation,
+                                       std::shared_ptr<const std::vector<ElementPtr>> elements,
+                                       const SelectionBufferParams& params,
+                                       const xoj::util::Rectangle<double>& originalBounds, double relativeX,
+                                       double relativeY):
+        slot(std::move(slot)),
+        generation(generation),
+        elements(std::move(elements)),
+        params(params),
+        originalBounds(originalBounds),
+        relativeX(relativeX),
+        relativeY(relativeY) {}
+
+SelectionRenderJob::~SelectionRenderJob() = default;
+
+auto SelectionRenderJob::getSource() -> void* { return this->slot.get(); }
+
+auto SelectionRenderJob::getType() -> JobType { return JOB_TYPE_RENDER; }
+
+void SelectionRenderJob::onDelete() {
+    std::lock_guard lock(this->slot->mutex);
+    this->slot->pending = false;
+}
+
+auto SelectionRenderJob::render(const ElementContainer* elements, const SelectionBufferParams& params,
+                                const xoj::util::Rectangle<double>& originalBounds, double relativeX, double relativeY,
+                                double maxPixels) -> xoj::util::CairoSurfaceSPtr {
+    const double fx = params.width / originalBounds.width;
+    const double fy = params.height / originalBounds.height;
+    const double zoom = params.zoom;
+    const double reduction = getReduction(params, maxPixels);
+
+    xoj::util::CairoSurfaceSPtr buffer(
+            cairo_image_surface_create(CAIRO_FORMAT_ARGB32,
+                                       std::max(1, static_cast<int>(std::abs(params.width) * zoom * reduction)),
+                                       std::max(1, static_cast<int>(std::abs(params.height) * zoom * reduction))),
+            xoj::util::adopt);
+    xoj::util::CairoSPtr crPtr(cairo_create(buffer.get()), xoj::util::adopt);
+    cairo_t* cr = crPtr.get();
+
+    int dx = static_cast<int>(relativeX * zoom);
+    int dy = static_cast<int>(relativeY * zoom);
+
+    cairo_scale(cr, reduction, reduction);
+    cairo_translate(cr, fx < 0 ? -params.width * zoom : 0, fy < 0 ? -params.height * zoom : 0);
+    cairo_scale(cr, fx, fy);
+    cairo_translate(cr, -dx, -dy);
+    cairo_scale(cr, zoom, zoom);
+
+    xoj::view::ElementContainerView view(elements);
+    view.draw(xoj::view::Context::createDefault(cr));
+
+    return buffer;
+}
+
+auto SelectionRenderJob::getReduction(const SelectionBufferParams& params, double maxPixels) -> double {
+    const double pixels = std::abs(params.width) * params.zoom * std::abs(params.height) * params.zoom;
+    return pixels > maxPixels ? std::sqrt(maxPixels / pixels) : 1.0;
+}
+
+void SelectionRenderJob::run() {
+    bool outdated = false;
+    {
+        std::lock_guard lock(this->slot->mutex);
+        outdated = !this->slot->alive || this->slot->generation != this->generation;
+    }
+
+    xoj::util::CairoSurfaceSPtr buffer;
+    if (!outdated) {
+        ElementCopies copies(*this->elements);
+        buffer = render(&copies, this->params, this->originalBounds, this->relativeX, this->relativeY);
+    }
+
+    {
+        std::lock_guard lock(this->slot->mutex);
+        this->slot->pending = false;
+        if (buffer && this->slot->alive && this->slot->generation == this->generation) {
+            this->slot->surface = std::move(buffer);
+            this->slot->params = this->params;
+        }
+    }
+
+    // Also when the buffer is outdated: the repaint requests a new one
+    Util::execInUiThread([slot = this->slot]() {
+        bool alive = false;
+        {
+            std::lock_guard lock(slot->mutex);
+            alive = slot->alive;
+        }
+        // The selection is destroyed in the UI thread: it cannot disappear before the repaint
+        if (alive) {
+            slot->xournal->repaintSelection();
+        }
+    });
+}
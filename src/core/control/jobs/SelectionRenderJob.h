@@ -0,0 +1,182 @@
+/*
+ * Xournal++
+ *
+ * A job which renders the buffer of a selection
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <memory>  // for shared_ptr
+#include <mutex>   // for mutex
+#include <vector>  // for vector
+
+#include <cairo.h>  // for cairo_surface_t
+
+#include "model/Element.h"            // for ElementPtr
+#include "util/Rectangle.h"           // for Rectangle
+#include "util/raii/CairoWrappers.h"  // for CairoSurfaceSPtr
+
+#include "Job.h"  // for Job, JobType
+
+class ElementContainer;
+class XournalView;
+
+/**
+ * @brief Size and zoom a selection buffer is rendered for
+ */
+struct SelectionBufferParams {
+    /// Size of the selection, in document coordinates. Negative if the selection is flipped.
+    double width = 0;
+    double height = 0;
+    double zoom = 0;
+
+    bool operator==(const SelectionBufferParams& o) const {
+        return width == o.width && height == o.height && zoom == o.zoom;
+    }
+    bool operator!=(const SelectionBufferParams& o) const { return !(*this == o); }
+};
+
+/**
+ * @brief Decides when the buffer of a selection is rendered. The full resolution buffer is always rendered in the
+ * background: right away if there is none or if the elements changed (the outdated buffer is still painted meanwhile),
+ * and once the size and zoom stopped changing if the selection is resized or zoomed (the buffer is scaled meanwhile).
+ * Until the first buffer is ready, and while zooming in, a low resolution preview is rendered on the UI thread.
+ */
+class SelectionBufferPolicy {
+public:
+    enum class Action {
+        NONE,
+        /// Render a buffer for the painted size and zoom
+        RENDER,
+        /// Call onSettleTimeout() every settle delay
+        START_SETTLE_TIMER,
+        /// Keep calling onSettleTimeout()
+        KEEP_WAITING
+    };
+
+    /// Called on each paint, before the preview. Never returns KEEP_WAITING.
+    Action onPaint(const SelectionBufferParams& params);
+
+    /**
+     * @return Whether a preview should be rendered synchronously for this paint: there is no buffer yet, or the zoom
+     * changed and the scaled buffer would look coarser than a preview.
+     */
+    bool needsPreview(const SelectionBufferParams& params) const;
+
+    /// Called every settle delay once onPaint() returned START_SETTLE_TIMER. Never returns START_SETTLE_TIMER.
+    Action onSettleTimeout();
+
+    /// A buffer rendered for the given size and zoom is painted from now on
+    void onBufferReady(const SelectionBufferParams& params);
+
+    /// A preview rendered for the given size and zoom is painted until the next buffer is ready
+    void onPreviewReady(const SelectionBufferParams& params);
+
+    /// The selected elements changed: the buffer needs to be rendered again
+    void invalidate();
+
+    /// @return Whether there is a buffer to paint, even if it is outdated or rendered for another size or zoom
+    bool hasBuffer() const;
+
+    /// @return The size and zoom of the last paint
+    const SelectionBufferParams& getPaintedParams() const;
+
+private:
+    bool buffered = false;
+    bool outdated = false;
+    bool settling = false;
+    /// The buffer is a low resolution preview
+    bool preview = false;
+
+    /// Parameters of the buffer, and the factor by which its resolution was reduced
+    SelectionBufferParams bufferParams;
+    double bufferReduction = 1.0;
+    /// Parameters of the last paint, and of the last paint before the previous onSettleTimeout() call
+    SelectionBufferParams paintedParams;
+    SelectionBufferParams settleParams;
+};
+
+/**
+ * @brief State shared between an EditSelectionContents and its render jobs
+ */
+struct SelectionBufferSlot {
+    explicit SelectionBufferSlot(XournalView* xournal): xournal(xournal) {}
+
+    std::mutex mutex;
+
+    /// false once the selection is destroyed
+    bool alive = true;
+    /// Incremented whenever the selected elements change: the buffers of older generations are outdated
+    unsigned int generation = 0;
+    /// A job is queued or running
+    bool pending = false;
+
+    /// Buffer rendered by the last job, not yet picked up by the selection
+    xoj::util::CairoSurfaceSPtr surface;
+    SelectionBufferParams params;
+
+    XournalView* const xournal;
+};
+
+/**
+ * @brief Renders a selection at full resolution, when the selection is created or modified and once the user stopped
+ * resizing it or zooming.
+ *
+ * The job works on copies of the selected elements: the originals may be modified by the UI thread meanwhile. The
+ * copies are never modified and are shared by all the jobs of the same generation. Once done, even if its buffer is
+ * outdated, the job repaints the selection, which may request a new buffer.
+ */
+class SelectionRenderJob: public Job {
+public:
+    SelectionRenderJob(std::shared_ptr<SelectionBufferSlot> slot, unsigned int generation,
+                       std::shared_ptr<const std::vector<ElementPtr>> elements, const SelectionBufferParams& params,
+                       const xoj::util::Rectangle<double>& originalBounds, double relativeX, double relativeY);
+
+protected:
+    ~SelectionRenderJob() override;
+
+public:
+    void* getSource() override;
+
+    void run() override;
+
+    JobType getType() override;
+
+    /**
+     * @brief Renders the elements of a selection, as they are when the selection is created, to a buffer scaled to
+     * the current size of the selection.
+     *
+     * The buffer has at most maxPixels pixels: if the selection is larger at this zoom, the buffer has a lower
+     * resolution and gets upscaled when painted.
+     */
+    static xoj::util::CairoSurfaceSPtr render(const ElementContainer* elements, const SelectionBufferParams& params,
+                                              const xoj::util::Rectangle<double>& originalBounds, double relativeX,
+                                              double relativeY, double maxPixels = MAX_BUFFER_PIXELS);
+
+    /// @return The factor (at most 1) by which render() reduces the resolution of a buffer to fit in maxPixels
+    static double getReduction(const SelectionBufferParams& params, double maxPixels);
+
+    /// 8 megapixels, i.e. 32 MB
+    static constexpr double MAX_BUFFER_PIXELS = 4096.0 * 2048.0;
+
+    /// Resolution cap of the previews rendered on the UI thread until a full buffer is ready
+    static constexpr double MAX_PREVIEW_PIXELS = 512.0 * 512.0;
+
+protected:
+    void onDelete() override;
+
+private:
+    std::shared_ptr<SelectionBufferSlot> slot;
+    unsigned int generation;
+
+    std::shared_ptr<const std::vector<ElementPtr>> elements;
+    SelectionBufferParams params;
+    xoj::util::Rectangle<double> originalBounds;
+    double relativeX;
+    double relativeY;
+};
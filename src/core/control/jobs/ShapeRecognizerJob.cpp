@@ -0,0 +1,124 @@
+#include "ShapeRecognizerJob.h"
+
+#include <algorithm>  // for equal, find
+#include <chrono>     // for steady_clock
+#include <cmath>      // for abs
+#include <limits>     // for numeric_limits
+#include <memory>     // for make_unique, unique_ptr
+#include <utility>    // for move
+#include <vector>     // for vector
+
+#include "control/Control.h"                          // for Control
+#include "control/PerformanceMonitor.h"               // for PerformanceMonitor
+#include "control/jobs/Job.h"                         // for JOB_TYPE_RECOGNIZER
+#include "control/settings/Settings.h"                // for Settings
+#include "control/shaperecognizer/ShapeRecognizer.h"  // for ShapeRecognizer
+#include "control/tools/SnapToGridInputHandler.h"     // for SnapToGridInputHandler
+#include "model/Document.h"                           // for Document
+#include "model/Element.h"                            // for Element, Element::InvalidIndex, ELEMENT_STROKE
+#include "model/Layer.h"                              // for Layer
+#include "model/Point.h"                              // for Point
+#include "model/Stroke.h"                             // for Stroke
+#include "model/XojPage.h"                            // for XojPage
+#include "undo/RecognizerUndoAction.h"                // for RecognizerUndoAction
+#include "undo/UndoRedoHandler.h"                     // for UndoRedoHandler
+#include "util/Assert.h"                              // for xoj_assert
+#include "util/Rectangle.h"                           // for Rectangle
+#include "util/Util.h"                                // for npos
+
+using xoj::util::Rectangle;
+
+ShapeRecognizerJob::ShapeRecognizerJob(Control* control, const PageRef& page, Layer* layer, Stroke* stroke,
+                                       const UndoAction* insertAction):
+        control(control),
+        page(page),
+        layer(layer),
+        stroke(stroke),
+        insertAction(insertAction),
+        copy(stroke->cloneStroke()),
+        minSize(control->getSettings()->getStrokeRecognizerMinSize()) {}
+
+ShapeRecognizerJob::~ShapeRecognizerJob() = default;
+
+void ShapeRecognizerJob::run() {
+    auto start = std::chrono::steady_clock::now();
+
+    ShapeRecognizer reco;
+    this->recognized = reco.recognizePatterns(this->copy.get(), this->minSize);
+
+    this->control->getPerformanceMonitor()->recordRecognitionTime(std::chrono::steady_clock::now() - start);
+
+    if (this->recognized) {
+        callAfterRun();
+    }
+}
+
+auto ShapeRecognizerJob::isStrokeUnchanged(Document* doc, const PageRef& page, Layer* layer, Element* element,
+                                           const Stroke& copy) -> bool {
+    if (doc->indexOf(page) == npos) {
+        return false;
+    }
+    std::vector<Layer*>* layers = page->getLayers();
+    if (std::find(layers->begin(), layers->end(), layer) == layers->end()) {
+        return false;
+    }
+    if (layer->indexOf(element) == Element::InvalidIndex || element->getType() != ELEMENT_STROKE) {
+        return false;
+    }
+    // The stroke may have been edited in place, or deleted and another one allocated at the same address
+    const auto& points = static_cast<Stroke*>(element)->getPointVector();
+    const auto& copyPoints = copy.getPointVector();
+    return std::equal(points.begin(), points.end(), copyPoints.begin(), copyPoints.end(),
+                      [](const Point& a, const Point& b) { return a.x == b.x && a.y == b.y && a.z == b.z; });
+}
+
+void ShapeRecognizerJob::snapToGrid(Stroke* recognized) const {
+    SnapToGridInputHandler snappingHandler(this->control->getSettings());
+
+    Rectangle<double> oldSnappedBounds = recognized->getSnappedBounds();
+    Point topLeft = Point(oldSnappedBounds.x, oldSnappedBounds.y);
+    Point topLeftSnapped = snappingHandler.snapToGrid(topLeft, false);
+
+    recognized->move(topLeftSnapped.x - topLeft.x, topLeftSnapped.y - topLeft.y);
+    Rectangle<double> snappedBounds = recognized->getSnappedBounds();
+    Point belowRight = Point(snappedBounds.x + snappedBounds.width, snappedBounds.y + snappedBounds.height);
+    Point belowRightSnapped = snappingHandler.snapToGrid(belowRight, false);
+
+    double fx = (std::abs(snappedBounds.width) > std::numeric_limits<double>::epsilon()) ?
+                        (belowRightSnapped.x - topLeftSnapped.x) / snappedBounds.width :
+                        1;
+    double fy = (std::abs(snappedBounds.height) > std::numeric_limits<double>::epsilon()) ?
+                        (belowRightSnapped.y - topLeftSnapped.y) / snappedBounds.height :
+                        1;
+    recognized->scale(topLeftSnapped.x, topLeftSnapped.y, fx, fy, 0, false);
+}
+
+void ShapeRecognizerJob::afterRun() {
+    xoj_assert(this->recognized);
+
+    this->recognized->setWidth(this->copy->hasPressure() ? this->copy->getAvgPressure() : this->copy->getWidth());
+    if (this->control->getSettings()->getSnapRecognizedShapesEnabled()) {
+        snapToGrid(this->recognized.get());
+    }
+
+    Document* doc = this->control->getDocument();
+    UndoRedoHandler* undo = this->control->getUndoRedoHandler();
+    doc->lock();
+    if (!isStrokeUnchanged(doc, this->page, this->layer, this->stroke, *this->copy) ||
+        !undo->isUndoable(this->insertAction)) {
+        // The stroke was modified in the meantime: it is not ours to replace anymore
+        doc->unlock();
+        return;
+    }
+    auto recognizedPtr = this->recognized.get();
+    auto original = this->layer->replaceElement(this->stroke, std::move(this->recognized));
+    doc->unlock();
+
+    auto action = std::make_unique<RecognizerUndoAction>(this->page, this->layer, std::move(original), recognizedPtr);
+    undo->replaceUndoAction(this->insertAction, std::move(action));
+
+    this->page->fireElementChanged(this->stroke);
+    this->page->fireElementChanged(recognizedPtr);
+}
+
+auto ShapeRecognizerJob::getType() -> JobType { return JOB_TYPE_RECOGNIZER; }
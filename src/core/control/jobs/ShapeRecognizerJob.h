@@ -0,0 +1,76 @@
+/*
+ * Xournal++
+ *
+ * A job which recognizes the shape of a finished stroke
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <memory>  // for unique_ptr
+
+#include "model/PageRef.h"  // for PageRef
+
+#include "Job.h"  // for Job, JobType
+
+class Control;
+class Document;
+class Element;
+class Layer;
+class Stroke;
+class UndoAction;
+
+/**
+ * @brief Runs the ShapeRecognizer on a copy of a stroke, off the UI thread.
+ *
+ * The stroke is already in the layer when the job is created. If a shape is recognized, afterRun() replaces the stroke
+ * with it, and replaces the InsertUndoAction of the stroke with a RecognizerUndoAction, so that the recognition is a
+ * single undo step. The replacement is dropped if the stroke was changed or removed from the layer (erased, undone,
+ * selected...) in the meantime.
+ */
+class ShapeRecognizerJob: public Job {
+public:
+    /**
+     * @param insertAction The action which inserted the stroke in the layer. Never dereferenced.
+     */
+    ShapeRecognizerJob(Control* control, const PageRef& page, Layer* layer, Stroke* stroke,
+                       const UndoAction* insertAction);
+
+protected:
+    ~ShapeRecognizerJob() override;
+
+public:
+    void run() override;
+    void afterRun() override;
+
+    JobType getType() override;
+
+    /**
+     * @return Whether the element is still on the layer, the layer on the page and the page in the document, and the
+     *         element is still a stroke with the points of the copy. The document must be locked.
+     *         The element is only dereferenced once found in the layer: a pointer to a deleted element is fine.
+     */
+    static bool isStrokeUnchanged(Document* doc, const PageRef& page, Layer* layer, Element* element,
+                                  const Stroke& copy);
+
+private:
+    void snapToGrid(Stroke* recognized) const;
+
+private:
+    Control* control;
+    PageRef page;
+    Layer* layer;
+
+    /// The stroke to replace. Never dereferenced before checking that it is still in the layer.
+    Element* stroke;
+    const UndoAction* insertAction;
+    /// The copy given to the recognizer
+    std::unique_ptr<Stroke> copy;
+    double minSize;
+
+    std::unique_ptr<Stroke> recognized;
+};
@@ -24,7 +24,20 @@ void XournalScheduler::removeSidebar(SidebarPreviewBaseEntry* preview) {
     removeSource(preview, JOB_TYPE_PREVIEW, JOB_PRIORITY_HIGH, waitForTaskCompletion);
 }
 
-void XournalScheduler::removePage(XojPageView* view) { removeSource(view, JOB_TYPE_RENDER, JOB_PRIORITY_URGENT); }
+void XournalScheduler::removePage(XojPageView* view) {
+    {
+        // The preview jobs may downsample the buffer of the view
+        std::lock_guard lock{this->jobQueueMutex};
+        for (Job* job: *this->jobQueue[JOB_PRIORITY_HIGH]) {
+            if (job->getType() == JOB_TYPE_PREVIEW) {
+                static_cast<PreviewJob*>(job)->forgetPageView(view);
+            }
+        }
+    }
+
+    // Also waits for the running job, which may be one of those preview jobs
+    removeSource(view, JOB_TYPE_RENDER, JOB_PRIORITY_URGENT);
+}
 
 void XournalScheduler::removeAllJobs() {
     std::lock_guard lock{this->jobQueueMutex};
@@ -0,0 +1,124 @@
+#include "LatexCache.h"
+
+#include <algorithm>     // for sort
+#include <fstream>       // for ofstream
+#include <system_error>  // for error_code
+#include <utility>       // for move, pair
+#include <vector>        // for vector
+
+#include <glib.h>  // for g_compute_checksum_for_data, g_warning
+
+#include "control/settings/LatexSettings.h"  // for LatexSettings
+#include "util/PathUtil.h"                   // for getCacheSubfolder, readString
+
+constexpr auto PDF_EXTENSION = ".pdf";
+
+LatexCache::LatexCache(fs::path dir, uint64_t maxSize): dir(std::move(dir)), maxSize(maxSize) {}
+
+auto LatexCache::fromSettings(const LatexSettings& settings) -> LatexCache {
+    constexpr uint64_t MIB = 1024 * 1024;
+    return LatexCache(Util::getCacheSubfolder("latex"), settings.cacheSize * MIB);
+}
+
+auto LatexCache::computeKey(const std::string& texContents, const std::string& genCmd) -> std::string {
+    // The command is part of the key: another engine or other options give another PDF
+    std::string data = genCmd;
+    data.push_back('\0');
+    data += texContents;
+
+    gchar* checksum = g_compute_checksum_for_data(G_CHECKSUM_SHA256, reinterpret_cast<const guchar*>(data.data()),
+                                                  data.size());
+    std::string key(checksum);
+    g_free(checksum);
+    return key;
+}
+
+auto LatexCache::pathFor(const std::string& key) const -> fs::path { return dir / (key + PDF_EXTENSION); }
+
+auto LatexCache::isEnabled() const -> bool { return maxSize != 0; }
+
+auto LatexCache::contains(const std::string& key) const -> bool {
+    std::error_code ec;
+    return isEnabled() && fs::is_regular_file(pathFor(key), ec);
+}
+
+auto LatexCache::lookup(const std::string& key) const -> std::optional<std::string> {
+    if (!contains(key)) {
+        return std::nullopt;
+    }
+
+    fs::path path = pathFor(key);
+    auto contents = Util::readString(path, false, std::ios::binary);
+    if (contents) {
+        // The modification time is the time of last use, for the eviction
+        std::error_code ec;
+        fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+    }
+    return contents;
+}
+
+void LatexCache::store(const std::string& key, const std::string& pdfContents) {
+    if (!isEnabled() || pdfContents.size() > maxSize) {
+        return;
+    }
+
+    // Write to a temporary file first, so that no partial file can be found in the cache
+    fs::path path = pathFor(key);
+    fs::path tmpPath = dir / (key + ".tmp");
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        out.write(pdfContents.data(), static_cast<std::streamsize>(pdfContents.size()));
+        if (!out) {
+            g_warning("Could not write to the LaTeX cache file \"%s\"", tmpPath.u8string().c_str());
+            std::error_code ec;
+            fs::remove(tmpPath, ec);
+            return;
+        }
+    }
+    std::error_code ec;
+    fs::rename(tmpPath, path, ec);
+    if (ec) {
+        g_warning("Could not store the LaTeX cache file \"%s\": %s", path.u8string().c_str(), ec.message().c_str());
+        fs::remove(tmpPath, ec);
+        return;
+    }
+
+    evict();
+}
+
+auto LatexCache::getSize() const -> uint64_t {
+    uint64_t size = 0;
+    std::error_code ec;
+    for (const auto& entry: fs::directory_iterator(dir, ec)) {
+        if (entry.path().extension() == PDF_EXTENSION) {
+            size += entry.file_size(ec);
+        }
+    }
+    return size;
+}
+
+void LatexCache::evict() {
+    std::vector<std::pair<fs::file_time_type, fs::directory_entry>> files;
+    uint64_t size = 0;
+    std::error_code ec;
+    for (const auto& entry: fs::directory_iterator(dir, ec)) {
+        if (entry.path().extension() == PDF_EXTENSION) {
+            size += entry.file_size(ec);
+            files.emplace_back(entry.last_write_time(ec), entry);
+        }
+    }
+    if (size <= maxSize) {
+        return;
+    }
+
+    std::sort(files.begin(), files.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (const auto& [time, entry]: files) {
+        if (size <= maxSize) {
+            break;
+        }
+        uint64_t fileSize = entry.file_size(ec);
+        if (fs::remove(entry.path(), ec)) {
+            size -= fileSize;
+        }
+    }
+}
@@ -0,0 +1,71 @@
+/*
+ * Xournal++
+ *
+ * Cache of the compiled LaTeX formulas
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <cstdint>   // for uint64_t
+#include <optional>  // for optional
+#include <string>    // for string
+
+#include "filesystem.h"  // for path
+
+class LatexSettings;
+
+/**
+ * @brief PDF files generated by the LaTeX tool, stored on disk and addressed by the hash of the LaTeX file which was
+ * compiled (i.e. the template with the formula and color substituted) and of the generation command.
+ *
+ * When the cache exceeds its maximal size, the least recently used files are removed.
+ */
+class LatexCache {
+public:
+    /**
+     * @param maxSize The maximal size of the cache, in bytes. 0 disables the cache.
+     */
+    LatexCache(fs::path dir, uint64_t maxSize);
+
+    /**
+     * @brief The cache in the user cache folder, with the size configured in the settings
+     */
+    static LatexCache fromSettings(const LatexSettings& settings);
+
+    /**
+     * @return The key under which the result of the compilation of `texContents` by `genCmd` is stored
+     */
+    static std::string computeKey(const std::string& texContents, const std::string& genCmd);
+
+    /**
+     * @return The contents of the stored PDF file, or std::nullopt if none is stored for this key
+     */
+    std::optional<std::string> lookup(const std::string& key) const;
+
+    /**
+     * @brief Stores the PDF file, then removes the least recently used files if the cache is too large
+     */
+    void store(const std::string& key, const std::string& pdfContents);
+
+    bool contains(const std::string& key) const;
+
+    bool isEnabled() const;
+
+    /**
+     * @return The size of the files in the cache, in bytes
+     */
+    uint64_t getSize() const;
+
+private:
+    fs::path pathFor(const std::string& key) const;
+    void evict();
+
+private:
+    fs::path dir;
+    uint64_t maxSize;
+};
@@ -0,0 +1,139 @@
+#include "LatexCachePrewarmer.h"
+
+#include <system_error>   // for error_code
+#include <unordered_set>  // for unordered_set
+#include <utility>        // for move
+#include <variant>        // for get_if, get
+
+#include <glib.h>  // for g_warning, g_error_matches
+
+#include "control/settings/LatexSettings.h"  // for LatexSettings
+#include "model/Document.h"                  // for Document
+#include "model/Element.h"                   // for Element, ELEMENT_TEXIMAGE
+#include "model/Layer.h"                     // for Layer
+#include "model/TexImage.h"                  // for TexImage
+#include "model/XojPage.h"                   // for XojPage
+#include "util/Assert.h"                     // for xoj_assert
+#include "util/PathUtil.h"                   // for getTmpDirSubfolder, readString
+
+LatexCachePrewarmer::LatexCachePrewarmer(const LatexSettings& settings, std::vector<std::string> texContents):
+        settings(settings),
+        generator(settings),
+        cache(LatexCache::fromSettings(settings)),
+        texDir(Util::getTmpDirSubfolder("tex-prewarm")),
+        texContents(std::move(texContents)) {}
+
+LatexCachePrewarmer::~LatexCachePrewarmer() {
+    if (this->cancellable) {
+        g_cancellable_cancel(this->cancellable);
+        g_object_unref(this->cancellable);
+    }
+    if (this->proc) {
+        g_subprocess_force_exit(this->proc);
+        g_object_unref(this->proc);
+    }
+}
+
+auto LatexCachePrewarmer::forDocument(Document* doc, const LatexSettings& settings, Color textColor)
+        -> std::unique_ptr<LatexCachePrewarmer> {
+    LatexCache cache = LatexCache::fromSettings(settings);
+    if (!cache.isEnabled()) {
+        return nullptr;
+    }
+
+    auto latexTemplate = Util::readString(settings.globalTemplatePath, false, std::ios::binary);
+    if (!latexTemplate) {
+        return nullptr;
+    }
+
+    std::vector<std::string> texTexts;
+    doc->lock();
+    for (size_t i = 0; i < doc->getPageCount(); i++) {
+        for (Layer* layer: *doc->getPage(i)->getLayers()) {
+            for (const auto& e: layer->getElements()) {
+                if (e->getType() == ELEMENT_TEXIMAGE) {
+                    texTexts.push_back(static_cast<TexImage*>(e.get())->getText());
+                }
+            }
+        }
+    }
+    doc->unlock();
+
+    std::vector<std::string> texContents;
+    std::unordered_set<std::string> keys;
+    for (const auto& text: texTexts) {
+        std::string contents = LatexGenerator::templateSub(text, *latexTemplate, textColor);
+        std::string key = LatexCache::computeKey(contents, settings.genCmd);
+        if (!cache.contains(key) && keys.insert(std::move(key)).second) {
+            texContents.push_back(std::move(contents));
+        }
+    }
+
+    if (texContents.empty()) {
+        return nullptr;
+    }
+    return std::make_unique<LatexCachePrewarmer>(settings, std::move(texContents));
+}
+
+void LatexCachePrewarmer::start() {
+    xoj_assert(this->cancellable == nullptr);
+    this->cancellable = g_cancellable_new();
+    compileNext();
+}
+
+void LatexCachePrewarmer::compileNext() {
+    g_clear_object(&this->proc);
+
+    while (this->next < this->texContents.size()) {
+        const std::string& contents = this->texContents[this->next++];
+        this->currentKey = LatexCache::computeKey(contents, this->settings.genCmd);
+        if (this->cache.contains(this->currentKey)) {
+            // Compiled by the LaTeX tool in the meantime
+            continue;
+        }
+
+        auto result = this->generator.asyncRun(this->texDir, contents);
+        if (auto* err = std::get_if<LatexGenerator::GenError>(&result)) {
+            // The LaTeX tool will show the error to the user, if they use it
+            g_warning("Could not prewarm the LaTeX cache: %s", err->message.c_str());
+            return;
+        }
+
+        // The output of the command is read (and dropped), so that it never blocks on a full pipe
+        this->proc = std::get<GSubprocess*>(result);
+        g_subprocess_communicate_async(this->proc, nullptr, this->cancellable, onCompiled, this);
+        return;
+    }
+}
+
+void LatexCachePrewarmer::onCompiled(GObject* procObj, GAsyncResult* res, gpointer data) {
+    GSubprocess* proc = G_SUBPROCESS(procObj);
+    GError* err = nullptr;
+    GBytes* output = nullptr;
+    bool exited = g_subprocess_communicate_finish(proc, res, &output, nullptr, &err);
+    if (output) {
+        g_bytes_unref(output);
+    }
+    if (err != nullptr) {
+        bool cancelled = g_error_matches(err, G_IO_ERROR, G_IO_ERROR_CANCELLED);
+        g_error_free(err);
+        if (cancelled) {
+            // The prewarmer was destroyed
+            return;
+        }
+    }
+
+    auto* self = static_cast<LatexCachePrewarmer*>(data);
+    // Invalid formulas are not cached: the LaTeX tool shows the error output when they are edited
+    if (exited && g_subprocess_get_successful(proc)) {
+        auto pdf = Util::readString(self->texDir / "tex.pdf", false, std::ios::binary);
+        if (pdf) {
+            self->cache.store(self->currentKey, *pdf);
+        }
+    }
+
+    std::error_code ec;
+    fs::remove(self->texDir / "tex.pdf", ec);
+
+    self->compileNext();
+}
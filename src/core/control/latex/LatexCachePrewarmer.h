@@ -0,0 +1,70 @@
+/*
+ * Xournal++
+ *
+ * Compiles the formulas of a document in the background
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <memory>  // for unique_ptr
+#include <string>  // for string
+#include <vector>  // for vector
+
+#include <gio/gio.h>  // for GAsyncResult, GCancellable, GSubprocess
+
+#include "util/Color.h"  // for Color
+
+#include "LatexCache.h"      // for LatexCache
+#include "LatexGenerator.h"  // for LatexGenerator
+#include "filesystem.h"      // for path
+
+class Document;
+class LatexSettings;
+
+/**
+ * @brief Fills the LaTeX cache with the formulas of a loaded document, so that editing them shows the preview without
+ * waiting for LaTeX.
+ *
+ * The formulas are compiled one after the other, in a temporary folder of their own, from the main loop. Destroying the
+ * prewarmer stops it.
+ */
+class LatexCachePrewarmer final {
+public:
+    LatexCachePrewarmer(const LatexSettings& settings, std::vector<std::string> texContents);
+    LatexCachePrewarmer(const LatexCachePrewarmer&) = delete;
+    LatexCachePrewarmer& operator=(const LatexCachePrewarmer&) = delete;
+    ~LatexCachePrewarmer();
+
+    /**
+     * @brief Creates a prewarmer for the formulas of the document which are not in the cache yet.
+     * The formulas are compiled with the global template and the given color, as the LaTeX tool would do.
+     *
+     * @return nullptr if there is nothing to compile
+     */
+    static std::unique_ptr<LatexCachePrewarmer> forDocument(Document* doc, const LatexSettings& settings,
+                                                            Color textColor);
+
+    void start();
+
+private:
+    void compileNext();
+    static void onCompiled(GObject* procObj, GAsyncResult* res, gpointer data);
+
+private:
+    const LatexSettings& settings;
+    LatexGenerator generator;
+    LatexCache cache;
+    fs::path texDir;
+
+    std::vector<std::string> texContents;
+    size_t next = 0;
+    std::string currentKey;
+
+    GSubprocess* proc = nullptr;
+    GCancellable* cancellable = nullptr;
+};
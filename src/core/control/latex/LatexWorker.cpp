@@ -0,0 +1,234 @@
+#include "LatexWorker.h"
+
+#include <algorithm>     // for any_of, min
+#include <iterator>      // for begin, end
+#include <system_error>  // for error_code
+#include <utility>       // for move
+
+#include <glib.h>  // for g_shell_parse_argv, g_find_program_in_path
+
+#include "control/settings/LatexSettings.h"  // for LatexSettings
+#include "util/Assert.h"                     // for xoj_assert
+#include "util/raii/GLibGuards.h"            // for GErrorGuard, GStrvGuard
+#include "util/safe_casts.h"                 // for as_signed
+
+#include "LatexCache.h"  // for LatexCache
+
+using namespace xoj::util;
+
+/// Name of the file containing the part of the document after the preamble
+constexpr auto BODY_FILE = "body.tex";
+
+LatexWorker::LatexWorker(const LatexSettings& settings, fs::path texDir, const std::string& latexTemplate):
+        texDir(std::move(texDir)), preamble(templatePreamble(latexTemplate)) {
+    GStrvGuard argv{};
+    if (!g_shell_parse_argv(settings.genCmd.c_str(), nullptr, out_ptr(argv), nullptr) || !argv.get()[0]) {
+        return;
+    }
+    // The format of the engine must be known to compile the preamble: only the default engine is supported
+    if (fs::path(argv.get()[0]).stem() != "pdflatex") {
+        return;
+    }
+    gchar* prog = g_find_program_in_path(argv.get()[0]);
+    if (!prog) {
+        return;
+    }
+    this->program = prog;
+    g_free(prog);
+
+    for (gchar** arg = argv.get() + 1; *arg; arg++) {
+        std::string option(*arg);
+        if (option.find("{}") == std::string::npos && option.find("-interaction") == std::string::npos) {
+            this->options.push_back(std::move(option));
+        }
+    }
+
+    // The format depends on the preamble and on the command, and is kept as long as the temporary directory
+    this->formatName = "preamble-" + LatexCache::computeKey(this->preamble, settings.genCmd).substr(0, 16);
+}
+
+LatexWorker::~LatexWorker() {
+    if (this->cancellable) {
+        g_cancellable_cancel(this->cancellable);
+        g_object_unref(this->cancellable);
+    }
+    for (GSubprocess* proc: {this->dumpProc, this->warmProc}) {
+        if (proc) {
+            g_subprocess_force_exit(proc);
+            g_object_unref(proc);
+        }
+    }
+}
+
+auto LatexWorker::templatePreamble(const std::string& latexTemplate) -> std::string {
+    size_t end = std::min(latexTemplate.find("%%XPP_"), latexTemplate.find("\\begin{document}"));
+    if (end == std::string::npos) {
+        return "";
+    }
+    // Cut at the beginning of the line, to keep the LaTeX commands whole
+    size_t lineStart = latexTemplate.rfind('\n', end);
+    if (lineStart == std::string::npos) {
+        return "";
+    }
+    std::string preamble = latexTemplate.substr(0, lineStart + 1);
+    if (preamble.find("\\documentclass") == std::string::npos) {
+        return "";
+    }
+    return preamble;
+}
+
+auto LatexWorker::isPreambleFailure(const std::string& log) -> bool {
+    // Errors of pdftex when loading the format, and of LaTeX when the body needs the preamble again
+    static constexpr const char* MARKERS[] = {"format file",
+                                              "---! ",
+                                              "Can be used only in preamble",
+                                              "Two \\documentclass",
+                                              "Missing \\begin{document}"};
+    return std::any_of(std::begin(MARKERS), std::end(MARKERS),
+                       [&log](const char* marker) { return log.find(marker) != std::string::npos; });
+}
+
+auto LatexWorker::isSupported() const -> bool { return !this->program.empty() && !this->preamble.empty(); }
+
+auto LatexWorker::spawn(const std::vector<std::string>& args, GSubprocessFlags flags) -> GSubprocess* {
+    std::vector<const gchar*> argv;
+    argv.reserve(args.size() + 2);
+    argv.push_back(this->program.c_str());
+    for (const auto& arg: args) {
+        argv.push_back(arg.c_str());
+    }
+    argv.push_back(nullptr);
+
+    GSubprocessLauncher* launcher = g_subprocess_launcher_new(flags);
+    g_subprocess_launcher_set_cwd(launcher, this->texDir.u8string().c_str());
+    GErrorGuard err{};
+    GSubprocess* proc = g_subprocess_launcher_spawnv(launcher, argv.data(), out_ptr(err));
+    g_object_unref(launcher);
+
+    if (!proc) {
+        g_warning("Could not start the LaTeX worker: %s", err->message);
+    }
+    return proc;
+}
+
+void LatexWorker::prepare() {
+    if (this->state != State::IDLE || !isSupported()) {
+        return;
+    }
+
+    std::error_code ec;
+    if (fs::is_regular_file(this->texDir / (this->formatName + ".fmt"), ec)) {
+        this->state = State::READY;
+        spawnWarmProcess();
+        return;
+    }
+
+    const std::string preambleFile = this->formatName + ".tex";
+    GErrorGuard err{};
+    if (!g_file_set_contents((this->texDir / preambleFile).u8string().c_str(), this->preamble.c_str(),
+                             as_signed(this->preamble.size()), out_ptr(err))) {
+        g_warning("Could not save the LaTeX preamble: %s", err->message);
+        this->state = State::FAILED;
+        return;
+    }
+
+    // Load the LaTeX format, read the preamble, and save the state of the engine
+    std::vector<std::string> args{"-ini", "-interaction=nonstopmode", "-halt-on-error", "-jobname=" + this->formatName};
+    args.insert(args.end(), this->options.begin(), this->options.end());
+    args.push_back("&pdflatex " + preambleFile + "\\dump");
+
+    auto flags = static_cast<GSubprocessFlags>(G_SUBPROCESS_FLAGS_STDOUT_PIPE | G_SUBPROCESS_FLAGS_STDERR_MERGE);
+    this->dumpProc = spawn(args, flags);
+    if (!this->dumpProc) {
+        this->state = State::FAILED;
+        return;
+    }
+
+    this->state = State::DUMPING;
+    this->cancellable = g_cancellable_new();
+    g_subprocess_communicate_async(this->dumpProc, nullptr, this->cancellable, onFormatDumped, this);
+}
+
+void LatexWorker::onFormatDumped(GObject* procObj, GAsyncResult* res, gpointer data) {
+    GSubprocess* proc = G_SUBPROCESS(procObj);
+    GError* err = nullptr;
+    GBytes* output = nullptr;
+    bool exited = g_subprocess_communicate_finish(proc, res, &output, nullptr, &err);
+    if (err != nullptr) {
+        bool cancelled = g_error_matches(err, G_IO_ERROR, G_IO_ERROR_CANCELLED);
+        g_error_free(err);
+        if (cancelled) {
+            // The worker was destroyed
+            if (output) {
+                g_bytes_unref(output);
+            }
+            return;
+        }
+    }
+
+    auto* self = static_cast<LatexWorker*>(data);
+    if (exited && g_subprocess_get_successful(proc)) {
+        self->state = State::READY;
+        self->spawnWarmProcess();
+    } else {
+        // Some packages cannot be preloaded: the one-shot command is always used then
+        gsize size = 0;
+        const char* log = output ? static_cast<const char*>(g_bytes_get_data(output, &size)) : "";
+        g_warning("Could not preload the LaTeX preamble, the previews will not use the LaTeX worker:\n%.*s",
+                  static_cast<int>(size), log);
+        self->state = State::FAILED;
+    }
+
+    if (output) {
+        g_bytes_unref(output);
+    }
+    g_clear_object(&self->dumpProc);
+}
+
+void LatexWorker::spawnWarmProcess() {
+    xoj_assert(this->warmProc == nullptr);
+
+    // The process reads the name of the file to compile from its standard input, once the format is loaded. Errors
+    // stop the process, as in the one-shot command: it never waits for the user to fix them.
+    std::vector<std::string> args{"-fmt=" + this->formatName, "-jobname=tex", "-halt-on-error"};
+    args.insert(args.end(), this->options.begin(), this->options.end());
+    args.emplace_back("{\\endlinechar=-1 \\global\\read16 to\\xojbody}\\input{\\xojbody}");
+
+    auto flags = static_cast<GSubprocessFlags>(G_SUBPROCESS_FLAGS_STDIN_PIPE | G_SUBPROCESS_FLAGS_STDOUT_PIPE |
+                                               G_SUBPROCESS_FLAGS_STDERR_MERGE);
+    this->warmProc = spawn(args, flags);
+    if (!this->warmProc) {
+        this->state = State::FAILED;
+    }
+}
+
+void LatexWorker::disable() {
+    this->state = State::FAILED;
+    if (this->warmProc) {
+        g_subprocess_force_exit(this->warmProc);
+        g_clear_object(&this->warmProc);
+    }
+}
+
+auto LatexWorker::run(const std::string& texContents) -> std::optional<Run> {
+    if (this->state != State::READY || !this->warmProc) {
+        return std::nullopt;
+    }
+    // The preamble contains no placeholder, so it is the beginning of every substituted template
+    if (texContents.compare(0, this->preamble.size(), this->preamble) != 0) {
+        return std::nullopt;
+    }
+
+    const std::string body = texContents.substr(this->preamble.size());
+    GErrorGuard err{};
+    if (!g_file_set_contents((this->texDir / BODY_FILE).u8string().c_str(), body.c_str(), as_signed(body.size()),
+                             out_ptr(err))) {
+        g_warning("Could not save the LaTeX file: %s", err->message);
+        return std::nullopt;
+    }
+
+    Run run{this->warmProc, std::string(BODY_FILE) + "\n"};
+    this->warmProc = nullptr;
+    spawnWarmProcess();
+    return run;
+}
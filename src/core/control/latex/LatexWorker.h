@@ -0,0 +1,107 @@
+/*
+ * Xournal++
+ *
+ * Warm LaTeX process for the previews
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <optional>  // for optional
+#include <string>    // for string
+#include <vector>    // for vector
+
+#include <gio/gio.h>  // for GSubprocess, GCancellable, GAsyncResult
+
+#include "filesystem.h"  // for path
+
+class LatexSettings;
+
+/**
+ * @brief Shortens the compilation of the LaTeX previews, which is mostly spent loading the packages of the template.
+ *
+ * The preamble of the template (the part before the first placeholder) is compiled once into a format file. A LaTeX
+ * process is then started in advance with this format: it loads it and waits for the name of the file to compile on
+ * its standard input. Each preview hands this process over to the caller, and starts the next one.
+ *
+ * Only pdflatex is supported. As long as no process is ready, the caller uses the one-shot command.
+ */
+class LatexWorker final {
+public:
+    /**
+     * @param texDir The directory in which the format file is stored and the previews are compiled
+     */
+    LatexWorker(const LatexSettings& settings, fs::path texDir, const std::string& latexTemplate);
+    LatexWorker(const LatexWorker&) = delete;
+    LatexWorker& operator=(const LatexWorker&) = delete;
+    ~LatexWorker();
+
+    /**
+     * @return The beginning of the template which does not depend on the formula: the lines before the first
+     * placeholder, and before \begin{document}. Empty if there is none.
+     */
+    static std::string templatePreamble(const std::string& latexTemplate);
+
+    /**
+     * @return Whether the log of a failed compilation hints at a problem with the format file or the preamble, rather
+     * than with the formula
+     */
+    static bool isPreambleFailure(const std::string& log);
+
+    /**
+     * @return Whether the generation command and the template can be used by the worker
+     */
+    bool isSupported() const;
+
+    /**
+     * @brief Compiles the format file, if needed, then starts a process waiting for a preview
+     */
+    void prepare();
+
+    /**
+     * @brief Stops using the worker, e.g. after it failed to compile a formula that the one-shot command compiled
+     */
+    void disable();
+
+    struct Run {
+        /// The process, owned by the caller
+        GSubprocess* proc;
+        /// What to write to the standard input of the process
+        std::string input;
+    };
+
+    /**
+     * @brief Hands over the waiting process, to compile the given LaTeX file (the substituted template). The PDF file
+     * is "tex.pdf" in the directory of the worker, as with the one-shot command.
+     *
+     * @return std::nullopt if no process is ready
+     */
+    std::optional<Run> run(const std::string& texContents);
+
+private:
+    void spawnWarmProcess();
+    GSubprocess* spawn(const std::vector<std::string>& args, GSubprocessFlags flags);
+    static void onFormatDumped(GObject* procObj, GAsyncResult* res, gpointer data);
+
+private:
+    enum class State { IDLE, DUMPING, READY, FAILED };
+    State state = State::IDLE;
+
+    fs::path texDir;
+    std::string preamble;
+
+    /// Path of the engine, and options of the generation command (without the file and the interaction mode)
+    std::string program;
+    std::vector<std::string> options;
+
+    /// Name of the format file, without the extension
+    std::string formatName;
+
+    GSubprocess* dumpProc = nullptr;
+    GSubprocess* warmProc = nullptr;
+    GCancellable* cancellable = nullptr;
+};
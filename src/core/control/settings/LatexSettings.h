@@ -27,6 +27,19 @@ public:
     std::string genCmd{"pdflatex -halt-on-error -interaction=nonstopmode '{}'"};
 #endif
 
+    /**
+     * Maximal size of the on-disk cache of compiled formulas, in MiB. 0 disables the cache.
+     */
+    unsigned int cacheSize{64};
+    /**
+     * Compile the formulas of a document in the background when it is loaded, to fill the cache.
+     */
+    bool prewarmCache{false};
+    /**
+     * Keep a LaTeX process with the preamble of the template preloaded, to compile the previews faster (pdflatex only).
+     */
+    bool useWorker{false};
+
     /**
      * LaTeX editor theme. Only used if linked with the GtkSourceView
      * library.
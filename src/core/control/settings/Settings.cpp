@@ -186,6 +186,7 @@ void Settings::loadDefault() {
     this->preloadPagesBefore = 3U;
     this->preloadPagesAfter = 5U;
     this->eagerPageCleanup = true;
+    this->undoMemoryBudget = 256U;
 
     this->selectionBorderColor = Colors::red;
     this->selectionMarkerColor = Colors::xopp_cornflowerblue;
@@ -237,6 +238,8 @@ void Settings::loadDefault() {
     this->stabilizerFinalizeStroke = true;
     /**/
 
+    this->strokePredictionHorizon = 0;
+
     this->useSpacesForTab = false;
     this->numberOfSpacesForTab = 4;
 
@@ -518,6 +521,9 @@ void Settings::parseItem(xmlDocPtr doc, xmlNodePtr cur) {
         this->preloadPagesAfter = g_ascii_strtoull(reinterpret_cast<const char*>(value), nullptr, 10);
     } else if (xmlStrcmp(name, reinterpret_cast<const xmlChar*>("eagerPageCleanup")) == 0) {
         this->eagerPageCleanup = xmlStrcmp(value, reinterpret_cast<const xmlChar*>("true")) == 0;
+    } else if (xmlStrcmp(name, reinterpret_cast<const xmlChar*>("undoMemoryBudget")) == 0) {
+        this->undoMemoryBudget =
+                static_cast<unsigned int>(g_ascii_strtoull(reinterpret_cast<const char*>(value), nullptr, 10));
     } else if (xmlStrcmp(name, reinterpret_cast<const xmlChar*>("selectionBorderColor")) == 0) {
         this->selectionBorderColor = Color(g_ascii_strtoull(reinterpret_cast<const char*>(value), nullptr, 10));
     } else if (xmlStrcmp(name, reinterpret_cast<const xmlChar*>("selectionMarkerColor")) == 0) {
@@ -630,6 +636,13 @@ void Settings::parseItem(xmlDocPtr doc, xmlNodePtr cur) {
         this->latexSettings.globalTemplatePath = fs::u8path(v);
     } else if (xmlStrcmp(name, reinterpret_cast<const xmlChar*>("latexSettings.genCmd")) == 0) {
         this->latexSettings.genCmd = reinterpret_cast<char*>(value);
+    } else if (xmlStrcmp(name, reinterpret_cast<const xmlChar*>("latexSettings.cacheSize")) == 0) {
+        this->latexSettings.cacheSize =
+                static_cast<unsigned int>(g_ascii_strtoull(reinterpret_cast<const char*>(value), nullptr, 10));
+    } else if (xmlStrcmp(name, reinterpret_cast<const xmlChar*>("latexSettings.prewarmCache")) == 0) {
+        this->latexSettings.prewarmCache = xmlStrcmp(value, reinterpret_cast<const xmlChar*>("true")) == 0;
+    } else if (xmlStrcmp(name, reinterpret_cast<const xmlChar*>("latexSettings.useWorker")) == 0) {
+        this->latexSettings.useWorker = xmlStrcmp(value, reinterpret_cast<const xmlChar*>("true")) == 0;
     } else if (xmlStrcmp(name, reinterpret_cast<const xmlChar*>("latexSettings.sourceViewThemeId")) == 0) {
         this->latexSettings.sourceViewThemeId = reinterpret_cast<char*>(value);
     } else if (xmlStrcmp(name, reinterpret_cast<const xmlChar*>("latexSettings.editorFont")) == 0) {
@@ -677,6 +690,9 @@ void Settings::parseItem(xmlDocPtr doc, xmlNodePtr cur) {
         this->stabilizerCuspDetection = xmlStrcmp(value, reinterpret_cast<const xmlChar*>("true")) == 0;
     } else if (xmlStrcmp(name, reinterpret_cast<const xmlChar*>("stabilizerFinalizeStroke")) == 0) {
         this->stabilizerFinalizeStroke = xmlStrcmp(value, reinterpret_cast<const xmlChar*>("true")) == 0;
+    } else if (xmlStrcmp(name, reinterpret_cast<const xmlChar*>("strokePredictionHorizon")) == 0) {
+        this->strokePredictionHorizon =
+                static_cast<unsigned int>(g_ascii_strtoull(reinterpret_cast<const char*>(value), nullptr, 10));
     } else if (xmlStrcmp(name, reinterpret_cast<const xmlChar*>("colorPalette")) == 0) {
         std::string paletteConfig = std::string{reinterpret_cast<const char*>(value)};
         if (!paletteConfig.empty()) {
@@ -1089,6 +1105,8 @@ void Settings::save() {
     SAVE_UINT_PROP(preloadPagesBefore);
     SAVE_UINT_PROP(preloadPagesAfter);
     SAVE_BOOL_PROP(eagerPageCleanup);
+    SAVE_UINT_PROP(undoMemoryBudget);
+    ATTACH_COMMENT("The memory of the undo history in MiB, beyond which old actions are moved to disk. 0 disables it.");
 
     SAVE_STRING_PROP(pageTemplate);
     ATTACH_COMMENT("Config for new pages");
@@ -1140,6 +1158,8 @@ void Settings::save() {
     SAVE_BOOL_PROP(stabilizerCuspDetection);
     SAVE_BOOL_PROP(stabilizerFinalizeStroke);
 
+    SAVE_UINT_PROP(strokePredictionHorizon);
+
     if (!this->colorPaletteSetting.empty()) {
         saveProperty("colorPalette", this->colorPaletteSetting.u8string().c_str(), root);
     }
@@ -1154,6 +1174,10 @@ void Settings::save() {
     fs::path& p = latexSettings.globalTemplatePath;
     xmlNode = saveProperty("latexSettings.globalTemplatePath", p.empty() ? "" : p.u8string().c_str(), root);
     SAVE_STRING_PROP(latexSettings.genCmd);
+    SAVE_UINT_PROP(latexSettings.cacheSize);
+    ATTACH_COMMENT("The maximal size of the cache of compiled LaTeX formulas, in MiB. 0 disables the cache.");
+    SAVE_BOOL_PROP(latexSettings.prewarmCache);
+    SAVE_BOOL_PROP(latexSettings.useWorker);
     SAVE_STRING_PROP(latexSettings.sourceViewThemeId);
     SAVE_FONT_PROP(latexSettings.editorFont);
     SAVE_BOOL_PROP(latexSettings.useCustomEditorFont);
@@ -2098,6 +2122,16 @@ void Settings::setEagerPageCleanup(bool b) {
     save();
 }
 
+auto Settings::getUndoMemoryBudget() const -> unsigned int { return this->undoMemoryBudget; }
+
+void Settings::setUndoMemoryBudget(unsigned int budget) {
+    if (this->undoMemoryBudget == budget) {
+        return;
+    }
+    this->undoMemoryBudget = budget;
+    save();
+}
+
 auto Settings::getBorderColor() const -> Color { return this->selectionBorderColor; }
 
 void Settings::setBorderColor(Color color) {
@@ -2584,6 +2618,15 @@ void Settings::setStabilizerPreprocessor(StrokeStabilizer::Preprocessor preproce
     save();
 }
 
+auto Settings::getStrokePredictionHorizon() const -> unsigned int { return strokePredictionHorizon; }
+
+void Settings::setStrokePredictionHorizon(unsigned int horizon) {
+    if (strokePredictionHorizon == horizon) {
+        return;
+    }
+    strokePredictionHorizon = horizon;
+    save();
+}
 
 auto Settings::getColorPaletteSetting() -> fs::path const& { return this->colorPaletteSetting; }
 
@@ -400,6 +400,13 @@ public:
     bool isEagerPageCleanup() const;
     void setEagerPageCleanup(bool b);
 
+    /**
+     * @brief Memory (in MiB) the undo history may use before the data of its oldest actions is moved to disk.
+     * 0 disables the budget.
+     */
+    unsigned int getUndoMemoryBudget() const;
+    void setUndoMemoryBudget(unsigned int budget);
+
     std::string const& getPageTemplate() const;
     void setPageTemplate(const std::string& pageTemplate);
 
@@ -567,6 +574,12 @@ public:
     void setStabilizerAveragingMethod(StrokeStabilizer::AveragingMethod averagingMethod);
     void setStabilizerPreprocessor(StrokeStabilizer::Preprocessor preprocessor);
 
+    /**
+     * @brief How far ahead (in ms) the tip of the stroke being drawn is predicted. 0 disables the prediction.
+     */
+    unsigned int getStrokePredictionHorizon() const;
+    void setStrokePredictionHorizon(unsigned int horizon);
+
     fs::path const& getColorPaletteSetting();
     void setColorPaletteSetting(fs::path palettePath);
 
@@ -1135,6 +1148,11 @@ private:
      */
     bool eagerPageCleanup{};
 
+    /**
+     * Memory budget of the undo history, in MiB
+     */
+    unsigned int undoMemoryBudget{};
+
     /**
      * Stabilizer related settings
      */
@@ -1149,6 +1167,11 @@ private:
     StrokeStabilizer::AveragingMethod stabilizerAveragingMethod{};
     StrokeStabilizer::Preprocessor stabilizerPreprocessor{};
 
+    /**
+     * Predicted tail of the stroke being drawn, in ms
+     */
+    unsigned int strokePredictionHorizon{};
+
     fs::path colorPaletteSetting;
 
     /**
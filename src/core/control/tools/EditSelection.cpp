@@ -3,6 +3,7 @@
 #include <algorithm>  // for min, max, stable_sort
 #include <cmath>      // for abs, cos, sin, cop...
 #include <cstddef>    // for size_t
+#include <cstdint>    // for uint8_t, uint64_t
 #include <limits>     // for numeric_limits
 #include <memory>     // for make_unique, __sha...
 #include <numeric>    // for reduce
@@ -24,19 +25,21 @@
 #include "model/Document.h"                        // for Document
 #include "model/Element.h"                         // for Element::Index
 #include "model/ElementInsertionPosition.h"
-#include "model/Layer.h"                          // for Layer
-#include "model/LineStyle.h"                      // for LineStyle
-#include "model/Point.h"                          // for Point
-#include "model/XojPage.h"                        // for XojPage
-#include "undo/ArrangeUndoAction.h"               // for ArrangeUndoAction
-#include "undo/InsertUndoAction.h"                // for InsertsUndoAction
-#include "undo/UndoRedoHandler.h"                 // for UndoRedoHandler
-#include "util/Range.h"                           // for Range
-#include "util/Util.h"                            // for cairo_set_dash_from_vector
-#include "util/glib_casts.h"                      // for wrap_v
-#include "util/i18n.h"                            // for _
-#include "util/serializing/ObjectInputStream.h"   // for ObjectInputStream
-#include "util/serializing/ObjectOutputStream.h"  // for ObjectOutputStream
+#include "model/Layer.h"                           // for Layer
+#include "model/LineStyle.h"                       // for LineStyle
+#include "model/Point.h"                           // for Point
+#include "model/XojPage.h"                         // for XojPage
+#include "undo/ArrangeUndoAction.h"                // for ArrangeUndoAction
+#include "undo/InsertUndoAction.h"                 // for InsertsUndoAction
+#include "undo/UndoRedoHandler.h"                  // for UndoRedoHandler
+#include "util/Range.h"                            // for Range
+#include "util/Util.h"                             // for cairo_set_dash_from_vector
+#include "util/glib_casts.h"                       // for wrap_v
+#include "util/i18n.h"                             // for _
+#include "util/serializing/CompactInputStream.h"   // for CompactInputStream
+#include "util/serializing/CompactOutputStream.h"  // for CompactOutputStream
+#include "util/serializing/ObjectInputStream.h"    // for ObjectInputStream
+#include "util/serializing/ObjectOutputStream.h"   // for ObjectOutputStream
 
 #include "EditSelectionContents.h"  // for EditSelectionConte...
 #include "Selection.h"              // for Selection
@@ -56,6 +59,9 @@ constexpr int ROTATE_PADDING = 8;
 /// Number of times to trigger edge pan timer per second
 constexpr unsigned int PAN_TIMER_RATE = 30;
 
+/// Last revision stamp given to a selection
+static uint64_t lastRevision = 0;
+
 namespace SelectionFactory {
 /// @return Bounds and SnappingBounds
 static auto computeBoxes(const InsertionOrder& elts) -> std::pair<Range, Range> {
@@ -215,6 +221,7 @@ EditSelection::EditSelection(Control* ctrl, InsertionOrder elts, const PageRef&
         btnWidth(std::max(10, ctrl->getSettings()->getDisplayDpi() / 8)),
         sourcePage(page),
         sourceLayer(layer),
+        revision(++lastRevision),
         view(view),
         undo(ctrl->getUndoRedoHandler()),
         snappingHandler(ctrl->getSettings()) {
@@ -246,6 +253,7 @@ EditSelection::EditSelection(Control* ctrl, const PageRef& page, Layer* layer, X
         btnWidth(std::max(10, ctrl->getSettings()->getDisplayDpi() / 8)),
         sourcePage(page),
         sourceLayer(layer),
+        revision(++lastRevision),
         view(view),
         undo(ctrl->getUndoRedoHandler()),
         snappingHandler(ctrl->getSettings()) {}
@@ -362,6 +370,10 @@ auto EditSelection::isRotationSupported() const -> bool { return this->supportRo
  */
 auto EditSelection::getSourcePage() const -> PageRef { return this->sourcePage; }
 
+auto EditSelection::getRevision() const -> uint64_t { return this->revision; }
+
+void EditSelection::bumpRevision() { this->revision = ++lastRevision; }
+
 /**
  * Get the source layer (form where the Elements come)
  */
@@ -434,6 +446,7 @@ void EditSelection::addElement(ElementPtr eOwned, Element::Index order) {
     this->preserveAspectRatio = this->preserveAspectRatio || e->rescaleOnlyAspectRatio();
     this->supportMirroring = this->supportMirroring && e->rescaleWithMirror();
     this->supportRotation = this->supportRotation && e->getType() == ELEMENT_STROKE;
+    bumpRevision();
 }
 
 /**
@@ -493,6 +506,7 @@ auto EditSelection::rearrangeInsertionOrder(const OrderChange change) -> UndoAct
 
     auto newOrd = refInsertionOrder(orderOwned);
     this->contents->replaceInsertionOrder(std::move(orderOwned));
+    bumpRevision();
     PageRef page = this->view->getPage();
 
     return std::make_unique<ArrangeUndoAction>(page, page->getSelectedLayer(), desc, std::move(oldOrd),
@@ -521,6 +535,7 @@ void EditSelection::mouseUp() {
                                   layer, page, this->view, this->undo, this->mouseDownType);
 
     this->mouseDownType = CURSOR_SELECTION_NONE;
+    bumpRevision();
 
     const bool wasEdgePanning = this->isEdgePanning();
     this->setEdgePan(false);
@@ -600,6 +615,7 @@ void EditSelection::mouseMove(double mouseX, double mouseY, bool alt) {
 
         double angle = atan2(rdy, rdx);
         this->rotation = angle;
+        bumpRevision();
         this->view->getXournal()->getCursor()->setRotationAngle(180 / M_PI * angle);
     } else {
         // Translate mouse position into rotated coordinate system:
@@ -758,6 +774,7 @@ void EditSelection::translateToView(XojPageView* v) {
     this->snappedBounds.y = this->y + oy;
 
     this->view = v;
+    bumpRevision();
 
     //	int aX2 = getXOnViewAbsolute();
     //	int aY2 = getYOnViewAbsolute();
@@ -819,6 +836,7 @@ void EditSelection::moveSelection(double dx, double dy, bool addMoveUndo) {
     this->y += dy;
     this->snappedBounds.x += dx;
     this->snappedBounds.y += dy;
+    bumpRevision();
 
     updateMatrix();
 
@@ -1212,6 +1230,50 @@ void EditSelection::readSerialized(ObjectInputStream& in) {
             std::make_unique<EditSelectionContents>(xoj::util::Rectangle<double>(), xoj::util::Rectangle<double>(),
                                                     this->sourcePage, this->sourceLayer, this->view);
     this->contents->readSerialized(in);
+    bumpRevision();
 
     in.endObject();
 }
+
+void EditSelection::writeCompact(CompactOutputStream& out) const {
+    out.write(this->x);
+    out.write(this->y);
+    out.write(this->width);
+    out.write(this->height);
+
+    out.write(this->snappedBounds.x);
+    out.write(this->snappedBounds.y);
+    out.write(this->snappedBounds.width);
+    out.write(this->snappedBounds.height);
+
+    out.write(this->rotation);
+
+    this->contents->writeCompact(out);
+
+    out.write<uint64_t>(this->getElements().size());
+    for (Element* e: this->getElements()) {
+        out.write<uint8_t>(static_cast<uint8_t>(e->getType()));
+        e->writeCompact(out);
+    }
+}
+
+void EditSelection::readCompact(CompactInputStream& in) {
+    this->x = in.read<double>();
+    this->y = in.read<double>();
+    this->width = in.read<double>();
+    this->height = in.read<double>();
+
+    double xSnap = in.read<double>();
+    double ySnap = in.read<double>();
+    double wSnap = in.read<double>();
+    double hSnap = in.read<double>();
+    this->snappedBounds = Rectangle<double>{xSnap, ySnap, wSnap, hSnap};
+
+    this->rotation = in.read<double>();
+
+    this->contents =
+            std::make_unique<EditSelectionContents>(xoj::util::Rectangle<double>(), xoj::util::Rectangle<double>(),
+                                                    this->sourcePage, this->sourceLayer, this->view);
+    this->contents->readCompact(in);
+    bumpRevision();
+}
@@ -12,7 +12,8 @@
 
 #pragma once
 
-#include <memory>  // for unique_ptr
+#include <cstdint>  // for uint64_t
+#include <memory>   // for unique_ptr
 #include <utility>  // for pair
 #include <vector>   // for vector
 
@@ -39,6 +40,8 @@ class Selection;
 class EditSelectionContents;
 class DeleteUndoAction;
 class LineStyle;
+class CompactInputStream;
+class CompactOutputStream;
 class ObjectInputStream;
 class ObjectOutputStream;
 class XojFont;
@@ -145,6 +148,12 @@ public:
      */
     PageRef getSourcePage() const;
 
+    /**
+     * @brief Revision stamp of the selection, changed every time the selection is moved, scaled or rotated, or its
+     * elements change. Stamps are unique among all selections.
+     */
+    uint64_t getRevision() const;
+
     /**
      * Get the source layer (form where the Elements come)
      */
@@ -291,6 +300,13 @@ public:
     void serialize(ObjectOutputStream& out) const override;
     void readSerialized(ObjectInputStream& in) override;
 
+    /**
+     * Same data as serialize(), in the compact clipboard layout (see CompactOutputStream).
+     * As with readSerialized(), readCompact() does not read the elements: the caller creates them.
+     */
+    void writeCompact(CompactOutputStream& out) const;
+    void readCompact(CompactInputStream& in);
+
 
     /// Applies the transformation to the selected elements, empties the selection and return the modified elements
     InsertionOrder makeMoveEffective();
@@ -350,6 +366,11 @@ private:
      */
     bool isEdgePanning() const;
 
+    /**
+     * Mark the selection as changed, see getRevision()
+     */
+    void bumpRevision();
+
     static bool handleEdgePan(EditSelection* self);
 
 private:  // DATA
@@ -417,6 +438,11 @@ private:  // DATA
      */
     Layer* sourceLayer{};
 
+    /**
+     * The revision stamp, see getRevision()
+     */
+    uint64_t revision{};
+
     /**
      * The contents of the selection
      */
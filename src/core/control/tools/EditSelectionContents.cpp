@@ -4,40 +4,44 @@
 #include <cmath>      // for abs, isnan
 #include <iterator>   // for back_insert_iterator
 #include <limits>     // for numeric_limits
-#include <memory>     // for make_unique, __shar...
-#include <utility>
-
-#include <glib.h>  // for g_idle_add, g_sourc...
-
-#include "control/Control.h"                      // for Control
-#include "control/settings/Settings.h"            // for Settings
-#include "control/tools/CursorSelectionType.h"    // for CURSOR_SELECTION_TO...
-#include "gui/PageView.h"                         // for XojPageView
-#include "gui/XournalView.h"                      // for XournalView
-#include "model/Element.h"                        // for Element, Element::I...
-#include "model/Layer.h"                          // for Layer
-#include "model/LineStyle.h"                      // for LineStyle
-#include "model/Stroke.h"                         // for Stroke, StrokeTool...
-#include "model/Text.h"                           // for Text
-#include "model/XojPage.h"                        // for XojPage
-#include "undo/ColorUndoAction.h"                 // for ColorUndoAction
-#include "undo/DeleteUndoAction.h"                // for DeleteUndoAction
-#include "undo/FillUndoAction.h"                  // for FillUndoAction
-#include "undo/FontUndoAction.h"                  // for FontUndoAction
-#include "undo/InsertUndoAction.h"                // for InsertsUndoAction
-#include "undo/LineStyleUndoAction.h"             // for LineStyleUndoAction
-#include "undo/MoveUndoAction.h"                  // for MoveUndoAction
-#include "undo/RotateUndoAction.h"                // for RotateUndoAction
-#include "undo/ScaleUndoAction.h"                 // for ScaleUndoAction
-#include "undo/SizeUndoAction.h"                  // for SizeUndoAction
-#include "undo/UndoRedoHandler.h"                 // for UndoRedoHandler
-#include "util/Assert.h"                          // for xoj_assert
-#include "util/glib_casts.h"                      // for wrap_v
-#include "util/safe_casts.h"                      // for as_signed
-#include "util/serializing/ObjectInputStream.h"   // for ObjectInputStream
-#include "util/serializing/ObjectOutputStream.h"  // for ObjectOutputStream
-#include "view/ElementContainerView.h"            // for ElementContainerView
-#include "view/View.h"                            // for Context
+#include <memory>     // for make_unique, make_shared
+#include <mutex>      // for lock_guard
+#include <utility>    // for move
+
+#include <glib.h>  // for g_timeout_add, g_sou...
+
+#include "control/Control.h"                       // for Control
+#include "control/jobs/Scheduler.h"                // for JOB_PRIORITY_URGENT
+#include "control/jobs/SelectionRenderJob.h"       // for SelectionRenderJob, SelectionBufferSlot
+#include "control/jobs/XournalScheduler.h"         // for XournalScheduler
+#include "control/settings/Settings.h"             // for Settings
+#include "control/tools/CursorSelectionType.h"     // for CURSOR_SELECTION_TO...
+#include "gui/PageView.h"                          // for XojPageView
+#include "gui/XournalView.h"                       // for XournalView
+#include "model/Element.h"                         // for Element, Element::I...
+#include "model/Layer.h"                           // for Layer
+#include "model/LineStyle.h"                       // for LineStyle
+#include "model/Stroke.h"                          // for Stroke, StrokeTool...
+#include "model/Text.h"                            // for Text
+#include "model/XojPage.h"                         // for XojPage
+#include "undo/ColorUndoAction.h"                  // for ColorUndoAction
+#include "undo/DeleteUndoAction.h"                 // for DeleteUndoAction
+#include "undo/FillUndoAction.h"                   // for FillUndoAction
+#include "undo/FontUndoAction.h"                   // for FontUndoAction
+#include "undo/InsertUndoAction.h"                 // for InsertsUndoAction
+#include "undo/LineStyleUndoAction.h"              // for LineStyleUndoAction
+#include "undo/MoveUndoAction.h"                   // for MoveUndoAction
+#include "undo/RotateUndoAction.h"                 // for RotateUndoAction
+#include "undo/ScaleUndoAction.h"                  // for ScaleUndoAction
+#include "undo/SizeUndoAction.h"                   // for SizeUndoAction
+#include "undo/UndoRedoHandler.h"                  // for UndoRedoHandler
+#include "util/Assert.h"                           // for xoj_assert
+#include "util/glib_casts.h"                       // for wrap_v
+#include "util/safe_casts.h"                       // for as_signed
+#include "util/serializing/CompactInputStream.h"   // for CompactInputStream
+#include "util/serializing/CompactOutputStream.h"  // for CompactOutputStream
+#include "util/serializing/ObjectInputStream.h"    // for ObjectInputStream
+#include "util/serializing/ObjectOutputStream.h"   // for ObjectOutputStream
 
 class XojFont;
 
@@ -51,19 +55,23 @@ EditSelectionContents::EditSelectionContents(Rectangle<double> bounds, Rectangle
         lastSnappedBounds(snappedBounds),
         sourcePage(sourcePage),
         sourceLayer(sourceLayer),
-        sourceView(sourceView) {
+        sourceView(sourceView),
+        bufferSlot(std::make_shared<SelectionBufferSlot>(sourceView->getXournal())) {
 
     this->restoreLineWidth =
             this->getSourceView()->getXournal()->getControl()->getSettings()->getRestoreLineWidthEnabled();
 }
 
 EditSelectionContents::~EditSelectionContents() {
-    if (this->rescaleId) {
-        g_source_remove(this->rescaleId);
-        this->rescaleId = 0;
+    if (this->settleTimeoutId) {
+        g_source_remove(this->settleTimeoutId);
+        this->settleTimeoutId = 0;
     }
 
     deleteViewBuffer();
+
+    std::lock_guard lock(this->bufferSlot->mutex);
+    this->bufferSlot->alive = false;
 }
 
 /**
@@ -74,6 +82,7 @@ void EditSelectionContents::addElement(ElementPtr e, Element::Index order) {
     this->selected.emplace_back(e.get());
     this->insertionOrder.emplace(std::upper_bound(this->insertionOrder.begin(), this->insertionOrder.end(), order),  //
                                  std::move(e), order);
+    this->renderedElements.reset();
 }
 
 void EditSelectionContents::replaceInsertionOrder(InsertionOrder newInsertionOrder) {
@@ -82,6 +91,7 @@ void EditSelectionContents::replaceInsertionOrder(InsertionOrder newInsertionOrd
     std::transform(begin(newInsertionOrder), end(newInsertionOrder), std::back_inserter(this->selected),
                    [](auto const& e) { return e.e.get(); });
     this->insertionOrder = std::move(newInsertionOrder);
+    this->renderedElements.reset();
 }
 
 auto EditSelectionContents::stealInsertionOrder() -> InsertionOrder { return std::move(this->insertionOrder); }
@@ -331,27 +341,67 @@ void EditSelectionContents::fillUndoItem(DeleteUndoAction* undo) {
     this->insertionOrder.clear();
 }
 
-/**
- * Callback to redrawing the buffer asynchron
- */
-auto EditSelectionContents::repaintSelection(EditSelectionContents* selection) -> bool {
-    // delete the selection buffer, force a redraw
-    selection->deleteViewBuffer();
-    selection->sourceView->getXournal()->repaintSelection();
-    selection->rescaleId = 0;
-
+auto EditSelectionContents::settleCallback(EditSelectionContents* selection) -> bool {
+    switch (selection->bufferPolicy.onSettleTimeout()) {
+        case SelectionBufferPolicy::Action::KEEP_WAITING:
+            return true;
+        case SelectionBufferPolicy::Action::RENDER:
+            selection->startBufferRender(selection->bufferPolicy.getPaintedParams());
+            break;
+        default:
+            break;
+    }
+    selection->settleTimeoutId = 0;
     return false;
 }
 
+void EditSelectionContents::startBufferRender(const SelectionBufferParams& params) {
+    unsigned int generation = 0;
+    {
+        std::lock_guard lock(this->bufferSlot->mutex);
+        if (this->bufferSlot->pending) {
+            // The next paint asks again once the running job is done
+            return;
+        }
+        this->bufferSlot->pending = true;
+        generation = this->bufferSlot->generation;
+    }
+
+    if (!this->renderedElements) {
+        // Cloned once per generation: the jobs never modify the copies
+        auto copies = std::make_shared<std::vector<ElementPtr>>();
+        copies->reserve(this->selected.size());
+        for (Element* e: this->selected) {
+            copies->emplace_back(e->clone());
+        }
+        this->renderedElements = std::move(copies);
+    }
+
+    auto* job = new SelectionRenderJob(this->bufferSlot, generation, this->renderedElements, params,
+                                       this->originalBounds, this->relativeX, this->relativeY);
+    this->sourceView->getXournal()->getControl()->getScheduler()->addJob(job, JOB_PRIORITY_URGENT);
+    job->unref();
+}
+
+void EditSelectionContents::renderPreview(const SelectionBufferParams& params) {
+    // The UI thread owns the elements: no copies are needed
+    this->crBuffer = SelectionRenderJob::render(this, params, this->originalBounds, this->relativeX, this->relativeY,
+                                                SelectionRenderJob::MAX_PREVIEW_PIXELS);
+    this->bufferPolicy.onPreviewReady(params);
+}
+
 /**
- * Delete our internal View buffer,
- * it will be recreated when the selection is painted next time
+ * Marks our internal View buffer as outdated,
+ * a new one is rendered when the selection is painted next time
  */
 void EditSelectionContents::deleteViewBuffer() {
-    if (this->crBuffer) {
-        cairo_surface_destroy(this->crBuffer);
-        this->crBuffer = nullptr;
-    }
+    this->bufferPolicy.invalidate();
+    this->renderedElements.reset();
+
+    std::lock_guard lock(this->bufferSlot->mutex);
+    // The buffers being rendered in the background show the previous state of the elements
+    this->bufferSlot->generation++;
+    this->bufferSlot->surface.reset();
 }
 
 InsertionOrder EditSelectionContents::makeMoveEffective(const xoj::util::Rectangle<double>& bounds,
@@ -504,9 +554,6 @@ void EditSelectionContents::updateContent(Rectangle<double> bounds, Rectangle<do
  */
 void EditSelectionContents::paint(cairo_t* cr, double x, double y, double rotation, double width, double height,
                                   double zoom) {
-    double fx = width / this->originalBounds.width;
-    double fy = height / this->originalBounds.height;
-
     if (this->relativeX == -9999999999) {
         this->relativeX = x;
         this->relativeY = y;
@@ -516,29 +563,35 @@ void EditSelectionContents::paint(cairo_t* cr, double x, double y, double rotati
         this->rotation = rotation;
     }
 
-    if (this->crBuffer == nullptr) {
-        this->crBuffer = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, static_cast<int>(std::abs(width) * zoom),
-                                                    static_cast<int>(std::abs(height) * zoom));
-        cairo_t* cr2 = cairo_create(this->crBuffer);
-
-        int dx = static_cast<int>(this->relativeX * zoom);
-        int dy = static_cast<int>(this->relativeY * zoom);
-
-        cairo_translate(cr2, fx < 0 ? -width * zoom : 0, fy < 0 ? -height * zoom : 0);
-        cairo_scale(cr2, fx, fy);
-        cairo_translate(cr2, -dx, -dy);
-        cairo_scale(cr2, zoom, zoom);
+    {
+        std::lock_guard lock(this->bufferSlot->mutex);
+        if (this->bufferSlot->surface) {
+            this->crBuffer = std::move(this->bufferSlot->surface);
+            this->bufferPolicy.onBufferReady(this->bufferSlot->params);
+        }
+    }
 
-        xoj::view::ElementContainerView view(this);
-        view.draw(xoj::view::Context::createDefault(cr2));
+    // The rotation is applied to cr: it does not need a new buffer
+    SelectionBufferParams params{width, height, zoom};
+    switch (this->bufferPolicy.onPaint(params)) {
+        case SelectionBufferPolicy::Action::RENDER:
+            startBufferRender(params);
+            break;
+        case SelectionBufferPolicy::Action::START_SETTLE_TIMER:
+            this->settleTimeoutId = g_timeout_add(SETTLE_DELAY, xoj::util::wrap_v<settleCallback>, this);
+            break;
+        default:
+            break;
+    }
 
-        cairo_destroy(cr2);
+    if (this->bufferPolicy.needsPreview(params)) {
+        renderPreview(params);
     }
 
     cairo_save(cr);
 
-    int wImg = cairo_image_surface_get_width(this->crBuffer);
-    int hImg = cairo_image_surface_get_height(this->crBuffer);
+    int wImg = cairo_image_surface_get_width(this->crBuffer.get());
+    int hImg = cairo_image_surface_get_height(this->crBuffer.get());
 
     int wTarget = static_cast<int>(std::abs(width) * zoom);
     int hTarget = static_cast<int>(std::abs(height) * zoom);
@@ -546,17 +599,15 @@ void EditSelectionContents::paint(cairo_t* cr, double x, double y, double rotati
     double sx = static_cast<double>(wTarget) / wImg;
     double sy = static_cast<double>(hTarget) / hImg;
 
-    if (wTarget != wImg || hTarget != hImg || std::abs(rotation) > std::numeric_limits<double>::epsilon()) {
-        if (!this->rescaleId) {
-            this->rescaleId = g_idle_add(xoj::util::wrap_v<repaintSelection>, this);
-        }
+    // The buffer is smaller than the target if it was rendered for another size, or if it has a reduced resolution
+    if (wTarget != wImg || hTarget != hImg) {
         cairo_scale(cr, sx, sy);
     }
 
     double dx = static_cast<int>(std::min(x, x + width) * zoom / sx);
     double dy = static_cast<int>(std::min(y, y + height) * zoom / sy);
 
-    cairo_set_source_surface(cr, this->crBuffer, dx, dy);
+    cairo_set_source_surface(cr, this->crBuffer.get(), dx, dy);
     cairo_paint(cr);
 
     cairo_restore(cr);
@@ -605,3 +656,39 @@ void EditSelectionContents::readSerialized(ObjectInputStream& in) {
 
     in.endObject();
 }
+
+void EditSelectionContents::writeCompact(CompactOutputStream& out) const {
+    out.write(this->originalBounds.x);
+    out.write(this->originalBounds.y);
+    out.write(this->originalBounds.width);
+    out.write(this->originalBounds.height);
+
+    out.write(this->lastSnappedBounds.x);
+    out.write(this->lastSnappedBounds.y);
+    out.write(this->lastSnappedBounds.width);
+    out.write(this->lastSnappedBounds.height);
+
+    out.write(this->rotation);
+
+    out.write(this->relativeX);
+    out.write(this->relativeY);
+}
+
+void EditSelectionContents::readCompact(CompactInputStream& in) {
+    double originalX = in.read<double>();
+    double originalY = in.read<double>();
+    double originalW = in.read<double>();
+    double originalH = in.read<double>();
+    this->originalBounds = Rectangle<double>{originalX, originalY, originalW, originalH};
+
+    double snappedX = in.read<double>();
+    double snappedY = in.read<double>();
+    double snappedW = in.read<double>();
+    double snappedH = in.read<double>();
+    this->lastSnappedBounds = Rectangle<double>{snappedX, snappedY, snappedW, snappedH};
+
+    this->rotation = in.read<double>();
+
+    this->relativeX = in.read<double>();
+    this->relativeY = in.read<double>();
+}
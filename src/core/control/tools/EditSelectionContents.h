@@ -11,21 +11,23 @@
 
 #pragma once
 
-#include <memory>   // for unique_ptr
+#include <memory>   // for unique_ptr, shared_ptr
 #include <utility>  // for pair
 #include <vector>   // for vector
 
 #include <cairo.h>  // for cairo_surface_t, cairo_t
 
-#include "control/ToolEnums.h"               // for ToolSize
-#include "model/Element.h"                   // for Element::Index, Element
-#include "model/ElementContainer.h"          // for ElementContainer
-#include "model/ElementInsertionPosition.h"  // for InsertionOrder
-#include "model/PageRef.h"                   // for PageRef
-#include "undo/UndoAction.h"                 // for UndoAction (ptr only)
-#include "util/Color.h"                      // for Color
-#include "util/Rectangle.h"                  // for Rectangle
-#include "util/serializing/Serializable.h"   // for Serializable
+#include "control/ToolEnums.h"                // for ToolSize
+#include "control/jobs/SelectionRenderJob.h"  // for SelectionBufferPolicy, SelectionBufferSlot
+#include "model/Element.h"                    // for Element::Index, Element, ElementPtr
+#include "model/ElementContainer.h"           // for ElementContainer
+#include "model/ElementInsertionPosition.h"   // for InsertionOrder
+#include "model/PageRef.h"                    // for PageRef
+#include "undo/UndoAction.h"                  // for UndoAction (ptr only)
+#include "util/Color.h"                       // for Color
+#include "util/Rectangle.h"                   // for Rectangle
+#include "util/raii/CairoWrappers.h"          // for CairoSurfaceSPtr
+#include "util/serializing/Serializable.h"    // for Serializable
 
 #include "CursorSelectionType.h"  // for CursorSelectionType
 
@@ -34,6 +36,8 @@ class Layer;
 class XojPageView;
 class DeleteUndoAction;
 class LineStyle;
+class CompactInputStream;
+class CompactOutputStream;
 class ObjectInputStream;
 class ObjectOutputStream;
 class XojFont;
@@ -140,15 +144,25 @@ public:
 
 private:
     /**
-     * Delete our internal View buffer,
-     * it will be recreated when the selection is painted next time
+     * Marks our internal View buffer as outdated. It is still painted until a new one is rendered in the background.
      */
     void deleteViewBuffer();
 
     /**
-     * Callback to redrawing the buffer asynchrony
+     * Called every SETTLE_DELAY ms while the buffer does not match the size of the selection. Starts rendering a new
+     * buffer once the size stopped changing.
      */
-    static auto repaintSelection(EditSelectionContents* selection) -> bool;
+    static auto settleCallback(EditSelectionContents* selection) -> bool;
+
+    /**
+     * Renders a buffer for the given size and zoom on the scheduler thread
+     */
+    void startBufferRender(const SelectionBufferParams& params);
+
+    /**
+     * Renders a low resolution buffer for the given size and zoom, painted until the next buffer is ready
+     */
+    void renderPreview(const SelectionBufferParams& params);
 
 public:
     /**
@@ -177,6 +191,9 @@ public:
     void serialize(ObjectOutputStream& out) const override;
     void readSerialized(ObjectInputStream& in) override;
 
+    void writeCompact(CompactOutputStream& out) const;
+    void readCompact(CompactInputStream& in);
+
 private:
     /**
      * The original dimensions to calculate the zoom factor for rescaling the items and the offset for moving the
@@ -217,14 +234,30 @@ private:
     InsertionOrder insertionOrder;
 
     /**
-     * The rendered elements
+     * The rendered elements. While the selection is being resized (or the zoom changes), the buffer is scaled. Once the
+     * elements changed, the outdated buffer is still painted. In both cases, a new buffer is rendered in the background.
+     * Until the first buffer is ready, and while zooming in, a low resolution preview is painted instead.
      */
-    cairo_surface_t* crBuffer = nullptr;
+    xoj::util::CairoSurfaceSPtr crBuffer;
+    SelectionBufferPolicy bufferPolicy;
 
     /**
-     * The source id for the rescaling task
+     * The source id of settleCallback()
      */
-    guint rescaleId = 0;
+    guint settleTimeoutId = 0;
+
+    /**
+     * Receives the buffers rendered in the background
+     */
+    std::shared_ptr<SelectionBufferSlot> bufferSlot;
+
+    /**
+     * Copies of the selected elements, shared by the render jobs until the elements change
+     */
+    std::shared_ptr<const std::vector<ElementPtr>> renderedElements;
+
+    /// Time without resizing after which the selection is rendered again at its new size, in ms
+    static constexpr guint SETTLE_DELAY = 150;
 
     /**
      * Source Page for Undo operations
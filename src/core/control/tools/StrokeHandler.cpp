@@ -1,8 +1,8 @@
 #include "StrokeHandler.h"
 
 #include <algorithm>  // for max, min
+#include <chrono>     // for steady_clock
 #include <cmath>      // for ceil, pow, abs
-#include <limits>     // for numeric_limits
 #include <memory>     // for unique_ptr, mak...
 #include <utility>    // for move
 #include <vector>     // for vector
@@ -10,14 +10,15 @@
 #include <gdk/gdk.h>  // for GdkEventKey
 
 #include "control/Control.h"                                // for Control
+#include "control/PerformanceMonitor.h"                     // for PerformanceMonitor
 #include "control/ToolEnums.h"                              // for DRAWING_TYPE_ST...
 #include "control/ToolHandler.h"                            // for ToolHandler
+#include "control/jobs/ShapeRecognizerJob.h"                // for ShapeRecognizerJob
+#include "control/jobs/XournalScheduler.h"                  // for XournalScheduler
 #include "control/layer/LayerController.h"                  // for LayerController
 #include "control/settings/Settings.h"                      // for Settings
 #include "control/settings/SettingsEnums.h"                 // for EmptyLastPageAppendType
-#include "control/shaperecognizer/ShapeRecognizer.h"        // for ShapeRecognizer
 #include "control/tools/InputHandler.h"                     // for InputHandler::P...
-#include "control/tools/SnapToGridInputHandler.h"           // for SnapToGridInput...
 #include "gui/inputdevices/PositionInputData.h"             // for PositionInputData
 #include "model/Document.h"                                 // for Document
 #include "model/Element.h"
@@ -26,23 +27,19 @@
 #include "model/Stroke.h"                                   // for Stroke, STROKE_...
 #include "model/XojPage.h"                                  // for XojPage
 #include "undo/InsertUndoAction.h"                          // for InsertUndoAction
-#include "undo/RecognizerUndoAction.h"                      // for RecognizerUndoA...
 #include "undo/UndoRedoHandler.h"                           // for UndoRedoHandler
 #include "util/Assert.h"                                    // for xoj_assert
 #include "util/DispatchPool.h"                              // for DispatchPool
 #include "util/Range.h"                                     // for Range
-#include "util/Rectangle.h"                                 // for Rectangle, util
 #include "view/overlays/StrokeToolFilledHighlighterView.h"  // for StrokeToolFilledHighlighterView
 #include "view/overlays/StrokeToolFilledView.h"             // for StrokeToolFilledView
 #include "view/overlays/StrokeToolView.h"                   // for StrokeToolView
 
+#include "StrokePredictor.h"   // for StrokePredictor
 #include "StrokeStabilizer.h"  // for Base, get
 
-using xoj::util::Rectangle;
-
 StrokeHandler::StrokeHandler(Control* control, const PageRef& page):
         InputHandler(control, page),
-        snappingHandler(control->getSettings()),
         stabilizer(StrokeStabilizer::get(control->getSettings())),
         viewPool(std::make_shared<xoj::util::DispatchPool<xoj::view::StrokeToolView>>()) {}
 
@@ -52,6 +49,7 @@ auto StrokeHandler::onKeyPressEvent(const KeyEvent&) -> bool { return false; }
 auto StrokeHandler::onKeyReleaseEvent(const KeyEvent&) -> bool { return false; }
 
 auto StrokeHandler::onMotionNotifyEvent(const PositionInputData& pos, double zoom) -> bool {
+    this->inputTime = std::chrono::steady_clock::now();
     if (!stroke) {
         return false;
     }
@@ -64,7 +62,12 @@ auto StrokeHandler::onMotionNotifyEvent(const PositionInputData& pos, double zoo
         return true;
     }
 
+    const size_t pointCount = stroke->getPointCount();
     stabilizer->processEvent(pos);
+    if (stroke->getPointCount() > pointCount) {
+        // Otherwise, the stabilizer held the event back or the motion was too short: the tip did not move
+        updatePrediction(pos.timestamp);
+    }
     return true;
 }
 
@@ -124,6 +127,7 @@ void StrokeHandler::drawSegmentTo(const Point& point) {
 
 void StrokeHandler::onSequenceCancelEvent() {
     if (this->stroke) {
+        finishPrediction();
         this->viewPool->dispatchAndClear(xoj::view::StrokeToolView::CANCELLATION_REQUEST,
                                          Range(this->stroke->boundingRect()));
         stroke.reset();
@@ -140,6 +144,7 @@ void StrokeHandler::onButtonReleaseEvent(const PositionInputData& pos, double zo
      * Fill this gap.
      */
     stabilizer->finalizeStroke();
+    finishPrediction();
 
     // Backward compatibility and also easier to handle for me;-)
     // I cannot draw a line with one point, to draw a visible line I need two points,
@@ -160,7 +165,9 @@ void StrokeHandler::onButtonReleaseEvent(const PositionInputData& pos, double zo
     Layer* layer = page->getSelectedLayer();
 
     UndoRedoHandler* undo = control->getUndoRedoHandler();
-    undo->addUndoAction(std::make_unique<InsertUndoAction>(page, layer, stroke.get()));
+    auto insertAction = std::make_unique<InsertUndoAction>(page, layer, stroke.get());
+    const UndoAction* insertActionPtr = insertAction.get();
+    undo->addUndoAction(std::move(insertAction));
 
     Settings* settings = control->getSettings();
     if (settings->getEmptyLastPageAppend() == EmptyLastPageAppendType::OnDrawOfLastPage) {
@@ -179,19 +186,6 @@ void StrokeHandler::onButtonReleaseEvent(const PositionInputData& pos, double zo
         }
     }
 
-    ToolHandler* h = control->getToolHandler();
-    if (h->getDrawingType() == DRAWING_TYPE_SHAPE_RECOGNIZER) {
-        ShapeRecognizer reco;
-
-        auto recognized = reco.recognizePatterns(stroke.get(), control->getSettings()->getStrokeRecognizerMinSize());
-
-        if (recognized) {
-            // strokeRecognizerDetected handles the repainting and the deletion of the views.
-            strokeRecognizerDetected(std::move(recognized), layer);
-            return;
-        }
-    }
-
     auto ptr = stroke.get();
     Document* doc = control->getDocument();
     doc->lock();
@@ -203,58 +197,19 @@ void StrokeHandler::onButtonReleaseEvent(const PositionInputData& pos, double zo
     this->viewPool->dispatchAndClear(xoj::view::StrokeToolView::FINALIZATION_REQUEST, Range());
 
     page->fireElementChanged(ptr);
-}
 
-void StrokeHandler::strokeRecognizerDetected(std::unique_ptr<Stroke> recognized, Layer* layer) {
-    recognized->setWidth(stroke->hasPressure() ? stroke->getAvgPressure() : stroke->getWidth());
-
-    // snapping
-    if (control->getSettings()->getSnapRecognizedShapesEnabled()) {
-        Rectangle<double> oldSnappedBounds = recognized->getSnappedBounds();
-        Point topLeft = Point(oldSnappedBounds.x, oldSnappedBounds.y);
-        Point topLeftSnapped = snappingHandler.snapToGrid(topLeft, false);
-
-        recognized->move(topLeftSnapped.x - topLeft.x, topLeftSnapped.y - topLeft.y);
-        Rectangle<double> snappedBounds = recognized->getSnappedBounds();
-        Point belowRight = Point(snappedBounds.x + snappedBounds.width, snappedBounds.y + snappedBounds.height);
-        Point belowRightSnapped = snappingHandler.snapToGrid(belowRight, false);
-
-        double fx = (std::abs(snappedBounds.width) > std::numeric_limits<double>::epsilon()) ?
-                            (belowRightSnapped.x - topLeftSnapped.x) / snappedBounds.width :
-                            1;
-        double fy = (std::abs(snappedBounds.height) > std::numeric_limits<double>::epsilon()) ?
-                            (belowRightSnapped.y - topLeftSnapped.y) / snappedBounds.height :
-                            1;
-        recognized->scale(topLeftSnapped.x, topLeftSnapped.y, fx, fy, 0, false);
+    ToolHandler* h = control->getToolHandler();
+    if (h->getDrawingType() == DRAWING_TYPE_SHAPE_RECOGNIZER) {
+        // The stroke is committed right away. The recognized shape, if any, replaces it once the job is done.
+        auto* job = new ShapeRecognizerJob(control, page, layer, ptr, insertActionPtr);
+        control->getScheduler()->addJob(job, JOB_PRIORITY_URGENT);
+        job->unref();
     }
-
-    UndoRedoHandler* undo = control->getUndoRedoHandler();
-    auto recognizedPtr = recognized.get();
-    auto strokePtr = stroke.get();
-    undo->addUndoAction(std::make_unique<RecognizerUndoAction>(page, layer, std::move(stroke), recognizedPtr));
-
-    Document* doc = control->getDocument();
-    doc->lock();
-    layer->addElement(std::move(recognized));
-    doc->unlock();
-
-    Range range(recognizedPtr->getX(), recognizedPtr->getY());
-    range.addPoint(recognizedPtr->getX() + recognizedPtr->getElementWidth(),
-                   recognizedPtr->getY() + recognizedPtr->getElementHeight());
-
-    range.addPoint(strokePtr->getX(), strokePtr->getY());
-    range.addPoint(strokePtr->getX() + strokePtr->getElementWidth(), strokePtr->getY() + strokePtr->getElementHeight());
-
-    this->viewPool->dispatch(xoj::view::StrokeToolView::STROKE_REPLACEMENT_REQUEST, *recognizedPtr);
-
-    // Blitt the new stroke to the page's buffer, delete all the views and refresh the area (so the recognized stroke
-    // gets displayed instead of the old one).
-    this->viewPool->dispatchAndClear(xoj::view::StrokeToolView::FINALIZATION_REQUEST, range);
-    page->fireElementChanged(recognizedPtr);
 }
 
 void StrokeHandler::onButtonPressEvent(const PositionInputData& pos, double zoom) {
     xoj_assert(!stroke);
+    this->inputTime = std::chrono::steady_clock::now();
 
     this->buttonDownPoint.x = pos.x / zoom;
     this->buttonDownPoint.y = pos.y / zoom;
@@ -267,6 +222,32 @@ void StrokeHandler::onButtonPressEvent(const PositionInputData& pos, double zoom
     stroke->addPoint(Point(this->buttonDownPoint.x, this->buttonDownPoint.y, width));
 
     stabilizer->initialize(this, zoom, pos);
+
+    const unsigned int horizon = control->getSettings()->getStrokePredictionHorizon();
+    // The tail is drawn over the stroke: it would show with translucent strokes or dashes
+    if (horizon > 0 && stroke->getToolType() == StrokeTool::PEN && !stroke->getLineStyle().hasDashes()) {
+        this->predictor = std::make_unique<StrokePredictor>(static_cast<double>(horizon));
+        this->predictor->addPoint(stroke->getPointVector().back(), pos.timestamp);
+    } else {
+        this->predictor.reset();
+    }
+}
+
+void StrokeHandler::updatePrediction(guint32 timestamp) {
+    if (!this->predictor) {
+        return;
+    }
+    this->predictor->addPoint(this->stroke->getPointVector().back(), timestamp);
+    this->viewPool->dispatch(xoj::view::StrokeToolView::PREDICTION_REQUEST, this->predictor->predict());
+}
+
+void StrokeHandler::finishPrediction() {
+    if (!this->predictor) {
+        return;
+    }
+    const StrokePredictor::ErrorStatistics& errors = this->predictor->getErrorStatistics();
+    control->getPerformanceMonitor()->recordPredictionErrors(errors.samples, errors.total, errors.max);
+    this->predictor.reset();
 }
 
 void StrokeHandler::onButtonDoublePressEvent(const PositionInputData&, double) {
@@ -292,3 +273,7 @@ auto StrokeHandler::createView(xoj::view::Repaintable* parent) const -> std::uni
 auto StrokeHandler::getViewPool() const -> const std::shared_ptr<xoj::util::DispatchPool<xoj::view::StrokeToolView>>& {
     return viewPool;
 }
+
+auto StrokeHandler::getInputTime() const -> std::chrono::steady_clock::time_point { return inputTime; }
+
+auto StrokeHandler::getPerformanceMonitor() const -> PerformanceMonitor* { return control->getPerformanceMonitor(); }
@@ -11,20 +11,22 @@
 
 #pragma once
 
+#include <chrono>  // for steady_clock
 #include <memory>  // for unique_ptr
 
 #include <gdk/gdk.h>  // for GdkEventKey
+#include <glib.h>     // for guint32
 
 #include "model/PageRef.h"  // for PageRef
 #include "model/Point.h"    // for Point
 
-#include "InputHandler.h"            // for InputHandler
-#include "SnapToGridInputHandler.h"  // for SnapToGridInputHandler
+#include "InputHandler.h"  // for InputHandler
 
 class Control;
-class Layer;
+class PerformanceMonitor;
 class PositionInputData;
 class Stroke;
+class StrokePredictor;
 
 namespace xoj::util {
 template <class T>
@@ -75,6 +77,13 @@ public:
 
     const std::shared_ptr<xoj::util::DispatchPool<xoj::view::StrokeToolView>>& getViewPool() const;
 
+    /**
+     * @brief Time at which the input event currently being processed was received
+     */
+    std::chrono::steady_clock::time_point getInputTime() const;
+
+    PerformanceMonitor* getPerformanceMonitor() const;
+
 protected:
     /**
      * @brief Unconditionally add a segment to the stroke.
@@ -83,11 +92,20 @@ protected:
      */
     void drawSegmentTo(const Point& point);
 
-    void strokeRecognizerDetected(std::unique_ptr<Stroke> recognized, Layer* layer);
+    /**
+     * @brief Feeds the predictor with the current tip of the stroke and sends the new predicted tail to the views.
+     * Only called once points were appended to the stroke, so that the predictor is not fed the same tip twice.
+     * @param timestamp The timestamp of the input event
+     */
+    void updatePrediction(guint32 timestamp);
+
+    /**
+     * @brief Reports the prediction errors of the stroke and drops the predictor
+     */
+    void finishPrediction();
 
 protected:
     Point buttonDownPoint;  // used for tapSelect and filtering - never snapped to grid.
-    SnapToGridInputHandler snappingHandler;
 
 private:
     /**
@@ -97,8 +115,15 @@ private:
 
     std::shared_ptr<xoj::util::DispatchPool<xoj::view::StrokeToolView>> viewPool;
 
+    /**
+     * @brief Ink prediction, if enabled for the current stroke
+     */
+    std::unique_ptr<StrokePredictor> predictor;
+
     bool hasPressure;
 
+    std::chrono::steady_clock::time_point inputTime{};
+
     friend class StrokeStabilizer::Active;
 
     static constexpr double MAX_WIDTH_VARIATION = 0.3;
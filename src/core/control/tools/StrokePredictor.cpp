@@ -0,0 +1,175 @@
+#include "StrokePredictor.h"
+
+#include <algorithm>  // for max, clamp
+#include <cmath>      // for hypot, abs
+
+namespace {
+/**
+ * @brief Solves the 3x3 system m * x = b with Cramer's rule
+ * @return false if the system is (nearly) singular
+ */
+bool solve3(const double m[3][3], const double b[3], double x[3]) {
+    auto det = [](const double a[3][3]) {
+        return a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1]) - a[0][1] * (a[1][0] * a[2][2] - a[1][2] * a[2][0]) +
+               a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+    };
+    const double d = det(m);
+    if (std::abs(d) <= 1e-9 * std::abs(m[0][0] * m[1][1] * m[2][2])) {
+        return false;
+    }
+    for (int col = 0; col < 3; col++) {
+        double mc[3][3];
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                mc[i][j] = j == col ? b[i] : m[i][j];
+            }
+        }
+        x[col] = det(mc) / d;
+    }
+    return true;
+}
+
+struct Derivatives {
+    double velocity = 0;
+    double acceleration = 0;
+};
+
+/**
+ * @brief Least squares fit of a polynomial of degree 2 (or 1 if there are too few samples)
+ * @param t The times of the samples, relative to the time at which the derivatives are computed
+ * @param v The values of the samples
+ */
+Derivatives fitDerivatives(const std::vector<double>& t, const std::vector<double>& v) {
+    const double n = static_cast<double>(t.size());
+    double s1 = 0, s2 = 0, s3 = 0, s4 = 0, b0 = 0, b1 = 0, b2 = 0;
+    for (size_t i = 0; i < t.size(); i++) {
+        const double t2 = t[i] * t[i];
+        s1 += t[i];
+        s2 += t2;
+        s3 += t2 * t[i];
+        s4 += t2 * t2;
+        b0 += v[i];
+        b1 += v[i] * t[i];
+        b2 += v[i] * t2;
+    }
+
+    if (t.size() >= 3) {
+        const double m[3][3] = {{n, s1, s2}, {s1, s2, s3}, {s2, s3, s4}};
+        const double b[3] = {b0, b1, b2};
+        double c[3];
+        if (solve3(m, b, c)) {
+            return {c[1], 2.0 * c[2]};
+        }
+    }
+
+    const double den = s2 - s1 * s1 / n;
+    if (den <= 0) {
+        return {};
+    }
+    return {(b1 - s1 * b0 / n) / den, 0};
+}
+}  // namespace
+
+StrokePredictor::StrokePredictor(double horizon): horizon(horizon) {}
+
+void StrokePredictor::addPoint(const Point& p, double time) {
+    if (!history.empty() && time < history.back().time) {
+        // The timestamps wrapped around
+        reset();
+    }
+
+    Sample current{p, time};
+    if (!history.empty()) {
+        checkPendingPredictions(history.back(), current);
+    }
+
+    if (!history.empty() && history.back().time == time) {
+        // The timestamps are in ms: keep the latest position
+        history.back().point = p;
+    } else {
+        history.push_back(current);
+    }
+
+    while (history.size() > MAX_HISTORY || time - history.front().time > HISTORY_DURATION) {
+        history.pop_front();
+    }
+}
+
+auto StrokePredictor::predict() -> std::vector<Point> {
+    if (history.size() < 2 || horizon <= 0) {
+        return {};
+    }
+
+    const Sample& last = history.back();
+    std::vector<double> t;
+    std::vector<double> x;
+    std::vector<double> y;
+    t.reserve(history.size());
+    x.reserve(history.size());
+    y.reserve(history.size());
+    for (const Sample& s: history) {
+        t.push_back(s.time - last.time);
+        x.push_back(s.point.x);
+        y.push_back(s.point.y);
+    }
+    const Derivatives dx = fitDerivatives(t, x);
+    const Derivatives dy = fitDerivatives(t, y);
+
+    double ax = dx.acceleration;
+    double ay = dy.acceleration;
+    // Do not let the acceleration take over: it is much noisier than the velocity
+    const double velocityPart = std::hypot(dx.velocity, dy.velocity) * horizon;
+    const double accelerationPart = 0.5 * std::hypot(ax, ay) * horizon * horizon;
+    if (accelerationPart > velocityPart) {
+        const double scale = velocityPart / accelerationPart;
+        ax *= scale;
+        ay *= scale;
+    }
+
+    auto at = [&](double s) {
+        return Point(last.point.x + dx.velocity * s + 0.5 * ax * s * s,
+                     last.point.y + dy.velocity * s + 0.5 * ay * s * s, last.point.z);
+    };
+
+    const Point end = at(horizon);
+    if (end.lineLengthTo(last.point) < MIN_DISTANCE) {
+        return {};
+    }
+
+    std::vector<Point> tail;
+    tail.reserve(STEPS + 1);
+    tail.push_back(last.point);
+    for (size_t i = 1; i <= STEPS; i++) {
+        tail.push_back(at(horizon * static_cast<double>(i) / static_cast<double>(STEPS)));
+    }
+
+    pending.push_back({last.time + horizon, end.x, end.y});
+    return tail;
+}
+
+void StrokePredictor::reset() {
+    history.clear();
+    pending.clear();
+}
+
+auto StrokePredictor::getErrorStatistics() const -> const ErrorStatistics& { return errors; }
+
+void StrokePredictor::checkPendingPredictions(const Sample& previous, const Sample& current) {
+    while (!pending.empty() && pending.front().time <= current.time) {
+        const PendingPrediction& p = pending.front();
+        // Real position at the predicted time
+        double f = 1.0;
+        if (current.time > previous.time) {
+            f = std::clamp((p.time - previous.time) / (current.time - previous.time), 0.0, 1.0);
+        }
+        const double x = previous.point.x + f * (current.point.x - previous.point.x);
+        const double y = previous.point.y + f * (current.point.y - previous.point.y);
+
+        const double error = std::hypot(p.x - x, p.y - y);
+        errors.samples++;
+        errors.total += error;
+        errors.max = std::max(errors.max, error);
+
+        pending.pop_front();
+    }
+}
@@ -0,0 +1,93 @@
+/*
+ * Xournal++
+ *
+ * Extrapolates the tip of the stroke being drawn
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <deque>    // for deque
+#include <vector>   // for vector
+
+#include "model/Point.h"  // for Point
+
+/**
+ * @brief Predicts where the stroke is heading, from the velocity and acceleration of its last points.
+ *
+ * The prediction is a short temporary tail, only meant to be displayed until the real points arrive: it hides part of
+ * the input-to-display latency. It is never added to the stroke.
+ *
+ * The points fed to the predictor are the stabilized points. Every prediction is compared to the real position of the
+ * stroke once the stroke reaches the predicted time, and the distance is accumulated in the error statistics.
+ */
+class StrokePredictor {
+public:
+    /**
+     * @param horizon How far in the future the tail goes, in ms
+     */
+    explicit StrokePredictor(double horizon);
+
+    struct ErrorStatistics {
+        size_t samples = 0;
+        double total = 0;
+        double max = 0;
+    };
+
+    /**
+     * @brief Adds a real point of the stroke
+     * @param time The time of the input event, in ms
+     */
+    void addPoint(const Point& p, double time);
+
+    /**
+     * @return The predicted tail: the last real point followed by the predicted points. Empty if there is no movement
+     *         or not enough points to predict it.
+     */
+    std::vector<Point> predict();
+
+    /**
+     * @brief Forgets the points (e.g. when the stroke ends). The error statistics are kept.
+     */
+    void reset();
+
+    /**
+     * @brief Error statistics (in document coordinates) of the predictions that could be checked so far
+     */
+    const ErrorStatistics& getErrorStatistics() const;
+
+    /// Points older than this (in ms) are not used for the prediction
+    static constexpr double HISTORY_DURATION = 40.0;
+    static constexpr size_t MAX_HISTORY = 8;
+    /// Number of predicted points in the tail
+    static constexpr size_t STEPS = 4;
+    /// Below this predicted distance, no tail is produced
+    static constexpr double MIN_DISTANCE = 0.1;
+
+private:
+    struct Sample {
+        Point point;
+        double time;
+    };
+
+    struct PendingPrediction {
+        double time;
+        double x;
+        double y;
+    };
+
+    void checkPendingPredictions(const Sample& previous, const Sample& current);
+
+private:
+    double horizon;
+
+    std::deque<Sample> history;
+    std::deque<PendingPrediction> pending;
+
+    ErrorStatistics errors;
+};
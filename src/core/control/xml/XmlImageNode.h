@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <string>  // for string
+
 #include <cairo.h>  // for cairo_surface_t, cairo_status_t
 
 #include "XmlNode.h"  // for XmlNode
@@ -25,12 +27,18 @@ public:
 public:
     void setImage(cairo_surface_t* img);
 
+    /**
+     * @brief Write already PNG encoded data, instead of encoding an image
+     */
+    void setPngData(std::string png);
+
     static cairo_status_t pngWriteFunction(XmlImageNode* image, const unsigned char* data, unsigned int length);
 
     void writeOut(OutputStream* out) override;
 
 private:
     cairo_surface_t* img;
+    std::string png;
 
     OutputStream* out;
     unsigned int pos;
@@ -29,6 +29,7 @@
 #include "util/GzUtil.h"                       // for GzUtil
 #include "util/LoopUtil.h"
 #include "util/PlaceholderString.h"  // for PlaceholderString
+#include "util/Tracing.h"            // for XOJ_TRACE_SCOPE
 #include "util/i18n.h"               // for _F, FC, FS, _
 #include "util/raii/GObjectSPtr.h"
 #include "util/safe_casts.h"  // for as_signed, as_unsigned
@@ -212,6 +213,7 @@ auto LoadHandler::readContentFile(char* buffer, zip_uint64_t len) -> zip_int64_t
 }
 
 auto LoadHandler::parseXml() -> bool {
+    XOJ_TRACE_SCOPE("LoadHandler::parseXml");
     xoj_assert(this->doc);
     const GMarkupParser parser = {LoadHandler::parserStartElement, LoadHandler::parserEndElement,
                                   LoadHandler::parserText, nullptr, nullptr};
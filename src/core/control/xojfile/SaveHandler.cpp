@@ -35,6 +35,7 @@
 #include "util/OutputStream.h"                 // for GzOutputStream, Output...
 #include "util/PathUtil.h"                     // for clearExtensions
 #include "util/PlaceholderString.h"            // for PlaceholderString
+#include "util/Tracing.h"                      // for XOJ_TRACE_SCOPE
 #include "util/i18n.h"                         // for FS, _F
 
 #include "config.h"  // for FILE_FORMAT_VERSION
@@ -60,7 +61,11 @@ void SaveHandler::prepareSave(Document* doc) {
     cairo_surface_t* preview = doc->getPreview();
     if (preview) {
         auto* image = new XmlImageNode("preview");
-        image->setImage(preview);
+        if (const std::string& png = doc->getPreviewPng(); !png.empty()) {
+            image->setPngData(png);
+        } else {
+            image->setImage(preview);
+        }
         this->root->addChild(image);
     }
 
@@ -316,6 +321,8 @@ void SaveHandler::writeBackgroundName(XmlNode* background, PageRef p) {
 }
 
 void SaveHandler::saveTo(const fs::path& filepath, ProgressListener* listener) {
+    XOJ_TRACE_SCOPE("SaveHandler::saveTo");
+
     GzOutputStream out(filepath);
 
     if (!out.getLastError().empty()) {
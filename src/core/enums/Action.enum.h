@@ -71,6 +71,8 @@ enum class Action : size_t {
     MANAGE_TOOLBAR,
     CUSTOMIZE_TOOLBAR,
     SHOW_MENUBAR,
+    SHOW_PERFORMANCE_OVERLAY,
+    RECORD_TRACE,
     ZOOM_IN,
     ZOOM_OUT,
     ZOOM_100,
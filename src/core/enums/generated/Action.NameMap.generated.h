@@ -41,6 +41,8 @@ constexpr const char* ACTION_NAMES[] = {  // Action to string conversion map
         "manage-toolbar",
         "customize-toolbar",
         "show-menubar",
+        "show-performance-overlay",
+        "record-trace",
         "zoom-in",
         "zoom-out",
         "zoom-100",
@@ -38,6 +38,7 @@ class ToolbarModel;
 class XournalView;
 class PdfFloatingToolbox;
 class FloatingToolbox;
+class PerformanceOverlay;
 class GladeSearchpath;
 
 class Menubar;
@@ -84,6 +85,7 @@ public:
     XournalView* getXournal() const;
 
     void setMenubarVisible(bool visible);
+    void setPerformanceOverlayVisible(bool visible);
     void setSidebarVisible(bool visible);
     void setToolbarVisible(bool visible);
 
@@ -171,6 +173,7 @@ private:
 
     std::unique_ptr<PdfFloatingToolbox> pdfFloatingToolBox;
     std::unique_ptr<FloatingToolbox> floatingToolbox;
+    std::unique_ptr<PerformanceOverlay> performanceOverlay;
 
     // Toolbars
     std::unique_ptr<ToolMenuHandler> toolbar;
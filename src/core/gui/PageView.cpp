@@ -1067,6 +1067,13 @@ auto XojPageView::isSelected() const -> bool { return selected; }
 
 auto XojPageView::hasBuffer() const -> bool { return this->buffer.isInitialized(); }
 
+auto XojPageView::isInputInProgress() const -> bool { return static_cast<bool>(this->currentSequenceDeviceId); }
+
+auto XojPageView::getBufferMemoryUsage() -> size_t {
+    std::lock_guard lock(this->drawingMutex);
+    return this->buffer.getMemoryUsage();
+}
+
 auto XojPageView::getSelectionColor() -> GdkRGBA { return Util::rgb_to_GdkRGBA(settings->getSelectionColor()); }
 
 auto XojPageView::getTextEditor() -> TextEditor* { return textEditor.get(); }
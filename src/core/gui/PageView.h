@@ -135,6 +135,16 @@ public:
     GdkRGBA getSelectionColor() override;
     bool hasBuffer() const;
 
+    /**
+     * @return true while an input sequence (e.g. a stroke being drawn) is in progress on this page
+     */
+    bool isInputInProgress() const;
+
+    /**
+     * @return The memory held by the rendered page, in bytes
+     */
+    size_t getBufferMemoryUsage();
+
     TextEditor* getTextEditor();
 
     /**
@@ -295,6 +305,8 @@ private:
     std::mutex repaintRectMutex;
     std::vector<xoj::util::Rectangle<double>> rerenderRects;
     bool rerenderComplete = false;
+    /// A RenderJob took the areas above and did not paint them to the buffer yet
+    bool renderInProgress = false;
 
     int dispX{};  // position on display - set in Layout::layoutPages
     int dispY{};
@@ -307,6 +319,7 @@ private:
 
 
     friend class RenderJob;
+    friend class PreviewJob;
     friend class InputHandler;
     friend class BaseSelectObject;
     friend class SelectObject;
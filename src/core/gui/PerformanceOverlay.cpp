@@ -0,0 +1,129 @@
+#include "PerformanceOverlay.h"
+
+#include <array>    // for array
+#include <cstddef>  // for size_t
+#include <iomanip>  // for setprecision
+#include <sstream>  // for ostringstream
+
+#include "control/Control.h"                // for Control
+#include "control/PdfCache.h"               // for PdfCache
+#include "control/PerformanceMonitor.h"     // for PerformanceMonitor
+#include "control/jobs/Scheduler.h"         // for JOB_N_PRIORITIES
+#include "control/jobs/XournalScheduler.h"  // for XournalScheduler
+#include "gui/MainWindow.h"                 // for MainWindow
+#include "gui/PageView.h"                   // for XojPageView
+#include "gui/XournalView.h"                // for XournalView
+#include "undo/UndoRedoHandler.h"           // for UndoRedoHandler
+#include "util/glib_casts.h"                // for wrap_v
+
+namespace {
+void writeBytes(std::ostream& out, size_t bytes) {
+    constexpr double MIB = 1024.0 * 1024.0;
+    out << static_cast<double>(bytes) / MIB << " MiB";
+}
+
+void writeTimings(std::ostream& out, const char* title, const PerformanceMonitor::TimingSummary& t) {
+    out << title;
+    if (t.samples == 0) {
+        out << "-\n";
+        return;
+    }
+    out << "last " << t.lastMs << " ms, avg " << t.averageMs << " ms, max " << t.maxMs << " ms\n";
+}
+}  // namespace
+
+PerformanceOverlay::PerformanceOverlay(Control* control, GtkOverlay* overlay):
+        control(control), label(gtk_label_new(nullptr)) {
+    gtk_widget_set_name(this->label, "performanceOverlay");
+    gtk_widget_set_halign(this->label, GTK_ALIGN_END);
+    gtk_widget_set_valign(this->label, GTK_ALIGN_START);
+    gtk_label_set_xalign(GTK_LABEL(this->label), 0.0f);
+
+    gtk_overlay_add_overlay(overlay, this->label);
+    gtk_overlay_set_overlay_pass_through(overlay, this->label, true);
+    gtk_widget_set_no_show_all(this->label, true);
+}
+
+PerformanceOverlay::~PerformanceOverlay() {
+    if (this->updateTimeout) {
+        g_source_remove(this->updateTimeout);
+        this->updateTimeout = 0;
+    }
+}
+
+void PerformanceOverlay::show() {
+    update();
+    gtk_widget_show(this->label);
+    if (!this->updateTimeout) {
+        this->updateTimeout = g_timeout_add(UPDATE_INTERVAL_MS, xoj::util::wrap_v<updateCallback>, this);
+    }
+}
+
+void PerformanceOverlay::hide() {
+    if (this->updateTimeout) {
+        g_source_remove(this->updateTimeout);
+        this->updateTimeout = 0;
+    }
+    gtk_widget_hide(this->label);
+}
+
+auto PerformanceOverlay::updateCallback(PerformanceOverlay* self) -> bool {
+    self->update();
+    return true;
+}
+
+void PerformanceOverlay::update() { gtk_label_set_text(GTK_LABEL(this->label), buildText().c_str()); }
+
+auto PerformanceOverlay::buildText() const -> std::string {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+
+    PerformanceMonitor* monitor = this->control->getPerformanceMonitor();
+    writeTimings(out, "Draw:    ", monitor->getDrawTimes());
+    writeTimings(out, "Ink:     ", monitor->getInkLatencies());
+    if (PerformanceMonitor::ErrorSummary errors = monitor->getPredictionErrors(); errors.samples > 0) {
+        out << "Predict: avg " << errors.averageError << " pt, max " << errors.maxError << " pt\n";
+    }
+    writeTimings(out, "Render:  ", monitor->getRenderLatencies());
+    for (auto&& [page, ms]: monitor->getRecentPageLatencies()) {
+        out << "  page " << page + 1 << ": " << ms << " ms\n";
+    }
+
+    std::array<size_t, JOB_N_PRIORITIES> queues = this->control->getScheduler()->getQueueLengths();
+    out << "Queues:  urgent " << queues[JOB_PRIORITY_URGENT] << ", high " << queues[JOB_PRIORITY_HIGH] << ", low "
+        << queues[JOB_PRIORITY_LOW] << ", none " << queues[JOB_PRIORITY_NONE] << "\n";
+
+    XournalView* xournal = this->control->getWindow()->getXournal();
+    out << "PDF:     ";
+    if (PdfCache* cache = xournal->getCache(); cache) {
+        PdfCache::Statistics stats = cache->getStatistics();
+        out << stats.hits << " hits, " << stats.misses << " misses, " << stats.entries << " entries, ";
+        writeBytes(out, stats.memoryUsage);
+        out << "\n";
+    } else {
+        out << "-\n";
+    }
+
+    size_t buffers = 0;
+    size_t bufferMemory = 0;
+    for (auto&& view: xournal->getViewPages()) {
+        if (size_t size = view->getBufferMemoryUsage(); size > 0) {
+            buffers++;
+            bufferMemory += size;
+        }
+    }
+    out << "Pages:   " << buffers << " buffers, ";
+    writeBytes(out, bufferMemory);
+    out << "\n";
+
+    UndoRedoHandler* undoRedo = this->control->getUndoRedoHandler();
+    out << "Undo:    " << undoRedo->getActionCount() << " actions, ";
+    writeBytes(out, undoRedo->getMemoryUsage());
+    if (size_t spilled = undoRedo->getSpilledSize(); spilled > 0) {
+        out << " + ";
+        writeBytes(out, spilled);
+        out << " on disk";
+    }
+
+    return out.str();
+}
@@ -0,0 +1,54 @@
+/*
+ * Xournal++
+ *
+ * Live performance statistics shown above the canvas
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <string>  // for string
+
+#include <glib.h>     // for guint
+#include <gtk/gtk.h>  // for GtkWidget, GtkOverlay
+
+class Control;
+
+/**
+ * @brief A label in the main overlay, showing the draw time of the canvas, the ink latency of the stroke being drawn,
+ * the render job latencies, the scheduler queues and the memory held by the PDF cache, the page buffers and the undo
+ * stack.
+ * The statistics are refreshed periodically while the overlay is visible.
+ */
+class PerformanceOverlay {
+public:
+    PerformanceOverlay(Control* control, GtkOverlay* overlay);
+    ~PerformanceOverlay();
+
+    PerformanceOverlay(const PerformanceOverlay&) = delete;
+    PerformanceOverlay& operator=(const PerformanceOverlay&) = delete;
+
+public:
+    void show();
+    void hide();
+
+private:
+    void update();
+    std::string buildText() const;
+
+    static bool updateCallback(PerformanceOverlay* self);
+
+private:
+    Control* control;
+
+    /// Owned by the overlay
+    GtkWidget* label;
+
+    guint updateTimeout = 0;
+
+    static constexpr guint UPDATE_INTERVAL_MS = 500;
+};
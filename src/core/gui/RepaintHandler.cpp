@@ -1,15 +1,28 @@
 #include "RepaintHandler.h"
 
-#include <gtk/gtk.h>  // for gtk_widget_queue_draw
+#include <utility>  // for swap
 
-#include "gui/widgets/XournalWidget.h"  // for gtk_xournal_repaint_area
+#include <cairo.h>  // for cairo_region_union_rectangle, cairo_re...
+
+#include "util/glib_casts.h"  // for wrap_v
 
 #include "PageView.h"     // for XojPageView
 #include "XournalView.h"  // for XournalView
 
-RepaintHandler::RepaintHandler(XournalView* xournal): xournal(xournal) {}
+RepaintHandler::RepaintHandler(XournalView* xournal):
+        xournal(xournal), dirtyRegion(cairo_region_create(), xoj::util::adopt) {}
 
-RepaintHandler::~RepaintHandler() { this->xournal = nullptr; }
+RepaintHandler::~RepaintHandler() {
+    std::lock_guard lock(this->regionMutex);
+    if (this->idleId) {
+        g_source_remove(this->idleId);
+    }
+    // The widget may already be destroyed, along with its tick callbacks
+    if (this->tickId && this->xournal->getWidget()) {
+        gtk_widget_remove_tick_callback(this->xournal->getWidget(), this->tickId);
+    }
+    this->xournal = nullptr;
+}
 
 void RepaintHandler::repaintPage(const XojPageView* view) {
     int x1 = view->getX();
@@ -17,13 +30,86 @@ void RepaintHandler::repaintPage(const XojPageView* view) {
     int x2 = x1 + view->getDisplayWidth();
     int y2 = y1 + view->getDisplayHeight();
 
-    gtk_xournal_repaint_area(this->xournal->getWidget(), x1, y1, x2, y2);
+    repaintArea(x1, y1, x2, y2);
 }
 
 void RepaintHandler::repaintPageArea(const XojPageView* view, int x1, int y1, int x2, int y2) {
     int x = view->getX();
     int y = view->getY();
-    gtk_xournal_repaint_area(this->xournal->getWidget(), x + x1, y + y1, x + x2, y + y2);
+    repaintArea(x + x1, y + y1, x + x2, y + y2);
+}
+
+void RepaintHandler::repaintArea(int x1, int y1, int x2, int y2) {
+    if (x2 <= x1 || y2 <= y1) {
+        return;
+    }
+    cairo_rectangle_int_t rect = {x1, y1, x2 - x1, y2 - y1};
+
+    std::lock_guard lock(this->regionMutex);
+    cairo_region_union_rectangle(this->dirtyRegion.get(), &rect);
+    scheduleFlush();
+}
+
+void RepaintHandler::scheduleFlush() {
+    if (this->flushScheduled) {
+        return;
+    }
+    this->flushScheduled = true;
+
+    if (g_main_context_is_owner(g_main_context_default())) {
+        // Already in the UI thread
+        this->tickId = gtk_widget_add_tick_callback(this->xournal->getWidget(),
+                                                    xoj::util::wrap_v<frameTickCallback>, this, nullptr);
+    } else {
+        // The frame clock may only be used from the UI thread: a single wakeup per frame instead of one per area
+        this->idleId = g_idle_add(xoj::util::wrap_v<addTickCallback>, this);
+    }
+}
+
+auto RepaintHandler::addTickCallback(RepaintHandler* self) -> bool {
+    std::lock_guard lock(self->regionMutex);
+    self->idleId = 0;
+    if (self->flushScheduled && !self->tickId) {
+        self->tickId = gtk_widget_add_tick_callback(self->xournal->getWidget(),
+                                                    xoj::util::wrap_v<frameTickCallback>, self, nullptr);
+    }
+    return false;
+}
+
+auto RepaintHandler::frameTickCallback(GtkWidget*, GdkFrameClock*, RepaintHandler* self) -> bool {
+    {
+        std::lock_guard lock(self->regionMutex);
+        self->tickId = 0;
+    }
+    self->flush();
+    return false;
+}
+
+void RepaintHandler::flush() {
+    xoj::util::CairoRegionSPtr region(cairo_region_create(), xoj::util::adopt);
+    {
+        std::lock_guard lock(this->regionMutex);
+        std::swap(region, this->dirtyRegion);
+        this->flushScheduled = false;
+        if (this->idleId) {
+            g_source_remove(this->idleId);
+            this->idleId = 0;
+        }
+        if (this->tickId) {
+            gtk_widget_remove_tick_callback(this->xournal->getWidget(), this->tickId);
+            this->tickId = 0;
+        }
+    }
+
+    GtkWidget* widget = this->xournal->getWidget();
+    GtkAllocation alloc = {0};
+    gtk_widget_get_allocation(widget, &alloc);
+    cairo_rectangle_int_t visible = {0, 0, alloc.width, alloc.height};
+    cairo_region_intersect_rectangle(region.get(), &visible);
+
+    if (!cairo_region_is_empty(region.get())) {
+        gtk_widget_queue_draw_region(widget, region.get());
+    }
 }
 
 void RepaintHandler::repaintPageBorder(const XojPageView* view) { gtk_widget_queue_draw(this->xournal->getWidget()); }
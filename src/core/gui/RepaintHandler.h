@@ -11,9 +11,21 @@
 
 #pragma once
 
+#include <mutex>  // for mutex
+
+#include <gtk/gtk.h>  // for GtkWidget, GdkFrameClock
+
+#include "util/raii/CairoWrappers.h"  // for CairoRegionSPtr
+
 class XojPageView;
 class XournalView;
 
+/**
+ * @brief Collects the areas of the widget that need to be redrawn.
+ *
+ * The areas are not invalidated right away: they are merged into a region, which is invalidated once per frame, from
+ * a tick callback of the frame clock. The repaint methods may be called from any thread.
+ */
 class RepaintHandler {
 public:
     RepaintHandler(XournalView* xournal);
@@ -35,6 +47,37 @@ public:
      */
     void repaintPageBorder(const XojPageView* view);
 
+    /**
+     * Invalidates the collected region right away, without waiting for the next frame. Must be called from the UI
+     * thread.
+     */
+    void flush();
+
+private:
+    void repaintArea(int x1, int y1, int x2, int y2);
+
+    /**
+     * Makes sure the collected region gets flushed on the next frame. regionMutex must be locked.
+     */
+    void scheduleFlush();
+
+    static bool addTickCallback(RepaintHandler* self);
+    static bool frameTickCallback(GtkWidget* widget, GdkFrameClock* clock, RepaintHandler* self);
+
 private:
     XournalView* xournal;
+
+    /**
+     * Protects the members below: the render jobs add their areas from the worker threads
+     */
+    std::mutex regionMutex;
+
+    /**
+     * Union of the areas repainted since the last flush, in widget coordinates
+     */
+    xoj::util::CairoRegionSPtr dirtyRegion;
+
+    bool flushScheduled = false;
+    guint idleId = 0;
+    guint tickId = 0;
 };
@@ -72,6 +72,9 @@ void LatexSettingsPanel::load(const LatexSettings& settings) {
                                       Util::toGFilename(settings.globalTemplatePath).c_str());
     }
     gtk_entry_set_text(GTK_ENTRY(builder.get("latexSettingsGenCmd")), settings.genCmd.c_str());
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(builder.get("latexSettingsCacheSize")), settings.cacheSize);
+    gtk_check_button_set_active(GTK_CHECK_BUTTON(builder.get("latexSettingsPrewarmCache")), settings.prewarmCache);
+    gtk_check_button_set_active(GTK_CHECK_BUTTON(builder.get("latexSettingsUseWorker")), settings.useWorker);
 
     std::string themeId = settings.sourceViewThemeId;
 
@@ -107,6 +110,10 @@ void LatexSettingsPanel::save(LatexSettings& settings) {
     settings.defaultText = gtk_entry_get_text(GTK_ENTRY(builder.get("latexDefaultEntry")));
     settings.globalTemplatePath = Util::fromGFilename(gtk_file_chooser_get_filename(this->globalTemplateChooser));
     settings.genCmd = gtk_entry_get_text(GTK_ENTRY(builder.get("latexSettingsGenCmd")));
+    settings.cacheSize = static_cast<unsigned int>(
+            gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(builder.get("latexSettingsCacheSize"))));
+    settings.prewarmCache = gtk_check_button_get_active(GTK_CHECK_BUTTON(builder.get("latexSettingsPrewarmCache")));
+    settings.useWorker = gtk_check_button_get_active(GTK_CHECK_BUTTON(builder.get("latexSettingsUseWorker")));
 
 #ifdef USE_GTK_SOURCEVIEW
     GtkSourceStyleScheme* theme = gtk_source_style_scheme_chooser_get_style_scheme(
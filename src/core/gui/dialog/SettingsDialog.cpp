@@ -393,6 +393,8 @@ void SettingsDialog::load() {
     gtk_spin_button_set_value(GTK_SPIN_BUTTON(sbStabilizerMass), settings->getStabilizerMass());
     GtkWidget* sbStabilizerSigma = builder.get("sbStabilizerSigma");
     gtk_spin_button_set_value(GTK_SPIN_BUTTON(sbStabilizerSigma), settings->getStabilizerSigma());
+    GtkWidget* sbStrokePredictionHorizon = builder.get("sbStrokePredictionHorizon");
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(sbStrokePredictionHorizon), settings->getStrokePredictionHorizon());
 
     GtkComboBox* cbStabilizerAveragingMethods = GTK_COMBO_BOX(builder.get("cbStabilizerAveragingMethods"));
     gtk_combo_box_set_active(cbStabilizerAveragingMethods, static_cast<int>(settings->getStabilizerAveragingMethod()));
@@ -593,6 +595,8 @@ void SettingsDialog::load() {
     gtk_spin_button_set_value(GTK_SPIN_BUTTON(builder.get("preloadPagesAfter")),
                               static_cast<double>(settings->getPreloadPagesAfter()));
     loadCheckbox("cbEagerPageCleanup", settings->isEagerPageCleanup());
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(builder.get("sbUndoMemoryBudget")),
+                              static_cast<double>(settings->getUndoMemoryBudget()));
 
     disableWithCheckbox("cbUnlimitedScrolling", "cbAddVerticalSpace");
     disableWithCheckbox("cbUnlimitedScrolling", "cbAddHorizontalSpace");
@@ -748,6 +752,8 @@ void SettingsDialog::save() {
     settings->setStabilizerSigma(gtk_spin_button_get_value(GTK_SPIN_BUTTON(builder.get("sbStabilizerSigma"))));
     settings->setStabilizerCuspDetection(getCheckbox("cbStabilizerEnableCuspDetection"));
     settings->setStabilizerFinalizeStroke(getCheckbox("cbStabilizerEnableFinalizeStroke"));
+    settings->setStrokePredictionHorizon(static_cast<unsigned int>(
+            gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(builder.get("sbStrokePredictionHorizon")))));
 
     settings->setSidebarNumberingStyle(static_cast<SidebarNumberingStyle>(
             gtk_combo_box_get_active(GTK_COMBO_BOX(builder.get("cbSidebarPageNumberStyle")))));
@@ -867,6 +873,7 @@ void SettingsDialog::save() {
     settings->setPreloadPagesAfter(preloadPagesAfter);
     settings->setPreloadPagesBefore(preloadPagesBefore);
     settings->setEagerPageCleanup(getCheckbox("cbEagerPageCleanup"));
+    settings->setUndoMemoryBudget(spinAsUint(GTK_SPIN_BUTTON(builder.get("sbUndoMemoryBudget"))));
 
     settings->setDefaultSaveName(gtk_entry_get_text(GTK_ENTRY(builder.get("txtDefaultSaveName"))));
     settings->setDefaultPdfExportName(gtk_entry_get_text(GTK_ENTRY(builder.get("txtDefaultPdfName"))));
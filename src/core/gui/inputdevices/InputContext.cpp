@@ -5,12 +5,14 @@
 #include "InputContext.h"
 
 #include <cstddef>  // for NULL
+#include <memory>   // for make_unique
 #include <vector>   // for vector
 
 #include <glib-object.h>  // for g_signal_hand...
 
 #include "control/Control.h"                            // for Control
 #include "control/DeviceListHelper.h"                   // for InputDevice
+#include "control/ToolHandler.h"                        // for ToolHandler
 #include "control/settings/Settings.h"                  // for Settings
 #include "gui/XournalView.h"                            // for XournalView
 #include "gui/inputdevices/GeometryToolInputHandler.h"  // for GeometryToolInputHandler
@@ -21,12 +23,14 @@
 #include "gui/inputdevices/TouchDrawingInputHandler.h"  // for TouchDrawingI...
 #include "gui/inputdevices/TouchInputHandler.h"         // for TouchInputHan...
 #include "util/Assert.h"                                // for xoj_assert
+#include "util/Tracing.h"                               // for XOJ_TRACE_SCOPE
 #include "util/gdk4_helper.h"
 #include "util/glib_casts.h"  // for wrap_for_g_callback
 #include "util/gtk4_helper.h"
 
-#include "InputEvents.h"   // for InputEvent
-#include "config-debug.h"  // for DEBUG_INPUT
+#include "InputEvents.h"     // for InputEvent
+#include "InputRecording.h"  // for InputRecorder
+#include "config-debug.h"    // for DEBUG_INPUT
 
 class ScrollHandling;
 class ToolHandler;
@@ -114,6 +118,8 @@ auto InputContext::eventCallback(GtkWidget* widget, GdkEvent* event, InputContex
 }
 
 auto InputContext::handle(GdkEvent* sourceEvent) -> bool {
+    XOJ_TRACE_SCOPE("InputContext::handle");
+
     printDebug(sourceEvent);
 
     GdkDevice* sourceDevice = gdk_event_get_source_device(sourceEvent);
@@ -142,6 +148,14 @@ auto InputContext::handle(GdkEvent* sourceEvent) -> bool {
         return false;
     }
 
+    if (this->recorder) {
+        this->recorder->record(event, this->view->getZoom(), this->getToolHandler()->getToolType());
+    }
+
+    return dispatchEvent(event);
+}
+
+auto InputContext::dispatchEvent(const InputEvent& event) -> bool {
     // Deactivate touchscreen when a pen event occurs
     this->getView()->getHandRecognition()->event(event.deviceClass);
 
@@ -188,6 +202,16 @@ auto InputContext::handle(GdkEvent* sourceEvent) -> bool {
     return false;
 }
 
+void InputContext::processPendingMotions() {
+    this->stylusHandler->processPendingMotions();
+    this->mouseHandler->processPendingMotions();
+    this->touchDrawingHandler->processPendingMotions();
+}
+
+void InputContext::startRecording(const fs::path& file) { this->recorder = std::make_unique<InputRecorder>(file); }
+
+void InputContext::stopRecording() { this->recorder.reset(); }
+
 auto InputContext::getXournal() -> GtkXournal* { return GTK_XOURNAL(widget); }
 
 auto InputContext::getView() -> XournalView* { return view; }
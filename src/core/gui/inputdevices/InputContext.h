@@ -22,7 +22,11 @@
 
 #include "gui/widgets/XournalWidget.h"  // for GtkXournal
 
+#include "filesystem.h"  // for path
+
 class GeometryToolInputHandler;
+class InputRecorder;
+struct InputEvent;
 class KeyboardInputHandler;
 class MouseInputHandler;
 class ScrollHandling;
@@ -52,6 +56,8 @@ private:
 
     std::set<std::string> knownDevices;
 
+    std::unique_ptr<InputRecorder> recorder;
+
 public:
     enum DeviceType {
         MOUSE,
@@ -91,6 +97,25 @@ public:
      */
     void connect(GtkWidget* widget);
 
+    /**
+     * Sends a translated event to the input handler of its device class.
+     * Events received from GTK go through here, and so do the events replayed by InputReplay.
+     * @return Whether the event was handled
+     */
+    bool dispatchEvent(const InputEvent& event);
+
+    /**
+     * Processes the motion events the pen input handlers queued until the next frame (see PenInputHandler)
+     */
+    void processPendingMotions();
+
+    /**
+     * Writes all the events received from GTK to file, until stopRecording() is called (see InputRecorder)
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    void startRecording(const fs::path& file);
+    void stopRecording();
+
     GtkXournal* getXournal();
     XournalView* getView();
     ToolHandler* getToolHandler();
@@ -0,0 +1,121 @@
+#include "InputRecording.h"
+
+#include <locale>     // for locale
+#include <sstream>    // for istringstream
+#include <stdexcept>  // for runtime_error
+#include <string>     // for getline, to_string
+
+#include "util/serdesstream.h"  // for serdes_stream
+
+namespace {
+constexpr auto HEADER = "xournalpp-input-recording";
+constexpr int VERSION = 1;
+}  // namespace
+
+InputRecorder::InputRecorder(const fs::path& file): start(g_get_monotonic_time()) {
+    out.open(file, std::ios::out | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Could not open the input recording file " + file.u8string());
+    }
+    // Same representation whatever the locale, and no precision lost on the coordinates
+    out.imbue(std::locale::classic());
+    out.precision(17);
+
+    out << HEADER << '\t' << VERSION << '\n';
+}
+
+InputRecorder::~InputRecorder() { out.flush(); }
+
+void InputRecorder::record(const InputEvent& event, double zoom, ToolType tool) {
+    if (zoom != this->lastZoom) {
+        out << "zoom\t" << zoom << '\n';
+        this->lastZoom = zoom;
+    }
+    if (tool != this->lastTool) {
+        out << "tool\t" << toolTypeToString(tool) << '\n';
+        this->lastTool = tool;
+    }
+
+    size_t sequence = 0;
+    if (event.sequence) {
+        auto [it, inserted] = this->sequences.try_emplace(event.sequence, this->lastSequence + 1);
+        if (inserted) {
+            this->lastSequence++;
+        }
+        sequence = it->second;
+        if (event.type == BUTTON_RELEASE_EVENT) {
+            // GDK may reuse the pointer for a later sequence
+            this->sequences.erase(it);
+        }
+    }
+
+    out << "event\t" << g_get_monotonic_time() - this->start << '\t' << event.type << '\t' << event.deviceClass << '\t'
+        << event.relativeX << '\t' << event.relativeY << '\t' << event.absoluteX << '\t' << event.absoluteY << '\t'
+        << event.pressure << '\t' << event.button << '\t' << event.state << '\t' << sequence << '\t'
+        << event.timestamp << '\t' << (event.deviceName ? event.deviceName : "") << '\n';
+}
+
+auto InputRecording::load(const fs::path& file) -> InputRecording {
+    auto in = serdes_stream<std::ifstream>(file);
+    if (!in) {
+        throw std::runtime_error("Could not open the input recording file " + file.u8string());
+    }
+
+    std::string line;
+    std::getline(in, line);
+    {
+        auto header = serdes_stream<std::istringstream>(line);
+        std::string name;
+        int version = 0;
+        if (!(header >> name >> version) || name != HEADER) {
+            throw std::runtime_error(file.u8string() + " is not an input recording");
+        }
+        if (version != VERSION) {
+            throw std::runtime_error("Unsupported input recording version " + std::to_string(version));
+        }
+    }
+
+    InputRecording recording;
+    double zoom = 1.0;
+    ToolType tool = TOOL_NONE;
+
+    for (size_t lineNr = 2; std::getline(in, line); lineNr++) {
+        auto fields = serdes_stream<std::istringstream>(line);
+        std::string kind;
+        std::getline(fields, kind, '\t');
+
+        if (kind == "zoom") {
+            if (!(fields >> zoom)) {
+                throw std::runtime_error("Invalid input recording " + file.u8string() + " at line " +
+                                         std::to_string(lineNr));
+            }
+        } else if (kind == "tool") {
+            std::string name;
+            std::getline(fields, name);
+            tool = toolTypeFromString(name);
+        } else if (kind == "event") {
+            RecordedInputEvent& e = recording.events.emplace_back();
+            int type = 0;
+            int deviceClass = 0;
+            int state = 0;
+            fields >> e.time >> type >> deviceClass >> e.relativeX >> e.relativeY >> e.absoluteX >> e.absoluteY >>
+                    e.pressure >> e.button >> state >> e.sequence >> e.timestamp;
+            if (fields.fail()) {
+                throw std::runtime_error("Invalid input recording " + file.u8string() + " at line " +
+                                         std::to_string(lineNr));
+            }
+            // The device name is the rest of the line, and may contain spaces
+            fields.ignore(1, '\t');
+            std::getline(fields, e.deviceName);
+
+            e.type = static_cast<InputEventType>(type);
+            e.deviceClass = static_cast<InputDeviceClass>(deviceClass);
+            e.state = static_cast<GdkModifierType>(state);
+            e.zoom = zoom;
+            e.tool = tool;
+        }
+        // Unknown records are skipped, so that later versions can add some without breaking the format
+    }
+
+    return recording;
+}
@@ -0,0 +1,101 @@
+/*
+ * Xournal++
+ *
+ * Recording of the input events, for reproducible benchmarks
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for int64_t
+#include <fstream>  // for ofstream
+#include <map>      // for map
+#include <string>   // for string
+#include <vector>   // for vector
+
+#include <gdk/gdk.h>  // for GdkModifierType, GdkEventSequence
+#include <glib.h>     // for guint, guint32, gint64
+
+#include "control/ToolEnums.h"  // for ToolType
+
+#include "InputEvents.h"  // for InputEventType, InputDeviceClass
+#include "filesystem.h"   // for path
+
+/**
+ * @brief An InputEvent as stored in a recording, together with the state needed to replay it.
+ */
+struct RecordedInputEvent {
+    /// Time the event was received, in microseconds since the start of the recording
+    int64_t time = 0;
+
+    InputEventType type = UNKNOWN;
+    InputDeviceClass deviceClass = INPUT_DEVICE_IGNORE;
+    std::string deviceName;
+
+    double relativeX = 0;
+    double relativeY = 0;
+    double absoluteX = 0;
+    double absoluteY = 0;
+    double pressure = 0;
+
+    guint button = 0;
+    GdkModifierType state{};
+    /// 0 if the event has no sequence. Otherwise identifies the (touch) sequence in the recording.
+    size_t sequence = 0;
+    guint32 timestamp = 0;
+
+    /// Zoom and tool when the event was received. Events are relative to the layout, which depends on the zoom.
+    double zoom = 1.0;
+    ToolType tool = TOOL_NONE;
+};
+
+/**
+ * @brief A recording, as written by InputRecorder
+ *
+ * The file is a text file, one line per record, with tab separated fields:
+ *  - a header "xournalpp-input-recording <version>"
+ *  - "zoom <zoom>" and "tool <name>" lines, whenever the zoom or the selected tool changed
+ *  - "event <time> <type> <device class> <relative x> <relative y> <absolute x> <absolute y> <pressure> <button>
+ *    <modifier state> <sequence> <timestamp> <device name>"
+ */
+struct InputRecording {
+    std::vector<RecordedInputEvent> events;
+
+    /**
+     * @throws std::runtime_error if the file cannot be read or is not a valid recording
+     */
+    static InputRecording load(const fs::path& file);
+};
+
+/**
+ * @brief Writes the input events received by the InputContext to a file
+ */
+class InputRecorder {
+public:
+    /**
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    explicit InputRecorder(const fs::path& file);
+    ~InputRecorder();
+
+    InputRecorder(const InputRecorder&) = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
+
+    void record(const InputEvent& event, double zoom, ToolType tool);
+
+private:
+    std::ofstream out;
+    gint64 start;
+
+    double lastZoom = -1;
+    ToolType lastTool = TOOL_NONE;
+
+    /// The sequences currently in use, and their identifiers in the recording
+    std::map<GdkEventSequence*, size_t> sequences;
+    size_t lastSequence = 0;
+};
@@ -0,0 +1,157 @@
+#include "InputReplay.h"
+
+#include <algorithm>  // for sort
+#include <chrono>     // for steady_clock, duration_cast
+#include <cstdint>    // for uintptr_t
+#include <map>        // for map
+#include <ostream>    // for ostream
+#include <string>     // for string
+#include <utility>    // for move
+
+#include "control/Control.h"             // for Control
+#include "control/PerformanceMonitor.h"  // for PerformanceMonitor
+#include "control/ToolHandler.h"         // for ToolHandler
+#include "control/zoom/ZoomControl.h"    // for ZoomControl
+#include "util/glib_casts.h"             // for wrap_v
+
+#include "InputContext.h"  // for InputContext
+
+InputReplay::InputReplay(Control* control, InputContext* context, InputRecording recording):
+        control(control), context(context), recording(std::move(recording)) {
+    GdkEvent* event = gdk_event_new(GDK_NOTHING);
+    this->sourceEvent = event;
+    gdk_event_free(event);
+
+    GdkSeat* seat = gdk_display_get_default_seat(gdk_display_get_default());
+    this->device = gdk_seat_get_pointer(seat);
+
+    this->measures.reserve(this->recording.events.size());
+}
+
+InputReplay::~InputReplay() {
+    if (this->sourceId) {
+        g_source_remove(this->sourceId);
+    }
+}
+
+void InputReplay::start(std::function<void()> onFinished) {
+    this->onFinished = std::move(onFinished);
+    this->next = 0;
+    this->measures.clear();
+
+    // Collect the ink prediction errors (if the prediction is enabled in the settings)
+    PerformanceMonitor* monitor = this->control->getPerformanceMonitor();
+    monitor->clear();
+    monitor->setEnabled(true);
+
+    // The recorded zoom must not be overridden by the window size
+    this->control->getZoomControl()->setZoomFitMode(false);
+
+    // Lower priority than the redraws, so that they are not starved by the replay
+    this->sourceId = g_idle_add_full(G_PRIORITY_DEFAULT_IDLE, xoj::util::wrap_v<replayNext>, this, nullptr);
+}
+
+auto InputReplay::replayNext(InputReplay* self) -> gboolean {
+    if (self->next >= self->recording.events.size()) {
+        self->sourceId = 0;
+        if (self->onFinished) {
+            self->onFinished();
+        }
+        return G_SOURCE_REMOVE;
+    }
+
+    const RecordedInputEvent& recorded = self->recording.events[self->next++];
+
+    self->control->getZoomControl()->setZoom(recorded.zoom);
+    if (recorded.tool != TOOL_NONE && self->control->getToolHandler()->getToolType() != recorded.tool) {
+        self->control->getToolHandler()->selectTool(recorded.tool);
+    }
+
+    InputEvent event = self->toInputEvent(recorded);
+
+    auto begin = std::chrono::steady_clock::now();
+    self->context->dispatchEvent(event);
+    // Measure the processing of each motion event, rather than leaving it to the next frame
+    self->context->processPendingMotions();
+    auto end = std::chrono::steady_clock::now();
+
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+    self->measures.push_back({recorded.type, static_cast<int64_t>(duration.count())});
+    return G_SOURCE_CONTINUE;
+}
+
+auto InputReplay::toInputEvent(const RecordedInputEvent& recorded) const -> InputEvent {
+    InputEvent event;
+    event.sourceEvent = this->sourceEvent;
+    event.type = recorded.type;
+    event.deviceClass = recorded.deviceClass;
+    event.deviceName = recorded.deviceName.c_str();
+    event.deviceId = DeviceId(this->device);
+
+    event.absoluteX = recorded.absoluteX;
+    event.absoluteY = recorded.absoluteY;
+    event.relativeX = recorded.relativeX;
+    event.relativeY = recorded.relativeY;
+
+    event.button = recorded.button;
+    event.state = recorded.state;
+    event.pressure = recorded.pressure;
+
+    // The handlers only compare the sequences: any distinct non null value will do
+    event.sequence = reinterpret_cast<GdkEventSequence*>(static_cast<uintptr_t>(recorded.sequence));
+    event.timestamp = recorded.timestamp;
+
+    return event;
+}
+
+void InputReplay::writeReport(std::ostream& out) const {
+    auto typeName = [](InputEventType type) {
+        switch (type) {
+            case BUTTON_PRESS_EVENT:
+            case BUTTON_2_PRESS_EVENT:
+            case BUTTON_3_PRESS_EVENT:
+                return "press";
+            case BUTTON_RELEASE_EVENT:
+                return "release";
+            case MOTION_EVENT:
+                return "motion";
+            default:
+                return "other";
+        }
+    };
+
+    std::map<std::string, std::vector<int64_t>> durations;
+    for (const Measure& m: this->measures) {
+        durations[typeName(m.type)].push_back(m.duration);
+        durations["all"].push_back(m.duration);
+    }
+
+    out << "type\tcount\ttotal_us\tp50_us\tp90_us\tp99_us\tmax_us\n";
+    for (auto& [name, values]: durations) {
+        std::sort(values.begin(), values.end());
+        // Percentiles without interpolation
+        auto percentile = [&values = values](size_t p) { return values[(values.size() - 1) * p / 100]; };
+
+        int64_t total = 0;
+        for (int64_t v: values) {
+            total += v;
+        }
+        out << name << '\t' << values.size() << '\t' << total << '\t' << percentile(50) << '\t' << percentile(90)
+            << '\t' << percentile(99) << '\t' << values.back() << '\n';
+    }
+
+    if (PerformanceMonitor::ErrorSummary errors = this->control->getPerformanceMonitor()->getPredictionErrors();
+        errors.samples > 0) {
+        // Distance between the predicted and the real tips of the strokes, in document coordinates
+        out << "\nprediction\tcount\tavg_error\tmax_error\n";
+        out << "ink\t" << errors.samples << '\t' << errors.averageError << '\t' << errors.maxError << '\n';
+    }
+
+    if (PerformanceMonitor::TimingSummary times = this->control->getPerformanceMonitor()->getRecognitionTimes();
+        times.samples > 0) {
+        // The shape recognition runs on the scheduler thread, after the release events: it is not part of their time
+        out << "\nrecognition\tcount\tavg_us\tmax_us\n";
+        out << "shape\t" << times.samples << '\t' << static_cast<int64_t>(times.averageMs * 1000) << '\t'
+            << static_cast<int64_t>(times.maxMs * 1000) << '\n';
+    }
+}
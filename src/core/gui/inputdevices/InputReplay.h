@@ -0,0 +1,84 @@
+/*
+ * Xournal++
+ *
+ * Replays an input recording and measures the time spent in the input handlers
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <cstddef>     // for size_t
+#include <cstdint>     // for int64_t
+#include <functional>  // for function
+#include <iosfwd>      // for ostream
+#include <vector>      // for vector
+
+#include <gdk/gdk.h>  // for GdkDevice
+#include <glib.h>     // for gboolean, guint
+
+#include "InputEvents.h"     // for InputEventType, InputEvent, GdkEventGuard
+#include "InputRecording.h"  // for InputRecording
+
+class Control;
+class InputContext;
+
+/**
+ * @brief Feeds a recording back to the InputContext, as fast as possible, and reports the processing time per event.
+ *
+ * The events go through InputContext::dispatchEvent(), i.e. the same input handlers (and tool handlers) as the events
+ * received from GTK. One event is dispatched per main loop iteration, at idle priority, so the page redraws triggered
+ * by an event happen before the next one. Only the time spent in dispatchEvent() is measured.
+ *
+ * The zoom and the tool recorded with the events are restored before dispatching them, so the replay only depends on
+ * the document and on the layout settings. All the recorded devices are mapped to the core pointer device.
+ *
+ * If the ink prediction is enabled, the report also gives its error: the distance between the predicted tips of the
+ * strokes and the real ones. If strokes were drawn with the shape recognizer, it gives the time spent recognizing them.
+ */
+class InputReplay {
+public:
+    InputReplay(Control* control, InputContext* context, InputRecording recording);
+    ~InputReplay();
+
+    InputReplay(const InputReplay&) = delete;
+    InputReplay& operator=(const InputReplay&) = delete;
+
+    /**
+     * @brief Starts replaying. onFinished is called from the main loop once all the events have been dispatched.
+     */
+    void start(std::function<void()> onFinished);
+
+    /**
+     * @brief Writes the number of events, and the percentiles of the processing time per event type, as tab separated
+     * values (times in microseconds).
+     */
+    void writeReport(std::ostream& out) const;
+
+private:
+    static gboolean replayNext(InputReplay* self);
+
+    InputEvent toInputEvent(const RecordedInputEvent& recorded) const;
+
+private:
+    Control* control;
+    InputContext* context;
+    InputRecording recording;
+
+    std::function<void()> onFinished;
+    guint sourceId = 0;
+    size_t next = 0;
+
+    /// Synthetic source event, shared by all the events: the handlers only check that there is one
+    GdkEventGuard sourceEvent;
+    GdkDevice* device = nullptr;
+
+    struct Measure {
+        InputEventType type;
+        int64_t duration;  ///< in microseconds
+    };
+    std::vector<Measure> measures;
+};
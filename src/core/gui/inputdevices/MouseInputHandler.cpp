@@ -26,6 +26,11 @@ auto MouseInputHandler::handleImpl(InputEvent const& event) -> bool {
     // Only handle events when there is no active gesture
     GtkXournal* xournal = inputContext->getXournal();
 
+    // Keep the events in order: the queued motion events go first
+    if (event.type != MOTION_EVENT) {
+        this->processPendingMotions();
+    }
+
     // Determine the pressed states of devices and associate them to the current event
     setPressedState(event);
 
@@ -7,7 +7,8 @@
 #include <algorithm>  // for max, min
 #include <cmath>      // for abs, atan, sqrt
 #include <thread>     // for thread
-#include <utility>    // for move
+#include <utility>    // for move, swap
+#include <vector>     // for vector
 
 #include <glib.h>     // for gdouble, gint, g_message
 #include <gtk/gtk.h>  // for gtk_adjustment_get_value
@@ -19,6 +20,7 @@
 #include "control/tools/EditSelection.h"        // for EditSelection
 #include "gui/Layout.h"                         // for Layout
 #include "gui/PageView.h"                       // for XojPageView
+#include "gui/RepaintHandler.h"                 // for RepaintHandler
 #include "gui/XournalView.h"                    // for XournalView
 #include "gui/XournalppCursor.h"                // for XournalppCursor
 #include "gui/scroll/ScrollHandling.h"          // for ScrollHandling
@@ -27,6 +29,7 @@
 #include "util/Assert.h"                        // for xoj_assert
 #include "util/Point.h"                         // for Point
 #include "util/Util.h"                          // for execInUiThread
+#include "util/glib_casts.h"                    // for wrap_v
 #include "util/safe_casts.h"
 
 #include "AbstractInputHandler.h"  // for AbstractInputHandler
@@ -38,7 +41,11 @@
 
 PenInputHandler::PenInputHandler(InputContext* inputContext): AbstractInputHandler(inputContext) {}
 
-PenInputHandler::~PenInputHandler() = default;
+PenInputHandler::~PenInputHandler() {
+    if (this->motionTickId) {
+        gtk_widget_remove_tick_callback(GTK_WIDGET(this->inputContext->getXournal()), this->motionTickId);
+    }
+}
 
 void PenInputHandler::updateLastEvent(InputEvent const& event) {
     if (!event) {
@@ -264,6 +271,50 @@ bool PenInputHandler::isCurrentTapSelection(InputEvent const& event) const {
 }
 
 auto PenInputHandler::actionMotion(InputEvent const& event) -> bool {
+    if (!this->inputRunning) {
+        processPendingMotions();
+        return processMotion(event);
+    }
+
+    /*
+     * Several motion events can arrive between two frames (high frequency devices). Processing them in one go, right
+     * before the frame is drawn, saves as many round-trips through the tool handlers' repaint requests.
+     * All the events are processed: no point of a stroke is dropped.
+     */
+    this->pendingMotions.push_back(event);
+    if (!this->motionTickId) {
+        this->motionTickId = gtk_widget_add_tick_callback(GTK_WIDGET(this->inputContext->getXournal()),
+                                                          xoj::util::wrap_v<motionTickCallback>, this, nullptr);
+    }
+    return true;
+}
+
+auto PenInputHandler::motionTickCallback(GtkWidget*, GdkFrameClock*, PenInputHandler* self) -> bool {
+    self->motionTickId = 0;
+    self->processPendingMotions();
+    return false;
+}
+
+void PenInputHandler::processPendingMotions() {
+    if (this->pendingMotions.empty()) {
+        return;
+    }
+    if (this->motionTickId) {
+        gtk_widget_remove_tick_callback(GTK_WIDGET(this->inputContext->getXournal()), this->motionTickId);
+        this->motionTickId = 0;
+    }
+
+    std::vector<InputEvent> events;
+    std::swap(events, this->pendingMotions);
+
+    for (const InputEvent& event: events) {
+        processMotion(event);
+    }
+    // Invalidate the new ink in this frame, rather than on the next tick
+    this->inputContext->getView()->getRepaintHandler()->flush();
+}
+
+auto PenInputHandler::processMotion(InputEvent const& event) -> bool {
     /*
      * Workaround for misbehaving devices where Enter events are not published every time
      * This is required to disable outside scrolling again
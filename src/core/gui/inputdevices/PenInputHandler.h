@@ -11,6 +11,12 @@
 
 #pragma once
 
+#include <vector>  // for vector
+
+#include <gdk/gdk.h>  // for GdkFrameClock
+#include <glib.h>     // for guint
+#include <gtk/gtk.h>  // for GtkWidget
+
 #include "gui/inputdevices/InputEvents.h"  // for InputEvent
 #include "util/Point.h"
 
@@ -84,10 +90,22 @@ protected:
     guint32 lastActionStartTimeStamp = 0U;
     xoj::util::Point<double> sequenceStartPosition;
 
+    /**
+     * Motion events received while an input is running. They are processed as a batch on the next frame clock tick.
+     */
+    std::vector<InputEvent> pendingMotions;
+    guint motionTickId = 0;
+
 public:
     explicit PenInputHandler(InputContext* inputContext);
     ~PenInputHandler() override;
 
+    /**
+     * @brief Processes the queued motion events now, in order, with a single repaint of the union of their dirty
+     * regions. Any other event of the device must only be handled after this, so that the events stay in order.
+     */
+    void processPendingMotions();
+
 protected:
     /**
      * Action for the start of an input
@@ -96,11 +114,17 @@ protected:
     bool actionStart(InputEvent const& event);
 
     /**
-     * Action for motion during an input
+     * Action for motion during an input.
+     * While an input is running, the event is queued until the next frame (see processPendingMotions())
      * @param event The event triggering the action
      */
     bool actionMotion(InputEvent const& event);
 
+    /**
+     * Processes a motion event immediately
+     */
+    bool processMotion(InputEvent const& event);
+
     /**
      * Action for a discrete input.
      */
@@ -161,4 +185,7 @@ protected:
      * rather than drawing
      */
     bool isCurrentTapSelection(InputEvent const& event) const;
+
+private:
+    static bool motionTickCallback(GtkWidget* widget, GdkFrameClock* clock, PenInputHandler* self);
 };
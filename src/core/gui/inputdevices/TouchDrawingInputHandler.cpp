@@ -42,6 +42,11 @@ auto TouchDrawingInputHandler::handleImpl(InputEvent const& event) -> bool {
     auto* mainWindow = inputContext->getView()->getControl()->getWindow();
     ToolHandler* toolHandler = this->inputContext->getToolHandler();
 
+    // Keep the events in order: the queued motion events go first
+    if (event.type != MOTION_EVENT) {
+        this->processPendingMotions();
+    }
+
     // Do we need to end the touch sequence?
     bool mustEnd = event.type == BUTTON_RELEASE_EVENT;
     mustEnd = mustEnd || (event.type == GRAB_BROKEN_EVENT && this->deviceClassPressed);
@@ -1,107 +1,71 @@
 #include "SidebarLayout.h"
 
-#include <algorithm>  // for max
-#include <vector>     // for vector
+#include <algorithm>  // for max, partition_point
 
-#include <gtk/gtk.h>  // for GTK_FIXED, gtk_fixed_move
+#include <gtk/gtk.h>  // for GTK_FIXED, gtk_widget_set_size_request
 
 #include "util/gtk4_helper.h"
-#include "util/safe_casts.h"  // for as_unsigned
 
-#include "SidebarPreviewBase.h"       // for SidebarPreviewBase
-#include "SidebarPreviewBaseEntry.h"  // for SidebarPreviewBaseEntry
+#include "SidebarPreviewBase.h"  // for SidebarPreviewBase
 
-class SidebarRow {
-public:
-    explicit SidebarRow(int width) {
-        this->width = width;
-        this->currentWidth = 0;
-    }
+auto SidebarLayout::computeLayout(const std::vector<EntrySize>& sizes, int sidebarWidth) -> Layout {
+    Layout result;
+    result.positions.reserve(sizes.size());
 
-    ~SidebarRow() { clear(); }
+    size_t rowBegin = 0;
+    int y = 0;
 
+    auto placeRow = [&](size_t rowEnd) {
+        int height = 0;
+        for (size_t i = rowBegin; i < rowEnd; i++) { height = std::max(height, sizes[i].height); }
 
-    auto isSpaceFor(SidebarPreviewBaseEntry* p) -> bool {
-        if (this->list.empty()) {
-            return true;
+        int x = 0;
+        for (size_t i = rowBegin; i < rowEnd; i++) {
+            int currentY = (height - sizes[i].height) / 2;
+            result.positions.emplace_back(x, y + currentY, sizes[i].width, sizes[i].height);
+            x += sizes[i].width;
         }
 
-        if (this->currentWidth + p->getWidth() < width) {
-            return true;
+        result.rows.push_back({rowBegin, y, height});
+        result.width = std::max(result.width, x);
+        y += height;
+        rowBegin = rowEnd;
+    };
+
+    int currentWidth = 0;
+    for (size_t i = 0; i < sizes.size(); i++) {
+        // A row always takes at least one entry
+        if (i != rowBegin && currentWidth + sizes[i].width >= sidebarWidth) {
+            placeRow(i);
+            currentWidth = 0;
         }
-        return false;
+        currentWidth += sizes[i].width;
     }
-
-    void add(SidebarPreviewBaseEntry* p) {
-        this->list.push_back(p);
-        this->currentWidth += p->getWidth();
-    }
-
-    void clear() {
-        this->list.clear();
-        this->currentWidth = 0;
+    if (rowBegin != sizes.size()) {
+        placeRow(sizes.size());
     }
 
-    auto getCount() -> size_t { return this->list.size(); }
-
-    auto getWidth() const -> int { return this->currentWidth; }
-
-    auto placeAt(int y, GtkFixed* layout) -> int {
-        int height = 0;
-        int x = 0;
-
-        for (SidebarPreviewBaseEntry* p: this->list) { height = std::max(height, p->getHeight()); }
-
-
-        for (SidebarPreviewBaseEntry* p: this->list) {
-            int currentY = (height - p->getHeight()) / 2;
-
-            gtk_fixed_move(layout, p->getWidget(), x, y + currentY);
-
-            x += p->getWidth();
-        }
-
-
-        return height;
-    }
+    result.height = y;
+    return result;
+}
 
-private:
-    int width;
-    int currentWidth;
+auto SidebarLayout::Layout::entriesBetween(double top, double bottom) const -> std::pair<size_t, size_t> {
+    auto firstRow =
+            std::partition_point(rows.begin(), rows.end(), [top](const Row& r) { return r.y + r.height <= top; });
+    auto lastRow = std::partition_point(firstRow, rows.end(), [bottom](const Row& r) { return r.y < bottom; });
 
-    std::vector<SidebarPreviewBaseEntry*> list;
-};
+    size_t first = firstRow == rows.end() ? positions.size() : firstRow->firstEntry;
+    size_t last = lastRow == rows.end() ? positions.size() : lastRow->firstEntry;
+    return {first, std::max(first, last)};
+}
 
 void SidebarLayout::layout(SidebarPreviewBase* sidebar) {
-    int y = 0;
-    int width = 0;
-
     int sidebarWidth = gtk_widget_get_width(sidebar->scrollableBox.get());
 
-    SidebarRow row(sidebarWidth);
-    GtkFixed* w = sidebar->miniaturesContainer.get();
+    sidebar->entryLayout = computeLayout(sidebar->getEntrySizes(), sidebarWidth);
 
-    for (auto& p: sidebar->previews) {
-        if (row.isSpaceFor(p.get())) {
-            row.add(p.get());
-        } else {
-            y += row.placeAt(y, w);
-
-            width = std::max(width, row.getWidth());
-
-            row.clear();
-            row.add(p.get());
-        }
-    }
-
-    if (row.getCount() != 0) {
-        y += row.placeAt(y, w);
-
-        width = std::max(width, row.getWidth());
-
-        row.clear();
-    }
+    GtkWidget* w = GTK_WIDGET(sidebar->miniaturesContainer.get());
+    gtk_widget_set_size_request(w, sidebar->entryLayout.width, sidebar->entryLayout.height);
 
-    gtk_widget_set_size_request(GTK_WIDGET(w), width, y);
-    gtk_widget_show_all(GTK_WIDGET(w));
+    sidebar->updateVisibleEntries();
 }
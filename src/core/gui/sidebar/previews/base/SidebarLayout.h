@@ -11,6 +11,12 @@
 
 #pragma once
 
+#include <cstddef>  // for size_t
+#include <utility>  // for pair
+#include <vector>   // for vector
+
+#include "util/Rectangle.h"  // for Rectangle
+
 class SidebarPreviewBase;
 
 class SidebarLayout {
@@ -19,6 +25,38 @@ public:
     ~SidebarLayout() = delete;
 
 public:
+    struct EntrySize {
+        int width;
+        int height;
+    };
+
+    /**
+     * Positions of the entries, computed from their sizes only
+     */
+    struct Layout {
+        struct Row {
+            size_t firstEntry;
+            int y;
+            int height;
+        };
+
+        /// One rectangle per entry, in the coordinates of the miniatures container
+        std::vector<xoj::util::Rectangle<int>> positions;
+        std::vector<Row> rows;
+        int width = 0;
+        int height = 0;
+
+        /**
+         * @return The range [first, last) of the entries whose row intersects the band [top, bottom)
+         */
+        std::pair<size_t, size_t> entriesBetween(double top, double bottom) const;
+    };
+
+    /**
+     * Places the entries in rows fitting in the given width
+     */
+    static Layout computeLayout(const std::vector<EntrySize>& sizes, int sidebarWidth);
+
     /**
      * Layouts the sidebar
      */
@@ -1,6 +1,8 @@
 #include "SidebarPreviewBase.h"
 
-#include <cstdlib>  // for abs, size_t
+#include <algorithm>  // for min
+#include <cstdlib>    // for abs, size_t
+#include <utility>    // for move
 
 #include <glib-object.h>  // for g_object_ref, G_CALLBACK, g_sig...
 #include <glib.h>         // for g_idle_add
@@ -19,11 +21,18 @@
 
 constexpr auto XML_FILE = "sidebar.ui";
 
+/// Height used to decide which entries to instantiate, before the scrollable area gets its size
+constexpr double DEFAULT_VIEW_HEIGHT = 1000;
+
+/// Number of rendered buffers kept for the entries which are not instantiated
+constexpr size_t BUFFER_CACHE_SIZE = 128;
+
 SidebarPreviewBase::SidebarPreviewBase(Control* control, const char* menuId, const char* toolbarId):
         AbstractSidebarPage(control),
         scrollableBox(gtk_scrolled_window_new(), xoj::util::adopt),
         mainBox(gtk_box_new(GTK_ORIENTATION_VERTICAL, 0), xoj::util::adopt),
-        miniaturesContainer(GTK_FIXED(gtk_fixed_new()), xoj::util::adopt) {
+        miniaturesContainer(GTK_FIXED(gtk_fixed_new()), xoj::util::adopt),
+        bufferCache(BUFFER_CACHE_SIZE) {
     gtk_box_append(GTK_BOX(mainBox.get()), scrollableBox.get());
     gtk_scrolled_window_set_policy(GTK_SCROLLED_WINDOW(scrollableBox.get()), GTK_POLICY_AUTOMATIC,
                                    GTK_POLICY_AUTOMATIC);
@@ -48,6 +57,16 @@ SidebarPreviewBase::SidebarPreviewBase(Control* control, const char* menuId, con
             }),
             this);
 
+    auto* vadj = gtk_scrolled_window_get_vadjustment(GTK_SCROLLED_WINDOW(scrollableBox.get()));
+    g_signal_connect(vadj, "value-changed", G_CALLBACK(+[](GtkAdjustment*, gpointer d) {
+                         static_cast<SidebarPreviewBase*>(d)->updateVisibleEntries();
+                     }),
+                     this);
+    g_signal_connect(vadj, "notify::page-size", G_CALLBACK(+[](GObject*, GParamSpec*, gpointer d) {
+                         static_cast<SidebarPreviewBase*>(d)->updateVisibleEntries();
+                     }),
+                     this);
+
     Builder builder(control->getGladeSearchPath(), XML_FILE);
     GMenuModel* menu = G_MENU_MODEL(builder.get<GObject>(menuId));
     contextMenu.reset(GTK_MENU(gtk_menu_new_from_model(menu)), xoj::util::adopt);
@@ -58,7 +77,14 @@ SidebarPreviewBase::SidebarPreviewBase(Control* control, const char* menuId, con
     gtk_widget_show_all(mainBox.get());
 }
 
-SidebarPreviewBase::~SidebarPreviewBase() { this->control->removeChangedDocumentListener(this); }
+SidebarPreviewBase::~SidebarPreviewBase() {
+    this->control->removeChangedDocumentListener(this);
+
+    // The entries are destroyed after this: removing their widgets must not instantiate other entries
+    auto* scrolledWindow = GTK_SCROLLED_WINDOW(scrollableBox.get());
+    g_signal_handlers_disconnect_by_data(gtk_scrolled_window_get_hadjustment(scrolledWindow), this);
+    g_signal_handlers_disconnect_by_data(gtk_scrolled_window_get_vadjustment(scrolledWindow), this);
+}
 
 void SidebarPreviewBase::enableSidebar() { enabled = true; }
 
@@ -79,6 +105,60 @@ auto SidebarPreviewBase::getCache() -> PdfCache* { return this->cache.get(); }
 
 void SidebarPreviewBase::layout() { SidebarLayout::layout(this); }
 
+void SidebarPreviewBase::updateVisibleEntries() {
+    GtkAdjustment* vadj = gtk_scrolled_window_get_vadjustment(GTK_SCROLLED_WINDOW(scrollableBox.get()));
+    double top = gtk_adjustment_get_value(vadj);
+    double viewHeight = gtk_adjustment_get_page_size(vadj);
+    if (viewHeight <= 0) {
+        viewHeight = DEFAULT_VIEW_HEIGHT;
+    }
+
+    // Keep one screen above and below instantiated, so that scrolling does not show empty space
+    auto [first, last] = entryLayout.entriesBetween(top - viewHeight, top + 2 * viewHeight);
+    last = std::min(last, previews.size());
+
+    for (size_t i = 0; i < previews.size(); i++) {
+        auto& p = previews[i];
+        if (i < first || i >= last) {
+            if (p) {
+                if (auto buffer = p->takeBuffer()) {
+                    bufferCache.put(i, std::move(buffer));
+                }
+                p.reset();
+            }
+            continue;
+        }
+
+        const auto& pos = entryLayout.positions[i];
+        if (p) {
+            gtk_fixed_move(miniaturesContainer.get(), p->getWidget(), pos.x, pos.y);
+            continue;
+        }
+
+        p = createEntry(i);
+        if (auto buffer = bufferCache.take(i)) {
+            p->setBuffer(std::move(*buffer));
+        }
+        p->setSelected(i == selectedEntry);
+        gtk_fixed_put(miniaturesContainer.get(), p->getWidget(), pos.x, pos.y);
+        gtk_widget_show_all(p->getWidget());
+    }
+}
+
+void SidebarPreviewBase::resetPreviews(size_t count) {
+    this->previews.clear();
+    this->previews.resize(count);
+    this->bufferCache.clear();
+}
+
+void SidebarPreviewBase::invalidatePreview(size_t index) {
+    if (auto& p = this->previews[index]) {
+        p->repaint();
+    } else {
+        this->bufferCache.erase(index);
+    }
+}
+
 auto SidebarPreviewBase::hasData() -> bool { return true; }
 
 auto SidebarPreviewBase::getWidget() -> GtkWidget* { return this->mainBox.get(); }
@@ -112,24 +192,19 @@ auto SidebarPreviewBase::scrollToPreview(SidebarPreviewBase* sidebar) -> bool {
         return false;
     }
 
-    if (sidebar->selectedEntry != npos && sidebar->selectedEntry < sidebar->previews.size()) {
-        auto& p = sidebar->previews[sidebar->selectedEntry];
+    if (sidebar->selectedEntry != npos && sidebar->selectedEntry < sidebar->entryLayout.positions.size()) {
+        const auto& pos = sidebar->entryLayout.positions[sidebar->selectedEntry];
 
         // scroll to preview
         GtkAdjustment* vadj = gtk_scrolled_window_get_vadjustment(GTK_SCROLLED_WINDOW(sidebar->scrollableBox.get()));
-        GtkWidget* widget = p->getWidget();
-
-        GtkAllocation allocation;
-        gtk_widget_get_allocation(widget, &allocation);
-        int x = allocation.x;
-        int y = allocation.y;
 
-        if (x == -1) {
+        if (gtk_adjustment_get_upper(vadj) < pos.y + pos.height) {
+            // The miniatures container did not get its new size yet
             g_idle_add(xoj::util::wrap_for_once_v<scrollToPreview>, sidebar);
             return false;
         }
 
-        gtk_adjustment_clamp_page(vadj, y, y + allocation.height);
+        gtk_adjustment_clamp_page(vadj, pos.y, pos.y + pos.height);
     }
     return false;
 }
@@ -19,11 +19,14 @@
 
 #include "gui/sidebar/AbstractSidebarPage.h"  // for AbstractSidebarPage
 #include "model/DocumentChangeType.h"         // for DocumentChangeType
+#include "util/LruCache.h"                    // for LruCache
 #include "util/Util.h"
+#include "util/raii/CairoWrappers.h"
 #include "util/raii/GObjectSPtr.h"
 
+#include "SidebarLayout.h"  // for SidebarLayout
+
 class PdfCache;
-class SidebarLayout;
 class SidebarPreviewBaseEntry;
 class Control;
 
@@ -81,6 +84,33 @@ protected:
     /// The width of the sidebar has changed
     void newWidth(double width);
 
+    /**
+     * @return The size of every entry, without instantiating them
+     */
+    virtual std::vector<SidebarLayout::EntrySize> getEntrySizes() const = 0;
+
+    /**
+     * Creates the widget of the entry at the given index, once it scrolls into view.
+     * The caller puts it in the miniatures container.
+     */
+    virtual std::unique_ptr<SidebarPreviewBaseEntry> createEntry(size_t index) = 0;
+
+    /**
+     * Instantiates the entries in (or close to) the visible part of the scrollable area and destroys the others.
+     * The rendered buffers of the destroyed entries are kept in the buffer cache.
+     */
+    void updateVisibleEntries();
+
+    /**
+     * Replaces the preview slots by `count` empty ones and forgets the cached buffers
+     */
+    void resetPreviews(size_t count);
+
+    /**
+     * The content of the entry changed: repaints it if it exists, otherwise drops its cached buffer
+     */
+    void invalidatePreview(size_t index);
+
 public:
     /**
      * Opens a context menu, at the current cursor position.
@@ -101,6 +131,9 @@ private:
      */
     std::unique_ptr<PdfCache> cache;
 
+    /// Positions of the entries, computed by SidebarLayout
+    SidebarLayout::Layout entryLayout;
+
 protected:
     /// The scrollable area with the miniatures
     xoj::util::WidgetSPtr scrollableBox;
@@ -125,10 +158,16 @@ protected:
     size_t selectedEntry = npos;
 
     /**
-     * The previews
+     * The previews: one slot per entry, which is nullptr while the entry is not in or close to the visible area
      */
     std::vector<std::unique_ptr<SidebarPreviewBaseEntry>> previews;
 
+    /**
+     * Rendered buffers of the entries which scrolled out of view, by entry index.
+     * Must be cleared when the entries are reordered.
+     */
+    xoj::util::LruCache<size_t, xoj::util::CairoSurfaceSPtr> bufferCache;
+
     /**
      * The sidebar is enabled
      */
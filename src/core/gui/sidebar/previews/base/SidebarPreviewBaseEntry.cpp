@@ -1,5 +1,8 @@
 #include "SidebarPreviewBaseEntry.h"
 
+#include <tuple>    // for tie
+#include <utility>  // for move
+
 #include <gdk/gdk.h>      // for GdkEvent, GDK_BUTTON_PRESS
 #include <glib-object.h>  // for G_CALLBACK, g_object_ref
 #include <gtk/gtk.h>      //
@@ -67,6 +70,7 @@ void SidebarPreviewBaseEntry::setSelected(bool selected) {
 void SidebarPreviewBaseEntry::repaint() { sidebar->getControl()->getScheduler()->addRepaintSidebar(this); }
 
 void SidebarPreviewBaseEntry::drawLoadingPage() {
+    this->bufferRendered = false;
     this->buffer.reset(cairo_image_surface_create(CAIRO_FORMAT_ARGB32, imageWidth, imageHeight), xoj::util::adopt);
 
     double zoom = sidebar->getZoom();
@@ -140,11 +144,34 @@ void SidebarPreviewBaseEntry::paint(cairo_t* cr) {
 void SidebarPreviewBaseEntry::updateSize() {
     this->DPIscaling = gtk_widget_get_scale_factor(this->button.get());
 
+    std::tie(this->imageWidth, this->imageHeight) = getImageSize(page, sidebar->getZoom());
+    gtk_widget_set_size_request(this->button.get(), imageWidth, imageHeight);
+}
+
+auto SidebarPreviewBaseEntry::getImageSize(const PageRef& page, double zoom) -> std::pair<int, int> {
     const int shadowPadding = Shadow::getShadowBottomRightSize() + Shadow::getShadowTopLeftSize() + 4;
     // To avoid having a black line, we use floor rather than ceil
-    this->imageWidth = floor_cast<int>(page->getWidth() * sidebar->getZoom()) + shadowPadding;
-    this->imageHeight = floor_cast<int>(page->getHeight() * sidebar->getZoom()) + shadowPadding;
-    gtk_widget_set_size_request(this->button.get(), imageWidth, imageHeight);
+    return {floor_cast<int>(page->getWidth() * zoom) + shadowPadding,
+            floor_cast<int>(page->getHeight() * zoom) + shadowPadding};
+}
+
+auto SidebarPreviewBaseEntry::takeBuffer() -> xoj::util::CairoSurfaceSPtr {
+    std::lock_guard lock(this->drawingMutex);
+    if (!this->bufferRendered) {
+        return nullptr;
+    }
+    this->bufferRendered = false;
+    return std::move(this->buffer);
+}
+
+void SidebarPreviewBaseEntry::setBuffer(xoj::util::CairoSurfaceSPtr buffer) {
+    if (cairo_image_surface_get_width(buffer.get()) != imageWidth * DPIscaling ||
+        cairo_image_surface_get_height(buffer.get()) != imageHeight * DPIscaling) {
+        return;
+    }
+    std::lock_guard lock(this->drawingMutex);
+    this->buffer = std::move(buffer);
+    this->bufferRendered = true;
 }
 
 auto SidebarPreviewBaseEntry::getWidget() const -> GtkWidget* { return this->button.get(); }
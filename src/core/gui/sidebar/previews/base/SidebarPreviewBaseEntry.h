@@ -11,7 +11,8 @@
 
 #pragma once
 
-#include <mutex>  // for mutex
+#include <mutex>    // for mutex
+#include <utility>  // for pair
 
 #include <cairo.h>    // for cairo_t, cairo_surface_t
 #include <glib.h>     // for gboolean
@@ -56,6 +57,22 @@ public:
     virtual void repaint();
     virtual void updateSize();
 
+    /**
+     * Removes the rendered preview from this entry, e.g. to keep it after the entry is destroyed
+     * @return The preview, or nullptr if it was not rendered yet
+     */
+    xoj::util::CairoSurfaceSPtr takeBuffer();
+
+    /**
+     * Shows a preview rendered for another instance of this entry. It is ignored if its size does not match.
+     */
+    void setBuffer(xoj::util::CairoSurfaceSPtr buffer);
+
+    /**
+     * @return The size of the preview image of the page, including the shadow
+     */
+    static std::pair<int, int> getImageSize(const PageRef& page, double zoom);
+
     /**
      * @return What should be rendered
      */
@@ -96,6 +113,9 @@ protected:
     /// Buffer because of performance reasons
     xoj::util::CairoSurfaceSPtr buffer;
 
+    /// The buffer contains the rendered preview (and not the "Loading..." placeholder)
+    bool bufferRendered = false;
+
     /// The main widget, containing the miniature
     xoj::util::WidgetSPtr button;
 
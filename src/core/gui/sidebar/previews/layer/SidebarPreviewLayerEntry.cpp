@@ -35,8 +35,6 @@ SidebarPreviewLayerEntry::SidebarPreviewLayerEntry(SidebarPreviewLayers* sidebar
             this);
     gtk_widget_set_margin_start(cbVisible, Shadow::getShadowTopLeftSize());
 
-    // This doesn't really do it. gtk_widget_get_allocated_height() always returns 1...
-    toolbarHeight = gtk_widget_get_allocated_height(cbVisible) + Shadow::getShadowTopLeftSize() + 20;
     gtk_box_append(GTK_BOX(box.get()), this->button.get());
     gtk_box_append(GTK_BOX(box.get()), cbVisible);
 
@@ -56,7 +54,12 @@ auto SidebarPreviewLayerEntry::getRenderType() const -> PreviewRenderType {
     return stacked ? RENDER_TYPE_PAGE_LAYERSTACK : RENDER_TYPE_PAGE_LAYER;
 }
 
-auto SidebarPreviewLayerEntry::getHeight() const -> int { return imageHeight + toolbarHeight; }
+auto SidebarPreviewLayerEntry::getHeight() const -> int { return imageHeight + getToolbarHeight(); }
+
+auto SidebarPreviewLayerEntry::getToolbarHeight() -> int {
+    // The layout is computed before the checkbox is allocated, so its height cannot be queried: use a fixed estimate
+    return Shadow::getShadowTopLeftSize() + 21;
+}
 
 auto SidebarPreviewLayerEntry::getLayer() const -> Layer::Index { return layerId; }
 
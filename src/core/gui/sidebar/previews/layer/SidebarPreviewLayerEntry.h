@@ -32,6 +32,11 @@ public:
 public:
     int getHeight() const override;
 
+    /**
+     * @return The height of the controls below the preview
+     */
+    static int getToolbarHeight();
+
     /**
      * @return What should be rendered
      * @override
@@ -60,11 +65,6 @@ private:
     /// Layer to render
     Layer::Index layerId;
 
-    /**
-     * Toolbar with controls
-     */
-    int toolbarHeight = 0;
-
     /// Container box for the preview and the button
     xoj::util::WidgetSPtr box;
 
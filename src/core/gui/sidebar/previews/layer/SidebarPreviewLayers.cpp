@@ -1,9 +1,7 @@
 #include "SidebarPreviewLayers.h"
 
-#include <algorithm>  // for max
-#include <vector>     // for vector
-
-#include <gtk/gtk.h>  // for gtk...
+#include <memory>  // for unique_ptr, make_unique
+#include <vector>  // for vector
 
 #include "control/Control.h"                                    // for Con...
 #include "control/layer/LayerController.h"                      // for Lay...
@@ -55,7 +53,7 @@ void SidebarPreviewLayers::pageChanged(size_t page) {
     }
 
     // Repaint all layer
-    for (auto& p: this->previews) { p->repaint(); }
+    for (size_t i = 0; i < this->previews.size(); i++) { invalidatePreview(i); }
 }
 
 void SidebarPreviewLayers::updatePreviews() {
@@ -63,30 +61,45 @@ void SidebarPreviewLayers::updatePreviews() {
         return;
     }
 
-    // clear old previews
-    this->previews.clear();
     this->selectedEntry = npos;
 
     PageRef page = lc->getCurrentPage();
     if (!page) {
+        resetPreviews(0);
         return;
     }
 
-    auto layerCount = page->getLayerCount();
-
-    for (auto i = layerCount + 1; i != 0;) {
-        --i;
-        std::string name = lc->getLayerNameById(i);
-        auto p = std::make_unique<SidebarPreviewLayerEntry>(this, page, i, name, this->stacked);
-        gtk_fixed_put(this->miniaturesContainer.get(), p->getWidget(), 0, 0);
-        this->previews.emplace_back(std::move(p));
-    }
+    // One entry per layer, and the background
+    resetPreviews(page->getLayerCount() + 1);
 
     layout();
     updateSelectedLayer();
     layerVisibilityChanged();
 }
 
+auto SidebarPreviewLayers::getEntrySizes() const -> std::vector<SidebarLayout::EntrySize> {
+    PageRef page = lc->getCurrentPage();
+    if (!page) {
+        return {};
+    }
+
+    // All entries show the same page
+    auto [width, height] = SidebarPreviewBaseEntry::getImageSize(page, getZoom());
+    return std::vector<SidebarLayout::EntrySize>(this->previews.size(),
+                                                 {width, height + SidebarPreviewLayerEntry::getToolbarHeight()});
+}
+
+auto SidebarPreviewLayers::createEntry(size_t index) -> std::unique_ptr<SidebarPreviewBaseEntry> {
+    PageRef page = lc->getCurrentPage();
+
+    // Layers are in reverse order (top index: 0, but bottom preview is 0)
+    Layer::Index layerId = this->previews.size() - index - 1;
+    auto p = std::make_unique<SidebarPreviewLayerEntry>(this, page, layerId, lc->getLayerNameById(layerId),
+                                                        this->stacked);
+    p->setVisibleCheckbox(page->isLayerVisible(layerId));
+    return p;
+}
+
 void SidebarPreviewLayers::rebuildLayerMenu() {
     if (!enabled) {
         return;
@@ -103,7 +116,10 @@ void SidebarPreviewLayers::layerVisibilityChanged() {
 
     Layer::Index i = p->getLayerCount();
     for (auto& e: this->previews) {
-        dynamic_cast<SidebarPreviewLayerEntry*>(e.get())->setVisibleCheckbox(p->isLayerVisible(i--));
+        if (e) {
+            dynamic_cast<SidebarPreviewLayerEntry*>(e.get())->setVisibleCheckbox(p->isLayerVisible(i));
+        }
+        i--;
     }
     updateSelectedLayer();
 }
@@ -116,14 +132,17 @@ void SidebarPreviewLayers::updateSelectedLayer() {
         return;
     }
 
-    if (this->selectedEntry != npos && this->selectedEntry < this->previews.size()) {
+    if (this->selectedEntry != npos && this->selectedEntry < this->previews.size() &&
+        this->previews[this->selectedEntry]) {
         this->previews[this->selectedEntry]->setSelected(false);
     }
 
     this->selectedEntry = entryIndex;
     if (this->selectedEntry != npos && this->selectedEntry < this->previews.size()) {
-        auto& p = this->previews[this->selectedEntry];
-        p->setSelected(true);
+        // An entry which is not instantiated is selected on creation
+        if (auto& p = this->previews[this->selectedEntry]) {
+            p->setSelected(true);
+        }
         scrollToPreview(this);
     }
 }
@@ -12,8 +12,9 @@
 #pragma once
 
 #include <cstddef>  // for size_t
-#include <memory>   // for shared_ptr
+#include <memory>   // for shared_ptr, unique_ptr
 #include <string>   // for string
+#include <vector>   // for vector
 
 #include "control/layer/LayerCtrlListener.h"               // for LayerCtrlL...
 #include "gui/IconNameHelper.h"                            // for IconNameHe...
@@ -71,6 +72,10 @@ public:
     void pageSizeChanged(size_t page) override;
     void pageChanged(size_t page) override;
 
+protected:
+    std::vector<SidebarLayout::EntrySize> getEntrySizes() const override;
+    std::unique_ptr<SidebarPreviewBaseEntry> createEntry(size_t index) override;
+
 private:
     /**
      * Layer Controller
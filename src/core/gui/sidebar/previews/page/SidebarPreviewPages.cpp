@@ -1,13 +1,14 @@
 #include "SidebarPreviewPages.h"
 
-#include <algorithm>  // for max
-#include <map>        // for map
+#include <algorithm>  // for min
 #include <memory>     // for uniqu...
-#include <utility>    // for pair
+#include <vector>     // for vector
 
 #include <glib-object.h>  // for g_obj...
 
 #include "control/Control.h"                                    // for Control
+#include "control/settings/Settings.h"                          // for Settings
+#include "gui/PagePreviewDecoration.h"                          // for PagePreviewDecoration
 #include "gui/sidebar/previews/base/SidebarPreviewBaseEntry.h"  // for Sideb...
 #include "model/Document.h"                                     // for Document
 #include "model/PageRef.h"                                      // for PageRef
@@ -38,28 +39,52 @@ auto SidebarPreviewPages::getName() -> std::string { return _("Page Preview"); }
 auto SidebarPreviewPages::getIconName() -> std::string { return this->iconNameHelper.iconName("sidebar-page-preview"); }
 
 void SidebarPreviewPages::updatePreviews() {
-    this->previews.clear();
-
     Document* doc = this->getControl()->getDocument();
     doc->lock();
     size_t len = doc->getPageCount();
+    doc->unlock();
+
+    resetPreviews(len);
+    layout();
+}
+
+auto SidebarPreviewPages::getEntrySizes() const -> std::vector<SidebarLayout::EntrySize> {
+    int extraHeight = 0;
+    if (control->getSettings()->getSidebarNumberingStyle() == SidebarNumberingStyle::NUMBER_BELOW_PREVIEW) {
+        extraHeight = PagePreviewDecoration::MARGIN_BOTTOM;
+    }
+
+    std::vector<SidebarLayout::EntrySize> sizes;
+    Document* doc = control->getDocument();
+    doc->lock();
+    size_t len = std::min(doc->getPageCount(), this->previews.size());
+    sizes.reserve(len);
     for (size_t i = 0; i < len; i++) {
-        auto p = std::make_unique<SidebarPreviewPageEntry>(this, doc->getPage(i), i);
-        gtk_fixed_put(this->miniaturesContainer.get(), p->getWidget(), 0, 0);
-        this->previews.emplace_back(std::move(p));
+        auto [width, height] = SidebarPreviewBaseEntry::getImageSize(doc->getPage(i), getZoom());
+        sizes.push_back({width, height + extraHeight});
     }
     doc->unlock();
 
-    layout();
+    return sizes;
+}
+
+auto SidebarPreviewPages::createEntry(size_t index) -> std::unique_ptr<SidebarPreviewBaseEntry> {
+    Document* doc = control->getDocument();
+    doc->lock();
+    PageRef page = doc->getPage(index);
+    doc->unlock();
+
+    return std::make_unique<SidebarPreviewPageEntry>(this, page, index);
 }
 
 void SidebarPreviewPages::pageSizeChanged(size_t page) {
     if (page == npos || page >= this->previews.size()) {
         return;
     }
-    auto& p = this->previews[page];
-    p->updateSize();
-    p->repaint();
+    if (auto& p = this->previews[page]) {
+        p->updateSize();
+    }
+    invalidatePreview(page);
 
     layout();
 }
@@ -69,8 +94,7 @@ void SidebarPreviewPages::pageChanged(size_t page) {
         return;
     }
 
-    auto& p = this->previews[page];
-    p->repaint();
+    invalidatePreview(page);
 }
 
 void SidebarPreviewPages::pageDeleted(size_t page) {
@@ -79,6 +103,8 @@ void SidebarPreviewPages::pageDeleted(size_t page) {
     }
 
     previews.erase(previews.begin() + as_signed(page));
+    // The cached buffers are stored by index
+    bufferCache.clear();
 
     // Unselect page, to prevent double selection displaying
     unselectPage();
@@ -89,15 +115,14 @@ void SidebarPreviewPages::pageDeleted(size_t page) {
 }
 
 void SidebarPreviewPages::pageInserted(size_t page) {
-    Document* doc = control->getDocument();
-    doc->lock();
-
-    auto p = std::make_unique<SidebarPreviewPageEntry>(this, doc->getPage(page), page);
-
-    doc->unlock();
+    if (page > previews.size()) {
+        return;
+    }
 
-    gtk_fixed_put(this->miniaturesContainer.get(), p->getWidget(), 0, 0);
-    this->previews.insert(this->previews.begin() + as_signed(page), std::move(p));
+    // The entry is created by the layout, if it is visible
+    this->previews.insert(this->previews.begin() + as_signed(page), nullptr);
+    // The cached buffers are stored by index
+    bufferCache.clear();
 
     // Unselect page, to prevent double selection displaying
     unselectPage();
@@ -112,12 +137,15 @@ void SidebarPreviewPages::pageInserted(size_t page) {
  */
 void SidebarPreviewPages::unselectPage() {
     for (auto& p: this->previews) {
-        p->setSelected(false);
+        if (p) {
+            p->setSelected(false);
+        }
     }
 }
 
 void SidebarPreviewPages::pageSelected(size_t page) {
-    if (this->selectedEntry != npos && this->selectedEntry < this->previews.size()) {
+    if (this->selectedEntry != npos && this->selectedEntry < this->previews.size() &&
+        this->previews[this->selectedEntry]) {
         this->previews[this->selectedEntry]->setSelected(false);
     }
     this->selectedEntry = page;
@@ -127,15 +155,18 @@ void SidebarPreviewPages::pageSelected(size_t page) {
     }
 
     if (this->selectedEntry != npos && this->selectedEntry < this->previews.size()) {
-        auto& p = this->previews[this->selectedEntry];
-        p->setSelected(true);
+        // An entry which is not instantiated is selected on creation
+        if (auto& p = this->previews[this->selectedEntry]) {
+            p->setSelected(true);
+        }
         scrollToPreview(this);
     }
 }
 
 void SidebarPreviewPages::updateIndices() {
-    size_t index = 0;
-    for (auto& preview: this->previews) {
-        dynamic_cast<SidebarPreviewPageEntry*>(preview.get())->setIndex(index++);
+    for (size_t index = 0; index < this->previews.size(); index++) {
+        if (auto& preview = this->previews[index]) {
+            dynamic_cast<SidebarPreviewPageEntry*>(preview.get())->setIndex(index);
+        }
     }
 }
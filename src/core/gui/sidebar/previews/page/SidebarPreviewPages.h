@@ -60,6 +60,10 @@ public:
     void pageInserted(size_t page) override;
     void pageDeleted(size_t page) override;
 
+protected:
+    std::vector<SidebarLayout::EntrySize> getEntrySizes() const override;
+    std::unique_ptr<SidebarPreviewBaseEntry> createEntry(size_t index) override;
+
 private:
     /**
      * Unselect the last selected page, if any
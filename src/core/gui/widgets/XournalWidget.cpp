@@ -1,6 +1,7 @@
 #include "XournalWidget.h"
 
 #include <algorithm>  // for max
+#include <chrono>     // for steady_clock
 #include <cmath>      // for NAN
 #include <optional>   // for optional
 #include <vector>     // for vector
@@ -9,6 +10,7 @@
 #include <gdk/gdk.h>  // for GdkRectangle, GdkWindowAttr
 
 #include "control/Control.h"                // for Control
+#include "control/PerformanceMonitor.h"     // for PerformanceMonitor
 #include "control/settings/Settings.h"      // for Settings
 #include "control/tools/EditSelection.h"    // for EditSelection
 #include "gui/Layout.h"                     // for Layout
@@ -20,6 +22,7 @@
 #include "gui/scroll/ScrollHandling.h"      // for ScrollHandling
 #include "util/Color.h"                     // for cairo_set_source_rgbi
 #include "util/Rectangle.h"                 // for Rectangle
+#include "util/Tracing.h"                   // for XOJ_TRACE_SCOPE
 
 
 using xoj::util::Rectangle;
@@ -243,11 +246,16 @@ void gtk_xournal_repaint_area(GtkWidget* widget, int x1, int y1, int x2, int y2)
 }
 
 static auto gtk_xournal_draw(GtkWidget* widget, cairo_t* cr) -> gboolean {
+    XOJ_TRACE_SCOPE("gtk_xournal_draw");
+
     g_return_val_if_fail(widget != nullptr, false);
     g_return_val_if_fail(GTK_IS_XOURNAL(widget), false);
 
     GtkXournal* xournal = GTK_XOURNAL(widget);
 
+    PerformanceMonitor* monitor = xournal->view->getControl()->getPerformanceMonitor();
+    const auto drawStart = std::chrono::steady_clock::now();
+
     double x1 = NAN, x2 = NAN, y1 = NAN, y2 = NAN;
 
     cairo_clip_extents(cr, &x1, &y1, &x2, &y2);
@@ -290,6 +298,8 @@ static auto gtk_xournal_draw(GtkWidget* widget, cairo_t* cr) -> gboolean {
         cairo_restore(cr);
     }
 
+    monitor->recordDrawTime(std::chrono::steady_clock::now() - drawStart);
+
     return true;
 }
 
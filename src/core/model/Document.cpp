@@ -86,10 +86,7 @@ void Document::unlock() {
 auto Document::tryLock() -> bool { return this->documentLock.try_lock(); }
 
 void Document::clearDocument(bool destroy) {
-    if (this->preview) {
-        cairo_surface_destroy(this->preview);
-        this->preview = nullptr;
-    }
+    setPreview(nullptr);
 
     if (!destroy) {
         // release lock
@@ -181,7 +178,9 @@ auto Document::createSaveFilename(DocumentType type, const std::string& defaultS
 
 auto Document::getPreview() const -> cairo_surface_t* { return this->preview; }
 
-void Document::setPreview(cairo_surface_t* preview) {
+auto Document::getPreviewPng() const -> const std::string& { return this->previewPng; }
+
+void Document::setPreview(cairo_surface_t* preview, std::string png, const PageRef& source, uint64_t revision) {
     if (this->preview) {
         cairo_surface_destroy(this->preview);
     }
@@ -190,6 +189,13 @@ void Document::setPreview(cairo_surface_t* preview) {
     } else {
         this->preview = nullptr;
     }
+    this->previewPng = std::move(png);
+    this->previewSource = source;
+    this->previewRevision = revision;
+}
+
+auto Document::isPreviewUpToDate(const PageRef& page) const -> bool {
+    return this->preview && page && this->previewSource.lock() == page && this->previewRevision == page->getRevision();
 }
 
 auto Document::getEvMetadataFilename() const -> fs::path {
@@ -345,6 +351,8 @@ auto Document::readPdf(const fs::path& filename, bool initPages, bool attachToDo
     this->pdfFilepath = filename;
     this->attachPdf = attachToDocument;
     lastError = "";
+    // The preview may show the PDF background
+    this->previewSource.reset();
 
     if (initPages) {
         this->pages.clear();
@@ -370,7 +378,11 @@ auto Document::readPdf(const fs::path& filename, bool initPages, bool attachToDo
     return true;
 }
 
-void Document::resetPdf() { pdfDocument.reset(); }
+void Document::resetPdf() {
+    pdfDocument.reset();
+    // The preview may show the PDF background
+    this->previewSource.reset();
+}
 
 void Document::setPageSize(PageRef p, double width, double height) { p->setSize(width, height); }
 
@@ -14,7 +14,8 @@
 #pragma once
 
 #include <cstddef>        // for size_t
-#include <memory>         // for unique_ptr
+#include <cstdint>        // for uint64_t
+#include <memory>         // for unique_ptr, weak_ptr
 #include <mutex>          // for mutex
 #include <string>         // for string
 #include <unordered_map>  // for unordered_map
@@ -92,7 +93,22 @@ public:
     bool isAttachPdf() const;
 
     cairo_surface_t* getPreview() const;
-    void setPreview(cairo_surface_t* preview);
+    /**
+     * @return The PNG encoding of the preview, or an empty string if it was not provided
+     */
+    const std::string& getPreviewPng() const;
+    /**
+     * @brief Set the preview of the document
+     * @param png The PNG encoding of preview (optional)
+     * @param source The page the preview was rendered from (optional)
+     * @param revision The revision of source the preview was rendered from
+     */
+    void setPreview(cairo_surface_t* preview, std::string png = {}, const PageRef& source = nullptr,
+                    uint64_t revision = 0);
+    /**
+     * @return true if the current preview was rendered from the current revision of page
+     */
+    bool isPreviewUpToDate(const PageRef& page) const;
 
     void lock();
     void unlock();
@@ -159,6 +175,12 @@ private:
      * The preview for the file
      */
     cairo_surface_t* preview = nullptr;
+    std::string previewPng;
+    /**
+     * The page and page revision the preview was rendered from
+     */
+    std::weak_ptr<XojPage> previewSource;
+    uint64_t previewRevision = 0;
 
     /**
      * The lock of the document
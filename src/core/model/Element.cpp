@@ -1,14 +1,18 @@
 #include "Element.h"
 
-#include <algorithm>  // for max, min
-#include <cmath>      // for ceil, floor, NAN
-#include <cstdint>    // for uint32_t
+#include <algorithm>    // for max, min
+#include <cmath>        // for ceil, floor, NAN
+#include <cstdint>      // for uint32_t
+#include <string_view>  // for string_view
 
-#include <glib.h>  // for gint
+#include <glib.h>  // for gint, g_string_free
 
-#include "util/safe_casts.h"                      // for as_unsigned
-#include "util/serializing/ObjectInputStream.h"   // for ObjectInputStream
-#include "util/serializing/ObjectOutputStream.h"  // for ObjectOutputStream
+#include "util/safe_casts.h"                       // for as_unsigned
+#include "util/serializing/BinObjectEncoding.h"    // for BinObjectEncoding
+#include "util/serializing/CompactInputStream.h"   // for CompactInputStream
+#include "util/serializing/CompactOutputStream.h"  // for CompactOutputStream
+#include "util/serializing/ObjectInputStream.h"    // for ObjectInputStream
+#include "util/serializing/ObjectOutputStream.h"   // for ObjectOutputStream
 
 using xoj::util::Rectangle;
 
@@ -144,6 +148,27 @@ void Element::readSerialized(ObjectInputStream& in) {
     in.endObject();
 }
 
+void Element::writeCompact(CompactOutputStream& out) const {
+    ObjectOutputStream legacy(new BinObjectEncoding());
+    serialize(legacy);
+
+    GString* str = legacy.getStr();
+    out.writeString(std::string_view(str->str, str->len));
+    g_string_free(str, true);
+}
+
+void Element::readCompact(CompactInputStream& in) {
+    std::string_view str = in.readStringView();
+
+    ObjectInputStream legacy;
+    if (!legacy.read(str.data(), str.length())) {
+        throw InputStreamException("Invalid embedded element", __FILE__, __LINE__);
+    }
+    readSerialized(legacy);
+}
+
+auto Element::getMemoryUsage() const -> size_t { return sizeof(Element); }
+
 namespace xoj {
 
 auto refElementContainer(const std::vector<ElementPtr>& elements) -> std::vector<Element*> {
@@ -11,7 +11,7 @@
 
 #pragma once
 
-#include <cstddef>  // for ptrdiff_t
+#include <cstddef>  // for ptrdiff_t, size_t
 #include <memory>   // for unique_ptr
 #include <vector>   // for vector
 
@@ -21,6 +21,8 @@
 #include "util/Rectangle.h"                 // for Rectangle
 #include "util/serializing/Serializable.h"  // for Serializable
 
+class CompactInputStream;
+class CompactOutputStream;
 class ObjectInputStream;
 class ObjectOutputStream;
 
@@ -84,6 +86,18 @@ public:
     void serialize(ObjectOutputStream& out) const override;
     void readSerialized(ObjectInputStream& in) override;
 
+    /**
+     * Compact binary serialization, used for the clipboard (see CompactOutputStream).
+     * By default, the output of serialize() is embedded as a string.
+     */
+    virtual void writeCompact(CompactOutputStream& out) const;
+    virtual void readCompact(CompactInputStream& in);
+
+    /**
+     * @return An estimate of the memory held by this element, in bytes (used for statistics)
+     */
+    virtual size_t getMemoryUsage() const;
+
 private:
 protected:
     virtual void calcSize() const = 0;
@@ -49,6 +49,8 @@ auto Image::clone() const -> ElementPtr {
     return img;
 }
 
+auto Image::getMemoryUsage() const -> size_t { return sizeof(Image) + data.capacity(); }
+
 void Image::setWidth(double width) {
     this->width = width;
     this->calcSize();
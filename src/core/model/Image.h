@@ -61,6 +61,9 @@ public:
 
     auto clone() const -> ElementPtr override;
 
+    /// The rendered surface is a cache shared between clones, so only the raw data is accounted for.
+    size_t getMemoryUsage() const override;
+
     bool hasData() const;
 
     /// Return a pointer to the raw data. Note that the pointer will be invalidated if the data is changed.
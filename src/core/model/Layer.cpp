@@ -86,6 +86,20 @@ auto Layer::removeElement(Element* e) -> InsertionPosition {
     return InsertionPosition{nullptr, Element::InvalidIndex};
 }
 
+auto Layer::replaceElement(Element* e, ElementPtr replacement) -> ElementPtr {
+    for (auto& element: this->elements) {
+        if (e == element.get()) {
+            std::swap(element, replacement);
+            return replacement;
+        }
+    }
+
+    g_warning("Could not replace element in layer, it's not on the layer!");
+    Stacktrace::printStacktrace();
+    addElement(std::move(replacement));
+    return nullptr;
+}
+
 auto Layer::removeElementAt(Element* e, Element::Index pos) -> InsertionPosition {
     if (pos >= 0 && as_unsigned(pos) < elements.size() && this->elements[as_unsigned(pos)].get() == e) {
         auto iter = std::next(this->elements.begin(), pos);
@@ -56,6 +56,12 @@ public:
      */
     auto removeElement(Element* e) -> InsertionPosition;
 
+    /**
+     * Replaces an Element by another one, at the same position in the Layer
+     * @return the replaced element, or nullptr if e is not in the Layer (the replacement is then added at the top)
+     */
+    auto replaceElement(Element* e, ElementPtr replacement) -> ElementPtr;
+
     /**
      * Removes the Element. If e is not at index pos, tries to find it elsewhere (this could happen is the layer was
      * modified between now and when pos was computed)
@@ -9,7 +9,11 @@ class Rectangle;
 
 using xoj::util::Rectangle;
 
-PageHandler::PageHandler() = default;
+namespace {
+std::atomic<uint64_t> lastRevision{0};
+}
+
+PageHandler::PageHandler(): revision(++lastRevision) {}
 
 PageHandler::~PageHandler() = default;
 
@@ -17,24 +21,33 @@ void PageHandler::addListener(PageListener* l) { this->listeners.push_back(l); }
 
 void PageHandler::removeListener(PageListener* l) { this->listeners.remove(l); }
 
+auto PageHandler::getRevision() const -> uint64_t { return this->revision; }
+
+void PageHandler::bumpRevision() { this->revision = ++lastRevision; }
+
 void PageHandler::fireRectChanged(Rectangle<double>& rect) {
+    bumpRevision();
     for (PageListener* pl: this->listeners) { pl->rectChanged(rect); }
 }
 
 void PageHandler::fireRangeChanged(Range& range) {
+    bumpRevision();
     for (PageListener* pl: this->listeners) { pl->rangeChanged(range); }
 }
 
 void PageHandler::fireElementChanged(Element* elem) {
+    bumpRevision();
     for (PageListener* pl: this->listeners) { pl->elementChanged(elem); }
 }
 
 void PageHandler::fireElementsChanged(const std::vector<Element*>& elements, Range range) {
+    bumpRevision();
     for (PageListener* pl: this->listeners) {
         pl->elementsChanged(elements, range);
     }
 }
 
 void PageHandler::firePageChanged() {
+    bumpRevision();
     for (PageListener* pl: this->listeners) { pl->pageChanged(); }
 }
@@ -11,7 +11,9 @@
 
 #pragma once
 
-#include <list>  // for list
+#include <atomic>   // for atomic
+#include <cstdint>  // for uint64_t
+#include <list>     // for list
 #include <vector>
 
 #include "util/Range.h"  // for Range
@@ -41,6 +43,18 @@ public:
     void fireElementsChanged(const std::vector<Element*>& elements, Range range = Range());
     void firePageChanged();
 
+    /**
+     * @brief Revision stamp of the page, changed every time a change of the page is notified.
+     * Stamps are unique among all pages, and can be read from any thread.
+     */
+    uint64_t getRevision() const;
+
+protected:
+    /**
+     * @brief Mark the page as changed, for modifications that are not notified through fire*Changed()
+     */
+    void bumpRevision();
+
 private:
     void addListener(PageListener* l);
     void removeListener(PageListener* l);
@@ -48,5 +62,7 @@ private:
 private:
     std::list<PageListener*> listeners;
 
+    std::atomic<uint64_t> revision;
+
     friend class PageListener;
 };
@@ -0,0 +1,121 @@
+#include "PointKernels.h"
+
+#include <algorithm>  // for min, max
+#include <cstddef>    // for offsetof
+
+#include "model/Point.h"  // for Point, Point::NO_PRESSURE
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define XOJ_POINT_KERNELS_SSE2
+#include <emmintrin.h>  // for __m128d, _mm_add_pd, _mm_mul_pd...
+#endif
+
+namespace PointKernels {
+
+void scalar::translate(Point* pts, size_t n, double dx, double dy) {
+    for (size_t i = 0; i < n; i++) {
+        pts[i].x += dx;
+        pts[i].y += dy;
+    }
+}
+
+void scalar::transform(Point* pts, size_t n, const cairo_matrix_t& m, double pressureFactor) {
+    for (size_t i = 0; i < n; i++) {
+        Point& p = pts[i];
+        cairo_matrix_transform_point(&m, &p.x, &p.y);
+        if (p.z != Point::NO_PRESSURE) {
+            p.z *= pressureFactor;
+        }
+    }
+}
+
+auto scalar::bounds(const Point* pts, size_t n) -> Bounds {
+    Bounds b{pts[0].x, pts[0].y, pts[0].x, pts[0].y, pts[0].z};
+    for (size_t i = 1; i < n; i++) {
+        const Point& p = pts[i];
+        b.minX = std::min(b.minX, p.x);
+        b.minY = std::min(b.minY, p.y);
+        b.maxX = std::max(b.maxX, p.x);
+        b.maxY = std::max(b.maxY, p.y);
+        b.maxZ = std::max(b.maxZ, p.z);
+    }
+    return b;
+}
+
+#ifdef XOJ_POINT_KERNELS_SSE2
+
+static_assert(offsetof(Point, y) == offsetof(Point, x) + sizeof(double), "x and y are loaded as a single vector");
+static_assert(offsetof(Bounds, minY) == offsetof(Bounds, minX) + sizeof(double) &&
+                      offsetof(Bounds, maxY) == offsetof(Bounds, maxX) + sizeof(double),
+              "the bounds are stored as vectors");
+
+void translate(Point* pts, size_t n, double dx, double dy) {
+    const __m128d d = _mm_set_pd(dy, dx);
+    for (size_t i = 0; i < n; i++) {
+        _mm_storeu_pd(&pts[i].x, _mm_add_pd(_mm_loadu_pd(&pts[i].x), d));
+    }
+}
+
+void transform(Point* pts, size_t n, const cairo_matrix_t& m, double pressureFactor) {
+    // (x', y') = (xx, yy) * (x, y) + (xy, yx) * (y, x) + (x0, y0), in the same order as cairo_matrix_transform_point()
+    const __m128d diagonal = _mm_set_pd(m.yy, m.xx);
+    const __m128d antiDiagonal = _mm_set_pd(m.yx, m.xy);
+    const __m128d offset = _mm_set_pd(m.y0, m.x0);
+    for (size_t i = 0; i < n; i++) {
+        Point& p = pts[i];
+        const __m128d v = _mm_loadu_pd(&p.x);
+        const __m128d swapped = _mm_shuffle_pd(v, v, 1);
+        const __m128d linear = _mm_add_pd(_mm_mul_pd(diagonal, v), _mm_mul_pd(antiDiagonal, swapped));
+        _mm_storeu_pd(&p.x, _mm_add_pd(linear, offset));
+        if (p.z != Point::NO_PRESSURE) {
+            p.z *= pressureFactor;
+        }
+    }
+}
+
+auto bounds(const Point* pts, size_t n) -> Bounds {
+    // Two independent accumulators, so that consecutive min/max do not wait for each other
+    __m128d min0 = _mm_loadu_pd(&pts[0].x);
+    __m128d max0 = min0;
+    __m128d min1 = min0;
+    __m128d max1 = min0;
+    double maxZ0 = pts[0].z;
+    double maxZ1 = pts[0].z;
+    size_t i = 1;
+    for (; i + 1 < n; i += 2) {
+        const __m128d v0 = _mm_loadu_pd(&pts[i].x);
+        const __m128d v1 = _mm_loadu_pd(&pts[i + 1].x);
+        min0 = _mm_min_pd(min0, v0);
+        max0 = _mm_max_pd(max0, v0);
+        min1 = _mm_min_pd(min1, v1);
+        max1 = _mm_max_pd(max1, v1);
+        maxZ0 = std::max(maxZ0, pts[i].z);
+        maxZ1 = std::max(maxZ1, pts[i + 1].z);
+    }
+    if (i < n) {
+        const __m128d v = _mm_loadu_pd(&pts[i].x);
+        min0 = _mm_min_pd(min0, v);
+        max0 = _mm_max_pd(max0, v);
+        maxZ0 = std::max(maxZ0, pts[i].z);
+    }
+
+    Bounds b{};
+    _mm_storeu_pd(&b.minX, _mm_min_pd(min0, min1));
+    _mm_storeu_pd(&b.maxX, _mm_max_pd(max0, max1));
+    b.maxZ = std::max(maxZ0, maxZ1);
+    return b;
+}
+
+#else
+
+void translate(Point* pts, size_t n, double dx, double dy) { scalar::translate(pts, n, dx, dy); }
+
+void transform(Point* pts, size_t n, const cairo_matrix_t& m, double pressureFactor) {
+    scalar::transform(pts, n, m, pressureFactor);
+}
+
+auto bounds(const Point* pts, size_t n) -> Bounds { return scalar::bounds(pts, n); }
+
+#endif
+
+}  // namespace PointKernels
@@ -0,0 +1,61 @@
+/*
+ * Xournal++
+ *
+ * Transformations and bounds of point arrays
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <cstddef>  // for size_t
+
+#include <cairo.h>  // for cairo_matrix_t
+
+class Point;
+
+/**
+ * Loops over the points of a stroke, vectorized with SSE2 when it is available (i.e. on all x86-64 CPUs): the x and y
+ * coordinates of a Point are adjacent, so each point is processed as one 128 bits vector. The results are the same as
+ * the scalar versions, which are used on the other architectures.
+ */
+namespace PointKernels {
+
+struct Bounds {
+    double minX;
+    double minY;
+    double maxX;
+    double maxY;
+    /// Largest pressure value
+    double maxZ;
+};
+
+/**
+ * @brief Adds (dx, dy) to the points
+ */
+void translate(Point* pts, size_t n, double dx, double dy);
+
+/**
+ * @brief Applies the affine transformation m to the points (like cairo_matrix_transform_point())
+ * @param pressureFactor Factor applied to the pressure values (unless they are Point::NO_PRESSURE)
+ */
+void transform(Point* pts, size_t n, const cairo_matrix_t& m, double pressureFactor = 1.0);
+
+/**
+ * @brief Bounds of the points. n must not be 0.
+ */
+Bounds bounds(const Point* pts, size_t n);
+
+/**
+ * The reference implementations, one point at a time
+ */
+namespace scalar {
+void translate(Point* pts, size_t n, double dx, double dy);
+void transform(Point* pts, size_t n, const cairo_matrix_t& m, double pressureFactor = 1.0);
+Bounds bounds(const Point* pts, size_t n);
+}  // namespace scalar
+
+}  // namespace PointKernels
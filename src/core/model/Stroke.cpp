@@ -4,7 +4,6 @@
 #include <cmath>      // for abs, hypot, sqrt
 #include <cstdint>    // for uint64_t
 #include <iterator>   // for back_insert_iterator
-#include <limits>     // for numeric_limits
 #include <memory>
 #include <numeric>    // for accumulate
 #include <optional>   // for optional, nullopt
@@ -13,23 +12,26 @@
 #include <cairo.h>  // for cairo_matrix_translate
 #include <glib.h>   // for g_free, g_message
 
-#include "eraser/PaddedBox.h"                     // for PaddedBox
-#include "model/AudioElement.h"                   // for AudioElement
-#include "model/Element.h"                        // for Element, ELEMENT_ST...
-#include "model/LineStyle.h"                      // for LineStyle
-#include "model/Point.h"                          // for Point, Point::NO_PR...
-#include "util/Assert.h"                          // for xoj_assert
-#include "util/BasePointerIterator.h"             // for BasePointerIterator
-#include "util/Interval.h"                        // for Interval
-#include "util/PairView.h"                        // for PairView<>::BaseIte...
-#include "util/PlaceholderString.h"               // for PlaceholderString
-#include "util/Rectangle.h"                       // for Rectangle
-#include "util/SmallVector.h"                     // for SmallVector
-#include "util/TinyVector.h"                      // for TinyVector
-#include "util/i18n.h"                            // for FC, FORMAT_STR
-#include "util/serdesstream.h"                    // for serdes_stream
-#include "util/serializing/ObjectInputStream.h"   // for ObjectInputStream
-#include "util/serializing/ObjectOutputStream.h"  // for ObjectOutputStream
+#include "eraser/PaddedBox.h"                      // for PaddedBox
+#include "model/AudioElement.h"                    // for AudioElement
+#include "model/Element.h"                         // for Element, ELEMENT_ST...
+#include "model/LineStyle.h"                       // for LineStyle
+#include "model/Point.h"                           // for Point, Point::NO_PR...
+#include "model/PointKernels.h"                    // for bounds, transform, translate
+#include "util/Assert.h"                           // for xoj_assert
+#include "util/BasePointerIterator.h"              // for BasePointerIterator
+#include "util/Interval.h"                         // for Interval
+#include "util/PairView.h"                         // for PairView<>::BaseIte...
+#include "util/PlaceholderString.h"                // for PlaceholderString
+#include "util/Rectangle.h"                        // for Rectangle
+#include "util/SmallVector.h"                      // for SmallVector
+#include "util/TinyVector.h"                       // for TinyVector
+#include "util/i18n.h"                             // for FC, FORMAT_STR
+#include "util/serdesstream.h"                     // for serdes_stream
+#include "util/serializing/CompactInputStream.h"   // for CompactInputStream
+#include "util/serializing/CompactOutputStream.h"  // for CompactOutputStream
+#include "util/serializing/ObjectInputStream.h"    // for ObjectInputStream
+#include "util/serializing/ObjectOutputStream.h"   // for ObjectOutputStream
 
 #include "PathParameter.h"  // for PathParameter
 #include "config-debug.h"   // for ENABLE_ERASER_DEBUG
@@ -111,26 +113,33 @@ auto Stroke::cloneStroke() const -> std::unique_ptr<Stroke> {
 
 auto Stroke::clone() const -> ElementPtr { return this->cloneStroke(); }
 
+auto Stroke::getMemoryUsage() const -> size_t {
+    // The points shared with other strokes are split between them
+    size_t pointMemory = points->capacity() * sizeof(Point);
+    return sizeof(Stroke) + (points.useCount() > 1 ? pointMemory / points.useCount() : pointMemory);
+}
+
 std::unique_ptr<Stroke> Stroke::cloneSection(const PathParameter& lowerBound, const PathParameter& upperBound) const {
     xoj_assert(lowerBound.isValid() && upperBound.isValid());
     xoj_assert(lowerBound <= upperBound);
-    xoj_assert(upperBound.index < this->points.size() - 1);
+    xoj_assert(upperBound.index < this->points->size() - 1);
 
     auto s = std::make_unique<Stroke>();
     s->applyStyleFrom(this);
 
-    s->points.reserve(upperBound.index - lowerBound.index + 2);
+    std::vector<Point>& sectionPoints = s->points.edit();
+    sectionPoints.reserve(upperBound.index - lowerBound.index + 2);
 
-    s->points.emplace_back(this->getPoint(lowerBound));
+    sectionPoints.emplace_back(this->getPoint(lowerBound));
 
-    auto beginIt = std::next(this->points.cbegin(), (std::ptrdiff_t)lowerBound.index + 1);
-    auto endIt = std::next(this->points.cbegin(), (std::ptrdiff_t)upperBound.index + 1);
-    std::copy(beginIt, endIt, std::back_inserter(s->points));
+    auto beginIt = std::next(this->points->cbegin(), (std::ptrdiff_t)lowerBound.index + 1);
+    auto endIt = std::next(this->points->cbegin(), (std::ptrdiff_t)upperBound.index + 1);
+    std::copy(beginIt, endIt, std::back_inserter(sectionPoints));
 
-    s->points.emplace_back(this->getPoint(upperBound));
+    sectionPoints.emplace_back(this->getPoint(upperBound));
 
     // Remove unused pressure value
-    s->points.back().z = Point::NO_PRESSURE;
+    sectionPoints.back().z = Point::NO_PRESSURE;
 
     return s;
 }
@@ -139,27 +148,28 @@ std::unique_ptr<Stroke> Stroke::cloneCircularSectionOfClosedStroke(const PathPar
                                                                    const PathParameter& endParam) const {
     xoj_assert(startParam.isValid() && endParam.isValid());
     xoj_assert(endParam < startParam);
-    xoj_assert(startParam.index < this->points.size() - 1);
+    xoj_assert(startParam.index < this->points->size() - 1);
 
     auto s = std::make_unique<Stroke>();
     s->applyStyleFrom(this);
 
-    s->points.reserve(this->points.size() - startParam.index + endParam.index + 1);
+    std::vector<Point>& sectionPoints = s->points.edit();
+    sectionPoints.reserve(this->points->size() - startParam.index + endParam.index + 1);
 
-    s->points.emplace_back(this->getPoint(startParam));
+    sectionPoints.emplace_back(this->getPoint(startParam));
 
-    auto startIt = std::next(this->points.cbegin(), (std::ptrdiff_t)startParam.index + 1);
+    auto startIt = std::next(this->points->cbegin(), (std::ptrdiff_t)startParam.index + 1);
     // Skip the last point: points.back().equalPos(points.front()) == true and we want this point only once
-    xoj_assert(startIt != this->points.cend());
-    std::copy(startIt, std::prev(this->points.cend()), std::back_inserter(s->points));
+    xoj_assert(startIt != this->points->cend());
+    std::copy(startIt, std::prev(this->points->cend()), std::back_inserter(sectionPoints));
 
-    auto endIt = std::next(this->points.cbegin(), (std::ptrdiff_t)endParam.index + 1);
-    std::copy(this->points.cbegin(), endIt, std::back_inserter(s->points));
+    auto endIt = std::next(this->points->cbegin(), (std::ptrdiff_t)endParam.index + 1);
+    std::copy(this->points->cbegin(), endIt, std::back_inserter(sectionPoints));
 
-    s->points.emplace_back(this->getPoint(endParam));
+    sectionPoints.emplace_back(this->getPoint(endParam));
 
     // Remove unused pressure value
-    s->points.back().z = Point::NO_PRESSURE;
+    sectionPoints.back().z = Point::NO_PRESSURE;
 
     return s;
 }
@@ -177,7 +187,7 @@ void Stroke::serialize(ObjectOutputStream& out) const {
 
     out.writeInt(this->capStyle);
 
-    out.writeData(this->points.data(), this->points.size(), sizeof(Point));
+    out.writeData(this->points->data(), this->points->size(), sizeof(Point));
 
     this->lineStyle.serialize(out);
 
@@ -197,12 +207,45 @@ void Stroke::readSerialized(ObjectInputStream& in) {
 
     this->capStyle = static_cast<StrokeCapStyle>(in.readInt());
 
-    in.readData(this->points);
+    in.readData(this->points.edit());
     this->lineStyle.readSerialized(in);
 
     in.endObject();
 }
 
+void Stroke::writeCompact(CompactOutputStream& out) const {
+    out.write(uint32_t(getColor()));
+    out.writeString(getAudioFilename().u8string());
+    out.write<uint64_t>(getTimestamp());
+
+    out.write(this->width);
+    out.write<int32_t>(this->toolType);
+    out.write<int32_t>(this->fill);
+    out.write<int32_t>(this->capStyle);
+
+    out.writeArray(*this->points);
+    out.writeArray(this->lineStyle.getDashes());
+}
+
+void Stroke::readCompact(CompactInputStream& in) {
+    setColor(Color(in.read<uint32_t>()));
+    setAudioFilename(fs::u8path(in.readStringView()));
+    setTimestamp(static_cast<size_t>(in.read<uint64_t>()));
+
+    this->width = in.read<double>();
+    this->toolType = static_cast<StrokeTool::Value>(in.read<int32_t>());
+    this->fill = in.read<int32_t>();
+    this->capStyle = static_cast<StrokeCapStyle>(in.read<int32_t>());
+
+    in.readArray(this->points.edit());
+
+    std::vector<double> dashes;
+    in.readArray(dashes);
+    this->lineStyle.setDashes(std::move(dashes));
+
+    this->sizeCalculated = false;
+}
+
 /**
  * Option to fill the shape:
  *  -1: The shape is not filled
@@ -228,7 +271,7 @@ auto Stroke::getWidth() const -> double { return this->width; }
 auto Stroke::rescaleWithMirror() -> bool { return true; }
 
 auto Stroke::isInSelection(ShapeContainer* container) const -> bool {
-    for (auto&& p: this->points) {
+    for (auto&& p: *this->points) {
         double px = p.x;
         double py = p.y;
 
@@ -241,7 +284,7 @@ auto Stroke::isInSelection(ShapeContainer* container) const -> bool {
 }
 
 void Stroke::addPoint(const Point& p) {
-    this->points.emplace_back(p);
+    this->points.edit().emplace_back(p);
     if (!sizeCalculated) {
         return;
     }
@@ -254,36 +297,41 @@ void Stroke::addPoint(const Point& p) {
     }
 }
 
-auto Stroke::getPointCount() const -> size_t { return this->points.size(); }
+auto Stroke::getPointCount() const -> size_t { return this->points->size(); }
+
+auto Stroke::getPointVector() const -> std::vector<Point> const& { return *points; }
 
-auto Stroke::getPointVector() const -> std::vector<Point> const& { return points; }
+auto Stroke::sharesPointsWith(const Stroke& other) const -> bool { return points.sharesWith(other.points); }
 
 void Stroke::deletePointsFrom(size_t index) {
-    points.resize(std::min(index, points.size()));
+    if (index >= points->size()) {
+        return;
+    }
+    points.edit().resize(index);
     this->sizeCalculated = false;
 }
 
 auto Stroke::getPoint(size_t index) const -> Point {
-    if (index < 0 || index >= this->points.size()) {
+    if (index < 0 || index >= this->points->size()) {
         g_warning("Stroke::getPoint(%zu) out of bounds!", index);
         return Point(0., 0., Point::NO_PRESSURE);
     }
-    return points.at(index);
+    return points->at(index);
 }
 
 Point Stroke::getPoint(PathParameter parameter) const {
-    xoj_assert(parameter.isValid() && parameter.index < this->points.size() - 1);
+    xoj_assert(parameter.isValid() && parameter.index < this->points->size() - 1);
 
-    const Point& p = this->points[parameter.index];
-    Point res = p.relativeLineTo(this->points[parameter.index + 1], parameter.t);
+    const Point& p = (*this->points)[parameter.index];
+    Point res = p.relativeLineTo((*this->points)[parameter.index + 1], parameter.t);
     res.z = p.z;  // The point's width should be that of the segment's first point
     return res;
 }
 
-auto Stroke::getPoints() const -> const Point* { return this->points.data(); }
+auto Stroke::getPoints() const -> const Point* { return this->points->data(); }
 
 void Stroke::setPointVectorInternal(const Range* const snappingBox) {
-    if (!snappingBox || this->points.empty() || this->points.front().z != Point::NO_PRESSURE) {
+    if (!snappingBox || this->points->empty() || this->points->front().z != Point::NO_PRESSURE) {
         // We cannot deduce the bounding box from the snapping box if the stroke has pressure values
         this->sizeCalculated = false;
     } else {
@@ -308,7 +356,11 @@ void Stroke::setPointVector(std::vector<Point>&& other, const Range* const snapp
 }
 
 
-void Stroke::freeUnusedPointItems() { this->points = {begin(this->points), end(this->points)}; }
+void Stroke::freeUnusedPointItems() {
+    if (points->capacity() > points->size()) {
+        this->points = std::vector<Point>(begin(*this->points), end(*this->points));
+    }
+}
 
 void Stroke::setToolType(StrokeTool type) { this->toolType = type; }
 
@@ -319,10 +371,8 @@ void Stroke::setLineStyle(const LineStyle& style) { this->lineStyle = style; }
 auto Stroke::getLineStyle() const -> const LineStyle& { return this->lineStyle; }
 
 void Stroke::move(double dx, double dy) {
-    for (auto&& point: points) {
-        point.x += dx;
-        point.y += dy;
-    }
+    std::vector<Point>& pts = points.edit();
+    PointKernels::translate(pts.data(), pts.size(), dx, dy);
     Element::x += dx;
     Element::y += dy;
     Element::snappedBounds = Element::snappedBounds.translated(dx, dy);
@@ -335,9 +385,8 @@ void Stroke::rotate(double x0, double y0, double th) {
     cairo_matrix_rotate(&rotMatrix, th);
     cairo_matrix_translate(&rotMatrix, -x0, -y0);
 
-    for (auto&& p: points) {
-        cairo_matrix_transform_point(&rotMatrix, &p.x, &p.y);
-    }
+    std::vector<Point>& pts = points.edit();
+    PointKernels::transform(pts.data(), pts.size(), rotMatrix);
     this->sizeCalculated = false;
     // Width and Height will likely be changed after this operation
 }
@@ -352,41 +401,36 @@ void Stroke::scale(double x0, double y0, double fx, double fy, double rotation,
     cairo_matrix_rotate(&scaleMatrix, -rotation);
     cairo_matrix_translate(&scaleMatrix, -x0, -y0);
 
-    for (auto&& p: points) {
-        cairo_matrix_transform_point(&scaleMatrix, &p.x, &p.y);
-
-        if (p.z != Point::NO_PRESSURE) {
-            p.z *= fz;
-        }
-    }
+    std::vector<Point>& pts = points.edit();
+    PointKernels::transform(pts.data(), pts.size(), scaleMatrix, fz);
     this->width *= fz;
 
     this->sizeCalculated = false;
 }
 
 auto Stroke::hasPressure() const -> bool {
-    if (!this->points.empty()) {
-        return this->points[0].z != Point::NO_PRESSURE;
+    if (!this->points->empty()) {
+        return (*this->points)[0].z != Point::NO_PRESSURE;
     }
     return false;
 }
 
 auto Stroke::getAvgPressure() const -> double {
-    return std::accumulate(begin(this->points), end(this->points), 0.0,
+    return std::accumulate(begin(*this->points), end(*this->points), 0.0,
                            [](double l, Point const& p) { return l + p.z; }) /
-           static_cast<double>(this->points.size());
+           static_cast<double>(this->points->size());
 }
 
 void Stroke::updateBoundsLastTwoPressures() {
-    if (!sizeCalculated || this->points.empty()) {
+    if (!sizeCalculated || this->points->empty()) {
         return;
     }
 
     auto const pointCount = this->getPointCount();
     xoj_assert(pointCount >= 2);
 
-    Point& p = this->points.back();
-    Point& p2 = this->points[pointCount - 2];
+    const Point& p = this->points->back();
+    const Point& p2 = (*this->points)[pointCount - 2];
     double pressure = p2.z;
 
     updateSnappedBounds(snappedBounds, p);
@@ -398,16 +442,16 @@ void Stroke::scalePressure(double factor) {
     if (!hasPressure()) {
         return;
     }
-    for (auto&& p: this->points) {
+    for (auto&& p: this->points.edit()) {
         p.z *= factor;
     }
     this->sizeCalculated = false;
 }
 
 void Stroke::setLastPressure(double pressure) {
-    if (!this->points.empty()) {
+    if (!this->points->empty()) {
         xoj_assert(pressure != Point::NO_PRESSURE);
-        Point& back = this->points.back();
+        Point& back = this->points.edit().back();
         back.z = pressure;
     }
 }
@@ -415,7 +459,7 @@ void Stroke::setLastPressure(double pressure) {
 void Stroke::setSecondToLastPressure(double pressure) {
     auto const pointCount = this->getPointCount();
     if (pointCount >= 2) {
-        Point& p = this->points[pointCount - 2];
+        Point& p = this->points.edit()[pointCount - 2];
         p.z = pressure;
         updateBoundsLastTwoPressures();
     }
@@ -423,14 +467,15 @@ void Stroke::setSecondToLastPressure(double pressure) {
 
 void Stroke::setPressure(const std::vector<double>& pressure) {
     // The last pressure is not used - as there is no line drawn from this point
-    if (this->points.size() - 1 != pressure.size()) {
+    if (this->points->size() - 1 != pressure.size()) {
         g_warning("invalid pressure point count: %s, expected %s", std::to_string(pressure.size()).data(),
-                  std::to_string(this->points.size() - 1).data());
+                  std::to_string(this->points->size() - 1).data());
     }
 
-    auto max_size = std::min(pressure.size(), this->points.size() - 1);
+    auto max_size = std::min(pressure.size(), this->points->size() - 1);
+    std::vector<Point>& pts = this->points.edit();
     for (size_t i = 0U; i != max_size; ++i) {
-        this->points[i].z = pressure[i];
+        pts[i].z = pressure[i];
     }
 }
 
@@ -445,7 +490,7 @@ auto Stroke::intersects(double x, double y, double halfEraserSize) const -> bool
  * checks if the stroke is intersected by the eraser rectangle
  */
 auto Stroke::intersects(double x, double y, double halfEraserSize, double* gap) const -> bool {
-    if (this->points.empty()) {
+    if (this->points->empty()) {
         return false;
     }
 
@@ -454,9 +499,9 @@ auto Stroke::intersects(double x, double y, double halfEraserSize, double* gap)
     double y1 = y - halfEraserSize;
     double y2 = y + halfEraserSize;
 
-    double lastX = points[0].x;
-    double lastY = points[0].y;
-    for (auto&& point: points) {
+    double lastX = (*points)[0].x;
+    double lastY = (*points)[0].y;
+    for (auto&& point: *points) {
         double px = point.x;
         double py = point.y;
 
@@ -577,9 +622,9 @@ static TinyVector<double, 2> intersectLineSegmentWithRectangle(const Point& p, c
 }
 
 auto Stroke::intersectWithPaddedBox(const PaddedBox& box) const -> IntersectionParametersContainer {
-    auto pointCount = this->points.size();
+    auto pointCount = this->points->size();
     if (pointCount < 2) {
-        if (pointCount == 1 && this->points.back().isInside(box.getInnerRectangle())) {
+        if (pointCount == 1 && this->points->back().isInside(box.getInnerRectangle())) {
             IntersectionParametersContainer result;
             result.emplace_back(0U, 0.0);
             result.emplace_back(0U, 0.0);
@@ -592,7 +637,7 @@ auto Stroke::intersectWithPaddedBox(const PaddedBox& box) const -> IntersectionP
 
 auto Stroke::intersectWithPaddedBox(const PaddedBox& box, size_t firstIndex, size_t lastIndex) const
         -> IntersectionParametersContainer {
-    xoj_assert(firstIndex <= lastIndex && lastIndex < this->points.size() - 1);
+    xoj_assert(firstIndex <= lastIndex && lastIndex < this->points->size() - 1);
 
     const auto innerBox = box.getInnerRectangle();
     const auto outerBox = box.getOuterRectangle();
@@ -618,7 +663,7 @@ auto Stroke::intersectWithPaddedBox(const PaddedBox& box, size_t firstIndex, siz
 
     size_t index = firstIndex;
 
-    const PairView segments(this->points);
+    const PairView segments(*this->points);
     auto segmentIt = std::next(segments.begin(), (std::ptrdiff_t)index);
 
     Flags flags = initializeFlagsFromHalfTangentAtFirstKnot(segmentIt.first(), segmentIt.second());
@@ -810,7 +855,7 @@ auto Stroke::intersectWithPaddedBox(const PaddedBox& box, size_t firstIndex, siz
  * Also used for Selected Bounding box.
  */
 void Stroke::calcSize() const {
-    if (this->points.empty()) {
+    if (this->points->empty()) {
         Element::x = 0;
         Element::y = 0;
 
@@ -820,25 +865,16 @@ void Stroke::calcSize() const {
 
         // used for snapping
         Element::snappedBounds = Rectangle<double>{};
+        return;
     }
 
-    double minSnapX = std::numeric_limits<double>::max();
-    double maxSnapX = std::numeric_limits<double>::min();
-    double minSnapY = std::numeric_limits<double>::max();
-    double maxSnapY = std::numeric_limits<double>::min();
-
-    auto halfThick = 0.0;
-
-    // #pragma omp parralel
-    for (auto&& p: points) {
-        halfThick = std::max(halfThick, p.z);
-        minSnapX = std::min(minSnapX, p.x);
-        minSnapY = std::min(minSnapY, p.y);
-        maxSnapX = std::max(maxSnapX, p.x);
-        maxSnapY = std::max(maxSnapY, p.y);
-    }
+    const PointKernels::Bounds b = PointKernels::bounds(points->data(), points->size());
+    const double minSnapX = b.minX;
+    const double minSnapY = b.minY;
+    const double maxSnapX = b.maxX;
+    const double maxSnapY = b.maxY;
 
-    halfThick = points[0].z != Point::NO_PRESSURE ? halfThick / 2.0 : this->width / 2.0;
+    auto halfThick = (*points)[0].z != Point::NO_PRESSURE ? std::max(0.0, b.maxZ) / 2.0 : this->width / 2.0;
 
     auto minX = minSnapX - halfThick;
     auto minY = minSnapY - halfThick;
@@ -863,7 +899,7 @@ void Stroke::setStrokeCapStyle(const StrokeCapStyle capStyle) { this->capStyle =
 void Stroke::debugPrint() const {
     g_message("%s", FC(FORMAT_STR("Stroke {1} / hasPressure() = {2}") % (int64_t)this % this->hasPressure()));
 
-    for (auto&& p: points) {
+    for (auto&& p: *points) {
         g_message("%lf / %lf / %lf", p.x, p.y, p.z);
     }
 
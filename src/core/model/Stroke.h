@@ -16,11 +16,14 @@
 #include <vector>   // for vector
 
 #include "model/Element.h"
+#include "util/CopyOnWrite.h"  // for CopyOnWrite
 
 #include "AudioElement.h"  // for AudioElement
 #include "LineStyle.h"     // for LineStyle
 #include "Point.h"         // for Point
 
+class CompactInputStream;
+class CompactOutputStream;
 class Element;
 class ObjectInputStream;
 class ObjectOutputStream;
@@ -68,6 +71,7 @@ public:
 public:
     auto cloneStroke() const -> std::unique_ptr<Stroke>;
     auto clone() const -> ElementPtr override;
+    size_t getMemoryUsage() const override;
 
     /**
      * @brief Create a partial clone whose points are those of parameters between lowerBound and upperBound
@@ -113,6 +117,12 @@ public:
     size_t getPointCount() const;
     void freeUnusedPointItems();
     std::vector<Point> const& getPointVector() const;
+
+    /**
+     * @return true if the points of both strokes are the same buffer, i.e. one is an unmodified clone of the other
+     */
+    bool sharesPointsWith(const Stroke& other) const;
+
     Point getPoint(size_t index) const;
     Point getPoint(PathParameter parameter) const;
     const Point* getPoints() const;
@@ -192,6 +202,12 @@ public:
     void serialize(ObjectOutputStream& out) const override;
     void readSerialized(ObjectInputStream& in) override;
 
+    /**
+     * The points and dashes are written as contiguous arrays
+     */
+    void writeCompact(CompactOutputStream& out) const override;
+    void readCompact(CompactInputStream& in) override;
+
     bool rescaleWithMirror() override;
 
 protected:
@@ -202,8 +218,8 @@ private:
     double width = 0;
     StrokeTool toolType = StrokeTool::PEN;
 
-    // The array with the points
-    std::vector<Point> points{};
+    // The array with the points, shared with the clones of this stroke until either of them is modified
+    xoj::util::CopyOnWrite<std::vector<Point>> points{};
 
     /**
      * Dashed line
@@ -1,12 +1,16 @@
 #include "TexImage.h"
 
+#include <atomic>         // for atomic
+#include <functional>     // for hash
 #include <memory>
-#include <utility>  // for move
+#include <mutex>          // for mutex, lock_guard
+#include <utility>        // for move, pair
 
 #include <poppler-document.h>  // for poppler_document_ge...
 #include <poppler-page.h>      // for poppler_page_get_size
 
 #include "model/Element.h"                        // for Element, ELEMENT_TE...
+#include "util/LruCache.h"                        // for LruCache
 #include "util/Rectangle.h"                       // for Rectangle
 #include "util/raii/GObjectSPtr.h"                // for GObjectSPtr
 #include "util/serializing/ObjectInputStream.h"   // for ObjectInputStream
@@ -14,6 +18,40 @@
 
 using xoj::util::Rectangle;
 
+namespace {
+struct RasterId {
+    uint64_t key;
+    int width;
+    int height;
+
+    bool operator==(const RasterId& other) const {
+        return key == other.key && width == other.width && height == other.height;
+    }
+};
+
+struct RasterIdHash {
+    size_t operator()(const RasterId& id) const {
+        return std::hash<uint64_t>()(id.key) ^ (std::hash<int>()(id.width) * 31U) ^ std::hash<int>()(id.height);
+    }
+};
+
+using RasterCache = xoj::util::LruCache<RasterId, xoj::util::CairoSurfaceSPtr, RasterIdHash>;
+
+/// The cache and its mutex, shared by the render threads
+auto rasterCache() -> std::pair<RasterCache&, std::mutex&> {
+    static RasterCache cache(TexImage::RASTER_CACHE_BYTES);
+    static std::mutex mutex;
+    return {cache, mutex};
+}
+
+auto rasterBytes(cairo_surface_t* raster) -> size_t {
+    return static_cast<size_t>(cairo_image_surface_get_stride(raster)) *
+           static_cast<size_t>(cairo_image_surface_get_height(raster));
+}
+
+std::atomic<uint64_t> nextRasterKey{1};
+}  // namespace
+
 TexImage::TexImage(): Element(ELEMENT_TEXIMAGE) { this->sizeCalculated = true; }
 
 TexImage::~TexImage() { freeImageAndPdf(); }
@@ -25,6 +63,9 @@ void TexImage::freeImageAndPdf() {
     }
 
     this->pdf.reset();
+
+    // The rasterizations are dropped by the cache once they are not used anymore
+    this->rasterKey = 0;
 }
 
 auto TexImage::cloneTexImage() const -> std::unique_ptr<TexImage> {
@@ -47,11 +88,22 @@ auto TexImage::cloneTexImage() const -> std::unique_ptr<TexImage> {
     // the PDF we've given it).
     img->loadData(std::string(this->binaryData), nullptr);
 
+    // Same PDF, same rasterizations
+    img->rasterKey = this->rasterKey;
+
     return img;
 }
 
 auto TexImage::clone() const -> ElementPtr { return cloneTexImage(); }
 
+auto TexImage::getMemoryUsage() const -> size_t { return sizeof(TexImage) + binaryData.capacity(); }
+
+auto TexImage::getRasterCacheMemoryUsage() -> size_t {
+    auto [cache, mutex] = rasterCache();
+    std::lock_guard<std::mutex> lock(mutex);
+    return cache.getWeight();
+}
+
 void TexImage::setWidth(double width) {
     this->width = width;
     this->calcSize();
@@ -97,6 +149,7 @@ auto TexImage::loadData(std::string&& bytes, GError** err) -> bool {
         if (!pdf.get() || poppler_document_get_n_pages(this->pdf.get()) < 1) {
             return false;
         }
+        this->rasterKey = nextRasterKey++;
         if (std::abs(this->width * this->height) <= std::numeric_limits<double>::epsilon()) {
             xoj::util::GObjectSPtr<PopplerPage> page(poppler_document_get_page(this->pdf.get(), 0), xoj::util::adopt);
             poppler_page_get_size(page.get(), &this->width, &this->height);
@@ -115,6 +168,26 @@ auto TexImage::getImage() const -> cairo_surface_t* { return this->image; }
 
 auto TexImage::getPdf() const -> PopplerDocument* { return this->pdf.get(); }
 
+auto TexImage::getCachedRaster(int width, int height) const -> xoj::util::CairoSurfaceSPtr {
+    auto [cache, mutex] = rasterCache();
+    std::lock_guard<std::mutex> lock(mutex);
+    auto* raster = cache.get({this->rasterKey, width, height});
+    return raster ? *raster : nullptr;
+}
+
+void TexImage::cacheRaster(xoj::util::CairoSurfaceSPtr raster) const {
+    if (this->rasterKey == 0) {
+        return;
+    }
+    RasterId id{this->rasterKey, cairo_image_surface_get_width(raster.get()),
+                cairo_image_surface_get_height(raster.get())};
+    const size_t bytes = rasterBytes(raster.get());
+    auto [cache, mutex] = rasterCache();
+    std::lock_guard<std::mutex> lock(mutex);
+    // Replaces the rasterization if it was rendered by another thread in the meantime
+    cache.put(id, std::move(raster), bytes);
+}
+
 void TexImage::scale(double x0, double y0, double fx, double fy, double rotation,
                      bool) {  // line width scaling option is not used
 
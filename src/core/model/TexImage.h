@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint64_t
 #include <memory>
 #include <string>  // for string
 
@@ -18,7 +20,8 @@
 #include <glib.h>     // for GError
 #include <poppler.h>  // for PopplerDocument
 
-#include "util/raii/GObjectSPtr.h"  // for GObjectSPtr
+#include "util/raii/CairoWrappers.h"  // for CairoSurfaceSPtr
+#include "util/raii/GObjectSPtr.h"    // for GObjectSPtr
 
 #include "Element.h"  // for Element
 
@@ -56,6 +59,29 @@ public:
      */
     PopplerDocument* getPdf() const;
 
+    /**
+     * Rasterizations of the PDF at a few sizes, shared by all the views of the element (main view, previews and
+     * selection) and by its clones. They are kept in a cache common to all the TexImages, which drops the least
+     * recently used rasterizations beyond RASTER_CACHE_BYTES. May be called from the render threads.
+     *
+     * @return The rasterization of the given size in pixels, or nullptr if there is none
+     */
+    xoj::util::CairoSurfaceSPtr getCachedRaster(int width, int height) const;
+
+    /**
+     * Adds a rasterization of the PDF to the cache
+     */
+    void cacheRaster(xoj::util::CairoSurfaceSPtr raster) const;
+
+    /// Total size of the rasterizations of all the TexImages
+    static constexpr size_t RASTER_CACHE_BYTES = 64 * 1024 * 1024;
+
+    /**
+     * @return The size of the rasterizations currently cached, counted once for all the TexImages. They are not part
+     * of getMemoryUsage(): a rasterization is shared by an element and its clones, and dropped by the cache anyway.
+     */
+    static size_t getRasterCacheMemoryUsage();
+
     void scale(double x0, double y0, double fx, double fy, double rotation, bool restoreLineWidth) override;
     void rotate(double x0, double y0, double th) override;
 
@@ -65,6 +91,7 @@ public:
 
     auto cloneTexImage() const -> std::unique_ptr<TexImage>;
     auto clone() const -> ElementPtr override;
+    size_t getMemoryUsage() const override;
 
     /**
      * @return true if the binary data (PNG or PDF) was loaded successfully.
@@ -92,6 +119,12 @@ private:
      */
     xoj::util::GObjectSPtr<PopplerDocument> pdf;
 
+    /**
+     * Identifies the rasterizations of the PDF in the cache: set when a PDF is loaded, and shared with the clones.
+     * 0 if there is no PDF.
+     */
+    uint64_t rasterKey = 0;
+
     /**
      * Tex image, if rendered as image. Note: this is deprecated and subject to removal in a later version.
      */
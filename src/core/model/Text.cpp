@@ -45,6 +45,8 @@ auto Text::cloneText() const -> std::unique_ptr<Text> {
 
 auto Text::clone() const -> ElementPtr { return cloneText(); }
 
+auto Text::getMemoryUsage() const -> size_t { return sizeof(Text) + text.capacity(); }
+
 auto Text::getFont() -> XojFont& { return font; }
 
 void Text::setFont(const XojFont& font) { this->font = font; }
@@ -11,7 +11,8 @@
 
 #pragma once
 
-#include <string>  // for string
+#include <cstddef>  // for size_t
+#include <string>   // for string
 #include <vector>
 
 #include <pango/pango.h>
@@ -57,6 +58,7 @@ public:
 
     auto cloneText() const -> std::unique_ptr<Text>;
     auto clone() const -> ElementPtr override;
+    size_t getMemoryUsage() const override;
 
     bool intersects(double x, double y, double halfEraserSize) const override;
     bool intersects(double x, double y, double halfEraserSize, double* gap) const override;
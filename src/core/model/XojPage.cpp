@@ -40,11 +40,13 @@ XojPage::XojPage(XojPage const& page):
 auto XojPage::clone() -> XojPage* { return new XojPage(*this); }
 
 void XojPage::addLayer(Layer* layer) {
+    bumpRevision();
     this->layer.push_back(layer);
     this->currentLayer = npos;
 }
 
 void XojPage::insertLayer(Layer* layer, Layer::Index index) {
+    bumpRevision();
     if (index >= this->layer.size()) {
         addLayer(layer);
         return;
@@ -55,6 +57,7 @@ void XojPage::insertLayer(Layer* layer, Layer::Index index) {
 }
 
 void XojPage::removeLayer(Layer* l) {
+    bumpRevision();
     if (auto it = std::find(layer.begin(), layer.end(), l); it != layer.end()) {
         this->layer.erase(it);
     }
@@ -83,6 +86,7 @@ auto XojPage::getSelectedLayerId() -> Layer::Index {
 }
 
 void XojPage::setLayerVisible(Layer::Index layerId, bool visible) {
+    bumpRevision();
     if (layerId == 0) {
         backgroundVisible = visible;
         return;
@@ -110,16 +114,21 @@ auto XojPage::isLayerVisible(Layer::Index layerId) const -> bool {
 }
 
 void XojPage::setBackgroundPdfPageNr(size_t page) {
+    bumpRevision();
     this->pdfBackgroundPage = page;
     this->bgType.format = PageTypeFormat::Pdf;
     this->bgType.config = "";
 }
 
-void XojPage::setBackgroundColor(Color color) { this->backgroundColor = color; }
+void XojPage::setBackgroundColor(Color color) {
+    bumpRevision();
+    this->backgroundColor = color;
+}
 
 auto XojPage::getBackgroundColor() const -> Color { return this->backgroundColor; }
 
 void XojPage::setSize(double width, double height) {
+    bumpRevision();
     this->width = width;
     this->height = height;
 }
@@ -140,6 +149,7 @@ auto XojPage::isAnnotated() const -> bool {
 }
 
 void XojPage::setBackgroundType(const PageType& bgType) {
+    bumpRevision();
     this->bgType = bgType;
 
     if (!bgType.isPdfPage()) {
@@ -154,7 +164,10 @@ auto XojPage::getBackgroundType() -> PageType { return this->bgType; }
 
 auto XojPage::getBackgroundImage() -> BackgroundImage& { return this->backgroundImage; }
 
-void XojPage::setBackgroundImage(BackgroundImage img) { this->backgroundImage = std::move(img); }
+void XojPage::setBackgroundImage(BackgroundImage img) {
+    bumpRevision();
+    this->backgroundImage = std::move(img);
+}
 
 auto XojPage::getSelectedLayer() -> Layer* {
     xoj_assert(!layer.empty());
@@ -17,7 +17,8 @@ using std::string;
 
 PopplerGlibDocument::PopplerGlibDocument() = default;
 
-PopplerGlibDocument::PopplerGlibDocument(const PopplerGlibDocument& doc): document(doc.document) {
+PopplerGlibDocument::PopplerGlibDocument(const PopplerGlibDocument& doc):
+        document(doc.document), renderMutex(doc.renderMutex) {
     if (document) {
         g_object_ref(document);
     }
@@ -35,7 +36,9 @@ void PopplerGlibDocument::assign(XojPdfDocumentInterface* doc) {
         g_object_unref(document);
     }
 
-    document = (dynamic_cast<PopplerGlibDocument*>(doc))->document;
+    auto* other = dynamic_cast<PopplerGlibDocument*>(doc);
+    document = other->document;
+    renderMutex = other->renderMutex;
     if (document) {
         g_object_ref(document);
     }
@@ -69,6 +72,7 @@ auto PopplerGlibDocument::load(fs::path const& file, string password, GError** e
     }
 
     this->document = poppler_document_new_from_file(uri->c_str(), password.c_str(), error);
+    this->renderMutex = std::make_shared<std::mutex>();
     return this->document != nullptr;
 }
 
@@ -82,6 +86,7 @@ auto PopplerGlibDocument::load(std::unique_ptr<std::string> data, string passwor
     data.release();  // the string will be deleted with the bytes object
     this->document = poppler_document_new_from_bytes(bytes, password.c_str(), error);
     g_bytes_unref(bytes);  // a reference is now held by the document
+    this->renderMutex = std::make_shared<std::mutex>();
 
     return this->document != nullptr;
 }
@@ -93,6 +98,7 @@ void PopplerGlibDocument::reset() {
         g_object_unref(document);
         document = nullptr;
     }
+    renderMutex.reset();
 }
 
 auto PopplerGlibDocument::getPage(size_t page) const -> XojPdfPageSPtr {
@@ -101,7 +107,7 @@ auto PopplerGlibDocument::getPage(size_t page) const -> XojPdfPageSPtr {
     }
 
     PopplerPage* pg = poppler_document_get_page(document, int(page));
-    XojPdfPageSPtr pageptr = std::make_shared<PopplerGlibPage>(pg, document);
+    XojPdfPageSPtr pageptr = std::make_shared<PopplerGlibPage>(pg, document, renderMutex);
     g_object_unref(pg);
 
     return pageptr;
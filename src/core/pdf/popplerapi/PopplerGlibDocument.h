@@ -12,6 +12,8 @@
 #pragma once
 
 #include <cstddef>  // for size_t
+#include <memory>   // for shared_ptr
+#include <mutex>    // for mutex
 #include <string>   // for string
 
 #include <glib.h>     // for GError, gpointer, gsize
@@ -47,4 +49,10 @@ public:
 
 private:
     PopplerDocument* document = nullptr;
+
+    /**
+     * Poppler is not thread safe for concurrent rendering of the same document. The pages are rendered from several
+     * threads (PdfCache, print spooler, exports): they share this mutex, created along with the PopplerDocument.
+     */
+    std::shared_ptr<std::mutex> renderMutex;
 };
@@ -3,7 +3,9 @@
 #include <algorithm>  // for max, min
 #include <cstdlib>    // for abs, NULL, ptrdiff_t
 #include <memory>     // for make_unique
+#include <mutex>      // for lock_guard
 #include <sstream>    // for operator<<, ostringstream, bas...
+#include <utility>    // for move
 
 #include <glib.h>          // for g_free, g_utf8_offset_to_pointer
 #include <poppler-page.h>  // for _PopplerRectangle, _PopplerLin...
@@ -19,13 +21,16 @@
 #include "PopplerGlibAction.h"  // for PopplerGlibAction
 #include "cairo.h"              // for cairo_region_create, cairo_reg...
 
-PopplerGlibPage::PopplerGlibPage(PopplerPage* page, PopplerDocument* parentDoc): page(page), document(parentDoc) {
+PopplerGlibPage::PopplerGlibPage(PopplerPage* page, PopplerDocument* parentDoc,
+                                 std::shared_ptr<std::mutex> renderMutex):
+        page(page), document(parentDoc), renderMutex(std::move(renderMutex)) {
     if (page != nullptr) {
         g_object_ref(page);
     }
 }
 
-PopplerGlibPage::PopplerGlibPage(const PopplerGlibPage& other): page(other.page), document(other.document) {
+PopplerGlibPage::PopplerGlibPage(const PopplerGlibPage& other):
+        page(other.page), document(other.document), renderMutex(other.renderMutex) {
     if (page != nullptr) {
         g_object_ref(page);
     }
@@ -55,6 +60,7 @@ PopplerGlibPage& PopplerGlibPage::operator=(const PopplerGlibPage& other) {
     }
 
     document = other.document;
+    renderMutex = other.renderMutex;
 
     return *this;
 }
@@ -77,11 +83,17 @@ void PopplerGlibPage::render(cairo_t* cr) const {
     cairo_save(cr);
     cairo_set_source_rgb(cr, 1., 1., 1.);
     cairo_paint(cr);
-    poppler_page_render(page, cr);
+    {
+        std::lock_guard lock(*renderMutex);
+        poppler_page_render(page, cr);
+    }
     cairo_restore(cr);
 }
 
-void PopplerGlibPage::renderForPrinting(cairo_t* cr) const { poppler_page_render_for_printing(page, cr); }
+void PopplerGlibPage::renderForPrinting(cairo_t* cr) const {
+    std::lock_guard lock(*renderMutex);
+    poppler_page_render_for_printing(page, cr);
+}
 
 auto PopplerGlibPage::getPageId() const -> int { return poppler_page_get_index(page); }
 
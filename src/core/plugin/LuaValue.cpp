@@ -0,0 +1,135 @@
+#include "LuaValue.h"
+
+#ifdef ENABLE_PLUGINS
+
+#include <type_traits>  // for decay_t, is_same_v
+#include <utility>      // for move
+
+extern "C" {
+#include <lauxlib.h>  // for luaL_checkstack, luaL_typename
+}
+
+LuaValue::LuaValue(lua_Number n): value(n) {}
+
+LuaValue::LuaValue(std::string s): value(std::move(s)) {}
+
+auto LuaValue::fromLua(lua_State* L, int idx, std::string& error) -> std::optional<LuaValue> {
+    return fromLua(L, lua_absindex(L, idx), error, 0);
+}
+
+auto LuaValue::fromLua(lua_State* L, int idx, std::string& error, int depth) -> std::optional<LuaValue> {
+    LuaValue v;
+    switch (lua_type(L, idx)) {
+        case LUA_TNIL:
+            break;
+        case LUA_TBOOLEAN:
+            v.value = static_cast<bool>(lua_toboolean(L, idx));
+            break;
+        case LUA_TNUMBER:
+            if (lua_isinteger(L, idx)) {
+                v.value = lua_tointeger(L, idx);
+            } else {
+                v.value = lua_tonumber(L, idx);
+            }
+            break;
+        case LUA_TSTRING: {
+            size_t len = 0;
+            const char* s = lua_tolstring(L, idx, &len);
+            v.value = std::string(s, len);
+            break;
+        }
+        case LUA_TTABLE: {
+            if (depth >= MAX_DEPTH) {
+                error = "Tables are nested too deeply";
+                return std::nullopt;
+            }
+            // Not luaL_checkstack: raising a Lua error would skip the destructors of the tables being copied
+            if (!lua_checkstack(L, 2)) {
+                error = "Not enough memory to copy the table";
+                return std::nullopt;
+            }
+            auto table = std::make_shared<Table>();
+            lua_pushnil(L);
+            while (lua_next(L, idx) != 0) {
+                // stack now has following:
+                // -2 = key
+                // -1 = value
+                auto key = fromLua(L, lua_absindex(L, -2), error, depth + 1);
+                auto val = key ? fromLua(L, lua_absindex(L, -1), error, depth + 1) : std::nullopt;
+                if (!val) {
+                    lua_pop(L, 2);
+                    return std::nullopt;
+                }
+                table->emplace_back(std::move(*key), std::move(*val));
+                lua_pop(L, 1);  // keep the key for lua_next
+            }
+            v.value = std::shared_ptr<const Table>(std::move(table));
+            break;
+        }
+        default:
+            error = std::string("Values of type ") + luaL_typename(L, idx) + " can not be copied";
+            return std::nullopt;
+    }
+    return v;
+}
+
+void LuaValue::push(lua_State* L) const {
+    luaL_checkstack(L, 3, "copying value");
+    std::visit(
+            [L](auto&& v) {
+                using T = std::decay_t<decltype(v)>;
+                if constexpr (std::is_same_v<T, std::monostate>) {
+                    lua_pushnil(L);
+                } else if constexpr (std::is_same_v<T, bool>) {
+                    lua_pushboolean(L, v);
+                } else if constexpr (std::is_same_v<T, lua_Integer>) {
+                    lua_pushinteger(L, v);
+                } else if constexpr (std::is_same_v<T, lua_Number>) {
+                    lua_pushnumber(L, v);
+                } else if constexpr (std::is_same_v<T, std::string>) {
+                    lua_pushlstring(L, v.data(), v.size());
+                } else {
+                    lua_createtable(L, 0, static_cast<int>(v->size()));
+                    for (const auto& [key, val]: *v) {
+                        key.push(L);
+                        val.push(L);
+                        lua_rawset(L, -3);
+                    }
+                }
+            },
+            value);
+}
+
+auto LuaValue::pcall(lua_State* L, const std::vector<LuaValue>& args, int nresults) -> int {
+    if (!lua_checkstack(L, 2)) {
+        // Replaces the function, without allocating
+        lua_pop(L, 1);
+        lua_pushnil(L);
+        return LUA_ERRMEM;
+    }
+    lua_pushcfunction(L, pushArgumentsAndCall);
+    lua_insert(L, -2);
+    lua_pushlightuserdata(L, const_cast<std::vector<LuaValue>*>(&args));
+    return lua_pcall(L, 2, nresults, 0);
+}
+
+auto LuaValue::pushArgumentsAndCall(lua_State* L) -> int {
+    const auto* args = static_cast<const std::vector<LuaValue>*>(lua_touserdata(L, 2));
+    lua_settop(L, 1);
+    for (const LuaValue& arg: *args) {
+        arg.push(L);
+    }
+    lua_call(L, static_cast<int>(args->size()), LUA_MULTRET);
+    return lua_gettop(L);
+}
+
+auto LuaValue::errorMessage(lua_State* L, int idx) -> std::string {
+    if (lua_type(L, idx) == LUA_TSTRING) {
+        size_t len = 0;
+        const char* s = lua_tolstring(L, idx, &len);
+        return std::string(s, len);
+    }
+    return std::string("(error object is a ") + luaL_typename(L, idx) + " value)";
+}
+
+#endif
@@ -0,0 +1,78 @@
+/*
+ * Xournal++
+ *
+ * A copy of a Lua value, independent of any Lua state
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include "config-features.h"  // for ENABLE_PLUGINS
+
+#ifdef ENABLE_PLUGINS
+
+#include <memory>    // for shared_ptr
+#include <optional>  // for optional
+#include <string>    // for string
+#include <utility>   // for pair
+#include <variant>   // for variant, monostate
+#include <vector>    // for vector
+
+extern "C" {
+#include <lua.h>  // for lua_State, lua_Integer, lua_Number
+}
+
+/**
+ * Lua states can not be shared between threads: the values passed between the plugin and its background jobs are
+ * copied into LuaValue's. Only nil, booleans, numbers, strings and tables of those can be copied.
+ */
+class LuaValue final {
+public:
+    using Table = std::vector<std::pair<LuaValue, LuaValue>>;
+
+    /// nil
+    LuaValue() = default;
+    explicit LuaValue(lua_Number n);
+    explicit LuaValue(std::string s);
+
+    /**
+     * Copies the value at the given index of the stack
+     * @param error Set to the reason if the value can not be copied
+     * @return std::nullopt if the value (or a value in the table) can not be copied
+     */
+    static auto fromLua(lua_State* L, int idx, std::string& error) -> std::optional<LuaValue>;
+
+    /// Pushes a copy of the value onto the stack. May raise a Lua error: see pcall().
+    void push(lua_State* L) const;
+
+    /**
+     * Calls the function on top of the stack with copies of args, like lua_pcall. The copies are pushed in protected
+     * mode too: running out of memory while copying them is reported as an error of the call.
+     * @return The status of the call. Unless it is LUA_OK, the error object replaces the function.
+     */
+    static int pcall(lua_State* L, const std::vector<LuaValue>& args, int nresults);
+
+    /**
+     * @return The message of the error object at the given index. Unlike luaL_tolstring, never raises a Lua error.
+     */
+    static auto errorMessage(lua_State* L, int idx) -> std::string;
+
+private:
+    static auto fromLua(lua_State* L, int idx, std::string& error, int depth) -> std::optional<LuaValue>;
+
+    /// Called in protected mode by pcall() with the function and the address of the arguments
+    static int pushArgumentsAndCall(lua_State* L);
+
+private:
+    /// Tables are immutable once copied: they are shared instead of being copied again
+    std::variant<std::monostate, bool, lua_Integer, lua_Number, std::string, std::shared_ptr<const Table>> value;
+
+    /// Nesting limit of the tables, which also protects against tables containing themselves
+    static constexpr int MAX_DEPTH = 64;
+};
+
+#endif
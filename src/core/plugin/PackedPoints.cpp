@@ -0,0 +1,43 @@
+#include "PackedPoints.h"
+
+#ifdef ENABLE_PLUGINS
+
+#include <cstring>  // for memcpy
+
+extern "C" {
+#include <lauxlib.h>  // for luaL_Buffer, luaL_buffinitsize, luaL_pushresultsize
+}
+
+void PackedPoints::push(lua_State* L, const std::vector<Point>& points) {
+    const size_t size = points.size() * POINT_SIZE;
+    luaL_Buffer buffer;
+    char* out = luaL_buffinitsize(L, &buffer, size);
+    for (const Point& p: points) {
+        std::memcpy(out, &p.x, sizeof(double));
+        std::memcpy(out + sizeof(double), &p.y, sizeof(double));
+        std::memcpy(out + 2 * sizeof(double), &p.z, sizeof(double));
+        out += POINT_SIZE;
+    }
+    luaL_pushresultsize(&buffer, size);
+}
+
+auto PackedPoints::read(lua_State* L, int idx, std::vector<Point>& points) -> bool {
+    if (lua_type(L, idx) != LUA_TSTRING) {
+        return false;
+    }
+    size_t size = 0;
+    const char* data = lua_tolstring(L, idx, &size);
+    if (size % POINT_SIZE != 0) {
+        return false;
+    }
+    points.resize(size / POINT_SIZE);
+    for (Point& p: points) {
+        std::memcpy(&p.x, data, sizeof(double));
+        std::memcpy(&p.y, data + sizeof(double), sizeof(double));
+        std::memcpy(&p.z, data + 2 * sizeof(double), sizeof(double));
+        data += POINT_SIZE;
+    }
+    return true;
+}
+
+#endif
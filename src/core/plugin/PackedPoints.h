@@ -0,0 +1,48 @@
+/*
+ * Xournal++
+ *
+ * Points of strokes packed in Lua strings, for the packed stroke API of the plugins
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include "config-features.h"  // for ENABLE_PLUGINS
+
+#ifdef ENABLE_PLUGINS
+
+#include <cstddef>  // for size_t
+#include <vector>   // for vector
+
+#include "model/Point.h"  // for Point
+
+extern "C" {
+#include <lua.h>  // for lua_State
+}
+
+/**
+ * Each point is packed as three native-endian doubles: x, y and pressure. Plugins read them with
+ * string.unpack("ddd", points, pos) and write them with string.pack("ddd", x, y, pressure).
+ */
+namespace PackedPoints {
+/// Size of a packed point, in bytes
+constexpr size_t POINT_SIZE = 3 * sizeof(double);
+
+/**
+ * Pushes the points onto the stack as a string of packed doubles
+ */
+void push(lua_State* L, const std::vector<Point>& points);
+
+/**
+ * Reads the string of packed doubles at the given index of the stack
+ *
+ * @return false if the value is not a string of packed points
+ */
+bool read(lua_State* L, int idx, std::vector<Point>& points);
+}  // namespace PackedPoints
+
+#endif
@@ -29,6 +29,7 @@ extern "C" {
 #include <lualib.h>   // for luaL_openlibs
 }
 
+#include "PluginJob.h"          // for PluginJob
 #include "luapi_application.h"  // for luaopen_app
 
 /*
@@ -42,6 +43,14 @@ Plugin::Plugin(Control* control, std::string name, fs::path path):
     loadIni();
 }
 
+Plugin::~Plugin() {
+    // Stop all the jobs at once, then wait for them, before the members they use are destroyed
+    for (auto& [id, job]: jobs) {
+        job->cancel();
+    }
+    jobs.clear();
+}
+
 auto Plugin::getPluginFromLua(lua_State* lua) -> Plugin* {
     lua_getfield(lua, LUA_REGISTRYINDEX, "Xournalpp_Plugin");
 
@@ -313,6 +322,43 @@ auto Plugin::callFunction(const std::string& fnc, const char* s) -> bool {
     return true;
 }
 
+auto Plugin::callFunction(const std::string& fnc, const std::vector<LuaValue>& args) -> bool {
+    lua_getglobal(lua.get(), fnc.c_str());
+
+    // Run the function
+    if (LuaValue::pcall(lua.get(), args, 0)) {
+        std::string errMsg = LuaValue::errorMessage(lua.get(), -1);
+        lua_pop(lua.get(), 1);
+        XojMsgBox::showPluginMessage(name, errMsg, true);
+
+        g_warning("Error in Plugin: \"%s\", error: \"%s\"", name.c_str(), errMsg.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+auto Plugin::startJob(const fs::path& script, LuaValue input, std::string callback, std::string progressCallback)
+        -> int {
+    int id = nextJobId++;
+    auto job = std::make_shared<PluginJob>(this, id, path / script, std::move(input),
+                                           PluginJob::Callbacks{std::move(callback), std::move(progressCallback)});
+    jobs.emplace(id, job);
+    job->start();
+    return id;
+}
+
+auto Plugin::cancelJob(int id) -> bool {
+    auto it = jobs.find(id);
+    if (it == jobs.end()) {
+        return false;
+    }
+    it->second->cancel();
+    return true;
+}
+
+void Plugin::removeJob(int id) { jobs.erase(id); }
+
 auto Plugin::getName() const -> std::string const& { return name; }
 auto Plugin::getDescription() const -> std::string const& { return description; }
 auto Plugin::getAuthor() const -> std::string const& { return author; }
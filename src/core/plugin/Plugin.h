@@ -19,6 +19,7 @@
 
 #ifdef ENABLE_PLUGINS
 
+#include <map>      // for map
 #include <string>   // for string
 #include <utility>  // for move
 #include <vector>   // for vector
@@ -27,6 +28,7 @@
 
 #include "util/raii/GObjectSPtr.h"
 
+#include "LuaValue.h"    // for LuaValue
 #include "filesystem.h"  // for path
 
 extern "C" {
@@ -34,6 +36,7 @@ extern "C" {
 }
 
 class Plugin;
+class PluginJob;
 class Control;
 class ToolMenuHandler;
 
@@ -85,6 +88,10 @@ struct LuaDeleter {
 class Plugin final {
 public:
     Plugin(Control* control, std::string name, fs::path path);
+    ~Plugin();
+
+    Plugin(const Plugin&) = delete;
+    Plugin& operator=(const Plugin&) = delete;
 
 public:
     /// Load the plugin script
@@ -168,6 +175,23 @@ public:
     /// Execute lua function
     auto callFunction(const std::string& fnc, ptrdiff_t mode = std::numeric_limits<ptrdiff_t>::max()) -> bool;
     auto callFunction(const std::string& fnc, const char* s) -> bool;
+    auto callFunction(const std::string& fnc, const std::vector<LuaValue>& args) -> bool;
+
+    /**
+     * @brief Run a Lua script of the plugin on a background thread
+     * @param script Path of the script, relative to the plugin folder
+     * @param input Argument of the script
+     * @param callback Function called on the main thread with the result of the script
+     * @param progressCallback Function called on the main thread with the progress reported by the script (optional)
+     * @return The id of the job
+     */
+    auto startJob(const fs::path& script, LuaValue input, std::string callback, std::string progressCallback) -> int;
+
+    /// @return false if there is no running job with this id
+    auto cancelJob(int id) -> bool;
+
+    /// Forget a finished job
+    void removeJob(int id);
 
 private:
     Control* control;                                      ///< The main controller
@@ -175,6 +199,8 @@ private:
     std::vector<MenuEntry> menuEntries;                    ///< All registered menu entries
     xoj::util::GObjectSPtr<GMenu> menuSection;             ///< Menu section containing the menu entries
     std::vector<ToolbarButtonEntry> toolbarButtonEntries;  ///< All registered toolbar button entries
+    std::map<int, std::shared_ptr<PluginJob>> jobs;        ///< Running background jobs, cancelled when destroyed
+    int nextJobId = 1;                                     ///< Id of the next background job
 
 
     std::string name;             ///< Plugin name
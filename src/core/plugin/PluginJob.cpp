@@ -0,0 +1,212 @@
+#include "PluginJob.h"
+
+#ifdef ENABLE_PLUGINS
+
+#include <algorithm>  // for clamp
+#include <utility>    // for move
+
+#include <glib.h>  // for g_warning
+
+#include "util/Util.h"       // for execInUiThread
+#include "util/XojMsgBox.h"  // for XojMsgBox
+
+extern "C" {
+#include <lauxlib.h>  // for luaL_Reg, luaL_newstate, luaL_error
+#include <lualib.h>   // for luaL_openlibs
+}
+
+PluginJob::PluginJob(Plugin* plugin, int id, fs::path script, LuaValue input, Callbacks callbacks):
+        plugin(plugin),
+        id(id),
+        script(std::move(script)),
+        pluginPath(plugin->getPath()),
+        input(std::move(input)),
+        callbacks(std::move(callbacks)) {}
+
+PluginJob::~PluginJob() {
+    cancel();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void PluginJob::start() { thread = std::thread([this] { run(); }); }
+
+void PluginJob::cancel() { cancelled = true; }
+
+auto PluginJob::getId() const -> int { return id; }
+
+void PluginJob::run() {
+    lua.reset(luaL_newstate());
+    lua_State* L = lua.get();
+    openLibs();
+
+    if (luaL_loadfile(L, script.string().c_str()) != LUA_OK) {
+        error = LuaValue::errorMessage(L, -1);
+    } else {
+        std::vector<LuaValue> args;
+        args.emplace_back(std::move(input));
+        if (LuaValue::pcall(L, args, 1) != LUA_OK) {
+            error = cancelled ? "Cancelled" : LuaValue::errorMessage(L, -1);
+        } else if (auto value = LuaValue::fromLua(L, -1, error)) {
+            result = std::move(*value);
+        }
+    }
+    lua.reset();
+
+    Util::execInUiThread([job = weak_from_this()]() {
+        if (auto self = job.lock()) {
+            self->finished();
+        }
+    });
+}
+
+void PluginJob::finished() {
+    thread.join();
+
+    // Removing the job from the plugin would destroy it
+    auto self = shared_from_this();
+    plugin->removeJob(id);
+
+    if (!callbacks.done.empty()) {
+        if (error.empty()) {
+            plugin->callFunction(callbacks.done, {result});
+        } else {
+            plugin->callFunction(callbacks.done, {LuaValue(), LuaValue(error)});
+        }
+    } else if (!error.empty()) {
+        XojMsgBox::showPluginMessage(plugin->getName(), error, true);
+        g_warning("Error in background job of Plugin: \"%s\", error: \"%s\"", plugin->getName().c_str(),
+                  error.c_str());
+    }
+}
+
+void PluginJob::reportProgress(double fraction, std::string message) {
+    std::lock_guard lock(progressMutex);
+    progressFraction = fraction;
+    progressMessage = std::move(message);
+    if (progressScheduled || callbacks.progress.empty()) {
+        return;
+    }
+    progressScheduled = true;
+
+    Util::execInUiThread([job = weak_from_this()]() {
+        auto self = job.lock();
+        if (!self) {
+            return;
+        }
+        std::vector<LuaValue> args;
+        {
+            std::lock_guard lock(self->progressMutex);
+            self->progressScheduled = false;
+            args = {LuaValue(self->progressFraction), LuaValue(self->progressMessage)};
+        }
+        self->plugin->callFunction(self->callbacks.progress, args);
+    });
+}
+
+void PluginJob::post(std::string fnc, std::vector<LuaValue> args) {
+    Util::execInUiThread([job = weak_from_this(), fnc = std::move(fnc), args = std::move(args)]() {
+        if (auto self = job.lock()) {
+            self->plugin->callFunction(fnc, args);
+        }
+    });
+}
+
+auto PluginJob::getJobFromLua(lua_State* L) -> PluginJob* {
+    lua_getfield(L, LUA_REGISTRYINDEX, "Xournalpp_PluginJob");
+    auto* job = static_cast<PluginJob*>(lua_touserdata(L, -1));
+    lua_pop(L, 1);
+    return job;
+}
+
+void PluginJob::cancellationHook(lua_State* L, lua_Debug*) {
+    if (getJobFromLua(L)->cancelled) {
+        luaL_error(L, "Cancelled");
+    }
+}
+
+/**
+ * Reports the progress of the job. The progress callback of the plugin is called on the main thread with the latest
+ * progress, as soon as the user interface is idle.
+ *
+ * @param fraction number between 0 and 1
+ * @param message string (optional)
+ *
+ * Example: job.progress(i / n, "Smoothing stroke " .. i)
+ */
+int PluginJob::joblib_progress(lua_State* L) {
+    double fraction = std::clamp(luaL_checknumber(L, 1), 0.0, 1.0);
+    std::string message = luaL_optstring(L, 2, "");
+    getJobFromLua(L)->reportProgress(fraction, std::move(message));
+    return 0;
+}
+
+/**
+ * Calls a global function of the plugin on the main thread, with a copy of the given arguments. The calls are made in
+ * order, and before the callback of the job. The function can use the app library.
+ *
+ * @param fnc string name of the function
+ * @param ... nil, boolean, number, string or table arguments
+ *
+ * Example: job.post("showMessage", "Half way through")
+ */
+int PluginJob::joblib_post(lua_State* L) {
+    luaL_checkstring(L, 1);
+    bool posted = [L] {
+        std::string fnc = lua_tostring(L, 1);
+        std::vector<LuaValue> args;
+        std::string error;
+        for (int i = 2; i <= lua_gettop(L); i++) {
+            auto value = LuaValue::fromLua(L, i, error);
+            if (!value) {
+                lua_pushfstring(L, "Argument %d: %s", i, error.c_str());
+                return false;
+            }
+            args.emplace_back(std::move(*value));
+        }
+        getJobFromLua(L)->post(std::move(fnc), std::move(args));
+        return true;
+    }();
+    if (!posted) {
+        // Raised once the C++ objects above are destroyed: Lua errors do not unwind the C++ stack
+        return lua_error(L);
+    }
+    return 0;
+}
+
+/**
+ * @return boolean true if the job was cancelled. Lua code is interrupted anyway, but long computations in C functions
+ * are not.
+ */
+int PluginJob::joblib_isCancelled(lua_State* L) {
+    lua_pushboolean(L, getJobFromLua(L)->cancelled);
+    return 1;
+}
+
+void PluginJob::openLibs() {
+    lua_State* L = lua.get();
+    luaL_openlibs(L);
+
+    lua_pushlightuserdata(L, this);
+    lua_setfield(L, LUA_REGISTRYINDEX, "Xournalpp_PluginJob");
+
+    static const luaL_Reg joblib[] = {{"progress", joblib_progress},
+                                      {"post", joblib_post},
+                                      {"isCancelled", joblib_isCancelled},
+                                      {nullptr, nullptr}};
+    luaL_newlib(L, joblib);
+    lua_setglobal(L, "job");
+
+    // Let the script require the modules of the plugin
+    lua_getglobal(L, "package");
+    auto path = (pluginPath / "?.lua").string();
+    lua_getfield(L, -1, "path");
+    lua_pushfstring(L, "%s;%s", path.c_str(), lua_tostring(L, -1));
+    lua_setfield(L, -3, "path");
+    lua_pop(L, 2);
+
+    lua_sethook(L, cancellationHook, LUA_MASKCOUNT, LUA_HOOK_COUNT);
+}
+
+#endif
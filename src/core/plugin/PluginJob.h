@@ -0,0 +1,114 @@
+/*
+ * Xournal++
+ *
+ * A Lua script of a plugin, run on a background thread
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include "config-features.h"  // for ENABLE_PLUGINS
+
+#ifdef ENABLE_PLUGINS
+
+#include <atomic>  // for atomic_bool
+#include <memory>  // for enable_shared_from_this, unique_ptr
+#include <mutex>   // for mutex
+#include <string>  // for string
+#include <thread>  // for thread
+#include <vector>  // for vector
+
+#include "LuaValue.h"    // for LuaValue
+#include "Plugin.h"      // for LuaDeleter
+#include "filesystem.h"  // for path
+
+extern "C" {
+#include <lua.h>  // for lua_State, lua_Debug
+}
+
+/**
+ * The script runs in its own Lua state, without access to the app library: the document and the user interface can
+ * only be accessed from the main thread. Instead:
+ *  - the script gets a copy of the input given by the plugin (e.g. the result of app.getStrokesPacked), as argument;
+ *  - the job library lets the script report its progress, check for cancellation and post calls to functions of the
+ *    plugin, which are run on the main thread with a copy of the arguments;
+ *  - the value returned by the script is passed to the callback of the plugin on the main thread, which applies the
+ *    changes to the document at once (e.g. with app.setStrokesPacked).
+ */
+class PluginJob final: public std::enable_shared_from_this<PluginJob> {
+public:
+    struct Callbacks {
+        std::string done;      ///< Called with the result (or nil and the error message) of the script
+        std::string progress;  ///< Called with the progress (between 0 and 1) and the message reported by the script
+    };
+
+    PluginJob(Plugin* plugin, int id, fs::path script, LuaValue input, Callbacks callbacks);
+    ~PluginJob();
+
+    PluginJob(const PluginJob&) = delete;
+    PluginJob& operator=(const PluginJob&) = delete;
+
+    /// Starts the background thread
+    void start();
+
+    /**
+     * Requests the script to stop. The script is interrupted at the latest after LUA_HOOK_COUNT Lua instructions, its
+     * callback is still called (with the error "Cancelled").
+     */
+    void cancel();
+
+    auto getId() const -> int;
+
+private:
+    /// Body of the background thread
+    void run();
+
+    /// Loads the standard libraries and the job library
+    void openLibs();
+
+    /// Schedules the progress callback, unless it is already scheduled (the latest progress is reported)
+    void reportProgress(double fraction, std::string message);
+
+    /// Schedules a call to a function of the plugin
+    void post(std::string fnc, std::vector<LuaValue> args);
+
+    /// Called on the main thread once the background thread is done
+    void finished();
+
+    static auto getJobFromLua(lua_State* L) -> PluginJob*;
+    static void cancellationHook(lua_State* L, lua_Debug* ar);
+
+    static int joblib_progress(lua_State* L);
+    static int joblib_post(lua_State* L);
+    static int joblib_isCancelled(lua_State* L);
+
+private:
+    Plugin* plugin;
+    int id;
+    fs::path script;
+    fs::path pluginPath;  ///< Copied on the main thread: the background thread must not access the plugin
+    LuaValue input;
+    Callbacks callbacks;
+
+    std::unique_ptr<lua_State, LuaDeleter> lua{};  ///< Only used by the background thread
+    std::thread thread;
+    std::atomic_bool cancelled{false};
+
+    /// Set by the background thread, read on the main thread after it was joined
+    LuaValue result;
+    std::string error;
+
+    std::mutex progressMutex;
+    double progressFraction = 0;
+    std::string progressMessage;
+    bool progressScheduled = false;
+
+    /// Number of Lua instructions between checks for cancellation
+    static constexpr int LUA_HOOK_COUNT = 1000;
+};
+
+#endif
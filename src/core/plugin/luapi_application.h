@@ -48,9 +48,12 @@
 #include "model/StrokeStyle.h"
 #include "model/Text.h"
 #include "model/XojPage.h"  // IWYU pragma: keep for XojPage
+#include "plugin/PackedPoints.h"
 #include "plugin/Plugin.h"
 #include "undo/InsertUndoAction.h"
+#include "undo/StrokePointsUndoAction.h"
 #include "util/PopupWindowWrapper.h"  // for PopupWindowWrapper
+#include "util/Range.h"               // for Range
 #include "util/StringUtils.h"
 #include "util/i18n.h"        // for _
 #include "util/safe_casts.h"  // for round_cast, as_signed, as_unsigned
@@ -1388,6 +1391,36 @@ static int applib_getTexts(lua_State* L) {
     return 1;
 }
 
+/**
+ * Helper function for the getStrokes API. Sets the pen settings of the stroke
+ * (tool, width, color, fill, lineStyle) in the table on top of the stack.
+ */
+static void pushStrokeAttributesHelper(lua_State* L, Stroke* s) {
+    StrokeTool tool = s->getToolType();
+    if (tool == StrokeTool::PEN) {
+        lua_pushstring(L, "pen");
+    } else if (tool == StrokeTool::ERASER) {
+        lua_pushstring(L, "eraser");
+    } else if (tool == StrokeTool::HIGHLIGHTER) {
+        lua_pushstring(L, "highlighter");
+    } else {
+        luaL_error(L, "Unknown StrokeTool::Value.");
+    }
+    lua_setfield(L, -2, "tool");  // add tool to stroke
+
+    lua_pushnumber(L, s->getWidth());
+    lua_setfield(L, -2, "width");  // add width to stroke
+
+    lua_pushinteger(L, as_signed(uint32_t(s->getColor()) & 0xffffffU));
+    lua_setfield(L, -2, "color");  // add color to stroke
+
+    lua_pushinteger(L, s->getFill());
+    lua_setfield(L, -2, "fill");  // add fill to stroke
+
+    lua_pushstring(L, StrokeStyle::formatStyle(s->getLineStyle()).c_str());
+    lua_setfield(L, -2, "lineStyle");  // add linestyle to stroke
+}
+
 /**
  * Puts a Lua Table of the Strokes (from the selection tool / selected layer) onto the stack.
  * Is inverse to app.addStrokes
@@ -1503,34 +1536,342 @@ static int applib_getStrokes(lua_State* L) {
             // -2 = index of the current stroke
             // -1 = current stroke
 
-            StrokeTool tool = s->getToolType();
-            if (tool == StrokeTool::PEN) {
-                lua_pushstring(L, "pen");
-            } else if (tool == StrokeTool::ERASER) {
-                lua_pushstring(L, "eraser");
-            } else if (tool == StrokeTool::HIGHLIGHTER) {
-                lua_pushstring(L, "highlighter");
-            } else {
-                return luaL_error(L, "Unknown StrokeTool::Value.");
+            pushStrokeAttributesHelper(L, s);
+
+            lua_settable(L, -3);  // add stroke to returned table
+        }
+    }
+    return 1;
+}
+
+/**
+ * Helper function for the packed stroke API. Collects the strokes of the selection, of the current layer or of all the
+ * layers of the current page, along with the (1-based) number of their layer.
+ */
+static std::tuple<std::optional<std::string>, std::vector<std::pair<Stroke*, Layer::Index>>> getStrokesFromHelper(
+        Control* control, const std::string& type) {
+    std::vector<std::pair<Stroke*, Layer::Index>> strokes = {};
+    if (type == "page") {
+        auto sel = control->getWindow()->getXournal()->getSelection();
+        if (sel) {
+            control->clearSelection();  // otherwise strokes in the selection won't be recognized
+        }
+        Layer::Index layerNo = 0;
+        for (Layer* layer: *control->getCurrentPage()->getLayers()) {
+            layerNo++;
+            for (const auto& e: layer->getElements()) {
+                if (e->getType() == ELEMENT_STROKE) {
+                    strokes.emplace_back(static_cast<Stroke*>(e.get()), layerNo);
+                }
             }
-            lua_setfield(L, -2, "tool");  // add tool to stroke
+        }
+        return std::make_tuple(std::nullopt, strokes);
+    }
 
-            lua_pushnumber(L, s->getWidth());
-            lua_setfield(L, -2, "width");  // add width to stroke
+    auto [err, elements] = getElementsFromHelper(control, type);
+    if (err.has_value()) {
+        return std::make_tuple(err, strokes);
+    }
+    Layer::Index layerNo = control->getCurrentPage()->getSelectedLayerId();
+    for (Element* e: elements) {
+        if (e->getType() == ELEMENT_STROKE) {
+            strokes.emplace_back(static_cast<Stroke*>(e), layerNo);
+        }
+    }
+    return std::make_tuple(std::nullopt, strokes);
+}
 
-            lua_pushinteger(L, as_signed(uint32_t(s->getColor()) & 0xffffffU));
-            lua_setfield(L, -2, "color");  // add color to stroke
+/**
+ * Helper function for the packed stroke API. Revision stamp of the strokes collected by getStrokesFromHelper. Moving or
+ * transforming the selection does not change the page, so the strokes of the selection use the stamp of the selection.
+ */
+static uint64_t getStrokesRevisionHelper(Control* control, const std::string& type) {
+    if (type == "selection") {
+        auto sel = control->getWindow()->getXournal()->getSelection();
+        return sel ? sel->getRevision() : 0;
+    }
+    return control->getCurrentPage()->getRevision();
+}
 
-            lua_pushinteger(L, s->getFill());
-            lua_setfield(L, -2, "fill");  // add fill to stroke
+/**
+ * Puts a Lua Table of the Strokes (from the selection tool / selected layer / current page) onto the stack, with the
+ * points of each stroke packed in a single binary string. This is much faster than app.getStrokes for strokes with many
+ * points. Is inverse to app.addStrokesPacked
+ *
+ * Each point is packed as three native-endian doubles: x, y and pressure, the latter being -1 for strokes without
+ * pressure. The points can be read with string.unpack("ddd", points, pos).
+ *
+ * The second return value identifies the state of the current page, or of the selection for "selection". It must be
+ * passed to app.setStrokesPacked, which fails if the page was modified, or the selection moved, transformed or replaced
+ * in the meantime, as the strokes may not be at the same positions anymore.
+ *
+ * @param type string "selection", "layer" or "page"
+ * @return {points:string, tool:string, width:number, color:integer, fill:number, lineStyle:string, layer:integer}[]
+ * strokes
+ * @return integer revision
+ *
+ * Required argument: type ("selection", "layer" or "page" for the strokes of all the layers of the current page)
+ *
+ * Example:
+ *
+ * local strokes, revision = app.getStrokesPacked("page")
+ * for _, stroke in ipairs(strokes) do
+ *   for pos = 1, #stroke.points, 24 do
+ *     local x, y, pressure = string.unpack("ddd", stroke.points, pos)
+ *   end
+ * end
+ *
+ * possible return value:
+ * {
+ *         {
+ *             ["points"]    = "...", -- 24 bytes per point
+ *             ["tool"]      = "pen",
+ *             ["width"]     = 0.85,
+ *             ["color"]     = 16744448,
+ *             ["fill"]      = -1,
+ *             ["lineStyle"] = "plain",
+ *             ["layer"]     = 1, -- number of the layer of the stroke, as in app.getDocumentStructure()
+ *         },
+ * }
+ */
+static int applib_getStrokesPacked(lua_State* L) {
+    Plugin* plugin = Plugin::getPluginFromLua(L);
+    std::string type = luaL_checkstring(L, 1);
+    Control* control = plugin->getControl();
 
-            lua_pushstring(L, StrokeStyle::formatStyle(s->getLineStyle()).c_str());
-            lua_setfield(L, -2, "lineStyle");  // add linestyle to stroke
+    // Discard any extra arguments passed in
+    lua_settop(L, 1);
 
-            lua_settable(L, -3);  // add stroke to returned table
+    const auto& [err, strokes] = getStrokesFromHelper(control, type);
+    if (err.has_value()) {
+        return luaL_error(L, err.value().c_str());
+    }
+
+    lua_createtable(L, static_cast<int>(strokes.size()), 0);  // create table of the strokes
+    lua_Integer currStrokeNo = 0;
+
+    // stack now has following:
+    //  1 = type (string)
+    // -1 = table of strokes (to be returned)
+
+    for (const auto& [s, layerNo]: strokes) {
+        lua_createtable(L, 0, 7);  // create stroke table
+
+        PackedPoints::push(L, s->getPointVector());
+        lua_setfield(L, -2, "points");  // add points to stroke
+
+        pushStrokeAttributesHelper(L, s);
+
+        lua_pushinteger(L, as_signed(layerNo));
+        lua_setfield(L, -2, "layer");  // add layer number to stroke
+
+        lua_rawseti(L, -2, ++currStrokeNo);  // add stroke to returned table
+    }
+
+    lua_pushinteger(L, as_signed(getStrokesRevisionHelper(control, type)));
+    return 2;
+}
+
+/**
+ * Given a table containing strokes with packed points (as returned by app.getStrokesPacked), adds them to the current
+ * layer. The pen settings are handled as in app.addStrokes. The page is rerendered once for all the strokes.
+ *
+ * Each point is packed as three native-endian doubles: x, y and pressure, the latter being -1 for strokes without
+ * pressure. Strokes with less than two points are discarded.
+ *
+ * @param opts {strokes:{points:string, tool:string, width:number, color:integer, fill:number, lineStyle:string}[],
+ * allowUndoRedoAction:string}
+ *
+ * Required Arguments: points
+ * Optional Arguments: tool, width, color, fill, lineStyle
+ *
+ * Example:
+ *
+ * local points = {}
+ * for i = 0, 100 do
+ *   points[#points + 1] = string.pack("ddd", 100 + i, 100 + 10 * math.sin(i / 10), -1)
+ * end
+ * app.addStrokesPacked({
+ *   strokes = {
+ *     { points = table.concat(points), color = 0x0000ff, width = 1.41 },
+ *   },
+ *   allowUndoRedoAction = "grouped", -- each call creates one undo action, or "individual" or "none"
+ * })
+ */
+static int applib_addStrokesPacked(lua_State* L) {
+    Plugin* plugin = Plugin::getPluginFromLua(L);
+    Control* ctrl = plugin->getControl();
+
+    // Discard any extra arguments passed in
+    lua_settop(L, 1);
+    luaL_checktype(L, 1, LUA_TTABLE);
+
+    lua_getfield(L, 1, "allowUndoRedoAction");
+    std::string allowUndoRedoAction = luaL_optstring(L, -1, "grouped");
+    lua_pop(L, 1);
+    if (allowUndoRedoAction != "grouped" && allowUndoRedoAction != "individual" && allowUndoRedoAction != "none") {
+        return luaL_error(L, "Unrecognized undo/redo option: %s", allowUndoRedoAction.c_str());
+    }
+
+    lua_getfield(L, 1, "strokes");
+    if (!lua_istable(L, -1)) {
+        return luaL_error(L, "Missing stroke table!");
+    }
+
+    // stack now has following:
+    //  1 = table arg
+    // -1 = strokes
+
+    size_t numStrokes = lua_rawlen(L, -1);
+    std::vector<Element*> strokes;
+    strokes.reserve(numStrokes);
+    for (size_t a = 1; a <= numStrokes; a++) {
+        lua_rawgeti(L, -1, as_signed(a));  // get current stroke
+        if (!lua_istable(L, -1)) {
+            return luaL_error(L, "Stroke %d is not a table!", static_cast<int>(a));
+        }
+
+        std::vector<Point> points;
+        lua_getfield(L, -1, "points");
+        if (!PackedPoints::read(L, -1, points)) {
+            return luaL_error(L, "The points of stroke %d are not packed as doubles x, y, pressure!",
+                              static_cast<int>(a));
         }
+        lua_pop(L, 1);  // cleanup points
+
+        if (points.size() < 2) {
+            g_warning("Stroke shorter than two points. Discarding. (Has %zu/2)", points.size());
+            lua_pop(L, 1);  // cleanup stroke table
+            continue;
+        }
+
+        auto stroke = std::make_unique<Stroke>();
+        stroke->setPointVector(std::move(points));
+        strokes.push_back(stroke.get());
+
+        // Finish building the Stroke and apply it to the layer.
+        addStrokeHelper(L, std::move(stroke));
+        // Onto the next stroke
+        lua_pop(L, 1);  // cleanup stroke table
     }
-    return 1;
+
+    if (strokes.empty()) {
+        return 0;
+    }
+
+    PageRef const& page = ctrl->getCurrentPage();
+    Layer* layer = page->getSelectedLayer();
+    UndoRedoHandler* undo = ctrl->getUndoRedoHandler();
+    if (allowUndoRedoAction == "grouped") {
+        undo->addUndoAction(std::make_unique<InsertsUndoAction>(page, layer, strokes));
+    } else if (allowUndoRedoAction == "individual") {
+        for (Element* element: strokes) {
+            undo->addUndoAction(std::make_unique<InsertUndoAction>(page, layer, element));
+        }
+    }
+    page->firePageChanged();
+    return 0;
+}
+
+/**
+ * Replaces the points of strokes from the selection tool / selected layer / current page by packed points, as returned
+ * by app.getStrokesPacked. All the modified strokes are restored by a single undo action, and the page is rerendered
+ * once. With "selection", the selection is cleared before the strokes are modified.
+ *
+ * Fails if the current page was modified, or with "selection" if the selection was moved, transformed or replaced,
+ * since app.getStrokesPacked was called, e.g. by the user while the new points were computed in the background: the
+ * strokes may not be at the same positions anymore.
+ *
+ * @param type string "selection", "layer" or "page"
+ * @param points table<integer, string> the new packed points, indexed by the position of the stroke in the table
+ * returned by app.getStrokesPacked(type). Strokes without new points are left untouched.
+ * @param revision integer the revision returned by app.getStrokesPacked(type)
+ *
+ * Required arguments: type, points, revision
+ *
+ * Example: local strokes, revision = app.getStrokesPacked("page")
+ *          local newPoints = {}
+ *          for i, stroke in ipairs(strokes) do
+ *            newPoints[i] = smooth(stroke.points) -- a string of packed points
+ *          end
+ *          app.setStrokesPacked("page", newPoints, revision)
+ */
+static int applib_setStrokesPacked(lua_State* L) {
+    Plugin* plugin = Plugin::getPluginFromLua(L);
+    std::string type = luaL_checkstring(L, 1);
+    luaL_checktype(L, 2, LUA_TTABLE);
+    lua_Integer revision = luaL_checkinteger(L, 3);
+    Control* control = plugin->getControl();
+
+    // Discard any extra arguments passed in
+    lua_settop(L, 2);
+
+    // Checked first: collecting the strokes may clear the selection, which changes the page
+    if (revision != as_signed(getStrokesRevisionHelper(control, type))) {
+        return luaL_error(L, "The %s was modified since app.getStrokesPacked was called!",
+                          type == "selection" ? "selection" : "page");
+    }
+
+    const auto& [err, strokes] = getStrokesFromHelper(control, type);
+    if (err.has_value()) {
+        return luaL_error(L, err.value().c_str());
+    }
+
+    // Read all the points before modifying anything, so that an invalid argument leaves the strokes untouched
+    std::vector<std::pair<Stroke*, std::vector<Point>>> changes;
+    lua_pushnil(L);
+    while (lua_next(L, 2) != 0) {
+        // stack now has following:
+        //  1 = type (string)
+        //  2 = table of points
+        // -2 = index of the stroke
+        // -1 = packed points
+        if (!lua_isinteger(L, -2)) {
+            return luaL_error(L, "The points must be indexed by the number of their stroke!");
+        }
+        lua_Integer index = lua_tointeger(L, -2);
+        if (index < 1 || as_unsigned(index) > strokes.size()) {
+            return luaL_error(L, "There is no stroke %d in the %s!", static_cast<int>(index), type.c_str());
+        }
+        std::vector<Point> points;
+        if (!PackedPoints::read(L, -1, points)) {
+            return luaL_error(L, "The points of stroke %d are not packed as doubles x, y, pressure!",
+                              static_cast<int>(index));
+        }
+        if (points.size() < 2) {
+            return luaL_error(L, "Stroke %d would have less than two points!", static_cast<int>(index));
+        }
+        changes.emplace_back(strokes[as_unsigned(index - 1)].first, std::move(points));
+        lua_pop(L, 1);  // cleanup points, keep the index for lua_next
+    }
+
+    if (changes.empty()) {
+        return 0;
+    }
+
+    if (type == "selection") {
+        // The bounds and the rendering of the selection would not match the new points: put the strokes back on their
+        // layer first
+        control->clearSelection();
+    }
+
+    PageRef const& page = control->getCurrentPage();
+    auto undoAction = std::make_unique<StrokePointsUndoAction>(page);
+    Range range;
+
+    Document* doc = control->getDocument();
+    doc->lock();
+    for (auto& [stroke, points]: changes) {
+        range = range.unite(Range(stroke->boundingRect()));
+        undoAction->addStroke(stroke, stroke->getPointVector());
+        stroke->setPointVector(std::move(points));
+        range = range.unite(Range(stroke->boundingRect()));
+    }
+    doc->unlock();
+
+    control->getUndoRedoHandler()->addUndoAction(std::move(undoAction));
+    page->fireRangeChanged(range);
+    return 0;
 }
 
 /**
@@ -2918,6 +3259,121 @@ static int applib_getImages(lua_State* L) {
     return 1;
 }
 
+/**
+ * Runs a Lua script of the plugin on a background thread, so that long computations do not freeze the user interface.
+ *
+ * The script runs in a separate Lua state, without the app library: the document and the user interface can only be
+ * accessed from the main thread. Instead, the script receives a copy of `input` as argument (`...`) and returns its
+ * result, which is passed to the callback on the main thread. The callback applies the changes to the document, e.g.
+ * with app.setStrokesPacked, so that they are undone at once.
+ *
+ * The script can use the job library:
+ *  - job.progress(fraction:number, message:string) reports the progress, passed to `progressCallback`;
+ *  - job.post(fnc:string, ...) calls the global function `fnc` of the plugin on the main thread;
+ *  - job.isCancelled() returns true if the job was cancelled. The script is interrupted anyway.
+ *
+ * Only nil, booleans, numbers, strings and tables of those can be passed between the plugin and the script.
+ *
+ * @param opts {script:string, input:any, callback:string, progressCallback:string}
+ * @return integer id of the job, to be passed to app.cancelBackgroundJob
+ *
+ * Required arguments: script (path relative to the plugin folder, which it can not leave), callback
+ * Optional arguments: input, progressCallback
+ *
+ * Example:
+ *
+ * -- main.lua
+ * local revision
+ * function smooth()
+ *   local strokes
+ *   strokes, revision = app.getStrokesPacked("page")
+ *   app.runInBackground({
+ *     script = "smooth.lua",
+ *     input = strokes,
+ *     callback = "onSmoothed",
+ *     progressCallback = "onProgress",
+ *   })
+ * end
+ * function onSmoothed(points, err) -- points is nil and err is set if the script failed or was cancelled
+ *   -- Fails if the page was modified while smoothing
+ *   if points then app.setStrokesPacked("page", points, revision) end
+ * end
+ *
+ * -- smooth.lua
+ * local strokes = ...
+ * local points = {}
+ * for i, stroke in ipairs(strokes) do
+ *   points[i] = smoothPoints(stroke.points)
+ *   job.progress(i / #strokes)
+ * end
+ * return points
+ */
+static int applib_runInBackground(lua_State* L) {
+    Plugin* plugin = Plugin::getPluginFromLua(L);
+
+    // Discard any extra arguments passed in
+    lua_settop(L, 1);
+    luaL_checktype(L, 1, LUA_TTABLE);
+
+    lua_getfield(L, 1, "script");
+    lua_getfield(L, 1, "callback");
+    lua_getfield(L, 1, "progressCallback");
+    lua_getfield(L, 1, "input");
+
+    // stack now has following:
+    //  1 = table arg
+    // -4 = script
+    // -3 = callback
+    // -2 = progressCallback
+    // -1 = input
+
+    luaL_checkstring(L, -4);
+    luaL_checkstring(L, -3);
+    luaL_optstring(L, -2, "");
+
+    bool started = [L, plugin] {
+        std::string script = lua_tostring(L, -4);
+        if (fs::path(script).has_root_path() || script.find("..") != std::string::npos) {
+            lua_pushfstring(L, "Unsupported script path \"%s\"", script.c_str());
+            return false;
+        }
+
+        std::string error;
+        auto input = LuaValue::fromLua(L, -1, error);
+        if (!input) {
+            lua_pushfstring(L, "Invalid input: %s", error.c_str());
+            return false;
+        }
+
+        std::string callback = lua_tostring(L, -3);
+        std::string progressCallback = lua_isstring(L, -2) ? lua_tostring(L, -2) : "";
+        lua_pushinteger(L,
+                        plugin->startJob(script, std::move(*input), std::move(callback), std::move(progressCallback)));
+        return true;
+    }();
+    if (!started) {
+        // Raised once the C++ objects above are destroyed: Lua errors do not unwind the C++ stack
+        return lua_error(L);
+    }
+    return 1;
+}
+
+/**
+ * Cancels a job started with app.runInBackground. Its callback is still called, with nil and the error "Cancelled".
+ *
+ * @param id integer id of the job
+ * @return boolean false if the job already finished
+ *
+ * Example: app.cancelBackgroundJob(jobId)
+ */
+static int applib_cancelBackgroundJob(lua_State* L) {
+    Plugin* plugin = Plugin::getPluginFromLua(L);
+    lua_Integer id = luaL_checkinteger(L, 1);
+
+    lua_pushboolean(L, plugin->cancelJob(static_cast<int>(id)));
+    return 1;
+}
+
 
 /*
  * The full Lua Plugin API.
@@ -2959,9 +3415,14 @@ static const luaL_Reg applib[] = {{"msgbox", applib_msgbox},  // Todo(gtk4) remo
                                   {"fileDialogOpen", applib_fileDialogOpen},
                                   {"refreshPage", applib_refreshPage},
                                   {"getStrokes", applib_getStrokes},
+                                  {"getStrokesPacked", applib_getStrokesPacked},
+                                  {"addStrokesPacked", applib_addStrokesPacked},
+                                  {"setStrokesPacked", applib_setStrokesPacked},
                                   {"getImages", applib_getImages},
                                   {"getTexts", applib_getTexts},
                                   {"openFile", applib_openFile},
+                                  {"runInBackground", applib_runInBackground},
+                                  {"cancelBackgroundJob", applib_cancelBackgroundJob},
                                   // Placeholder
                                   //	{"MSG_BT_OK", nullptr},
 
@@ -8,6 +8,7 @@
 #include "model/Document.h"
 #include "model/Element.h"           // for Element, ELEMENT_IMAGE, ELEMENT_...
 #include "model/Layer.h"             // for Layer
+#include "model/Stroke.h"            // for Stroke
 #include "model/XojPage.h"           // for XojPage
 #include "undo/UndoAction.h"         // for UndoAction
 #include "util/i18n.h"               // for _
@@ -66,6 +67,24 @@ auto DeleteUndoAction::redo(Control* control) -> bool {
     return true;
 }
 
+auto DeleteUndoAction::getMemoryUsage() const -> size_t {
+    size_t size = sizeof(DeleteUndoAction);
+    for (const auto& e: elements) {
+        size += e.elementOwn ? e.elementOwn->getMemoryUsage() : sizeof(e);
+    }
+    return size;
+}
+
+auto DeleteUndoAction::spill(UndoSpillFile& file) -> size_t {
+    size_t freed = 0;
+    for (const auto& e: elements) {
+        if (e.elementOwn && e.elementOwn->getType() == ELEMENT_STROKE) {
+            freed += spilled.spill(file, static_cast<Stroke*>(e.elementOwn.get()));
+        }
+    }
+    return freed;
+}
+
 auto DeleteUndoAction::getText() -> std::string {
     if (eraser) {
         return _("Erase stroke");
@@ -34,6 +34,8 @@ public:
     void addElement(Layer* layer, ElementPtr e, Element::Index pos);
 
     std::string getText() override;
+    size_t getMemoryUsage() const override;
+    size_t spill(UndoSpillFile& file) override;
 
 private:
     // Todo (performance): replace by flat_multi_set / sorted_vector
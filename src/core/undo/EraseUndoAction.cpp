@@ -63,6 +63,27 @@ void EraseUndoAction::finalize() {
 
 auto EraseUndoAction::getText() -> std::string { return _("Erase stroke"); }
 
+auto EraseUndoAction::getMemoryUsage() const -> size_t {
+    size_t size = sizeof(EraseUndoAction);
+    for (const auto* entries: {&edited, &original}) {
+        for (const auto& e: *entries) {
+            size += e.elementOwn ? e.elementOwn->getMemoryUsage() : sizeof(e);
+        }
+    }
+    return size;
+}
+
+auto EraseUndoAction::spill(UndoSpillFile& file) -> size_t {
+    size_t freed = 0;
+    // The erased originals: the edited strokes are in the layer
+    for (const auto& e: original) {
+        if (e.elementOwn) {
+            freed += spilled.spill(file, e.element);
+        }
+    }
+    return freed;
+}
+
 auto EraseUndoAction::undo(Control* control) -> bool {
     Document* doc = control->getDocument();
     doc->lock();
@@ -38,6 +38,8 @@ public:
     void finalize();
 
     std::string getText() override;
+    size_t getMemoryUsage() const override;
+    size_t spill(UndoSpillFile& file) override;
 
 private:
     std::multiset<PageLayerPosEntry<Stroke>> edited{};
@@ -4,7 +4,11 @@
 #include "control/ScrollHandler.h"  // for ScrollHandler
 #include "gui/XournalppCursor.h"    // for XournalppCursor
 #include "model/Document.h"         // for Document
+#include "model/Element.h"          // for Element, ELEMENT_STROKE
+#include "model/Layer.h"            // for Layer
 #include "model/PageRef.h"          // for PageRef
+#include "model/Stroke.h"           // for Stroke
+#include "model/XojPage.h"          // for XojPage
 #include "undo/UndoAction.h"        // for UndoAction
 #include "util/Util.h"              // for npos
 #include "util/i18n.h"              // for _
@@ -19,6 +23,7 @@ InsertDeletePageUndoAction::InsertDeletePageUndoAction(const PageRef& page, size
 InsertDeletePageUndoAction::~InsertDeletePageUndoAction() { this->page = nullptr; }
 
 auto InsertDeletePageUndoAction::undo(Control* control) -> bool {
+    this->undone = true;
     if (this->inserted) {
         return deletePage(control);
     }
@@ -28,6 +33,7 @@ auto InsertDeletePageUndoAction::undo(Control* control) -> bool {
 }
 
 auto InsertDeletePageUndoAction::redo(Control* control) -> bool {
+    this->undone = false;
     if (this->inserted) {
         return insertPage(control);
     }
@@ -86,3 +92,33 @@ auto InsertDeletePageUndoAction::getText() -> std::string {
 
     return _("Page deleted");
 }
+
+auto InsertDeletePageUndoAction::ownsPage() const -> bool { return this->inserted == this->undone; }
+
+auto InsertDeletePageUndoAction::getMemoryUsage() const -> size_t {
+    size_t size = sizeof(InsertDeletePageUndoAction);
+    if (ownsPage()) {
+        for (const Layer* l: *this->page->getLayers()) {
+            for (const auto& e: l->getElements()) {
+                size += e->getMemoryUsage();
+            }
+        }
+    }
+    return size;
+}
+
+auto InsertDeletePageUndoAction::spill(UndoSpillFile& file) -> size_t {
+    if (!ownsPage()) {
+        return 0;
+    }
+
+    size_t freed = 0;
+    for (const Layer* l: *this->page->getLayers()) {
+        for (const auto& e: l->getElements()) {
+            if (e->getType() == ELEMENT_STROKE) {
+                freed += spilled.spill(file, static_cast<Stroke*>(e.get()));
+            }
+        }
+    }
+    return freed;
+}
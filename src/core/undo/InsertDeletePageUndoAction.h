@@ -11,7 +11,8 @@
 
 #pragma once
 
-#include <string>  // for string
+#include <cstddef>  // for size_t
+#include <string>   // for string
 
 #include "model/PageRef.h"  // for PageRef
 
@@ -30,11 +31,18 @@ public:
     bool redo(Control* control) override;
 
     std::string getText() override;
+    size_t getMemoryUsage() const override;
+    size_t spill(UndoSpillFile& file) override;
 
 private:
     bool insertPage(Control* control);
     bool deletePage(Control* control);
 
+    /**
+     * @return true if the page is not part of the document, i.e. owned by this action
+     */
+    bool ownsPage() const;
+
 private:
     bool inserted;
     size_t pagePos;
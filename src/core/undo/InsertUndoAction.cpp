@@ -19,6 +19,10 @@ InsertUndoAction::InsertUndoAction(const PageRef& page, Layer* layer, Element* e
 
 InsertUndoAction::~InsertUndoAction() = default;
 
+auto InsertUndoAction::getMemoryUsage() const -> size_t {
+    return sizeof(InsertUndoAction) + (elementOwn ? elementOwn->getMemoryUsage() : 0);
+}
+
 auto InsertUndoAction::getText() -> std::string {
     switch (element->getType()) {
         case ELEMENT_STROKE:
@@ -69,6 +73,14 @@ InsertsUndoAction::~InsertsUndoAction() = default;
 
 auto InsertsUndoAction::getText() -> std::string { return _("Insert elements"); }
 
+auto InsertsUndoAction::getMemoryUsage() const -> size_t {
+    size_t size = sizeof(InsertsUndoAction) + elements.capacity() * sizeof(Element*);
+    for (const auto& e: elementsOwn) {
+        size += e->getMemoryUsage();
+    }
+    return size;
+}
+
 auto InsertsUndoAction::undo(Control* control) -> bool {
     this->elementsOwn.reserve(this->elements.size());
 
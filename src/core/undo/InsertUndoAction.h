@@ -35,6 +35,7 @@ public:
     bool redo(Control* control) override;
 
     std::string getText() override;
+    size_t getMemoryUsage() const override;
 
 private:
     Layer* layer;
@@ -52,6 +53,7 @@ public:
     bool redo(Control* control) override;
 
     std::string getText() override;
+    size_t getMemoryUsage() const override;
 
 private:
     Layer* layer;
@@ -28,10 +28,7 @@ RecognizerUndoAction::~RecognizerUndoAction() = default;
 auto RecognizerUndoAction::undo(Control* control) -> bool {
     Document* doc = control->getDocument();
     doc->lock();
-    auto [owned, pos] = this->layer->removeElement(this->recognized);
-    this->recognizedOwned = std::move(owned);
-
-    this->layer->insertElement(std::move(this->originalOwned), pos);
+    this->recognizedOwned = this->layer->replaceElement(this->recognized, std::move(this->originalOwned));
     doc->unlock();
 
     this->page->fireElementChanged(this->recognized);
@@ -42,13 +39,9 @@ auto RecognizerUndoAction::undo(Control* control) -> bool {
 }
 
 auto RecognizerUndoAction::redo(Control* control) -> bool {
-    Element::Index pos = 0;
-
     Document* doc = control->getDocument();
     doc->lock();
-    auto [owned, posi] = this->layer->removeElement(original);
-    this->originalOwned = std::move(owned);
-    this->layer->insertElement(std::move(this->recognizedOwned), pos);
+    this->originalOwned = this->layer->replaceElement(this->original, std::move(this->recognizedOwned));
     doc->unlock();
 
     this->page->fireElementChanged(original);
@@ -59,3 +52,8 @@ auto RecognizerUndoAction::redo(Control* control) -> bool {
 }
 
 auto RecognizerUndoAction::getText() -> std::string { return _("Stroke recognizer"); }
+
+auto RecognizerUndoAction::getMemoryUsage() const -> size_t {
+    return sizeof(RecognizerUndoAction) + (originalOwned ? originalOwned->getMemoryUsage() : 0) +
+           (recognizedOwned ? recognizedOwned->getMemoryUsage() : 0);
+}
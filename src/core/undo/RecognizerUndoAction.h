@@ -34,6 +34,7 @@ public:
     bool redo(Control* control) override;
 
     std::string getText() override;
+    size_t getMemoryUsage() const override;
 
 private:
     Layer* layer;
@@ -0,0 +1,57 @@
+#include "StrokePointsUndoAction.h"
+
+#include <utility>  // for move
+
+#include "control/Control.h"  // for Control
+#include "model/Document.h"   // for Document
+#include "model/Stroke.h"     // for Stroke
+#include "model/XojPage.h"    // for XojPage
+#include "util/Range.h"       // for Range
+#include "util/i18n.h"        // for _
+
+StrokePointsUndoAction::StrokePointsUndoAction(const PageRef& page): UndoAction("StrokePointsUndoAction") {
+    this->page = page;
+}
+
+void StrokePointsUndoAction::addStroke(Stroke* s, std::vector<Point> oldPoints) {
+    this->entries.push_back({s, std::move(oldPoints)});
+}
+
+void StrokePointsUndoAction::swapPoints(Document* doc) {
+    if (this->entries.empty()) {
+        return;
+    }
+
+    doc->lock();
+    Range range;
+    for (Entry& e: this->entries) {
+        range = range.unite(Range(e.stroke->boundingRect()));
+        std::vector<Point> current = e.stroke->getPointVector();
+        e.stroke->setPointVector(std::move(e.points));
+        e.points = std::move(current);
+        range = range.unite(Range(e.stroke->boundingRect()));
+    }
+    doc->unlock();
+
+    this->page->fireRangeChanged(range);
+}
+
+auto StrokePointsUndoAction::undo(Control* control) -> bool {
+    swapPoints(control->getDocument());
+    return true;
+}
+
+auto StrokePointsUndoAction::redo(Control* control) -> bool {
+    swapPoints(control->getDocument());
+    return true;
+}
+
+auto StrokePointsUndoAction::getMemoryUsage() const -> size_t {
+    size_t size = sizeof(StrokePointsUndoAction) + this->entries.capacity() * sizeof(Entry);
+    for (const Entry& e: this->entries) {
+        size += e.points.capacity() * sizeof(Point);
+    }
+    return size;
+}
+
+auto StrokePointsUndoAction::getText() -> std::string { return _("Edit strokes"); }
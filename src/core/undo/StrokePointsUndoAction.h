@@ -0,0 +1,53 @@
+/*
+ * Xournal++
+ *
+ * Undo action for replacing the points of strokes (plugins)
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <string>  // for string
+#include <vector>  // for vector
+
+#include "model/PageRef.h"  // for PageRef
+#include "model/Point.h"    // for Point
+
+#include "UndoAction.h"  // for UndoAction
+
+class Control;
+class Document;
+class Stroke;
+
+class StrokePointsUndoAction: public UndoAction {
+public:
+    StrokePointsUndoAction(const PageRef& page);
+
+public:
+    bool undo(Control* control) override;
+    bool redo(Control* control) override;
+    std::string getText() override;
+    size_t getMemoryUsage() const override;
+
+    /**
+     * @param oldPoints The points of the stroke before it was modified
+     */
+    void addStroke(Stroke* s, std::vector<Point> oldPoints);
+
+    /**
+     * Swaps the points of the strokes with the stored ones: undoes the change, or redoes it once undone
+     */
+    void swapPoints(Document* doc);
+
+private:
+    struct Entry {
+        Stroke* stroke;
+        /// The points which are not currently in the stroke
+        std::vector<Point> points;
+    };
+    std::vector<Entry> entries;
+};
@@ -25,6 +25,10 @@ TextBoxUndoAction::~TextBoxUndoAction() = default;
 
 auto TextBoxUndoAction::getText() -> std::string { return _("Edit text"); }
 
+auto TextBoxUndoAction::getMemoryUsage() const -> size_t {
+    return sizeof(TextBoxUndoAction) + (oldelement ? oldelement->getMemoryUsage() : 0);
+}
+
 auto TextBoxUndoAction::undo(Control* control) -> bool {
     Document* doc = control->getDocument();
     doc->lock();
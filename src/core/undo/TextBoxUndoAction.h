@@ -33,6 +33,7 @@ public:
     auto redo(Control* control) -> bool override;
 
     auto getText() -> std::string override;
+    auto getMemoryUsage() const -> size_t override;
 
 private:
     Layer* layer;
@@ -2,6 +2,8 @@
 
 #include <utility>  // for move
 
+#include <glib.h>  // for g_warning
+
 UndoAction::UndoAction(std::string className): className(std::move(className)) {}
 
 auto UndoAction::getPages() -> std::vector<PageRef> {
@@ -10,4 +12,14 @@ auto UndoAction::getPages() -> std::vector<PageRef> {
     return pages;
 }
 
+auto UndoAction::getMemoryUsage() const -> size_t { return sizeof(UndoAction); }
+
+auto UndoAction::spill(UndoSpillFile&) -> size_t { return 0; }
+
+void UndoAction::reload() {
+    if (!spilled.empty() && !spilled.reload()) {
+        g_warning("%s: some strokes could not be reloaded from the undo spill file", className.c_str());
+    }
+}
+
 auto UndoAction::getClassName() const -> std::string const& { return this->className; }
@@ -11,12 +11,15 @@
 
 #pragma once
 
-#include <memory>  // for unique_ptr
-#include <string>  // for string
-#include <vector>  // for vector
+#include <cstddef>  // for size_t
+#include <memory>   // for unique_ptr
+#include <string>   // for string
+#include <vector>   // for vector
 
 #include "model/PageRef.h"  // for PageRef
 
+#include "UndoSpillFile.h"  // for SpilledStrokes
+
 class Control;
 
 class UndoAction {
@@ -35,6 +38,23 @@ public:
      */
     virtual std::vector<PageRef> getPages();
 
+    /**
+     * @return An estimate of the memory held by this action (mostly the elements it owns), in bytes
+     */
+    virtual size_t getMemoryUsage() const;
+
+    /**
+     * @brief Moves the bulk data of this action (the points of the strokes it owns) to the spill file.
+     * Only called on actions which are not undone.
+     * @return The number of bytes freed
+     */
+    virtual size_t spill(UndoSpillFile& file);
+
+    /**
+     * @brief Loads back the data moved by spill(). Called before the action is undone or redone.
+     */
+    void reload();
+
     auto getClassName() const -> std::string const&;
 
 protected:
@@ -42,6 +62,8 @@ protected:
     std::string className;
     PageRef page;
     bool undone = false;
+
+    SpilledStrokes spilled;
 };
 
 using UndoActionPtr = std::unique_ptr<UndoAction>;
@@ -1,10 +1,11 @@
 #include "UndoRedoHandler.h"
 
-#include <algorithm>  // for find_if
+#include <algorithm>  // for any_of, find_if, min
 #include <cinttypes>  // for PRIu64
 #include <cstdint>    // for uint64_t
 #include <iterator>   // for end, begin
 #include <memory>     // for unique_ptr, allocator_traits<>::value_type
+#include <string>     // for to_string
 #include <utility>    // for move
 
 #include <glib.h>  // for g_message
@@ -13,6 +14,7 @@
 #include "model/Document.h"   // for Document
 #include "undo/UndoAction.h"  // for UndoActionPtr, UndoAction
 #include "util/Assert.h"      // for xoj_assert
+#include "util/PathUtil.h"    // for getTmpDirSubfolder
 #include "util/XojMsgBox.h"   // for XojMsgBox
 #include "util/i18n.h"        // for _, FS, _F
 
@@ -78,6 +80,9 @@ void UndoRedoHandler::clearContents() {
 
     undoList.clear();
     clearRedo();
+    this->memoryUsage = 0;
+    this->actionMemory.clear();
+    this->spillIndex = 0;
 
     this->savedUndo = nullptr;
     this->autosavedUndo = nullptr;
@@ -91,6 +96,9 @@ void UndoRedoHandler::clearRedo() {
         g_message("clearRedo()::Delete UndoAction: %" PRIu64 " / %s", (size_t)&undoAction, undoAction.getClassName());
     }
 #endif
+    for (const auto& action: this->redoList) {
+        releaseMemory(*action);
+    }
     redoList.clear();
     printContents();
 }
@@ -105,8 +113,12 @@ void UndoRedoHandler::undo() {
     auto& undoAction = *this->undoList.back();
     this->redoList.emplace_back(std::move(this->undoList.back()));
     this->undoList.pop_back();
+    this->spillIndex = std::min(this->spillIndex, this->undoList.size());
 
+    releaseMemory(undoAction);
+    undoAction.reload();
     bool undoResult = undoAction.undo(this->control);
+    measureMemory(undoAction);
 
     if (!undoResult) {
         string msg = FS(_F("Could not undo \"{1}\"\n"
@@ -132,7 +144,10 @@ void UndoRedoHandler::redo() {
     this->undoList.emplace_back(std::move(this->redoList.back()));
     this->redoList.pop_back();
 
+    releaseMemory(redoAction);
+    redoAction.reload();
     bool redoResult = redoAction.redo(this->control);
+    measureMemory(redoAction);
 
     if (!redoResult) {
         string msg = FS(_F("Could not redo \"{1}\"\n"
@@ -158,13 +173,49 @@ void UndoRedoHandler::addUndoAction(UndoActionPtr action) {
         return;
     }
 
+    // The previous action may have been filled since it was added
+    if (!this->undoList.empty()) {
+        measureMemory(*this->undoList.back());
+    }
+    measureMemory(*action);
     this->undoList.emplace_back(std::move(action));
     clearRedo();
+    enforceMemoryBudget();
     fireUpdateUndoRedoButtons(this->undoList.back()->getPages());
 
     printContents();
 }
 
+auto UndoRedoHandler::isUndoable(const UndoAction* action) const -> bool {
+    return std::any_of(this->undoList.begin(), this->undoList.end(),
+                       [action](const UndoActionPtr& a) { return a.get() == action; });
+}
+
+auto UndoRedoHandler::replaceUndoAction(const UndoAction* action, UndoActionPtr replacement) -> bool {
+    auto it = std::find_if(this->undoList.begin(), this->undoList.end(),
+                           [action](const UndoActionPtr& a) { return a.get() == action; });
+    if (it == this->undoList.end() || !replacement) {
+        return false;
+    }
+
+    // The document does not match the saved state anymore
+    if (this->savedUndo == action) {
+        this->savedUndo = nullptr;
+    }
+    if (this->autosavedUndo == action) {
+        this->autosavedUndo = nullptr;
+    }
+
+    releaseMemory(**it);
+    measureMemory(*replacement);
+    *it = std::move(replacement);
+    enforceMemoryBudget();
+    fireUpdateUndoRedoButtons((*it)->getPages());
+
+    printContents();
+    return true;
+}
+
 auto UndoRedoHandler::undoDescription() -> string {
     if (!this->undoList.empty()) {
         UndoAction& a = *this->undoList.back();
@@ -203,6 +254,63 @@ void UndoRedoHandler::fireUpdateUndoRedoButtons(const std::vector<PageRef>& page
 
 void UndoRedoHandler::addUndoRedoListener(UndoRedoListener* listener) { this->listener.emplace_back(listener); }
 
+auto UndoRedoHandler::getActionCount() const -> size_t { return this->undoList.size() + this->redoList.size(); }
+
+auto UndoRedoHandler::getMemoryUsage() const -> size_t {
+    if (this->undoList.empty()) {
+        return this->memoryUsage;
+    }
+    // The last action may still be filled
+    const UndoAction& last = *this->undoList.back();
+    auto it = this->actionMemory.find(&last);
+    const size_t recorded = it == this->actionMemory.end() ? 0 : it->second;
+    return this->memoryUsage - recorded + last.getMemoryUsage();
+}
+
+void UndoRedoHandler::setMemoryBudget(size_t bytes) {
+    this->memoryBudget = bytes;
+    enforceMemoryBudget();
+}
+
+auto UndoRedoHandler::getSpilledSize() const -> size_t { return this->spillFile ? this->spillFile->getSize() : 0; }
+
+void UndoRedoHandler::measureMemory(const UndoAction& action) {
+    size_t& recorded = this->actionMemory[&action];
+    this->memoryUsage -= recorded;
+    recorded = action.getMemoryUsage();
+    this->memoryUsage += recorded;
+}
+
+void UndoRedoHandler::releaseMemory(const UndoAction& action) {
+    if (auto it = this->actionMemory.find(&action); it != this->actionMemory.end()) {
+        this->memoryUsage -= it->second;
+        this->actionMemory.erase(it);
+    }
+}
+
+void UndoRedoHandler::enforceMemoryBudget() {
+    if (!this->undoList.empty()) {
+        measureMemory(*this->undoList.back());
+    }
+    if (this->memoryBudget == 0 || this->memoryUsage <= this->memoryBudget) {
+        return;
+    }
+
+    if (!this->spillFile) {
+        static unsigned int spillFileCount = 0;
+        this->spillFile = std::make_unique<UndoSpillFile>(Util::getTmpDirSubfolder("undo") /
+                                                          ("spill-" + std::to_string(spillFileCount++) + ".bin"));
+    }
+
+    // The last action is the most likely to be undone: keep it in memory
+    for (; this->spillIndex + 1 < this->undoList.size() && this->memoryUsage > this->memoryBudget;
+         this->spillIndex++) {
+        UndoAction& action = *this->undoList[this->spillIndex];
+        action.spill(*this->spillFile);
+        measureMemory(action);
+    }
+}
+
 auto UndoRedoHandler::isChanged() -> bool {
     if (this->undoList.empty()) {
         return this->savedUndo;
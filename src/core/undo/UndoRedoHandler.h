@@ -11,13 +11,17 @@
 
 #pragma once
 
-#include <deque>   // for deque
-#include <string>  // for string
-#include <vector>  // for vector
+#include <cstddef>        // for size_t
+#include <deque>          // for deque
+#include <memory>         // for unique_ptr
+#include <string>         // for string
+#include <unordered_map>  // for unordered_map
+#include <vector>         // for vector
 
 #include "model/PageRef.h"  // for PageRef
 
-#include "UndoAction.h"  // for UndoActionPtr
+#include "UndoAction.h"     // for UndoActionPtr
+#include "UndoSpillFile.h"  // for UndoSpillFile
 
 class Control;
 
@@ -42,6 +46,19 @@ public:
 
     void addUndoAction(UndoActionPtr action);
 
+    /**
+     * @return Whether the action is in the undo stack, i.e. whether it is done and can be undone
+     */
+    bool isUndoable(const UndoAction* action) const;
+
+    /**
+     * Replaces an action of the undo stack in place. Used to merge a follow-up change with the action it completes,
+     * so that the user undoes both in one step (e.g. the shape recognized from a stroke with the insertion of the
+     * stroke).
+     * @return false if the action is not in the undo stack. The replacement is then discarded.
+     */
+    bool replaceUndoAction(const UndoAction* action, UndoActionPtr replacement);
+
     std::string undoDescription();
     std::string redoDescription();
 
@@ -55,11 +72,50 @@ public:
     void documentAutosaved();
     void documentSaved();
 
+    /**
+     * @return The number of actions in the undo and redo stacks
+     */
+    size_t getActionCount() const;
+
+    /**
+     * @return An estimate of the memory held by the undo and redo stacks, in bytes
+     */
+    size_t getMemoryUsage() const;
+
+    /**
+     * Sets the memory the undo history may use before the data of its oldest actions is moved to disk
+     * @param bytes 0 for no limit
+     */
+    void setMemoryBudget(size_t bytes);
+
+    /**
+     * @return The size of the data moved to disk to keep the undo history within its memory budget, in bytes
+     */
+    size_t getSpilledSize() const;
+
 private:
     void clearRedo();
     void printContents();
 
+    /**
+     * Moves the data of the oldest actions to the spill file while the history is above the memory budget. The actions
+     * stay in the history and are reloaded when they get undone.
+     */
+    void enforceMemoryBudget();
+
+    /**
+     * Measures the memory of an action of the stacks again and updates the running total. Actions may grow after they
+     * were added, e.g. the DeleteUndoAction of an eraser session is filled while erasing.
+     */
+    void measureMemory(const UndoAction& action);
+
+    /// Removes the memory recorded for an action leaving the stacks (or about to change) from the running total
+    void releaseMemory(const UndoAction& action);
+
 private:
+    /// Created on the first spill. Declared before the lists: the actions release their records when destroyed.
+    std::unique_ptr<UndoSpillFile> spillFile;
+
     std::deque<UndoActionPtr> undoList;
     std::deque<UndoActionPtr> redoList;
 
@@ -68,5 +124,13 @@ private:
 
     std::vector<UndoRedoListener*> listener;
 
+    /// Running total of the memory recorded for the actions of both stacks
+    size_t memoryUsage = 0;
+    /// The memory of each action, as recorded in the running total: subtracted when the action leaves the stacks
+    std::unordered_map<const UndoAction*, size_t> actionMemory;
+    size_t memoryBudget = 0;
+    /// The actions of the undo stack before this index are spilled already
+    size_t spillIndex = 0;
+
     Control* control = nullptr;
 };
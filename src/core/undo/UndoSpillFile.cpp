@@ -0,0 +1,116 @@
+#include "UndoSpillFile.h"
+
+#include <system_error>  // for error_code
+#include <utility>       // for move
+
+#include <glib.h>  // for g_warning
+
+#include "model/Point.h"   // for Point
+#include "model/Stroke.h"  // for Stroke
+#include "util/Assert.h"   // for xoj_assert
+
+UndoSpillFile::UndoSpillFile(fs::path path): path(std::move(path)) {}
+
+UndoSpillFile::~UndoSpillFile() { close(); }
+
+void UndoSpillFile::close() {
+    if (file.is_open()) {
+        file.close();
+        std::error_code ec;
+        fs::remove(path, ec);
+    }
+    end = 0;
+}
+
+auto UndoSpillFile::write(const void* data, size_t size, Record& record) -> bool {
+    if (!file.is_open()) {
+        file.open(path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            g_warning("Could not create the undo spill file \"%s\"", path.u8string().c_str());
+            return false;
+        }
+    }
+
+    file.clear();
+    file.seekp(static_cast<std::streamoff>(end));
+    file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    file.flush();
+    if (!file) {
+        g_warning("Could not write to the undo spill file \"%s\"", path.u8string().c_str());
+        return false;
+    }
+
+    record = {end, size};
+    end += size;
+    this->size += size;
+    records++;
+    return true;
+}
+
+auto UndoSpillFile::read(const Record& record, void* data) -> bool {
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(record.offset));
+    file.read(static_cast<char*>(data), static_cast<std::streamsize>(record.size));
+    if (!file || static_cast<size_t>(file.gcount()) != record.size) {
+        g_warning("Could not read from the undo spill file \"%s\"", path.u8string().c_str());
+        return false;
+    }
+    return true;
+}
+
+void UndoSpillFile::release(const Record& record) {
+    xoj_assert(records > 0 && size >= record.size);
+    size -= record.size;
+    records--;
+
+    if (records == 0) {
+        // The space of the released records is only reclaimed once the file is empty
+        close();
+    }
+}
+
+auto UndoSpillFile::getSize() const -> size_t { return size; }
+
+SpilledStrokes::~SpilledStrokes() {
+    for (auto& [stroke, record]: strokes) {
+        file->release(record);
+    }
+}
+
+auto SpilledStrokes::spill(UndoSpillFile& file, Stroke* stroke) -> size_t {
+    xoj_assert(!this->file || this->file == &file);
+
+    const std::vector<Point>& points = stroke->getPointVector();
+    if (points.empty()) {
+        return 0;
+    }
+
+    UndoSpillFile::Record record;
+    if (!file.write(points.data(), points.size() * sizeof(Point), record)) {
+        return 0;
+    }
+
+    // The points may be shared with clones of the stroke: only its share is freed
+    const size_t memoryUsage = stroke->getMemoryUsage();
+    this->file = &file;
+    strokes.emplace_back(stroke, record);
+    stroke->setPointVector(std::vector<Point>());
+    return memoryUsage - stroke->getMemoryUsage();
+}
+
+auto SpilledStrokes::reload() -> bool {
+    bool success = true;
+    for (auto& [stroke, record]: strokes) {
+        std::vector<Point> points(record.size / sizeof(Point));
+        if (file->read(record, points.data())) {
+            stroke->setPointVector(std::move(points));
+        } else {
+            success = false;
+        }
+        file->release(record);
+    }
+    strokes.clear();
+    return success;
+}
+
+auto SpilledStrokes::empty() const -> bool { return strokes.empty(); }
@@ -0,0 +1,107 @@
+/*
+ * Xournal++
+ *
+ * Temporary file holding the data of old undo actions
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint64_t
+#include <fstream>  // for fstream
+#include <utility>  // for pair
+#include <vector>   // for vector
+
+#include "filesystem.h"  // for path
+
+class Stroke;
+
+/**
+ * @brief Append-only temporary file to which the UndoRedoHandler moves the bulk data of old undo actions once the undo
+ * history exceeds its memory budget.
+ *
+ * The file is created on the first write. It is removed when this object is destroyed, and whenever no record is left
+ * in it.
+ */
+class UndoSpillFile {
+public:
+    explicit UndoSpillFile(fs::path path);
+    ~UndoSpillFile();
+
+    UndoSpillFile(const UndoSpillFile&) = delete;
+    UndoSpillFile& operator=(const UndoSpillFile&) = delete;
+
+    struct Record {
+        uint64_t offset = 0;
+        size_t size = 0;
+    };
+
+    /**
+     * @return false if the file could not be written. Nothing is stored in this case.
+     */
+    bool write(const void* data, size_t size, Record& record);
+
+    /**
+     * @return false if the record could not be read back
+     */
+    bool read(const Record& record, void* data);
+
+    /**
+     * @brief Forgets a record which will not be read anymore
+     */
+    void release(const Record& record);
+
+    /**
+     * @return The size of the records currently stored, in bytes
+     */
+    size_t getSize() const;
+
+private:
+    void close();
+
+private:
+    fs::path path;
+    std::fstream file;
+
+    uint64_t end = 0;
+    size_t size = 0;
+    size_t records = 0;
+};
+
+/**
+ * @brief The strokes of an undo action whose points were moved to an UndoSpillFile.
+ *
+ * Only the points are spilled: the Stroke objects stay where they are, so the pointers held by the other undo actions
+ * remain valid. The strokes must not be part of the document while they are spilled.
+ */
+class SpilledStrokes {
+public:
+    SpilledStrokes() = default;
+    ~SpilledStrokes();
+
+    SpilledStrokes(const SpilledStrokes&) = delete;
+    SpilledStrokes& operator=(const SpilledStrokes&) = delete;
+
+    /**
+     * @brief Writes the points of the stroke to the file and frees them
+     * @return The number of bytes freed
+     */
+    size_t spill(UndoSpillFile& file, Stroke* stroke);
+
+    /**
+     * @brief Gives all spilled strokes their points back
+     * @return false if some points could not be read. These strokes stay empty.
+     */
+    bool reload();
+
+    bool empty() const;
+
+private:
+    UndoSpillFile* file = nullptr;
+    std::vector<std::pair<Stroke*, UndoSpillFile::Record>> strokes;
+};
@@ -0,0 +1,143 @@
+#include "ImageKernels.h"
+
+#include <algorithm>  // for min, max, fill
+#include <cstddef>    // for size_t
+#include <cstdint>    // for int32_t
+#include <cstring>    // for memcpy
+#include <vector>     // for vector
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define XOJ_IMAGE_KERNELS_SSE2
+#include <emmintrin.h>  // for __m128, _mm_mul_ps, _mm_add_ps...
+#endif
+
+namespace ImageKernels {
+
+namespace {
+/**
+ * The source pixels covered by each destination pixel, along one axis
+ */
+struct BoxWeights {
+    /// First source pixel covered by each destination pixel
+    std::vector<int> first;
+    /// Index in `weights` of the first weight of each destination pixel, plus the total number of weights
+    std::vector<size_t> offset;
+    /// Coverage of the source pixels, divided by the size of the destination pixel so that they sum up to 1
+    std::vector<float> weights;
+};
+
+auto boxWeights(int srcSize, int dstSize) -> BoxWeights {
+    BoxWeights w;
+    w.first.reserve(static_cast<size_t>(dstSize));
+    w.offset.reserve(static_cast<size_t>(dstSize) + 1);
+
+    const double ratio = static_cast<double>(srcSize) / dstSize;
+    for (int d = 0; d < dstSize; d++) {
+        const double begin = d * ratio;
+        const double end = std::min((d + 1) * ratio, static_cast<double>(srcSize));
+        int s = static_cast<int>(begin);
+        w.first.push_back(s);
+        w.offset.push_back(w.weights.size());
+        for (; s < srcSize && s < end; s++) {
+            const double coverage = std::min(end, s + 1.0) - std::max(begin, static_cast<double>(s));
+            w.weights.push_back(static_cast<float>(coverage / ratio));
+        }
+    }
+    w.offset.push_back(w.weights.size());
+    return w;
+}
+}  // namespace
+
+void scalar::downsampleBox(const unsigned char* src, int srcWidth, int srcHeight, int srcStride, unsigned char* dst,
+                           int dstWidth, int dstHeight, int dstStride) {
+    const BoxWeights columns = boxWeights(srcWidth, dstWidth);
+    const BoxWeights rows = boxWeights(srcHeight, dstHeight);
+    std::vector<float> acc(4 * static_cast<size_t>(dstWidth));
+
+    for (int dy = 0; dy < dstHeight; dy++) {
+        std::fill(acc.begin(), acc.end(), 0.0f);
+        // The source rows at the border of two destination rows are filtered horizontally twice: this is cheaper than
+        // keeping them, as there are few of them when shrinking a lot.
+        for (size_t k = rows.offset[dy]; k < rows.offset[dy + 1]; k++) {
+            const unsigned char* srcRow = src + static_cast<size_t>(rows.first[dy] + (k - rows.offset[dy])) * srcStride;
+            const float wy = rows.weights[k];
+            for (int dx = 0; dx < dstWidth; dx++) {
+                const unsigned char* px = srcRow + 4 * columns.first[dx];
+                float sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+                for (size_t j = columns.offset[dx]; j < columns.offset[dx + 1]; j++, px += 4) {
+                    const float wx = columns.weights[j];
+                    for (int c = 0; c < 4; c++) {
+                        sum[c] += wx * px[c];
+                    }
+                }
+                for (int c = 0; c < 4; c++) {
+                    acc[4 * dx + c] += wy * sum[c];
+                }
+            }
+        }
+
+        unsigned char* dstRow = dst + static_cast<size_t>(dy) * dstStride;
+        for (size_t i = 0; i < acc.size(); i++) {
+            dstRow[i] = static_cast<unsigned char>(std::min(255.0f, acc[i] + 0.5f));
+        }
+    }
+}
+
+#ifdef XOJ_IMAGE_KERNELS_SSE2
+
+static inline auto loadPixel(const unsigned char* px) -> __m128 {
+    int32_t value;
+    std::memcpy(&value, px, sizeof(value));
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bytes = _mm_cvtsi32_si128(value);
+    return _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(bytes, zero), zero));
+}
+
+static inline void storePixel(unsigned char* px, __m128 v) {
+    const __m128 rounded = _mm_min_ps(_mm_add_ps(v, _mm_set1_ps(0.5f)), _mm_set1_ps(255.0f));
+    __m128i i = _mm_cvttps_epi32(rounded);
+    i = _mm_packs_epi32(i, i);
+    i = _mm_packus_epi16(i, i);
+    const int32_t value = _mm_cvtsi128_si32(i);
+    std::memcpy(px, &value, sizeof(value));
+}
+
+void downsampleBox(const unsigned char* src, int srcWidth, int srcHeight, int srcStride, unsigned char* dst,
+                   int dstWidth, int dstHeight, int dstStride) {
+    const BoxWeights columns = boxWeights(srcWidth, dstWidth);
+    const BoxWeights rows = boxWeights(srcHeight, dstHeight);
+    std::vector<float> acc(4 * static_cast<size_t>(dstWidth));
+
+    for (int dy = 0; dy < dstHeight; dy++) {
+        std::fill(acc.begin(), acc.end(), 0.0f);
+        for (size_t k = rows.offset[dy]; k < rows.offset[dy + 1]; k++) {
+            const unsigned char* srcRow = src + static_cast<size_t>(rows.first[dy] + (k - rows.offset[dy])) * srcStride;
+            const __m128 wy = _mm_set1_ps(rows.weights[k]);
+            for (int dx = 0; dx < dstWidth; dx++) {
+                const unsigned char* px = srcRow + 4 * columns.first[dx];
+                __m128 sum = _mm_setzero_ps();
+                for (size_t j = columns.offset[dx]; j < columns.offset[dx + 1]; j++, px += 4) {
+                    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(columns.weights[j]), loadPixel(px)));
+                }
+                float* a = &acc[4 * static_cast<size_t>(dx)];
+                _mm_storeu_ps(a, _mm_add_ps(_mm_loadu_ps(a), _mm_mul_ps(wy, sum)));
+            }
+        }
+
+        unsigned char* dstRow = dst + static_cast<size_t>(dy) * dstStride;
+        for (int dx = 0; dx < dstWidth; dx++) {
+            storePixel(dstRow + 4 * dx, _mm_loadu_ps(&acc[4 * static_cast<size_t>(dx)]));
+        }
+    }
+}
+
+#else
+
+void downsampleBox(const unsigned char* src, int srcWidth, int srcHeight, int srcStride, unsigned char* dst,
+                   int dstWidth, int dstHeight, int dstStride) {
+    scalar::downsampleBox(src, srcWidth, srcHeight, srcStride, dst, dstWidth, dstHeight, dstStride);
+}
+
+#endif
+
+}  // namespace ImageKernels
@@ -0,0 +1,38 @@
+/*
+ * Xournal++
+ *
+ * Resampling of rendered images
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+/**
+ * Loops over the pixels of CAIRO_FORMAT_ARGB32 images, vectorized with SSE2 when it is available (i.e. on all x86-64
+ * CPUs): the four channels of a pixel are processed as one vector of floats. The results are the same as the scalar
+ * versions, which are used on the other architectures.
+ */
+namespace ImageKernels {
+
+/**
+ * @brief Shrinks a premultiplied ARGB32 image with a box filter: each destination pixel is the average of the source
+ * area it covers, partially covered source pixels being weighted by their coverage.
+ *
+ * The destination must not be larger than the source in either direction. The strides are in bytes.
+ */
+void downsampleBox(const unsigned char* src, int srcWidth, int srcHeight, int srcStride, unsigned char* dst,
+                   int dstWidth, int dstHeight, int dstStride);
+
+/**
+ * The reference implementation, one channel at a time
+ */
+namespace scalar {
+void downsampleBox(const unsigned char* src, int srcWidth, int srcHeight, int srcStride, unsigned char* dst,
+                   int dstWidth, int dstHeight, int dstStride);
+}  // namespace scalar
+
+}  // namespace ImageKernels
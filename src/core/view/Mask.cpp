@@ -1,5 +1,6 @@
 #include "Mask.h"
 
+#include <cmath>  // for ceil
 #include <iostream>
 
 #include <cairo.h>
@@ -84,6 +85,12 @@ void Mask::constructorImpl(DPIInfoType dpiInfo, const Range& extent, double zoom
         std::cout << "  Its DPI scaling: " << x << " x " << y << std::endl;
     });
 
+    double xScale = 1.0;
+    double yScale = 1.0;
+    cairo_surface_get_device_scale(surf, &xScale, &yScale);
+    const size_t bytesPerPixel = contentType == CAIRO_CONTENT_ALPHA ? 1 : 4;
+    this->memoryUsage = static_cast<size_t>(std::ceil(width * xScale) * std::ceil(height * yScale)) * bytesPerPixel;
+
     this->cr.reset(cairo_create(surf), xoj::util::adopt);
     cairo_surface_destroy(surf);  // surf is now owned by this->cr
 
@@ -139,6 +146,8 @@ void Mask::wipeRange(const Range& rg) {
 
 void Mask::reset() { cr.reset(); }
 
+auto Mask::getMemoryUsage() const -> size_t { return cr ? memoryUsage : 0; }
+
 #ifdef DEBUG_MASKS
 namespace {
 auto getSurfaceTypeName(cairo_surface_t* surf) -> std::string {
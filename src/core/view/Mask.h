@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <cstddef>  // for size_t
+
 #include <cairo.h>
 #include <gdk/gdk.h>
 
@@ -75,6 +77,11 @@ public:
 
     inline double getZoom() const { return zoom; }
 
+    /**
+     * @brief Estimate of the memory used by the surface, in bytes (0 if the mask is not initialized)
+     */
+    size_t getMemoryUsage() const;
+
 private:
     template <typename DPIInfoType>
     void constructorImpl(DPIInfoType dpiInfo, const Range& extent, double zoom, cairo_content_t contentType);
@@ -83,5 +90,6 @@ private:
     int xOffset = 0;
     int yOffset = 0;
     double zoom = 1.0;
+    size_t memoryUsage = 0;
 };
 };  // namespace xoj::view
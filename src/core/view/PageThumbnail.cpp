@@ -0,0 +1,46 @@
+#include "PageThumbnail.h"
+
+#include <algorithm>  // for max
+
+#include <cairo.h>  // for cairo_create, cairo_scale
+
+#include "model/PageType.h"                   // for PageType
+#include "model/XojPage.h"                    // for XojPage
+#include "util/safe_casts.h"                  // for ceil_cast
+#include "view/DocumentView.h"                // for DocumentView
+#include "view/background/BackgroundFlags.h"  // for BackgroundFlags
+
+auto xoj::view::renderPageThumbnail(const PageRef& page, const XojPdfPageSPtr& pdfPage, int maxSize)
+        -> xoj::util::CairoSurfaceSPtr {
+    double width = page->getWidth();
+    double height = page->getHeight();
+
+    double zoom = maxSize / std::max(width, height);
+    width *= zoom;
+    height *= zoom;
+
+    xoj::util::CairoSurfaceSPtr buffer(
+            cairo_image_surface_create(CAIRO_FORMAT_ARGB32, ceil_cast<int>(width), ceil_cast<int>(height)),
+            xoj::util::adopt);
+
+    xoj::util::CairoSPtr cr(cairo_create(buffer.get()), xoj::util::adopt);
+    cairo_scale(cr.get(), zoom, zoom);
+
+    xoj::view::BackgroundFlags flags = xoj::view::BACKGROUND_SHOW_ALL;
+
+    // We don't have access to a PdfCache on which DocumentView relies for PDF backgrounds.
+    // We thus print the PDF background by hand.
+    if (page->getBackgroundType().isPdfPage()) {
+        if (pdfPage) {
+            pdfPage->render(cr.get());
+        }
+        flags.showPDF = xoj::view::HIDE_PDF_BACKGROUND;  // Already printed (if any)
+    } else {
+        flags.forceBackgroundColor = xoj::view::FORCE_AT_LEAST_BACKGROUND_COLOR;
+    }
+
+    DocumentView view;
+    view.drawPage(page, cr.get(), true /* don't render erasable */, flags);
+
+    return buffer;
+}
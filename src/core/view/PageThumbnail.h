@@ -0,0 +1,31 @@
+/*
+ * Xournal++
+ *
+ * Renders a small preview of a page
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include "model/PageRef.h"            // for PageRef
+#include "pdf/base/XojPdfPage.h"      // for XojPdfPageSPtr
+#include "util/raii/CairoWrappers.h"  // for CairoSurfaceSPtr
+
+namespace xoj::view {
+
+/**
+ * @brief Renders the page into a new image surface whose largest side is maxSize pixels.
+ *
+ * No PdfCache is involved: the PDF background (if any) is rendered directly from pdfPage.
+ * The caller must make sure the page is not modified while rendering (lock the document or pass a copy).
+ *
+ * @param page The page to render
+ * @param pdfPage The PDF page of the background, or nullptr if the page has no (available) PDF background
+ * @param maxSize Size in pixels of the largest side of the thumbnail
+ */
+auto renderPageThumbnail(const PageRef& page, const XojPdfPageSPtr& pdfPage, int maxSize) -> xoj::util::CairoSurfaceSPtr;
+}  // namespace xoj::view
@@ -1,5 +1,6 @@
 #include "TexImageView.h"
 
+#include <cmath>   // for abs, ceil, exp2, log2
 #include <string>  // for string
 
 #include <cairo.h>             // for cairo_paint_with_alpha, cairo_scale
@@ -8,11 +9,19 @@
 #include <poppler-page.h>      // for poppler_page_render, poppler_page_get_...
 #include <poppler.h>           // for PopplerPage, PopplerDocument, g_clear_...
 
-#include "model/TexImage.h"  // for TexImage
-#include "view/View.h"       // for Context, OPACITY_NO_AUDIO, view
+#include "model/TexImage.h"         // for TexImage
+#include "util/raii/GObjectSPtr.h"  // for GObjectSPtr
+#include "view/View.h"              // for Context, OPACITY_NO_AUDIO, view
 
 using namespace xoj::view;
 
+/// Larger formulas are drawn as vectors, instead of keeping huge images (8 MiB)
+constexpr double MAX_RASTER_PIXELS = 2048.0 * 1024.0;
+
+auto TexImageView::rasterSize(double pixels) -> int {
+    return static_cast<int>(std::ceil(std::exp2(std::ceil(4.0 * std::log2(pixels)) / 4.0)));
+}
+
 TexImageView::TexImageView(const TexImage* texImage): texImage(texImage) {}
 
 TexImageView::~TexImageView() = default;
@@ -28,6 +37,12 @@ void TexImageView::draw(const Context& ctx) const {
     if (pdf != nullptr) {
         if (poppler_document_get_n_pages(pdf) < 1) {
             g_warning("Got latex PDF without pages!: %s", texImage->getText().c_str());
+            cairo_restore(cr);
+            return;
+        }
+
+        if (drawRaster(ctx)) {
+            cairo_restore(cr);
             return;
         }
 
@@ -83,3 +98,75 @@ void TexImageView::draw(const Context& ctx) const {
 
     cairo_restore(cr);
 }
+
+auto TexImageView::drawRaster(const Context& ctx) const -> bool {
+    cairo_t* cr = ctx.cr;
+
+    // Exports and printing keep the vector rendering
+    cairo_surface_t* target = cairo_get_group_target(cr);
+    if (cairo_surface_get_type(target) != CAIRO_SURFACE_TYPE_IMAGE) {
+        return false;
+    }
+
+    cairo_matrix_t matrix;
+    cairo_get_matrix(cr, &matrix);
+    if (matrix.xy != 0.0 || matrix.yx != 0.0) {
+        return false;
+    }
+    double deviceScaleX = 1.0;
+    double deviceScaleY = 1.0;
+    cairo_surface_get_device_scale(target, &deviceScaleX, &deviceScaleY);
+
+    const double pixelWidth = std::abs(matrix.xx) * deviceScaleX * texImage->getElementWidth();
+    const double pixelHeight = std::abs(matrix.yy) * deviceScaleY * texImage->getElementHeight();
+    if (pixelWidth < 1.0 || pixelHeight < 1.0 || pixelWidth * pixelHeight > MAX_RASTER_PIXELS) {
+        return false;
+    }
+
+    const int width = rasterSize(pixelWidth);
+    const int height = rasterSize(pixelHeight);
+    xoj::util::CairoSurfaceSPtr raster = texImage->getCachedRaster(width, height);
+    if (!raster) {
+        raster = renderRaster(width, height);
+        if (!raster) {
+            return false;
+        }
+        texImage->cacheRaster(raster);
+    }
+
+    cairo_set_operator(cr, CAIRO_OPERATOR_OVER);
+    cairo_translate(cr, texImage->getX(), texImage->getY());
+    cairo_scale(cr, texImage->getElementWidth() / width, texImage->getElementHeight() / height);
+    cairo_set_source_surface(cr, raster.get(), 0, 0);
+    cairo_pattern_set_filter(cairo_get_source(cr), CAIRO_FILTER_GOOD);
+
+    // Make TeX images translucent when highlighting audio strokes as they can not have audio
+    if (ctx.fadeOutNonAudio) {
+        cairo_paint_with_alpha(cr, OPACITY_NO_AUDIO);
+    } else {
+        cairo_paint(cr);
+    }
+    return true;
+}
+
+auto TexImageView::renderRaster(int width, int height) const -> xoj::util::CairoSurfaceSPtr {
+    xoj::util::GObjectSPtr<PopplerPage> page(poppler_document_get_page(texImage->getPdf(), 0), xoj::util::adopt);
+    if (!page) {
+        return nullptr;
+    }
+    double pageWidth = 0;
+    double pageHeight = 0;
+    poppler_page_get_size(page.get(), &pageWidth, &pageHeight);
+
+    xoj::util::CairoSurfaceSPtr raster(cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height),
+                                       xoj::util::adopt);
+    if (cairo_surface_status(raster.get()) != CAIRO_STATUS_SUCCESS) {
+        return nullptr;
+    }
+    xoj::util::CairoSPtr cr(cairo_create(raster.get()), xoj::util::adopt);
+    cairo_scale(cr.get(), width / pageWidth, height / pageHeight);
+    poppler_page_render(page.get(), cr.get());
+    cairo_surface_flush(raster.get());
+
+    return raster;
+}
@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include "util/raii/CairoWrappers.h"  // for CairoSurfaceSPtr
+
 #include "View.h"
 
 class TexImage;
@@ -25,6 +27,28 @@ public:
      */
     void draw(const Context& ctx) const override;
 
+    /**
+     * The sizes of the rasterizations are powers of 2^(1/4), so that they are shared by close zoom levels, and shrunk
+     * by a factor of at most 2^(1/4) when drawn.
+     *
+     * @return The size in pixels of the rasterization drawn over the given number of pixels
+     */
+    static int rasterSize(double pixels);
+
+private:
+    /**
+     * Draws the PDF from a rasterization cached in the TexImage, rendering it if needed.
+     *
+     * @return false if the PDF must be drawn as vectors: when drawing to a vector surface (export, printing), or
+     * with a rotation, or at a huge size.
+     */
+    bool drawRaster(const Context& ctx) const;
+
+    /**
+     * Renders the PDF to an image of the given size
+     */
+    xoj::util::CairoSurfaceSPtr renderRaster(int width, int height) const;
+
 private:
     const TexImage* texImage;
 };
@@ -16,9 +16,9 @@ StrokeToolFilledHighlighterView::StrokeToolFilledHighlighterView(const StrokeHan
 
 StrokeToolFilledHighlighterView::~StrokeToolFilledHighlighterView() noexcept = default;
 
-void StrokeToolFilledHighlighterView::draw(cairo_t* cr) const {
+void StrokeToolFilledHighlighterView::drawWithoutDrawingAids(cairo_t* cr) const {
 
-    std::vector<Point> pts = this->flushBuffer();
+    const std::vector<Point>& pts = this->flushBuffer();
     if (pts.empty()) {
         // The input sequence has probably been cancelled. This view should soon be deleted
         return;
@@ -70,4 +70,5 @@ void StrokeToolFilledHighlighterView::draw(cairo_t* cr) const {
     cairo_set_operator(cr, this->cairoOp);
 
     this->mask.blitTo(cr);
+    this->recordInkLatency();
 }
@@ -20,6 +20,6 @@ public:
     StrokeToolFilledHighlighterView(const StrokeHandler* strokeHandler, const Stroke& stroke, Repaintable* parent);
     virtual ~StrokeToolFilledHighlighterView() noexcept;
 
-    void draw(cairo_t* cr) const override;
+    void drawWithoutDrawingAids(cairo_t* cr) const override;
 };
 };  // namespace xoj::view
@@ -36,9 +36,8 @@ void StrokeToolFilledView::drawFilling(cairo_t* cr, const std::vector<Point>& pt
 
 void StrokeToolFilledView::on(StrokeToolView::AddPointRequest, const Point& p) {
     this->singleDot = false;
-    xoj_assert(!this->pointBuffer.empty());
-    Point lastPoint = this->pointBuffer.back();
-    this->pointBuffer.emplace_back(p);
+    Point lastPoint = this->lastQueuedPoint;
+    this->pushPoint(p);
     auto rg = this->getRepaintRange(lastPoint, p);
     // Add the first point, so that the range covers all the filling changes
     rg.addPoint(this->filling.firstPoint.x, this->filling.firstPoint.y);
@@ -47,10 +46,16 @@ void StrokeToolFilledView::on(StrokeToolView::AddPointRequest, const Point& p) {
 
 void StrokeToolFilledView::on(StrokeToolView::StrokeReplacementRequest, const Stroke& newStroke) {
     StrokeToolView::on(STROKE_REPLACEMENT_REQUEST, newStroke);
-    this->filling.contour = this->pointBuffer;
-    if (!this->pointBuffer.empty()) {
-        const Point& fp = this->pointBuffer.front();
-        this->filling.firstPoint = xoj::util::Point<double>(fp.x, fp.y);
+    if (const auto& pts = newStroke.getPointVector(); !pts.empty()) {
+        this->filling.firstPoint = xoj::util::Point<double>(pts.front().x, pts.front().y);
+    }
+}
+
+void StrokeToolFilledView::onReset(const std::vector<Point>& pts) const {
+    // The next call to appendSegments() adds the other points
+    this->filling.contour.clear();
+    if (!pts.empty()) {
+        this->filling.contour.emplace_back(pts.front());
     }
 }
 
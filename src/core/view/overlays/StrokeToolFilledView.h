@@ -38,6 +38,8 @@ public:
     void on(StrokeReplacementRequest, const Stroke& newStroke) override;
 
 protected:
+    void onReset(const std::vector<Point>& pts) const override;
+
     class FillingData {
     public:
         FillingData(double alpha, const Point& p): alpha(alpha), firstPoint(p.x, p.y), contour{p} {}
@@ -1,9 +1,12 @@
 #include "StrokeToolView.h"
 
+#include <chrono>
 #include <functional>
+#include <iterator>
 #include <memory>
 #include <numeric>
 
+#include "control/PerformanceMonitor.h"
 #include "control/tools/StrokeHandler.h"
 #include "model/LineStyle.h"
 #include "model/Stroke.h"
@@ -18,7 +21,12 @@
 using namespace xoj::view;
 
 StrokeToolView::StrokeToolView(const StrokeHandler* strokeHandler, const Stroke& stroke, Repaintable* parent):
-        BaseStrokeToolView(parent, stroke), strokeHandler(strokeHandler), pointBuffer(stroke.getPointVector()) {
+        BaseStrokeToolView(parent, stroke),
+        strokeHandler(strokeHandler),
+        performanceMonitor(strokeHandler->getPerformanceMonitor()) {
+    for (const Point& p: stroke.getPointVector()) {
+        this->pushPoint(p);
+    }
     this->registerToPool(strokeHandler->getViewPool());
     parent->flagDirtyRegion(Range(stroke.boundingRect()));
 }
@@ -28,8 +36,13 @@ StrokeToolView::~StrokeToolView() noexcept { this->unregisterFromPool(); }
 bool StrokeToolView::isViewOf(const OverlayBase* overlay) const { return overlay == this->strokeHandler; }
 
 void StrokeToolView::draw(cairo_t* cr) const {
+    this->drawWithoutDrawingAids(cr);
+    this->drawPredictedTail(cr);
+}
 
-    std::vector<Point> pts = this->flushBuffer();
+void StrokeToolView::drawWithoutDrawingAids(cairo_t* cr) const {
+
+    const std::vector<Point>& pts = this->flushBuffer();
     if (pts.empty()) {
         // The input sequence has probably been cancelled. This view should soon be deleted
         return;
@@ -76,39 +89,47 @@ void StrokeToolView::draw(cairo_t* cr) const {
     }
 
     this->mask.blitTo(cr);
+    this->recordInkLatency();
 }
 
 void StrokeToolView::on(StrokeToolView::AddPointRequest, const Point& p) {
     this->singleDot = false;
-    xoj_assert(!this->pointBuffer.empty());  // front() is the last point we painted on the mask (see flushBuffer())
-    Point lastPoint = this->pointBuffer.back();
-    this->pointBuffer.emplace_back(p);
+    Point lastPoint = this->lastQueuedPoint;
+    this->pushPoint(p);
     this->parent->flagDirtyRegion(this->getRepaintRange(lastPoint, p));
 }
 
 void StrokeToolView::on(StrokeToolView::ThickenFirstPointRequest, double newWidth) {
     xoj_assert(newWidth > 0.0);
-    xoj_assert(this->pointBuffer.size() == 1);
-    Point& p = this->pointBuffer.back();
+    Point p = this->lastQueuedPoint;
     xoj_assert(p.z <= newWidth);  // Thicken means thicken
     p.z = newWidth;
+    this->lastQueuedPoint = p;
+    this->queueReset({p}, false);
     Range rg = Range(p.x, p.y);
     rg.addPadding(0.5 * newWidth);
     this->parent->flagDirtyRegion(rg);
 }
 
 void StrokeToolView::deleteOn(StrokeToolView::CancellationRequest, const Range& rg) {
-    this->pointBuffer.clear();
-    this->parent->drawAndDeleteToolView(this, rg);
+    this->queueReset({}, false);
+    this->parent->drawAndDeleteToolView(this, rg.unite(this->clearPredictedTail()));
 }
 
-void StrokeToolView::on(StrokeToolView::StrokeReplacementRequest, const Stroke& newStroke) {
-    if (this->mask.isInitialized()) {
-        // only wipe mask it actually exists (the view has already been drawn at least once)
-        this->mask.wipe();
+void StrokeToolView::on(StrokeToolView::PredictionRequest, const std::vector<Point>& tail) {
+    Range rg = this->getTailRange(tail);
+    {
+        std::lock_guard lock(this->predictionMutex);
+        rg = rg.unite(this->getTailRange(this->predictedTail));
+        this->predictedTail = tail;
     }
-    this->pointBuffer = newStroke.getPointVector();
-    this->dashOffset = 0;
+    if (!rg.empty()) {
+        this->parent->flagDirtyRegion(rg);
+    }
+}
+
+void StrokeToolView::on(StrokeToolView::StrokeReplacementRequest, const Stroke& newStroke) {
+    this->queueReset(newStroke.getPointVector(), true);
     this->strokeWidth = newStroke.getWidth();
     xoj_assert(this->strokeColor == strokeColorWithAlpha(newStroke));
     xoj_assert(this->lineStyle == newStroke.getLineStyle());
@@ -117,7 +138,7 @@ void StrokeToolView::on(StrokeToolView::StrokeReplacementRequest, const Stroke&
 }
 
 void StrokeToolView::deleteOn(StrokeToolView::FinalizationRequest, const Range& rg) {
-    this->parent->drawAndDeleteToolView(this, rg);
+    this->parent->drawAndDeleteToolView(this, rg.unite(this->clearPredictedTail()));
 }
 
 auto StrokeToolView::getRepaintRange(const Point& lastPoint, const Point& addedPoint) const -> Range {
@@ -136,12 +157,136 @@ void StrokeToolView::drawDot(cairo_t* cr, const Point& p) const {
     cairo_stroke(cr);
 }
 
-std::vector<Point> StrokeToolView::flushBuffer() const {
-    std::vector<Point> pts;
-    std::swap(this->pointBuffer, pts);
-    if (!pts.empty()) {
-        // Keep the last point in the buffer - to be used in the next iteration
-        this->pointBuffer.emplace_back(pts.back());
+void StrokeToolView::drawPredictedTail(cairo_t* cr) const {
+    std::lock_guard lock(this->predictionMutex);
+    if (this->predictedTail.size() < 2 || !this->mask.isInitialized()) {
+        return;
+    }
+    xoj::util::CairoSaveGuard saveGuard(cr);
+    cairo_set_operator(cr, this->cairoOp);
+    Util::cairo_set_source_argb(cr, strokeColor);
+
+    const Point& front = this->predictedTail.front();
+    cairo_set_line_width(cr, front.z == Point::NO_PRESSURE ? this->strokeWidth : front.z);
+    cairo_set_line_cap(cr, CAIRO_LINE_CAP_ROUND);
+    cairo_set_line_join(cr, CAIRO_LINE_JOIN_ROUND);
+    cairo_move_to(cr, front.x, front.y);
+    for (auto it = std::next(this->predictedTail.begin()); it != this->predictedTail.end(); ++it) {
+        cairo_line_to(cr, it->x, it->y);
+    }
+    cairo_stroke(cr);
+}
+
+auto StrokeToolView::clearPredictedTail() -> Range {
+    std::lock_guard lock(this->predictionMutex);
+    Range rg = this->getTailRange(this->predictedTail);
+    this->predictedTail.clear();
+    return rg;
+}
+
+auto StrokeToolView::getTailRange(const std::vector<Point>& tail) const -> Range {
+    if (tail.empty()) {
+        return Range();
+    }
+    Range rg(tail.front().x, tail.front().y);
+    for (const Point& p: tail) {
+        rg.addPoint(p.x, p.y);
+    }
+    rg.addPadding(0.5 * (tail.front().z == Point::NO_PRESSURE ? this->strokeWidth : tail.front().z));
+    return rg;
+}
+
+void StrokeToolView::pushPoint(const Point& p) {
+    this->lastQueuedPoint = p;
+    this->enqueue({p, this->strokeHandler->getInputTime()});
+}
+
+void StrokeToolView::queueReset(std::vector<Point> points, bool wipeMask) {
+    if (!points.empty()) {
+        this->lastQueuedPoint = points.back();
+    }
+    {
+        std::lock_guard lock(this->slowPathMutex);
+        this->resets.push_back({std::move(points), wipeMask});
+    }
+    QueuedPoint marker;
+    marker.isResetMarker = true;
+    this->enqueue(marker);
+}
+
+void StrokeToolView::enqueue(const QueuedPoint& qp) {
+    if (!this->overflowing.load(std::memory_order_acquire) && this->pointQueue.push(qp)) {
+        return;
+    }
+    std::lock_guard lock(this->slowPathMutex);
+    // Once overflowing, keep using the overflow until the view empties it, to preserve the order
+    if (this->overflowing.load(std::memory_order_relaxed) || !this->pointQueue.push(qp)) {
+        this->overflow.push_back(qp);
+        this->overflowing.store(true, std::memory_order_release);
+    }
+}
+
+auto StrokeToolView::flushBuffer() const -> const std::vector<Point>& {
+    this->drawBuffer.clear();
+    if (this->lastDrawnPoint) {
+        // Keep the last point painted - to be used in this iteration
+        this->drawBuffer.emplace_back(*this->lastDrawnPoint);
+    }
+
+    QueuedPoint qp;
+    while (this->pointQueue.pop(qp)) {
+        consume(qp);
+    }
+    if (this->overflowing.load(std::memory_order_acquire)) {
+        std::vector<QueuedPoint> overflown;
+        {
+            std::lock_guard lock(this->slowPathMutex);
+            std::swap(overflown, this->overflow);
+            this->overflowing.store(false, std::memory_order_release);
+        }
+        for (const QueuedPoint& p: overflown) {
+            consume(p);
+        }
+    }
+
+    if (!this->drawBuffer.empty()) {
+        this->lastDrawnPoint = this->drawBuffer.back();
+    }
+    return this->drawBuffer;
+}
+
+void StrokeToolView::consume(const QueuedPoint& qp) const {
+    if (qp.isResetMarker) {
+        applyNextReset();
+        return;
+    }
+    this->drawBuffer.emplace_back(qp.point);
+    if (!this->oldestInputTime) {
+        this->oldestInputTime = qp.inputTime;
+    }
+}
+
+void StrokeToolView::applyNextReset() const {
+    Reset reset;
+    {
+        std::lock_guard lock(this->slowPathMutex);
+        xoj_assert(!this->resets.empty());
+        reset = std::move(this->resets.front());
+        this->resets.pop_front();
+    }
+    // Only wipe the mask if it actually exists (the view has already been drawn at least once)
+    if (reset.wipeMask && this->mask.isInitialized()) {
+        this->mask.wipe();
+    }
+    this->dashOffset = 0;
+    this->lastDrawnPoint.reset();
+    this->drawBuffer = std::move(reset.points);
+    this->onReset(this->drawBuffer);
+}
+
+void StrokeToolView::recordInkLatency() const {
+    if (this->oldestInputTime) {
+        this->performanceMonitor->recordInkLatency(std::chrono::steady_clock::now() - *this->oldestInputTime);
+        this->oldestInputTime.reset();
     }
-    return pts;
 }
@@ -10,17 +10,25 @@
  */
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
 #include <vector>
 
 #include <cairo.h>
 
+#include "model/Point.h"
 #include "util/DispatchPool.h"
+#include "util/SpscRingBuffer.h"
 #include "view/Mask.h"
 
 #include "BaseStrokeToolView.h"
 
+class PerformanceMonitor;
 class StrokeHandler;
-class Point;
 class Range;
 class Stroke;
 class OverlayBase;
@@ -35,8 +43,16 @@ public:
 
     bool isViewOf(const OverlayBase* overlay) const override;
 
+    /**
+     * @brief Draws the stroke and the predicted tail (if any)
+     */
     void draw(cairo_t* cr) const override;
 
+    /**
+     * @brief Draws the stroke only: the predicted tail must not end up in the page buffer
+     */
+    void drawWithoutDrawingAids(cairo_t* cr) const override;
+
     /**
      * Listener interface
      */
@@ -56,6 +72,13 @@ public:
     } CANCELLATION_REQUEST = {};
     void deleteOn(CancellationRequest, const Range& rg);
 
+    static constexpr struct PredictionRequest {
+    } PREDICTION_REQUEST = {};
+    /**
+     * @brief Replaces the predicted tail of the stroke (see StrokePredictor). An empty tail removes it.
+     */
+    void on(PredictionRequest, const std::vector<Point>& tail);
+
     /**
      * @brief Called before the corresponding StrokeHandler's destruction
      */
@@ -71,10 +94,43 @@ protected:
 
     void drawDot(cairo_t* cr, const Point& p) const;
 
+    void drawPredictedTail(cairo_t* cr) const;
+
+    /**
+     * @brief Removes the predicted tail
+     * @return The area the tail covered
+     */
+    Range clearPredictedTail();
+    Range getTailRange(const std::vector<Point>& tail) const;
+
+    /**
+     * @brief (Controller side) Queue a point for the next call to draw()
+     */
+    void pushPoint(const Point& p);
+
+    /**
+     * @brief (Controller side) Replace all the points queued or drawn so far by the given ones.
+     * The replacement is applied by flushBuffer(), in order with the queued points.
+     * @param wipeMask Whether the mask must be wiped before drawing the new points
+     */
+    void queueReset(std::vector<Point> points, bool wipeMask);
+
     /**
-     * @brief (Thread-safe) Flush the communication buffer and returns its content.
+     * @brief (View side) Flush the communication queue and returns the points to draw.
+     * front() is the last point painted on the mask by the previous call (if any).
+     * The returned vector is reused by the next call.
      */
-    std::vector<Point> flushBuffer() const;
+    const std::vector<Point>& flushBuffer() const;
+
+    /**
+     * @brief (View side) Called by flushBuffer() when a reset is applied, with the new points
+     */
+    virtual void onReset(const std::vector<Point>&) const {}
+
+    /**
+     * @brief (View side) Report the time elapsed since the input event of the oldest point of the last flush
+     */
+    void recordInkLatency() const;
 
     // Nothing in the base class
     virtual void drawFilling(cairo_t*, const std::vector<Point>&) const {}
@@ -83,7 +139,7 @@ protected:
     const StrokeHandler* strokeHandler;
 
 protected:
-    bool singleDot = true;
+    std::atomic<bool> singleDot{true};
 
     /**
      * @brief offset for drawing dashes (if any)
@@ -92,10 +148,54 @@ protected:
     mutable double dashOffset = 0;
 
     /**
-     * @brief Controller/View communication buffer
-     *      Those are in the same thread. Add mutex protection if this changes
+     * @brief Controller/View communication
+     *
+     * The points go through a lock-free queue: no allocation nor locking while the view keeps up with the input.
+     * The rare events use a mutex: the queue overflowing (e.g. while the page is not visible) and the resets (stroke
+     * replacement, cancellation...). Each reset has a marker in the queue, so that it is applied in order.
+     */
+    struct QueuedPoint {
+        Point point;
+        std::chrono::steady_clock::time_point inputTime;
+        bool isResetMarker = false;
+    };
+
+    struct Reset {
+        std::vector<Point> points;
+        bool wipeMask = false;
+    };
+
+    static constexpr size_t QUEUE_CAPACITY = 1024;
+
+    void enqueue(const QueuedPoint& qp);
+    void consume(const QueuedPoint& qp) const;
+    void applyNextReset() const;
+
+    mutable xoj::util::SpscRingBuffer<QueuedPoint, QUEUE_CAPACITY> pointQueue;
+
+    mutable std::mutex slowPathMutex;
+    /// Points queued while pointQueue was full. Guarded by slowPathMutex.
+    mutable std::vector<QueuedPoint> overflow;
+    std::atomic<bool> overflowing{false};
+    /// Guarded by slowPathMutex
+    mutable std::deque<Reset> resets;
+
+    /// Controller side: the last point queued
+    Point lastQueuedPoint;
+
+    /// View side: the points to draw, the last point painted and the input time of the oldest point to draw
+    mutable std::vector<Point> drawBuffer;
+    mutable std::optional<Point> lastDrawnPoint;
+    mutable std::optional<std::chrono::steady_clock::time_point> oldestInputTime;
+
+    PerformanceMonitor* performanceMonitor;
+
+    /**
+     * @brief Predicted continuation of the stroke, drawn over the mask but never on it.
+     * Its front() is the last real point. Guarded by predictionMutex.
      */
-    mutable std::vector<Point> pointBuffer;  // Todo: implement a lock-free fifo?
+    std::vector<Point> predictedTail;
+    mutable std::mutex predictionMutex;
 
     /**
      * @brief Drawing mask.
@@ -0,0 +1,188 @@
+#include "util/Tracing.h"
+
+#include <chrono>   // for steady_clock, duration_cast
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint64_t
+#include <fstream>  // for ofstream
+#include <memory>   // for shared_ptr, make_shared
+#include <mutex>    // for mutex, lock_guard
+#include <ostream>  // for ostream
+#include <string>   // for string
+#include <utility>  // for move
+#include <vector>   // for vector
+
+#include <glib.h>  // for g_warning
+
+#include "util/serdesstream.h"  // for serdes_stream
+
+namespace xoj::util::trace {
+
+namespace {
+struct Event {
+    const char* name;
+    int64_t begin;
+    int64_t end;
+};
+
+/// The spans of one thread. Only this thread appends to it, but stop() reads it from another thread.
+struct ThreadBuffer {
+    std::mutex mutex;
+    /// Ring buffer of the spans, once it reached the maximal size
+    std::vector<Event> events;
+    /// Index of the oldest span, once the buffer is full
+    size_t oldest = 0;
+    std::string name;
+    uint64_t id = 0;
+
+    void clear() {
+        events.clear();
+        oldest = 0;
+    }
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    fs::path file;
+    uint64_t nextThreadId = 1;
+};
+
+/// Only written under the registry mutex, while tracing is disabled
+std::atomic<size_t> maxEventsPerThread{DEFAULT_MAX_EVENTS_PER_THREAD};
+
+auto registry() -> Registry& {
+    // Never destroyed: threads may record spans during the static destruction
+    static auto* r = new Registry;
+    return *r;
+}
+
+auto threadBuffer() -> ThreadBuffer& {
+    // The registry keeps a reference, so that the spans of a thread are kept after the thread ended
+    thread_local std::shared_ptr<ThreadBuffer> buffer = [] {
+        auto b = std::make_shared<ThreadBuffer>();
+        Registry& r = registry();
+        std::lock_guard lock(r.mutex);
+        b->id = r.nextThreadId++;
+        r.buffers.push_back(b);
+        return b;
+    }();
+    return *buffer;
+}
+
+const auto epoch = std::chrono::steady_clock::now();
+
+void writeJsonString(std::ostream& out, const std::string& str) {
+    out << '"';
+    for (char c: str) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out << ' ';
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+/// Timestamps are stored in nanoseconds, but the trace format expects microseconds
+void writeMicroseconds(std::ostream& out, int64_t ns) { out << ns / 1000 << '.' << (ns % 1000) / 100; }
+}  // namespace
+
+std::atomic<bool> detail::enabled{false};
+
+auto detail::now() -> int64_t {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+void detail::record(const char* name, int64_t begin, int64_t end) {
+    if (!isEnabled()) {
+        // Tracing was stopped while the span was open
+        return;
+    }
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard lock(buffer.mutex);
+    if (buffer.events.size() < maxEventsPerThread.load(std::memory_order_relaxed)) {
+        buffer.events.push_back({name, begin, end});
+    } else if (!buffer.events.empty()) {
+        // Overwrite the oldest span
+        buffer.events[buffer.oldest] = {name, begin, end};
+        buffer.oldest = (buffer.oldest + 1) % buffer.events.size();
+    }
+}
+
+void setThreadName(const char* name) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard lock(buffer.mutex);
+    buffer.name = name;
+}
+
+void start(fs::path file, size_t maxEvents) {
+    Registry& r = registry();
+    std::lock_guard lock(r.mutex);
+    detail::enabled = false;
+    maxEventsPerThread = maxEvents;
+    for (auto& buffer: r.buffers) {
+        std::lock_guard bufferLock(buffer->mutex);
+        buffer->clear();
+    }
+    r.file = std::move(file);
+    detail::enabled = true;
+}
+
+auto getFile() -> fs::path {
+    Registry& r = registry();
+    std::lock_guard lock(r.mutex);
+    return r.file;
+}
+
+auto stop() -> bool {
+    if (!detail::enabled.exchange(false)) {
+        return true;
+    }
+
+    Registry& r = registry();
+    std::lock_guard lock(r.mutex);
+
+    auto out = serdes_stream<std::ofstream>(r.file);
+    if (!out) {
+        g_warning("Could not write the trace to %s", r.file.u8string().c_str());
+        return false;
+    }
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    auto separator = [&]() -> std::ostream& {
+        if (!first) {
+            out << ",\n";
+        }
+        first = false;
+        return out;
+    };
+
+    for (auto& buffer: r.buffers) {
+        std::lock_guard bufferLock(buffer->mutex);
+        if (!buffer->name.empty()) {
+            separator() << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer->id
+                        << ",\"args\":{\"name\":";
+            writeJsonString(out, buffer->name);
+            out << "}}";
+        }
+        for (size_t n = 0; n < buffer->events.size(); n++) {
+            const Event& e = buffer->events[(buffer->oldest + n) % buffer->events.size()];
+            separator() << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->id << ",\"name\":";
+            writeJsonString(out, e.name);
+            out << ",\"ts\":";
+            writeMicroseconds(out, e.begin);
+            out << ",\"dur\":";
+            writeMicroseconds(out, e.end - e.begin);
+            out << "}";
+        }
+        buffer->clear();
+    }
+    out << "\n]}\n";
+
+    return static_cast<bool>(out);
+}
+
+}  // namespace xoj::util::trace
@@ -30,7 +30,9 @@ constexpr auto BUF_SIZE = 68000;
 
 XojPreviewExtractor::XojPreviewExtractor() = default;
 
-XojPreviewExtractor::~XojPreviewExtractor() {
+XojPreviewExtractor::~XojPreviewExtractor() { reset(); }
+
+void XojPreviewExtractor::reset() {
     g_free(data);
     data = nullptr;
     dataLen = 0;
@@ -88,6 +90,7 @@ auto XojPreviewExtractor::readPreview(char* buffer, int len) -> PreviewExtractRe
 
     if (startPreview != -1 && endPreview != -1) {
         buffer[endPreview] = 0;
+        reset();
         this->data = g_base64_decode(buffer + startPreview, &dataLen);
         return PREVIEW_RESULT_IMAGE_READ;
     }
@@ -109,6 +112,9 @@ auto XojPreviewExtractor::readFile(const fs::path& file) -> PreviewExtractResult
     if (!Util::hasXournalFileExt(file)) {
         return PREVIEW_RESULT_BAD_FILE_EXTENSION;
     }
+    // The extractor may be reused for several files (see xournalpp-thumbnailer --batch)
+    reset();
+
     // read the new file format
     int zipError = 0;
     zip_t* zipFp = zip_open(file.u8string().c_str(), ZIP_RDONLY, &zipError);
@@ -140,9 +146,7 @@ auto XojPreviewExtractor::readFile(const fs::path& file) -> PreviewExtractResult
         return PREVIEW_RESULT_NO_PREVIEW;
     }
 
-    if (thumbStat.valid & ZIP_STAT_SIZE) {
-        dataLen = thumbStat.size;
-    } else {
+    if (!(thumbStat.valid & ZIP_STAT_SIZE)) {
         zip_close(zipFp);
         return PREVIEW_RESULT_ERROR_READING_PREVIEW;
     }
@@ -155,11 +159,12 @@ auto XojPreviewExtractor::readFile(const fs::path& file) -> PreviewExtractResult
     }
 
     data = static_cast<unsigned char*>(g_malloc(thumbStat.size));
+    dataLen = thumbStat.size;
     zip_uint64_t readBytes = 0;
     while (readBytes < dataLen) {
-        zip_int64_t read = zip_fread(thumb, data, thumbStat.size);
-        if (read == -1) {
-            g_free(data);
+        zip_int64_t read = zip_fread(thumb, data + readBytes, dataLen - readBytes);
+        if (read <= 0) {
+            reset();
             zip_fclose(thumb);
             zip_close(zipFp);
             return PREVIEW_RESULT_ERROR_READING_PREVIEW;
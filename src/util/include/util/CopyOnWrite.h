@@ -0,0 +1,80 @@
+/*
+ * Xournal++
+ *
+ * Value shared between copies until one of them is modified
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <memory>   // for shared_ptr, make_shared
+#include <utility>  // for move
+
+namespace xoj::util {
+
+/**
+ * @brief Holds a value of type T which is shared, not copied, when the CopyOnWrite is copied. The value is only
+ * duplicated when a copy is modified through edit() while it is still shared.
+ *
+ * A shared value is never modified, so copies may be read from other threads. edit() must not be called on a given
+ * CopyOnWrite while it is being read from another thread (as for a plain T).
+ *
+ * The empty state does not allocate: a default constructed CopyOnWrite reads as a default constructed T.
+ */
+template <class T>
+class CopyOnWrite {
+public:
+    CopyOnWrite() = default;
+    CopyOnWrite(const CopyOnWrite&) = default;
+    CopyOnWrite(CopyOnWrite&&) noexcept = default;
+    CopyOnWrite& operator=(const CopyOnWrite&) = default;
+    CopyOnWrite& operator=(CopyOnWrite&&) noexcept = default;
+
+    explicit CopyOnWrite(T value): data(std::make_shared<T>(std::move(value))) {}
+
+    CopyOnWrite& operator=(T value) {
+        data = std::make_shared<T>(std::move(value));
+        return *this;
+    }
+
+    const T& get() const { return data ? *data : empty(); }
+    const T& operator*() const { return get(); }
+    const T* operator->() const { return &get(); }
+
+    /**
+     * @return The value, which is first duplicated if it is shared with another CopyOnWrite
+     */
+    T& edit() {
+        if (!data) {
+            data = std::make_shared<T>();
+        } else if (data.use_count() > 1) {
+            data = std::make_shared<T>(*data);
+        }
+        return *data;
+    }
+
+    /**
+     * @return The number of CopyOnWrite sharing this value (0 in the empty state)
+     */
+    size_t useCount() const { return static_cast<size_t>(data.use_count()); }
+
+    /**
+     * @return true if both share the same value
+     */
+    bool sharesWith(const CopyOnWrite& other) const { return data && data == other.data; }
+
+private:
+    static const T& empty() {
+        static const T value{};
+        return value;
+    }
+
+    std::shared_ptr<T> data;
+};
+
+}  // namespace xoj::util
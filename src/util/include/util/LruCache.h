@@ -0,0 +1,126 @@
+/*
+ * Xournal++
+ *
+ * Bounded key-value cache evicting the least recently used values
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <cstddef>        // for size_t
+#include <functional>     // for hash
+#include <list>           // for list
+#include <optional>       // for optional, nullopt
+#include <tuple>          // for tuple
+#include <unordered_map>  // for unordered_map
+#include <utility>        // for move, pair
+
+namespace xoj::util {
+
+/**
+ * @brief Holds values of a total weight of at most `capacity`. Storing a value beyond this capacity drops the least
+ * recently used ones. Each value weighs 1 unless stated otherwise, e.g. its size in bytes.
+ *
+ * Not thread safe.
+ */
+template <class Key, class Value, class Hash = std::hash<Key>>
+class LruCache {
+public:
+    explicit LruCache(size_t capacity): capacity(capacity) {}
+
+    /**
+     * @brief Stores the value, replacing any value already stored for this key
+     *
+     * A value heavier than the capacity is not stored.
+     */
+    void put(const Key& key, Value value, size_t weight = 1) {
+        erase(key);
+        if (weight > capacity) {
+            return;
+        }
+        while (totalWeight + weight > capacity) {
+            totalWeight -= std::get<2>(entries.back());
+            index.erase(std::get<0>(entries.back()));
+            entries.pop_back();
+        }
+        entries.emplace_front(key, std::move(value), weight);
+        index.emplace(key, entries.begin());
+        totalWeight += weight;
+    }
+
+    /**
+     * @brief Marks the value as the most recently used one
+     * @return The value, or nullptr if none is stored for this key. Valid until the value is dropped from the cache.
+     */
+    Value* get(const Key& key) {
+        auto it = index.find(key);
+        if (it == index.end()) {
+            return nullptr;
+        }
+        entries.splice(entries.begin(), entries, it->second);
+        return &std::get<1>(entries.front());
+    }
+
+    /**
+     * @brief Removes the value from the cache and returns it
+     * @return The value, or std::nullopt if none is stored for this key
+     */
+    std::optional<Value> take(const Key& key) {
+        auto it = index.find(key);
+        if (it == index.end()) {
+            return std::nullopt;
+        }
+        std::optional<Value> value(std::move(std::get<1>(*it->second)));
+        totalWeight -= std::get<2>(*it->second);
+        entries.erase(it->second);
+        index.erase(it);
+        return value;
+    }
+
+    void erase(const Key& key) {
+        if (auto it = index.find(key); it != index.end()) {
+            totalWeight -= std::get<2>(*it->second);
+            entries.erase(it->second);
+            index.erase(it);
+        }
+    }
+
+    void clear() {
+        index.clear();
+        entries.clear();
+        totalWeight = 0;
+    }
+
+    /**
+     * @brief Calls `f(key, value, weight)` for each value, the most recently used first, without changing the order
+     */
+    template <class F>
+    void forEach(F&& f) const {
+        for (const auto& [key, value, weight]: entries) {
+            f(key, value, weight);
+        }
+    }
+
+    bool contains(const Key& key) const { return index.count(key) != 0; }
+
+    size_t size() const { return entries.size(); }
+
+    size_t getWeight() const { return totalWeight; }
+
+    size_t getCapacity() const { return capacity; }
+
+private:
+    size_t capacity;
+    size_t totalWeight = 0;
+
+    /// Key, value and weight, the most recently used first
+    using Entry = std::tuple<Key, Value, size_t>;
+    std::list<Entry> entries;
+    std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> index;
+};
+
+}  // namespace xoj::util
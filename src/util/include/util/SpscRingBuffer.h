@@ -0,0 +1,88 @@
+/*
+ * Xournal++
+ *
+ * A bounded lock-free single-producer/single-consumer queue
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <array>    // for array
+#include <atomic>   // for atomic, memory_order_acquire, memory_order_relaxed, memory_order_release
+#include <cstddef>  // for size_t
+
+namespace xoj::util {
+
+/**
+ * @brief Fixed capacity FIFO, for one producer thread and one consumer thread. Neither side ever blocks or allocates.
+ *
+ * push() and pushedCount() must only be called by the producer, pop() and poppedCount() only by the consumer.
+ * The counters are monotonic: they count the elements that ever went through the queue.
+ *
+ * @tparam N The capacity, a power of two
+ */
+template <class T, size_t N>
+class SpscRingBuffer {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "The capacity of SpscRingBuffer must be a power of two");
+
+public:
+    static constexpr size_t capacity() { return N; }
+
+    /**
+     * @brief (Producer) Appends an element
+     * @return false if the queue is full (the element is not added)
+     */
+    bool push(const T& value) {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        if (t - producerCachedHead == N) {
+            producerCachedHead = head.load(std::memory_order_acquire);
+            if (t - producerCachedHead == N) {
+                return false;
+            }
+        }
+        slots[t & (N - 1)] = value;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief (Consumer) Removes the oldest element
+     * @return false if the queue is empty (value is left untouched)
+     */
+    bool pop(T& value) {
+        const size_t h = head.load(std::memory_order_relaxed);
+        if (h == consumerCachedTail) {
+            consumerCachedTail = tail.load(std::memory_order_acquire);
+            if (h == consumerCachedTail) {
+                return false;
+            }
+        }
+        value = slots[h & (N - 1)];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// (Producer) Number of elements pushed since the construction
+    size_t pushedCount() const { return tail.load(std::memory_order_relaxed); }
+
+    /// (Consumer) Number of elements popped since the construction
+    size_t poppedCount() const { return head.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    // The producer and the consumer indices live on different cache lines, to avoid false sharing
+    alignas(CACHE_LINE) std::atomic<size_t> tail{0};
+    size_t producerCachedHead = 0;
+
+    alignas(CACHE_LINE) std::atomic<size_t> head{0};
+    size_t consumerCachedTail = 0;
+
+    alignas(CACHE_LINE) std::array<T, N> slots{};
+};
+
+}  // namespace xoj::util
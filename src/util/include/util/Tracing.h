@@ -0,0 +1,87 @@
+/*
+ * Xournal++
+ *
+ * Scoped trace spans, written as a Chrome trace (viewable in Perfetto or chrome://tracing)
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <atomic>   // for atomic, memory_order_relaxed
+#include <cstddef>  // for size_t
+#include <cstdint>  // for int64_t
+
+#include "filesystem.h"  // for path
+
+namespace xoj::util::trace {
+
+namespace detail {
+extern std::atomic<bool> enabled;
+
+int64_t now();
+void record(const char* name, int64_t begin, int64_t end);
+}  // namespace detail
+
+/// Number of spans kept per thread by default: about 1.5 MiB per thread
+constexpr size_t DEFAULT_MAX_EVENTS_PER_THREAD = 1 << 16;
+
+/**
+ * @brief Starts collecting the spans. They are kept in memory and written to file by stop().
+ * Can be called at any time, from any thread. Calling it while tracing discards the spans collected so far.
+ *
+ * @param maxEventsPerThread Bounds the memory used by long traces: only the most recent spans of each thread are kept.
+ */
+void start(fs::path file, size_t maxEventsPerThread = DEFAULT_MAX_EVENTS_PER_THREAD);
+
+/**
+ * @brief Stops collecting the spans and writes them to the file given to start(), in the Chrome trace JSON format.
+ * @return false if the file could not be written
+ */
+bool stop();
+
+/// @return The file given to the last call to start()
+auto getFile() -> fs::path;
+
+inline bool isEnabled() { return detail::enabled.load(std::memory_order_relaxed); }
+
+/**
+ * @brief Names the calling thread in the trace. May be called before start().
+ */
+void setThreadName(const char* name);
+
+/**
+ * @brief Records the time between its construction and its destruction, if tracing is enabled at construction.
+ * When tracing is disabled, the cost is a relaxed atomic load.
+ *
+ * @param name Must be a string literal (or outlive the trace): only the pointer is stored.
+ */
+class Span {
+public:
+    explicit Span(const char* name): name(isEnabled() ? name : nullptr), begin(this->name ? detail::now() : 0) {}
+    ~Span() {
+        if (name) {
+            detail::record(name, begin, detail::now());
+        }
+    }
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+private:
+    const char* name;
+    int64_t begin;
+};
+
+}  // namespace xoj::util::trace
+
+#define XOJ_TRACE_CONCAT_IMPL(a, b) a##b
+#define XOJ_TRACE_CONCAT(a, b) XOJ_TRACE_CONCAT_IMPL(a, b)
+
+/**
+ * Traces the enclosing scope under the given name
+ */
+#define XOJ_TRACE_SCOPE(name) xoj::util::trace::Span XOJ_TRACE_CONCAT(xojTraceSpan, __LINE__)(name)
@@ -70,6 +70,11 @@ public:
      */
     unsigned char* getData(gsize& dataLen);
 
+    /**
+     * Release the preview data, so that the extractor can be reused for another file
+     */
+    void reset();
+
     // Member
 private:
     /**
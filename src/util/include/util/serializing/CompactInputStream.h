@@ -0,0 +1,93 @@
+/*
+ * Xournal++
+ *
+ * Compact binary input stream
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint32_t, uint64_t
+#include <cstring>      // for memcpy
+#include <string>       // for string
+#include <string_view>  // for string_view
+#include <type_traits>  // for is_trivially_copyable_v
+#include <vector>       // for vector
+
+#include "InputStreamException.h"
+
+/**
+ * @brief Reads a stream written by CompactOutputStream.
+ *
+ * The stream is a cursor over a buffer it does not own: the buffer must outlive the stream. Strings can be read as
+ * views into the buffer, and arrays are copied directly into their destination.
+ * Every read is bounds checked and throws an InputStreamException if the data is truncated.
+ */
+class CompactInputStream {
+public:
+    /**
+     * @throws InputStreamException if the buffer does not start with a compact stream header
+     */
+    CompactInputStream(const char* data, size_t len);
+
+public:
+    /**
+     * @return The format version given to the CompactOutputStream
+     */
+    uint32_t getVersion() const;
+
+    template <typename T>
+    T read();
+
+    std::string readString();
+
+    /**
+     * @return A view into the underlying buffer: no copy is made
+     */
+    std::string_view readStringView();
+
+    template <typename T>
+    void readArray(std::vector<T>& out);
+
+    bool atEnd() const;
+
+private:
+    /**
+     * @return A pointer to the next len bytes, and advances the cursor past them
+     */
+    const char* consume(size_t len);
+
+    /**
+     * @return The element count of an array of count elements of elemSize bytes
+     */
+    size_t readArraySize(size_t elemSize);
+
+private:
+    const char* data;
+    size_t len;
+    size_t pos = 0;
+    uint32_t version = 0;
+};
+
+template <typename T>
+T CompactInputStream::read() {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types have a binary representation");
+    T value;
+    std::memcpy(&value, consume(sizeof(T)), sizeof(T));
+    return value;
+}
+
+template <typename T>
+void CompactInputStream::readArray(std::vector<T>& out) {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types have a binary representation");
+    size_t count = readArraySize(sizeof(T));
+    out.resize(count);
+    if (count > 0) {
+        std::memcpy(out.data(), consume(count * sizeof(T)), count * sizeof(T));
+    }
+}
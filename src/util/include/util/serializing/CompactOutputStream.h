@@ -0,0 +1,80 @@
+/*
+ * Xournal++
+ *
+ * Compact binary output stream
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint32_t, uint64_t
+#include <string>       // for string
+#include <string_view>  // for string_view
+#include <type_traits>  // for is_trivially_copyable_v
+#include <vector>       // for vector
+
+/// Magic number starting every compact stream ("XojC" in memory order on little endian hosts)
+constexpr uint32_t COMPACT_STREAM_MAGIC = 0x436a6f58;
+
+/**
+ * @brief Writes values in their native binary representation, without any type tag.
+ *
+ * Unlike ObjectOutputStream, the reader has to know the layout: the layout as a whole is versioned by the header
+ * (magic number and format version) written on construction. Values are written in the host byte order, so the
+ * streams are meant to be exchanged between processes of the same machine (e.g. through the clipboard).
+ *
+ * Arrays are written as their element count followed by the contiguous elements, so that CompactInputStream can read
+ * them back with a single copy.
+ */
+class CompactOutputStream {
+public:
+    explicit CompactOutputStream(uint32_t version);
+
+public:
+    template <typename T>
+    void write(T value);
+
+    void writeString(std::string_view s);
+
+    template <typename T>
+    void writeArray(const T* data, size_t count);
+
+    template <typename T>
+    void writeArray(const std::vector<T>& data);
+
+    const std::string& getData() const;
+
+    /**
+     * @brief Moves the written data out of the stream
+     */
+    std::string takeData();
+
+private:
+    void writeRaw(const void* data, size_t len);
+
+private:
+    std::string data;
+};
+
+template <typename T>
+void CompactOutputStream::write(T value) {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types have a binary representation");
+    writeRaw(&value, sizeof(T));
+}
+
+template <typename T>
+void CompactOutputStream::writeArray(const T* data, size_t count) {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types have a binary representation");
+    write<uint64_t>(count);
+    writeRaw(data, count * sizeof(T));
+}
+
+template <typename T>
+void CompactOutputStream::writeArray(const std::vector<T>& data) {
+    writeArray(data.data(), data.size());
+}
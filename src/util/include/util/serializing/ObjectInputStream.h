@@ -33,6 +33,8 @@ public:
     std::string readObject();
     std::string getNextObjectName();
     void endObject();
+    /// Skips the next object, including the objects it contains
+    void skipObject();
 
     int readInt();
     uint32_t readUInt();
@@ -0,0 +1,47 @@
+#include "util/serializing/CompactInputStream.h"
+
+#include <sstream>  // for ostringstream
+
+#include "util/serializing/CompactOutputStream.h"  // for COMPACT_STREAM_MAGIC
+
+CompactInputStream::CompactInputStream(const char* data, size_t len): data(data), len(len) {
+    if (read<uint32_t>() != COMPACT_STREAM_MAGIC) {
+        throw InputStreamException("Not a compact stream", __FILE__, __LINE__);
+    }
+    this->version = read<uint32_t>();
+}
+
+auto CompactInputStream::getVersion() const -> uint32_t { return this->version; }
+
+auto CompactInputStream::readString() -> std::string { return std::string(readStringView()); }
+
+auto CompactInputStream::readStringView() -> std::string_view {
+    size_t length = readArraySize(1);
+    return std::string_view(consume(length), length);
+}
+
+auto CompactInputStream::atEnd() const -> bool { return this->pos == this->len; }
+
+auto CompactInputStream::consume(size_t n) -> const char* {
+    if (n > this->len - this->pos) {
+        std::ostringstream oss;
+        oss << "End reached: trying to read " << n << " bytes while only " << this->len - this->pos
+            << " bytes available";
+        throw InputStreamException(oss.str(), __FILE__, __LINE__);
+    }
+    const char* p = this->data + this->pos;
+    this->pos += n;
+    return p;
+}
+
+auto CompactInputStream::readArraySize(size_t elemSize) -> size_t {
+    auto count = read<uint64_t>();
+    // Checked before allocating anything: a corrupted count must not trigger a huge allocation
+    if (count > (this->len - this->pos) / elemSize) {
+        std::ostringstream oss;
+        oss << "End reached: trying to read " << count << " elements of " << elemSize << " bytes while only "
+            << this->len - this->pos << " bytes available";
+        throw InputStreamException(oss.str(), __FILE__, __LINE__);
+    }
+    return static_cast<size_t>(count);
+}
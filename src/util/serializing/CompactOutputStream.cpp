@@ -0,0 +1,21 @@
+#include "util/serializing/CompactOutputStream.h"
+
+#include <utility>  // for move
+
+CompactOutputStream::CompactOutputStream(uint32_t version) {
+    write(COMPACT_STREAM_MAGIC);
+    write(version);
+}
+
+void CompactOutputStream::writeString(std::string_view s) {
+    write<uint64_t>(s.length());
+    writeRaw(s.data(), s.length());
+}
+
+auto CompactOutputStream::getData() const -> const std::string& { return this->data; }
+
+auto CompactOutputStream::takeData() -> std::string { return std::move(this->data); }
+
+void CompactOutputStream::writeRaw(const void* data, size_t len) {
+    this->data.append(static_cast<const char*>(data), len);
+}
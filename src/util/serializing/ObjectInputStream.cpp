@@ -75,6 +75,62 @@ auto ObjectInputStream::getNextObjectName() -> std::string {
 
 void ObjectInputStream::endObject() { checkType('}'); }
 
+void ObjectInputStream::skipObject() {
+    readObject();
+
+    for (int depth = 1; depth > 0;) {
+        if (istream.str().size() < 2) {
+            throw InputStreamException("End reached, but try to skip an object", __FILE__, __LINE__);
+        }
+        char t = 0, underscore = 0;
+        istream >> underscore >> t;
+        if (underscore != '_') {
+            throw InputStreamException(FS(FORMAT_STR("Expected type signature, index {1} of {2}, but read '{3}'") %
+                                          (pos() + 1) % len % underscore),
+                                       __FILE__, __LINE__);
+        }
+
+        size_t skip = 0;
+        switch (t) {
+            case '{':
+                // Followed by the name of the object, skipped as a string
+                depth++;
+                break;
+            case '}':
+                depth--;
+                break;
+            case 'i':
+                skip = sizeof(int);
+                break;
+            case 'u':
+                skip = sizeof(uint32_t);
+                break;
+            case 'd':
+                skip = sizeof(double);
+                break;
+            case 'l':
+                skip = sizeof(size_t);
+                break;
+            case 's':
+            case 'm':
+                skip = readType<size_t>();
+                break;
+            case 'b': {
+                size_t count = readType<size_t>();
+                skip = count * readType<size_t>();
+                break;
+            }
+            default:
+                throw InputStreamException(FS(FORMAT_STR("Cannot skip {1}") % getType(t)), __FILE__, __LINE__);
+        }
+
+        if (skip > len - pos()) {
+            throw InputStreamException("End reached, but try to skip data", __FILE__, __LINE__);
+        }
+        istream.seekg(as_signed(skip), std::ios::cur);
+    }
+}
+
 auto ObjectInputStream::readInt() -> int {
     checkType('i');
     return readType<int>();
@@ -14,7 +14,9 @@
 
 #include <algorithm>  // for max, min
 #include <cstdio>     // for fclose, fopen, fwrite, FILE
-#include <iostream>   // for endl, ostream, basic_ostream
+#include <cstdlib>    // for atoi
+#include <cstring>    // for strcmp
+#include <iostream>   // for endl, ostream, basic_ostream, cin
 #include <locale>     // for locale
 #include <string>     // for string, basic_string, allocator
 #include <vector>     // for vector
@@ -32,6 +34,19 @@
 #include "config.h"      // for GETTEXT_PACKAGE, ENABLE_NLS
 #include "filesystem.h"  // for path, operator/, u8path, exists
 
+#ifdef THUMBNAILER_RENDER_FALLBACK
+#include "control/xojfile/LoadHandler.h"  // for LoadHandler
+#include "model/Document.h"               // for Document
+#include "model/PageType.h"               // for PageType
+#include "model/XojPage.h"                // for XojPage
+#include "view/PageThumbnail.h"           // for renderPageThumbnail
+
+/**
+ * Size of the thumbnails rendered for files without preview, if none was requested
+ */
+constexpr int DEFAULT_RENDER_SIZE = 128;
+#endif
+
 #ifdef DEBUG_THUMBERNAILER
 #include <fstream>
 #endif
@@ -51,8 +66,13 @@ void initLocalisation() {
     std::cout.imbue(std::locale());
 }
 
+/**
+ * In batch mode, stdout is reserved for the answers to the requests
+ */
+static bool batchMode = false;
+
 void logMessage(string msg, bool error) {
-    if (error) {
+    if (error || batchMode) {
         cerr << msg << endl;
     } else {
         cout << msg << endl;
@@ -113,33 +133,151 @@ fs::path findAppIcon() {
     return "";
 }
 
-int main(int argc, char* argv[]) {
-    initLocalisation();
+/**
+ * Load the PNG data of a preview into a cairo surface
+ */
+cairo_surface_t* loadPreviewImage(unsigned char* imageData, gsize dataLen) {
+    // Struct for reading imageData into a cairo surface
+    struct ReadClosure {
+        unsigned int pos;
+        unsigned char* data;
+        gsize maxLen;
+    };
+    cairo_read_func_t processRead =
+            (cairo_read_func_t) + [](ReadClosure* closure, unsigned char* data, unsigned int length) {
+                if (closure->pos + length > closure->maxLen) {
+                    return CAIRO_STATUS_READ_ERROR;
+                }
 
-    // check args count
-    if (argc != 3) {
-        logMessage(_("xoj-preview-extractor: call with INPUT.xoj OUTPUT.png"), true);
-        return 1;
+                for (auto i = 0U; i < length; i++) {
+                    data[i] = closure->data[closure->pos + i];
+                }
+                closure->pos += length;
+                return CAIRO_STATUS_SUCCESS;
+            };
+    ReadClosure closure{0, imageData, dataLen};
+    return cairo_image_surface_create_from_png_stream(processRead, &closure);
+}
+
+#ifdef THUMBNAILER_RENDER_FALLBACK
+/**
+ * Render the first page of a file which contains no preview
+ * @return nullptr if the file could not be loaded
+ */
+cairo_surface_t* renderFirstPage(const fs::path& file, int size) {
+    LoadHandler loader;
+    auto doc = loader.loadDocument(file);
+    if (!doc || doc->getPageCount() == 0) {
+        return nullptr;
     }
 
-    XojPreviewExtractor extractor;
-    PreviewExtractResult result = extractor.readFile(argv[1]);
+    PageRef page = doc->getPage(0);
+    XojPdfPageSPtr pdfPage;
+    if (page->getBackgroundType().isPdfPage()) {
+        pdfPage = doc->getPdfPage(page->getPdfPageNr());
+    }
+    return xoj::view::renderPageThumbnail(page, pdfPage, size).release();
+}
+#endif
+
+/**
+ * Downscale the thumbnail so that its largest side is at most size pixels
+ * @return The scaled thumbnail. thumbnail is destroyed if a new surface was created.
+ */
+cairo_surface_t* limitSize(cairo_surface_t* thumbnail, int size) {
+    const auto width = cairo_image_surface_get_width(thumbnail);
+    const auto height = cairo_image_surface_get_height(thumbnail);
+    if (size <= 0 || std::max(width, height) <= size) {
+        return thumbnail;
+    }
+
+    const double scale = static_cast<double>(size) / std::max(width, height);
+    cairo_surface_t* scaled = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, std::max(1, static_cast<int>(width * scale)),
+                                                         std::max(1, static_cast<int>(height * scale)));
+    cairo_t* cr = cairo_create(scaled);
+    cairo_scale(cr, scale, scale);
+    cairo_set_source_surface(cr, thumbnail, 0, 0);
+    cairo_pattern_set_filter(cairo_get_source(cr), CAIRO_FILTER_GOOD);
+    cairo_paint(cr);
+    cairo_destroy(cr);
+    cairo_surface_destroy(thumbnail);
+    return scaled;
+}
+
+/**
+ * Render the Xournal++ icon on top of the thumbnail.
+ * The icon is loaded once and kept for the following thumbnails (in batch mode).
+ */
+void drawAppIcon(cairo_surface_t* thumbnail) {
+    static RsvgHandle* handle = [] {
+        GError* err = nullptr;
+        const auto svgPath = findAppIcon();
+        RsvgHandle* h = rsvg_handle_new_from_file(svgPath.c_str(), &err);
+        if (err) {
+            logMessage((_F("xoj-preview-extractor: could not find icon \"{1}\"") % iconName).str(), true);
+            g_clear_error(&err);
+            return static_cast<RsvgHandle*>(nullptr);
+        }
+        rsvg_handle_set_dpi(h, 90);  // does the dpi matter for an icon overlay?
+        return h;
+    }();
+    if (!handle) {
+        return;
+    }
+
+    const auto width = cairo_image_surface_get_width(thumbnail);
+    const auto height = cairo_image_surface_get_height(thumbnail);
+    const auto iconSize = 0.5 * std::min(width, height);
+
+    // Render at bottom right
+    cairo_t* cr = cairo_create(thumbnail);
+    const RsvgRectangle viewport{width - iconSize, height - iconSize, iconSize, iconSize};
+    GError* error = nullptr;
+    rsvg_handle_render_document(handle, cr, &viewport, &error);
+    if (error != nullptr) {
+        g_warning("Could not render the icon");
+        g_clear_error(&error);
+    }
+    cairo_destroy(cr);
+}
+
+/**
+ * Write the thumbnail of input to output
+ * @param extractor Extractor, reused between the thumbnails
+ * @param size Size in pixels of the largest side of the thumbnail, 0 to keep the size of the embedded preview
+ * @return 0 on success, an error code otherwise (see main())
+ */
+int createThumbnail(XojPreviewExtractor& extractor, const fs::path& input, const fs::path& output, int size) {
+    PreviewExtractResult result = extractor.readFile(input);
+
+    cairo_surface_t* thumbnail = nullptr;
+    gsize dataLen = 0;
+    unsigned char* imageData = nullptr;
 
     switch (result) {
         case PREVIEW_RESULT_IMAGE_READ:
-            // continue to write preview
+            imageData = extractor.getData(dataLen);
+            thumbnail = loadPreviewImage(imageData, dataLen);
             break;
 
         case PREVIEW_RESULT_BAD_FILE_EXTENSION:
-            logMessage((_F("xoj-preview-extractor: file \"{1}\" is not .xoj file") % argv[1]).str(), true);
+            logMessage((_F("xoj-preview-extractor: file \"{1}\" is not .xoj file") % input.u8string()).str(), true);
             return 2;
 
         case PREVIEW_RESULT_COULD_NOT_OPEN_FILE:
-            logMessage((_F("xoj-preview-extractor: opening input file \"{1}\" failed") % argv[1]).str(), true);
+            logMessage((_F("xoj-preview-extractor: opening input file \"{1}\" failed") % input.u8string()).str(),
+                       true);
             return 3;
 
         case PREVIEW_RESULT_NO_PREVIEW:
-            logMessage((_F("xoj-preview-extractor: file \"{1}\" contains no preview") % argv[1]).str(), true);
+#ifdef THUMBNAILER_RENDER_FALLBACK
+            thumbnail = renderFirstPage(input, size > 0 ? size : DEFAULT_RENDER_SIZE);
+            if (thumbnail) {
+                break;
+            }
+#endif
+            logMessage((_F("xoj-preview-extractor: file \"{1}\" contains no preview") % input.u8string()).str(),
+                       true);
             return 4;
 
         case PREVIEW_RESULT_ERROR_READING_PREVIEW:
@@ -148,67 +286,81 @@ int main(int argc, char* argv[]) {
             return 5;
     }
 
-
-    gsize dataLen = 0;
-    unsigned char* imageData = extractor.getData(dataLen);
-
     // The following code is for rendering the Xournal++ icon on top of thumbnails.
-
-    // Struct for reading imageData into a cairo surface
-    struct ReadClosure {
-        unsigned int pos;
-        unsigned char* data;
-        gsize maxLen;
-    };
-    cairo_read_func_t processRead =
-            (cairo_read_func_t) + [](ReadClosure* closure, unsigned char* data, unsigned int length) {
-                if (closure->pos + length > closure->maxLen) {
-                    return CAIRO_STATUS_READ_ERROR;
-                }
-
-                for (auto i = 0U; i < length; i++) {
-                    data[i] = closure->data[closure->pos + i];
-                }
-                closure->pos += length;
-                return CAIRO_STATUS_SUCCESS;
-            };
-    ReadClosure closure{0, imageData, dataLen};
-    cairo_surface_t* thumbnail = cairo_image_surface_create_from_png_stream(processRead, &closure);
-    // This application is short-lived, so we'll purposefully be sloppy and let the OS free memory.
     if (cairo_surface_status(thumbnail) == CAIRO_STATUS_SUCCESS) {
-        GError* err = nullptr;
-        const auto width = cairo_image_surface_get_width(thumbnail);
-        const auto height = cairo_image_surface_get_height(thumbnail);
-        const auto iconSize = 0.5 * std::min(width, height);
-
-        const auto svgPath = findAppIcon();
-        RsvgHandle* handle = rsvg_handle_new_from_file(svgPath.c_str(), &err);
-        if (err) {
-            logMessage((_F("xoj-preview-extractor: could not find icon \"{1}\"") % iconName).str(), true);
-        } else {
-            rsvg_handle_set_dpi(handle, 90);  // does the dpi matter for an icon overlay?
-            // Render at bottom right
-            cairo_t* cr = cairo_create(thumbnail);
-            const RsvgRectangle viewport{width - iconSize, height - iconSize, iconSize, iconSize};
-            GError* error = nullptr;
-            rsvg_handle_render_document(handle, cr, &viewport, &error);
-            if (error != nullptr) {
-                g_warning("Could not render the icon");
-                g_clear_error(&error);
-            }
-        }
-        cairo_surface_write_to_png(thumbnail, argv[2]);
+        thumbnail = limitSize(thumbnail, size);
+        drawAppIcon(thumbnail);
+        cairo_surface_write_to_png(thumbnail, output.u8string().c_str());
+        cairo_surface_destroy(thumbnail);
     } else {
+        cairo_surface_destroy(thumbnail);
         // Cairo was unable to load the image, so fallback to writing the PNG data to disk.
-        FILE* fp = fopen(argv[2], "wb");
+        FILE* fp = fopen(output.u8string().c_str(), "wb");
         if (!fp) {
-            logMessage((_F("xoj-preview-extractor: opening output file \"{1}\" failed") % argv[2]).str(), true);
+            logMessage((_F("xoj-preview-extractor: opening output file \"{1}\" failed") % output.u8string()).str(),
+                       true);
             return 6;
         }
         fwrite(imageData, dataLen, 1, fp);
         fclose(fp);
     }
 
-    logMessage(_("xoj-preview-extractor: successfully extracted"), false);
     return 0;
 }
+
+/**
+ * Long-lived mode: read requests from stdin, one per line, formatted as
+ *      INPUT<TAB>SIZE<TAB>OUTPUT
+ * and answer each of them on stdout with a line
+ *      OK<TAB>OUTPUT       or      ERROR<TAB>CODE<TAB>INPUT
+ * Diagnostics are written to stderr. Returns when stdin is closed.
+ */
+int runBatch() {
+    batchMode = true;
+    XojPreviewExtractor extractor;
+
+    string line;
+    while (std::getline(std::cin, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        auto firstTab = line.find('\t');
+        auto secondTab = firstTab == string::npos ? string::npos : line.find('\t', firstTab + 1);
+        if (secondTab == string::npos) {
+            cout << "ERROR\t1\t" << line << endl;
+            continue;
+        }
+        string input = line.substr(0, firstTab);
+        int size = std::atoi(line.substr(firstTab + 1, secondTab - firstTab - 1).c_str());
+        string output = line.substr(secondTab + 1);
+
+        int res = createThumbnail(extractor, fs::u8path(input), fs::u8path(output), size);
+        if (res == 0) {
+            cout << "OK\t" << output << endl;
+        } else {
+            cout << "ERROR\t" << res << "\t" << input << endl;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    initLocalisation();
+
+    if (argc == 2 && strcmp(argv[1], "--batch") == 0) {
+        return runBatch();
+    }
+
+    // check args count
+    if (argc != 3) {
+        logMessage(_("xoj-preview-extractor: call with INPUT.xoj OUTPUT.png, or with --batch"), true);
+        return 1;
+    }
+
+    XojPreviewExtractor extractor;
+    int res = createThumbnail(extractor, fs::u8path(argv[1]), fs::u8path(argv[2]), 0);
+    if (res == 0) {
+        logMessage(_("xoj-preview-extractor: successfully extracted"), false);
+    }
+    return res;
+}
@@ -0,0 +1,84 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <chrono>
+#include <string>
+#include <system_error>
+
+#include <gtest/gtest.h>
+
+#include "control/latex/LatexCache.h"
+
+#include "filesystem.h"
+
+class LatexCacheTest: public ::testing::Test {
+protected:
+    void SetUp() override {
+        auto seed = ::testing::UnitTest::GetInstance()->random_seed();
+        dir = fs::temp_directory_path() / ("xournalpp-latex-cache-test-" + std::to_string(seed));
+        fs::create_directories(dir);
+    }
+    void TearDown() override {
+        std::error_code ec;
+        fs::remove_all(dir, ec);
+    }
+
+    fs::path dir;
+};
+
+TEST_F(LatexCacheTest, testKey) {
+    auto key = LatexCache::computeKey("x^2", "pdflatex '{}'");
+    EXPECT_EQ(key, LatexCache::computeKey("x^2", "pdflatex '{}'"));
+    EXPECT_NE(key, LatexCache::computeKey("x^3", "pdflatex '{}'"));
+    // Another command gives another PDF
+    EXPECT_NE(key, LatexCache::computeKey("x^2", "lualatex '{}'"));
+    // The command and the contents are separated
+    EXPECT_NE(LatexCache::computeKey("ab", "c"), LatexCache::computeKey("b", "ca"));
+}
+
+TEST_F(LatexCacheTest, testStoreLookup) {
+    LatexCache cache(dir, 1000);
+    EXPECT_FALSE(cache.lookup("a").has_value());
+
+    std::string pdf("%PDF\0binary", 11);
+    cache.store("a", pdf);
+    EXPECT_TRUE(cache.contains("a"));
+    auto found = cache.lookup("a");
+    ASSERT_TRUE(found.has_value());
+    EXPECT_EQ(pdf, *found);
+    EXPECT_EQ(11U, cache.getSize());
+
+    LatexCache disabled(dir, 0);
+    EXPECT_FALSE(disabled.lookup("a").has_value());
+}
+
+TEST_F(LatexCacheTest, testEviction) {
+    LatexCache cache(dir, 250);
+    cache.store("a", std::string(100, 'a'));
+    cache.store("b", std::string(100, 'b'));
+
+    // Use "a", so that "b" is the least recently used
+    auto past = fs::file_time_type::clock::now() - std::chrono::hours(1);
+    fs::last_write_time(dir / "a.pdf", past);
+    fs::last_write_time(dir / "b.pdf", past - std::chrono::hours(1));
+    ASSERT_TRUE(cache.lookup("a").has_value());
+
+    cache.store("c", std::string(100, 'c'));
+    EXPECT_TRUE(cache.contains("a"));
+    EXPECT_FALSE(cache.contains("b"));
+    EXPECT_TRUE(cache.contains("c"));
+    EXPECT_EQ(200U, cache.getSize());
+
+    // A file larger than the cache is not stored
+    cache.store("d", std::string(300, 'd'));
+    EXPECT_FALSE(cache.contains("d"));
+    EXPECT_TRUE(cache.contains("a"));
+}
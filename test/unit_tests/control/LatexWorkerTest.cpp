@@ -0,0 +1,51 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "control/latex/LatexWorker.h"
+
+TEST(LatexWorker, testTemplatePreamble) {
+    const std::string templ = "\\documentclass{standalone}\n"
+                              "\\usepackage{amsmath}\n"
+                              "\\definecolor{c}{HTML}{%%XPP_TEXT_COLOR%%}\n"
+                              "\\begin{document}\n"
+                              "%%XPP_TOOL_INPUT%%\n"
+                              "\\end{document}\n";
+    // The preamble stops before the line of the first placeholder
+    EXPECT_EQ("\\documentclass{standalone}\n\\usepackage{amsmath}\n", LatexWorker::templatePreamble(templ));
+
+    const std::string noPlaceholderInPreamble = "\\documentclass{article}\n"
+                                                "\\begin{document}\n"
+                                                "%%XPP_TOOL_INPUT%%\n"
+                                                "\\end{document}\n";
+    EXPECT_EQ("\\documentclass{article}\n", LatexWorker::templatePreamble(noPlaceholderInPreamble));
+
+    // Nothing can be preloaded
+    EXPECT_EQ("", LatexWorker::templatePreamble("\\documentclass{article}%%XPP_TOOL_INPUT%%"));
+    EXPECT_EQ("", LatexWorker::templatePreamble("% comment\n%%XPP_TOOL_INPUT%%\n"));
+    EXPECT_EQ("", LatexWorker::templatePreamble(""));
+}
+
+TEST(LatexWorker, testPreambleFailures) {
+    EXPECT_TRUE(LatexWorker::isPreambleFailure("---! ./xournalpp-preview.fmt was written by pdftex\n"
+                                               "(Fatal format file error; I'm stymied)\n"));
+    EXPECT_TRUE(LatexWorker::isPreambleFailure("! LaTeX Error: Can be used only in preamble.\n"));
+    EXPECT_TRUE(LatexWorker::isPreambleFailure("! LaTeX Error: Two \\documentclass or \\documentstyle commands.\n"));
+    EXPECT_TRUE(LatexWorker::isPreambleFailure("! LaTeX Error: Missing \\begin{document}.\n"));
+
+    // Mistakes in the formula
+    EXPECT_FALSE(LatexWorker::isPreambleFailure("! Undefined control sequence.\nl.3 \\fracc\n"));
+    EXPECT_FALSE(LatexWorker::isPreambleFailure("! Missing $ inserted.\n"));
+    EXPECT_FALSE(LatexWorker::isPreambleFailure(""));
+}
@@ -0,0 +1,114 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "control/PerformanceMonitor.h"
+
+using namespace std::chrono_literals;
+
+TEST(PerformanceMonitorTest, testDisabled) {
+    PerformanceMonitor monitor;
+    EXPECT_FALSE(monitor.isEnabled());
+    monitor.recordDrawTime(5ms);
+    monitor.recordRenderLatency(0, 5ms);
+    monitor.recordInkLatency(5ms);
+    EXPECT_EQ(0U, monitor.getDrawTimes().samples);
+    EXPECT_EQ(0U, monitor.getInkLatencies().samples);
+    EXPECT_EQ(0U, monitor.getRenderLatencies().samples);
+    EXPECT_TRUE(monitor.getRecentPageLatencies().empty());
+}
+
+TEST(PerformanceMonitorTest, testTimingSummary) {
+    PerformanceMonitor monitor;
+    monitor.setEnabled(true);
+    monitor.recordDrawTime(2ms);
+    monitor.recordDrawTime(6ms);
+    monitor.recordDrawTime(4ms);
+
+    auto draw = monitor.getDrawTimes();
+    EXPECT_EQ(3U, draw.samples);
+    EXPECT_DOUBLE_EQ(4.0, draw.lastMs);
+    EXPECT_DOUBLE_EQ(4.0, draw.averageMs);
+    EXPECT_DOUBLE_EQ(6.0, draw.maxMs);
+
+    // Only the last WINDOW_SIZE samples are kept
+    for (size_t i = 0; i < PerformanceMonitor::WINDOW_SIZE; i++) {
+        monitor.recordDrawTime(1ms);
+    }
+    draw = monitor.getDrawTimes();
+    EXPECT_EQ(PerformanceMonitor::WINDOW_SIZE, draw.samples);
+    EXPECT_DOUBLE_EQ(1.0, draw.averageMs);
+    EXPECT_DOUBLE_EQ(1.0, draw.maxMs);
+
+    monitor.clear();
+    EXPECT_EQ(0U, monitor.getDrawTimes().samples);
+}
+
+TEST(PerformanceMonitorTest, testRecentPages) {
+    PerformanceMonitor monitor;
+    monitor.setEnabled(true);
+    for (size_t page = 0; page < PerformanceMonitor::RECENT_PAGES + 2; page++) {
+        monitor.recordRenderLatency(page, 10ms);
+    }
+    monitor.recordRenderLatency(4, 20ms);
+
+    auto recent = monitor.getRecentPageLatencies();
+    ASSERT_EQ(PerformanceMonitor::RECENT_PAGES, recent.size());
+    // Most recent first, and a page appears only once
+    EXPECT_EQ((std::pair<size_t, double>{4, 20.0}), recent[0]);
+    EXPECT_EQ(6U, recent[1].first);
+    EXPECT_EQ(5U, recent[2].first);
+    EXPECT_EQ(3U, recent[3].first);
+    EXPECT_EQ(2U, recent[4].first);
+
+    EXPECT_EQ(PerformanceMonitor::RECENT_PAGES + 3, monitor.getRenderLatencies().samples);
+}
+
+TEST(PerformanceMonitorTest, testPredictionErrors) {
+    PerformanceMonitor monitor;
+    monitor.recordPredictionErrors(2, 3.0, 2.0);
+    EXPECT_EQ(0U, monitor.getPredictionErrors().samples);
+
+    monitor.setEnabled(true);
+    monitor.recordPredictionErrors(2, 3.0, 2.0);
+    monitor.recordPredictionErrors(2, 1.0, 0.5);
+    auto errors = monitor.getPredictionErrors();
+    EXPECT_EQ(4U, errors.samples);
+    EXPECT_DOUBLE_EQ(1.0, errors.averageError);
+    EXPECT_DOUBLE_EQ(2.0, errors.maxError);
+
+    monitor.clear();
+    EXPECT_EQ(0U, monitor.getPredictionErrors().samples);
+}
+
+TEST(PerformanceMonitorTest, testRecognitionTimes) {
+    PerformanceMonitor monitor;
+    monitor.setEnabled(true);
+    // More samples than the window: all of them are kept
+    for (size_t i = 0; i < PerformanceMonitor::WINDOW_SIZE; i++) {
+        monitor.recordRecognitionTime(1ms);
+        monitor.recordRecognitionTime(3ms);
+    }
+    auto times = monitor.getRecognitionTimes();
+    EXPECT_EQ(2 * PerformanceMonitor::WINDOW_SIZE, times.samples);
+    EXPECT_DOUBLE_EQ(2.0, times.averageMs);
+    EXPECT_DOUBLE_EQ(3.0, times.maxMs);
+    EXPECT_DOUBLE_EQ(3.0, times.lastMs);
+
+    monitor.clear();
+    EXPECT_EQ(0U, monitor.getRecognitionTimes().samples);
+}
@@ -0,0 +1,70 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include "control/jobs/SaveJob.h"
+#include "model/Document.h"
+#include "model/PageRef.h"
+#include "model/XojPage.h"
+#include "util/Color.h"
+
+TEST(SaveJob, testPreviewIsOnlyRenderedWhenTheFirstPageChanged) {
+    Document doc(nullptr);
+    auto page = std::make_shared<XojPage>(200, 300);
+    auto secondPage = std::make_shared<XojPage>(200, 300);
+    doc.addPage(page);
+    doc.addPage(secondPage);
+
+    SaveJob::updatePreview(&doc);
+    cairo_surface_t* preview = doc.getPreview();
+    ASSERT_NE(nullptr, preview);
+    EXPECT_FALSE(doc.getPreviewPng().empty());
+
+    // Nothing changed: the preview is kept as is
+    SaveJob::updatePreview(&doc);
+    EXPECT_EQ(preview, doc.getPreview());
+
+    // The preview only shows the first page
+    secondPage->firePageChanged();
+    SaveJob::updatePreview(&doc);
+    EXPECT_EQ(preview, doc.getPreview());
+
+    page->setBackgroundColor(Colors::black);
+    SaveJob::updatePreview(&doc);
+    EXPECT_NE(preview, doc.getPreview());
+    preview = doc.getPreview();
+
+    page->firePageChanged();
+    SaveJob::updatePreview(&doc);
+    EXPECT_NE(preview, doc.getPreview());
+}
+
+TEST(SaveJob, testPreviewFollowsTheFirstPage) {
+    Document doc(nullptr);
+    auto page = std::make_shared<XojPage>(200, 300);
+    doc.addPage(page);
+    SaveJob::updatePreview(&doc);
+    cairo_surface_t* preview = doc.getPreview();
+    ASSERT_NE(nullptr, preview);
+
+    // A new first page, even unchanged, needs a new preview
+    doc.insertPage(std::make_shared<XojPage>(200, 300), 0);
+    SaveJob::updatePreview(&doc);
+    EXPECT_NE(preview, doc.getPreview());
+
+    doc.deletePage(0);
+    doc.deletePage(0);
+    SaveJob::updatePreview(&doc);
+    EXPECT_EQ(nullptr, doc.getPreview());
+}
@@ -0,0 +1,166 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <cmath>
+#include <functional>
+#include <utility>
+
+#include <cairo.h>
+#include <gtest/gtest.h>
+
+#include "control/jobs/SelectionRenderJob.h"
+#include "model/ElementContainer.h"
+#include "util/Rectangle.h"
+
+using Action = SelectionBufferPolicy::Action;
+
+namespace {
+class EmptyContainer: public ElementContainer {
+public:
+    void forEachElement(std::function<void(Element*)>) const override {}
+};
+
+auto renderedSize(const SelectionBufferParams& params, double maxPixels = SelectionRenderJob::MAX_BUFFER_PIXELS)
+        -> std::pair<int, int> {
+    EmptyContainer elements;
+    xoj::util::Rectangle<double> originalBounds(0, 0, std::abs(params.width), std::abs(params.height));
+    auto buffer = SelectionRenderJob::render(&elements, params, originalBounds, 0, 0, maxPixels);
+    return {cairo_image_surface_get_width(buffer.get()), cairo_image_surface_get_height(buffer.get())};
+}
+}  // namespace
+
+TEST(SelectionRenderJob, testBufferHasTheSizeOfTheSelection) {
+    EXPECT_EQ(std::make_pair(300, 100), renderedSize({150, 50, 2.0}));
+    // Flipped selections
+    EXPECT_EQ(std::make_pair(300, 100), renderedSize({-150, -50, 2.0}));
+}
+
+TEST(SelectionRenderJob, testBufferResolutionIsCapped) {
+    auto [width, height] = renderedSize({4000, 3000, 2.0});
+    EXPECT_LE(static_cast<double>(width) * height, SelectionRenderJob::MAX_BUFFER_PIXELS);
+    // Just below the cap, with the aspect ratio of the selection
+    EXPECT_GT(static_cast<double>(width) * height, 0.99 * SelectionRenderJob::MAX_BUFFER_PIXELS);
+    EXPECT_NEAR(4.0 / 3.0, static_cast<double>(width) / height, 0.01);
+}
+
+TEST(SelectionRenderJob, testPreviewResolutionIsCapped) {
+    auto [width, height] = renderedSize({800, 600, 1.0}, SelectionRenderJob::MAX_PREVIEW_PIXELS);
+    EXPECT_LE(static_cast<double>(width) * height, SelectionRenderJob::MAX_PREVIEW_PIXELS);
+    EXPECT_NEAR(4.0 / 3.0, static_cast<double>(width) / height, 0.01);
+
+    // Small selections are not reduced
+    EXPECT_EQ(std::make_pair(200, 100), renderedSize({100, 50, 2.0}, SelectionRenderJob::MAX_PREVIEW_PIXELS));
+}
+
+TEST(SelectionBufferPolicy, testFirstPaintRendersRightAway) {
+    SelectionBufferPolicy policy;
+    EXPECT_FALSE(policy.hasBuffer());
+    EXPECT_EQ(Action::RENDER, policy.onPaint({100, 50, 1.0}));
+    // Until the buffer is ready
+    EXPECT_EQ(Action::RENDER, policy.onPaint({100, 50, 1.0}));
+
+    policy.onBufferReady({100, 50, 1.0});
+    EXPECT_TRUE(policy.hasBuffer());
+    EXPECT_EQ(Action::NONE, policy.onPaint({100, 50, 1.0}));
+}
+
+TEST(SelectionBufferPolicy, testFirstPaintShowsAPreview) {
+    SelectionBufferPolicy policy;
+    EXPECT_EQ(Action::RENDER, policy.onPaint({1000, 500, 1.0}));
+    EXPECT_TRUE(policy.needsPreview({1000, 500, 1.0}));
+    policy.onPreviewReady({1000, 500, 1.0});
+    EXPECT_TRUE(policy.hasBuffer());
+    EXPECT_FALSE(policy.needsPreview({1000, 500, 1.0}));
+
+    // The full buffer is still requested
+    EXPECT_EQ(Action::RENDER, policy.onPaint({1000, 500, 1.0}));
+    policy.onBufferReady({1000, 500, 1.0});
+    EXPECT_EQ(Action::NONE, policy.onPaint({1000, 500, 1.0}));
+}
+
+TEST(SelectionBufferPolicy, testZoomingInShowsAPreview) {
+    SelectionBufferPolicy policy;
+    policy.onPaint({100, 50, 1.0});
+    policy.onBufferReady({100, 50, 1.0});
+
+    // Zooming out: the buffer is downscaled
+    EXPECT_FALSE(policy.needsPreview({100, 50, 0.5}));
+    // Resizing: the buffer is scaled until the size settles
+    EXPECT_FALSE(policy.needsPreview({200, 100, 1.0}));
+
+    EXPECT_EQ(Action::START_SETTLE_TIMER, policy.onPaint({100, 50, 4.0}));
+    EXPECT_TRUE(policy.needsPreview({100, 50, 4.0}));
+    policy.onPreviewReady({100, 50, 4.0});
+    // The full buffer waits until the zoom settles
+    EXPECT_EQ(Action::NONE, policy.onPaint({100, 50, 4.0}));
+    EXPECT_EQ(Action::RENDER, policy.onSettleTimeout());
+    policy.onBufferReady({100, 50, 4.0});
+    EXPECT_EQ(Action::NONE, policy.onPaint({100, 50, 4.0}));
+}
+
+TEST(SelectionBufferPolicy, testPreviewIsNotCoarserThanTheBuffer) {
+    SelectionBufferPolicy policy;
+    policy.onPaint({1000, 1000, 1.0});
+    policy.onBufferReady({1000, 1000, 1.0});
+
+    // The scaled buffer still has more pixels than a preview would
+    EXPECT_FALSE(policy.needsPreview({1000, 1000, 1.1}));
+    EXPECT_FALSE(policy.needsPreview({1000, 1000, 4.0}));
+}
+
+TEST(SelectionBufferPolicy, testModifiedElementsRenderRightAway) {
+    SelectionBufferPolicy policy;
+    policy.onPaint({100, 50, 1.0});
+    policy.onBufferReady({100, 50, 1.0});
+
+    policy.invalidate();
+    // The outdated buffer is still painted meanwhile
+    EXPECT_TRUE(policy.hasBuffer());
+    EXPECT_EQ(Action::RENDER, policy.onPaint({100, 50, 1.0}));
+    policy.onBufferReady({100, 50, 1.0});
+    EXPECT_EQ(Action::NONE, policy.onPaint({100, 50, 1.0}));
+}
+
+TEST(SelectionBufferPolicy, testResizingRendersOnceSettled) {
+    SelectionBufferPolicy policy;
+    policy.onPaint({100, 50, 1.0});
+    policy.onBufferReady({100, 50, 1.0});
+
+    EXPECT_EQ(Action::START_SETTLE_TIMER, policy.onPaint({110, 50, 1.0}));
+    // The timer is already running
+    EXPECT_EQ(Action::NONE, policy.onPaint({120, 50, 1.0}));
+    EXPECT_EQ(Action::KEEP_WAITING, policy.onSettleTimeout());
+    EXPECT_EQ(Action::NONE, policy.onPaint({130, 50, 1.0}));
+    EXPECT_EQ(Action::KEEP_WAITING, policy.onSettleTimeout());
+
+    // No paint with another size since the last timeout
+    EXPECT_EQ(Action::RENDER, policy.onSettleTimeout());
+    EXPECT_EQ(130, policy.getPaintedParams().width);
+    policy.onBufferReady(policy.getPaintedParams());
+    EXPECT_EQ(Action::NONE, policy.onPaint({130, 50, 1.0}));
+
+    // Zooming too
+    EXPECT_EQ(Action::START_SETTLE_TIMER, policy.onPaint({130, 50, 2.0}));
+}
+
+TEST(SelectionBufferPolicy, testResizingBackNeedsNoRender) {
+    SelectionBufferPolicy policy;
+    policy.onPaint({100, 50, 1.0});
+    policy.onBufferReady({100, 50, 1.0});
+
+    EXPECT_EQ(Action::START_SETTLE_TIMER, policy.onPaint({110, 50, 1.0}));
+    EXPECT_EQ(Action::NONE, policy.onPaint({100, 50, 1.0}));
+    EXPECT_EQ(Action::KEEP_WAITING, policy.onSettleTimeout());
+    EXPECT_EQ(Action::NONE, policy.onSettleTimeout());
+
+    // The timer can be started again
+    EXPECT_EQ(Action::START_SETTLE_TIMER, policy.onPaint({90, 50, 1.0}));
+}
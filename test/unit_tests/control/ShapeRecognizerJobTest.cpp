@@ -0,0 +1,103 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include "control/jobs/ShapeRecognizerJob.h"
+#include "model/Document.h"
+#include "model/Layer.h"
+#include "model/PageRef.h"
+#include "model/Point.h"
+#include "model/Stroke.h"
+#include "model/Text.h"
+#include "model/XojPage.h"
+
+namespace {
+auto makeStroke() -> std::unique_ptr<Stroke> {
+    auto stroke = std::make_unique<Stroke>();
+    stroke->addPoint(Point(10, 10, 1));
+    stroke->addPoint(Point(50, 20, 1));
+    stroke->addPoint(Point(40, 60, 1));
+    return stroke;
+}
+
+struct Fixture {
+    Fixture() {
+        doc.addPage(page);
+        layer = page->getSelectedLayer();
+        auto s = makeStroke();
+        stroke = s.get();
+        copy = s->cloneStroke();
+        layer->addElement(std::move(s));
+    }
+
+    Document doc{nullptr};
+    PageRef page = std::make_shared<XojPage>(200, 300);
+    Layer* layer = nullptr;
+    Stroke* stroke = nullptr;
+    std::unique_ptr<Stroke> copy;
+};
+}  // namespace
+
+TEST(ShapeRecognizerJob, testUnchangedStrokeIsReplaced) {
+    Fixture f;
+    EXPECT_TRUE(ShapeRecognizerJob::isStrokeUnchanged(&f.doc, f.page, f.layer, f.stroke, *f.copy));
+}
+
+TEST(ShapeRecognizerJob, testEditedStrokeIsKept) {
+    Fixture f;
+    f.stroke->addPoint(Point(80, 80, 1));
+    EXPECT_FALSE(ShapeRecognizerJob::isStrokeUnchanged(&f.doc, f.page, f.layer, f.stroke, *f.copy));
+
+    Fixture moved;
+    moved.stroke->move(1, 0);
+    EXPECT_FALSE(
+            ShapeRecognizerJob::isStrokeUnchanged(&moved.doc, moved.page, moved.layer, moved.stroke, *moved.copy));
+}
+
+TEST(ShapeRecognizerJob, testRemovedStrokeIsIgnored) {
+    Fixture f;
+    auto removed = f.layer->removeElement(f.stroke);
+    EXPECT_FALSE(ShapeRecognizerJob::isStrokeUnchanged(&f.doc, f.page, f.layer, f.stroke, *f.copy));
+
+    // Back in the layer, e.g. after an undo and a redo: the stroke is ours again
+    f.layer->insertElement(std::move(removed.e), removed.pos);
+    EXPECT_TRUE(ShapeRecognizerJob::isStrokeUnchanged(&f.doc, f.page, f.layer, f.stroke, *f.copy));
+}
+
+TEST(ShapeRecognizerJob, testOtherElementAtSameAddressIsIgnored) {
+    Fixture f;
+    auto text = std::make_unique<Text>();
+    Element* textPtr = text.get();
+    f.layer->addElement(std::move(text));
+    EXPECT_FALSE(ShapeRecognizerJob::isStrokeUnchanged(&f.doc, f.page, f.layer, textPtr, *f.copy));
+
+    // A new stroke with other points, as if it had been allocated where the deleted one was
+    auto other = makeStroke();
+    other->addPoint(Point(0, 0, 1));
+    Element* otherPtr = other.get();
+    f.layer->addElement(std::move(other));
+    EXPECT_FALSE(ShapeRecognizerJob::isStrokeUnchanged(&f.doc, f.page, f.layer, otherPtr, *f.copy));
+}
+
+TEST(ShapeRecognizerJob, testStrokeOfRemovedLayerOrPageIsIgnored) {
+    Fixture f;
+    f.page->addLayer(new Layer());
+    f.page->removeLayer(f.layer);
+    EXPECT_FALSE(ShapeRecognizerJob::isStrokeUnchanged(&f.doc, f.page, f.layer, f.stroke, *f.copy));
+    f.page->addLayer(f.layer);
+    EXPECT_TRUE(ShapeRecognizerJob::isStrokeUnchanged(&f.doc, f.page, f.layer, f.stroke, *f.copy));
+
+    f.doc.deletePage(0);
+    EXPECT_FALSE(ShapeRecognizerJob::isStrokeUnchanged(&f.doc, f.page, f.layer, f.stroke, *f.copy));
+}
@@ -0,0 +1,96 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "control/tools/StrokePredictor.h"
+#include "model/Point.h"
+
+TEST(StrokePredictorTest, testNotEnoughPoints) {
+    StrokePredictor predictor(10.0);
+    EXPECT_TRUE(predictor.predict().empty());
+
+    predictor.addPoint(Point(0, 0), 100);
+    EXPECT_TRUE(predictor.predict().empty());
+
+    // Same timestamp: the position is updated, but there is still a single sample
+    predictor.addPoint(Point(1, 0), 100);
+    EXPECT_TRUE(predictor.predict().empty());
+}
+
+TEST(StrokePredictorTest, testNoMovement) {
+    StrokePredictor predictor(10.0);
+    for (int i = 0; i < 5; i++) {
+        predictor.addPoint(Point(3, 4), 100 + 8 * i);
+    }
+    EXPECT_TRUE(predictor.predict().empty());
+}
+
+TEST(StrokePredictorTest, testConstantVelocity) {
+    StrokePredictor predictor(16.0);
+    // 0.5 pt per ms, to the bottom right
+    for (int i = 0; i < 6; i++) {
+        predictor.addPoint(Point(0.5 * 8 * i, 0.25 * 8 * i, 2.0), 1000 + 8 * i);
+    }
+
+    std::vector<Point> tail = predictor.predict();
+    ASSERT_EQ(StrokePredictor::STEPS + 1, tail.size());
+    EXPECT_DOUBLE_EQ(20.0, tail.front().x);
+    EXPECT_DOUBLE_EQ(10.0, tail.front().y);
+    EXPECT_NEAR(28.0, tail.back().x, 1e-6);
+    EXPECT_NEAR(14.0, tail.back().y, 1e-6);
+    for (const Point& p: tail) {
+        EXPECT_DOUBLE_EQ(2.0, p.z);
+    }
+
+    // The stroke goes on as predicted
+    predictor.addPoint(Point(24, 12, 2.0), 1048);
+    predictor.addPoint(Point(28, 14, 2.0), 1056);
+    EXPECT_EQ(1U, predictor.getErrorStatistics().samples);
+    EXPECT_NEAR(0.0, predictor.getErrorStatistics().max, 1e-6);
+}
+
+TEST(StrokePredictorTest, testPredictionError) {
+    StrokePredictor predictor(8.0);
+    for (int i = 0; i < 4; i++) {
+        predictor.addPoint(Point(8.0 * i, 0), 8 * i);
+    }
+    std::vector<Point> tail = predictor.predict();
+    ASSERT_FALSE(tail.empty());
+    EXPECT_NEAR(32.0, tail.back().x, 1e-6);
+
+    // The stroke stops: the prediction was 8 pt too far
+    predictor.addPoint(Point(24, 0), 32);
+    const auto& errors = predictor.getErrorStatistics();
+    EXPECT_EQ(1U, errors.samples);
+    EXPECT_NEAR(8.0, errors.total, 1e-6);
+    EXPECT_NEAR(8.0, errors.max, 1e-6);
+
+    // Resetting forgets the points, not the statistics
+    predictor.reset();
+    EXPECT_TRUE(predictor.predict().empty());
+    EXPECT_EQ(1U, predictor.getErrorStatistics().samples);
+}
+
+TEST(StrokePredictorTest, testAcceleration) {
+    StrokePredictor predictor(10.0);
+    // x = t^2 / 100, the velocity at t = 50 is 1 pt/ms and the acceleration 0.02 pt/ms^2
+    for (int t = 10; t <= 50; t += 5) {
+        predictor.addPoint(Point(t * t / 100.0, 0), t);
+    }
+    std::vector<Point> tail = predictor.predict();
+    ASSERT_FALSE(tail.empty());
+    EXPECT_NEAR(25.0 + 10.0 + 1.0, tail.back().x, 1e-6);
+    EXPECT_NEAR(0.0, tail.back().y, 1e-6);
+}
@@ -0,0 +1,110 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "gui/inputdevices/InputEvents.h"
+#include "gui/inputdevices/InputRecording.h"
+
+#include "filesystem.h"
+
+namespace {
+auto makeEvent(InputEventType type, double x, double y, GdkEventSequence* sequence) -> InputEvent {
+    InputEvent event;
+    event.type = type;
+    event.deviceClass = INPUT_DEVICE_PEN;
+    event.deviceName = "Wacom Pen stylus";
+    event.relativeX = x;
+    event.relativeY = y;
+    event.absoluteX = x + 100.25;
+    event.absoluteY = y + 200.5;
+    event.pressure = 0.1 + x / 1000.;
+    event.button = type == MOTION_EVENT ? 0 : 1;
+    event.state = GDK_BUTTON1_MASK;
+    event.sequence = sequence;
+    event.timestamp = static_cast<guint32>(x);
+    return event;
+}
+}  // namespace
+
+TEST(InputRecording, testRoundTrip) {
+    fs::path file = fs::temp_directory_path() / "xournalpp-test-input-recording.txt";
+
+    // Any non null pointer identifies a sequence
+    auto* sequence = reinterpret_cast<GdkEventSequence*>(static_cast<uintptr_t>(0x1234));
+    {
+        InputRecorder recorder(file);
+        recorder.record(makeEvent(BUTTON_PRESS_EVENT, 10., 20., sequence), 1.0, TOOL_PEN);
+        recorder.record(makeEvent(MOTION_EVENT, 11.1, 21.3, sequence), 1.0, TOOL_PEN);
+        recorder.record(makeEvent(BUTTON_RELEASE_EVENT, 12.7, 22.9, sequence), 1.5, TOOL_PEN);
+        // Same pointer, but a new sequence
+        recorder.record(makeEvent(BUTTON_PRESS_EVENT, 1. / 3., 2., sequence), 1.5, TOOL_HIGHLIGHTER);
+        recorder.record(makeEvent(MOTION_EVENT, 5., 6., nullptr), 1.5, TOOL_HIGHLIGHTER);
+    }
+
+    InputRecording recording = InputRecording::load(file);
+    fs::remove(file);
+
+    ASSERT_EQ(5U, recording.events.size());
+    const auto& events = recording.events;
+
+    EXPECT_EQ(BUTTON_PRESS_EVENT, events[0].type);
+    EXPECT_EQ(INPUT_DEVICE_PEN, events[0].deviceClass);
+    EXPECT_EQ("Wacom Pen stylus", events[0].deviceName);
+    EXPECT_EQ(10., events[0].relativeX);
+    EXPECT_EQ(220.5, events[0].absoluteY);
+    EXPECT_EQ(1U, events[0].button);
+    EXPECT_EQ(GDK_BUTTON1_MASK, events[0].state);
+    EXPECT_EQ(10U, events[0].timestamp);
+    EXPECT_EQ(1.0, events[0].zoom);
+    EXPECT_EQ(TOOL_PEN, events[0].tool);
+
+    EXPECT_EQ(MOTION_EVENT, events[1].type);
+    EXPECT_EQ(0.1 + 11.1 / 1000., events[1].pressure);
+
+    EXPECT_EQ(1.5, events[2].zoom);
+    EXPECT_EQ(events[0].sequence, events[1].sequence);
+    EXPECT_EQ(events[0].sequence, events[2].sequence);
+    EXPECT_NE(0U, events[0].sequence);
+
+    // No precision is lost on the coordinates
+    EXPECT_EQ(1. / 3., events[3].relativeX);
+    EXPECT_EQ(TOOL_HIGHLIGHTER, events[3].tool);
+    EXPECT_NE(events[0].sequence, events[3].sequence);
+
+    EXPECT_EQ(0U, events[4].sequence);
+
+    for (size_t i = 1; i < events.size(); i++) {
+        EXPECT_LE(events[i - 1].time, events[i].time);
+    }
+}
+
+TEST(InputRecording, testInvalidFile) {
+    fs::path file = fs::temp_directory_path() / "xournalpp-test-invalid-recording.txt";
+    {
+        std::ofstream out(file);
+        out << "not a recording\n";
+    }
+    EXPECT_THROW(InputRecording::load(file), std::runtime_error);
+
+    {
+        std::ofstream out(file);
+        out << "xournalpp-input-recording\t1\nevent\t0\tnot a number\n";
+    }
+    EXPECT_THROW(InputRecording::load(file), std::runtime_error);
+    fs::remove(file);
+
+    EXPECT_THROW(InputRecording::load(file), std::runtime_error);
+}
@@ -0,0 +1,54 @@
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "gui/sidebar/previews/base/SidebarLayout.h"
+
+using Size = SidebarLayout::EntrySize;
+
+TEST(SidebarLayout, testRows) {
+    // Two entries fit in a row of width 250, the third one does not
+    std::vector<Size> sizes{{100, 150}, {100, 130}, {100, 150}, {120, 80}};
+    auto layout = SidebarLayout::computeLayout(sizes, 250);
+
+    ASSERT_EQ(4U, layout.positions.size());
+    ASSERT_EQ(2U, layout.rows.size());
+    EXPECT_EQ(xoj::util::Rectangle<int>(0, 0, 100, 150), layout.positions[0]);
+    // Smaller entries are centered vertically in the row
+    EXPECT_EQ(xoj::util::Rectangle<int>(100, 10, 100, 130), layout.positions[1]);
+    EXPECT_EQ(xoj::util::Rectangle<int>(0, 150, 100, 150), layout.positions[2]);
+    EXPECT_EQ(xoj::util::Rectangle<int>(100, 185, 120, 80), layout.positions[3]);
+    EXPECT_EQ(220, layout.width);
+    EXPECT_EQ(300, layout.height);
+
+    // An entry wider than the sidebar still gets a row
+    auto narrow = SidebarLayout::computeLayout(sizes, 50);
+    EXPECT_EQ(4U, narrow.rows.size());
+    EXPECT_EQ(510, narrow.height);
+
+    EXPECT_EQ(0, SidebarLayout::computeLayout({}, 250).height);
+}
+
+TEST(SidebarLayout, testEntriesBetween) {
+    // A thousand page document, one page per row
+    std::vector<Size> sizes(1000, {100, 150});
+    auto layout = SidebarLayout::computeLayout(sizes, 150);
+    ASSERT_EQ(1000U, layout.rows.size());
+    EXPECT_EQ(150000, layout.height);
+
+    auto [first, last] = layout.entriesBetween(1500, 2000);
+    EXPECT_EQ(10U, first);
+    EXPECT_EQ(14U, last);
+
+    std::tie(first, last) = layout.entriesBetween(-1000, 10);
+    EXPECT_EQ(0U, first);
+    EXPECT_EQ(1U, last);
+
+    std::tie(first, last) = layout.entriesBetween(149900, 200000);
+    EXPECT_EQ(999U, first);
+    EXPECT_EQ(1000U, last);
+
+    std::tie(first, last) = layout.entriesBetween(160000, 170000);
+    EXPECT_EQ(first, last);
+}
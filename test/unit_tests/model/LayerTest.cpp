@@ -0,0 +1,64 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "model/Element.h"
+#include "model/Layer.h"
+#include "model/Stroke.h"
+
+namespace {
+auto fillLayer(Layer& layer, size_t count) -> std::vector<Element*> {
+    std::vector<Element*> elements;
+    for (size_t i = 0; i < count; i++) {
+        auto stroke = std::make_unique<Stroke>();
+        elements.push_back(stroke.get());
+        layer.addElement(std::move(stroke));
+    }
+    return elements;
+}
+}  // namespace
+
+// RecognizerUndoAction::undo and redo swap the original stroke and the recognized shape with replaceElement
+TEST(Layer, testReplaceElementKeepsThePosition) {
+    Layer layer;
+    auto elements = fillLayer(layer, 3);
+
+    auto shape = std::make_unique<Stroke>();
+    Element* shapePtr = shape.get();
+    auto original = layer.replaceElement(elements[1], std::move(shape));
+    ASSERT_EQ(elements[1], original.get());
+    EXPECT_EQ(1, layer.indexOf(shapePtr));
+    EXPECT_EQ(Element::InvalidIndex, layer.indexOf(elements[1]));
+    EXPECT_EQ(3U, layer.getElements().size());
+
+    // And back
+    auto replaced = layer.replaceElement(shapePtr, std::move(original));
+    ASSERT_EQ(shapePtr, replaced.get());
+    EXPECT_EQ(1, layer.indexOf(elements[1]));
+    EXPECT_EQ(0, layer.indexOf(elements[0]));
+    EXPECT_EQ(2, layer.indexOf(elements[2]));
+}
+
+TEST(Layer, testReplaceMissingElementAddsTheReplacement) {
+    Layer layer;
+    fillLayer(layer, 2);
+    Stroke missing;
+
+    auto replacement = std::make_unique<Stroke>();
+    Element* replacementPtr = replacement.get();
+    EXPECT_EQ(nullptr, layer.replaceElement(&missing, std::move(replacement)));
+    EXPECT_EQ(2, layer.indexOf(replacementPtr));
+}
@@ -0,0 +1,106 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <cairo.h>
+#include <gtest/gtest.h>
+
+#include "model/Point.h"
+#include "model/PointKernels.h"
+
+namespace {
+std::vector<Point> randomPoints(size_t n, bool pressure) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> coord(-500.0, 1500.0);
+    std::uniform_real_distribution<double> width(0.1, 5.0);
+    std::vector<Point> pts;
+    pts.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        pts.emplace_back(coord(gen), coord(gen), pressure ? width(gen) : Point::NO_PRESSURE);
+    }
+    return pts;
+}
+
+cairo_matrix_t scaleRotateMatrix() {
+    cairo_matrix_t m;
+    cairo_matrix_init_identity(&m);
+    cairo_matrix_translate(&m, 120.5, -33.25);
+    cairo_matrix_rotate(&m, 0.3);
+    cairo_matrix_scale(&m, 1.7, 0.6);
+    cairo_matrix_rotate(&m, -0.3);
+    cairo_matrix_translate(&m, -120.5, 33.25);
+    return m;
+}
+
+void expectSamePoints(const std::vector<Point>& expected, const std::vector<Point>& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        // Same operations in the same order: the results are identical
+        EXPECT_EQ(expected[i].x, actual[i].x) << "point " << i;
+        EXPECT_EQ(expected[i].y, actual[i].y) << "point " << i;
+        EXPECT_EQ(expected[i].z, actual[i].z) << "point " << i;
+    }
+}
+}  // namespace
+
+TEST(PointKernelsTest, testTranslate) {
+    std::vector<Point> expected = randomPoints(101, true);
+    std::vector<Point> actual = expected;
+
+    PointKernels::scalar::translate(expected.data(), expected.size(), 12.125, -0.1);
+    PointKernels::translate(actual.data(), actual.size(), 12.125, -0.1);
+    expectSamePoints(expected, actual);
+}
+
+TEST(PointKernelsTest, testTransform) {
+    const cairo_matrix_t m = scaleRotateMatrix();
+    for (bool pressure: {true, false}) {
+        std::vector<Point> expected = randomPoints(101, pressure);
+        std::vector<Point> actual = expected;
+
+        PointKernels::scalar::transform(expected.data(), expected.size(), m, 1.5);
+        PointKernels::transform(actual.data(), actual.size(), m, 1.5);
+        expectSamePoints(expected, actual);
+    }
+
+    std::vector<Point> pts = {Point(1, 2, 3), Point(4, 5)};
+    PointKernels::transform(pts.data(), pts.size(), m, 2.0);
+    EXPECT_EQ(6.0, pts[0].z);
+    EXPECT_EQ(Point::NO_PRESSURE, pts[1].z);
+}
+
+TEST(PointKernelsTest, testBounds) {
+    std::vector<Point> pts = randomPoints(101, true);
+    PointKernels::Bounds expected = PointKernels::scalar::bounds(pts.data(), pts.size());
+    PointKernels::Bounds actual = PointKernels::bounds(pts.data(), pts.size());
+    EXPECT_EQ(expected.minX, actual.minX);
+    EXPECT_EQ(expected.minY, actual.minY);
+    EXPECT_EQ(expected.maxX, actual.maxX);
+    EXPECT_EQ(expected.maxY, actual.maxY);
+    EXPECT_EQ(expected.maxZ, actual.maxZ);
+
+    // Negative coordinates only
+    std::vector<Point> negative = {Point(-3, -4, 1), Point(-1, -8, 2)};
+    actual = PointKernels::bounds(negative.data(), negative.size());
+    EXPECT_EQ(-3.0, actual.minX);
+    EXPECT_EQ(-8.0, actual.minY);
+    EXPECT_EQ(-1.0, actual.maxX);
+    EXPECT_EQ(-4.0, actual.maxY);
+    EXPECT_EQ(2.0, actual.maxZ);
+
+    // Single point
+    actual = PointKernels::bounds(negative.data(), 1);
+    EXPECT_EQ(-3.0, actual.minX);
+    EXPECT_EQ(-3.0, actual.maxX);
+}
@@ -0,0 +1,62 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <string>
+
+#include <cairo-pdf.h>
+#include <cairo.h>
+#include <gtest/gtest.h>
+
+#include "model/TexImage.h"
+#include "util/raii/CairoWrappers.h"
+
+namespace {
+auto writeToString(std::string* out, const unsigned char* data, unsigned int length) -> cairo_status_t {
+    out->append(reinterpret_cast<const char*>(data), length);
+    return CAIRO_STATUS_SUCCESS;
+}
+
+/// A one page PDF, as produced by the LaTeX tool
+auto makePdf() -> std::string {
+    std::string pdf;
+    xoj::util::CairoSurfaceSPtr surface(
+            cairo_pdf_surface_create_for_stream(reinterpret_cast<cairo_write_func_t>(writeToString), &pdf, 20, 10),
+            xoj::util::adopt);
+    {
+        xoj::util::CairoSPtr cr(cairo_create(surface.get()), xoj::util::adopt);
+        cairo_rectangle(cr.get(), 2, 2, 16, 6);
+        cairo_fill(cr.get());
+    }
+    cairo_surface_finish(surface.get());
+    return pdf;
+}
+}  // namespace
+
+TEST(TexImage, testRastersAreCountedOnceByTheCache) {
+    TexImage image;
+    ASSERT_TRUE(image.loadData(makePdf()));
+    auto clone = image.cloneTexImage();
+
+    const size_t imageSize = image.getMemoryUsage();
+    const size_t cloneSize = clone->getMemoryUsage();
+    const size_t cached = TexImage::getRasterCacheMemoryUsage();
+
+    xoj::util::CairoSurfaceSPtr raster(cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 64, 32), xoj::util::adopt);
+    const size_t rasterBytes = static_cast<size_t>(cairo_image_surface_get_stride(raster.get())) * 32U;
+    image.cacheRaster(raster);
+
+    // The clone shares the rasterization
+    EXPECT_EQ(raster.get(), clone->getCachedRaster(64, 32).get());
+
+    EXPECT_EQ(cached + rasterBytes, TexImage::getRasterCacheMemoryUsage());
+    EXPECT_EQ(imageSize, image.getMemoryUsage());
+    EXPECT_EQ(cloneSize, clone->getMemoryUsage());
+}
@@ -0,0 +1,119 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "model/Layer.h"
+#include "model/Point.h"
+#include "model/Stroke.h"
+#include "model/XojPage.h"
+#include "util/Color.h"
+#include "util/Range.h"
+
+
+TEST(XojPage, testRevisionChangesOnNotification) {
+    XojPage page(100, 100);
+    auto rev = page.getRevision();
+
+    Range range(0, 0, 10, 10);
+    page.fireRangeChanged(range);
+    EXPECT_NE(rev, page.getRevision());
+
+    rev = page.getRevision();
+    page.firePageChanged();
+    EXPECT_NE(rev, page.getRevision());
+}
+
+TEST(XojPage, testRevisionChangesOnBackgroundChange) {
+    XojPage page(100, 100);
+    auto rev = page.getRevision();
+
+    page.setBackgroundColor(Colors::black);
+    EXPECT_NE(rev, page.getRevision());
+
+    rev = page.getRevision();
+    page.setSize(200, 200);
+    EXPECT_NE(rev, page.getRevision());
+}
+
+TEST(XojPage, testRevisionIsUniqueAmongPages) {
+    XojPage page(100, 100);
+    std::unique_ptr<XojPage> copy(page.clone());
+    EXPECT_NE(page.getRevision(), copy->getRevision());
+
+    auto rev = page.getRevision();
+    EXPECT_EQ(rev, page.getRevision());
+}
+
+namespace {
+size_t getElementMemoryUsage(XojPage& page) {
+    size_t size = 0;
+    for (const Layer* layer: *page.getLayers()) {
+        for (const auto& e: layer->getElements()) {
+            size += e->getMemoryUsage();
+        }
+    }
+    return size;
+}
+}  // namespace
+
+TEST(XojPage, testClonesSharePoints) {
+    constexpr size_t STROKES = 10000;
+    constexpr size_t POINTS = 50;
+    constexpr size_t CLONES = 50;
+
+    XojPage page(595, 842);
+    auto* layer = new Layer();
+    page.addLayer(layer);
+    for (size_t i = 0; i < STROKES; i++) {
+        auto stroke = std::make_unique<Stroke>();
+        for (size_t j = 0; j < POINTS; j++) {
+            stroke->addPoint(Point(static_cast<double>(j), static_cast<double>(i % 800)));
+        }
+        layer->addElement(std::move(stroke));
+    }
+
+    const size_t strokeObjects = STROKES * sizeof(Stroke);
+    const size_t pointMemory = getElementMemoryUsage(page) - strokeObjects;
+    EXPECT_GE(pointMemory, STROKES * POINTS * sizeof(Point));
+
+    std::vector<std::unique_ptr<XojPage>> clones;
+    for (size_t i = 0; i < CLONES; i++) {
+        clones.emplace_back(page.clone());
+    }
+
+    // The shared points are split between the strokes: all pages together still hold a single copy of the points
+    size_t total = getElementMemoryUsage(page);
+    for (auto& clone: clones) {
+        total += getElementMemoryUsage(*clone);
+    }
+    EXPECT_LE(total, (CLONES + 1) * strokeObjects + pointMemory);
+    EXPECT_GE(total, (CLONES + 1) * strokeObjects + pointMemory - (CLONES + 1) * STROKES);
+
+    // Editing a clone only copies the points of the edited stroke
+    auto* original = dynamic_cast<Stroke*>(layer->getElements().front().get());
+    auto* copy = dynamic_cast<Stroke*>((*clones.front()->getLayers()).front()->getElements().front().get());
+    ASSERT_NE(original, nullptr);
+    ASSERT_NE(copy, nullptr);
+    EXPECT_TRUE(copy->sharesPointsWith(*original));
+
+    copy->move(10, 0);
+    EXPECT_FALSE(copy->sharesPointsWith(*original));
+    EXPECT_DOUBLE_EQ(0.0, original->getPoint(0).x);
+    EXPECT_DOUBLE_EQ(10.0, copy->getPoint(0).x);
+
+    auto* secondCopy = dynamic_cast<Stroke*>((*clones.back()->getLayers()).front()->getElements().front().get());
+    EXPECT_TRUE(secondCopy->sharesPointsWith(*original));
+}
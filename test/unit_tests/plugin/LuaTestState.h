@@ -0,0 +1,32 @@
+/*
+ * Xournal++
+ *
+ * Lua states for the plugin tests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <memory>  // for unique_ptr
+
+extern "C" {
+#include <lauxlib.h>  // for luaL_newstate
+#include <lua.h>      // for lua_State, lua_close
+#include <lualib.h>   // for luaL_openlibs
+}
+
+struct LuaStateCloser {
+    void operator()(lua_State* L) const { lua_close(L); }
+};
+using LuaStatePtr = std::unique_ptr<lua_State, LuaStateCloser>;
+
+/// A new Lua state with the standard libraries
+inline auto newLuaState() -> LuaStatePtr {
+    LuaStatePtr L(luaL_newstate());
+    luaL_openlibs(L.get());
+    return L;
+}
@@ -0,0 +1,186 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include "config-features.h"
+
+#ifdef ENABLE_PLUGINS
+
+#include <cstdlib>
+#include <optional>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "plugin/LuaValue.h"
+
+#include "LuaTestState.h"
+
+namespace {
+/// Copies the value returned by the Lua code
+auto copyOf(lua_State* L, const char* code, std::string& error) -> std::optional<LuaValue> {
+    EXPECT_EQ(LUA_OK, luaL_dostring(L, code)) << lua_tostring(L, -1);
+    const int top = lua_gettop(L);
+    auto value = LuaValue::fromLua(L, -1, error);
+    EXPECT_EQ(top, lua_gettop(L)) << "The stack is left as is, even if the value can not be copied";
+    lua_pop(L, 1);
+    return value;
+}
+
+/// Allocator of a Lua state, which can be made to fail
+struct Allocator {
+    bool failing = false;
+
+    static auto alloc(void* ud, void* ptr, size_t osize, size_t nsize) -> void* {
+        if (nsize == 0) {
+            std::free(ptr);
+            return nullptr;
+        }
+        if (static_cast<Allocator*>(ud)->failing && (ptr == nullptr || nsize > osize)) {
+            return nullptr;
+        }
+        return std::realloc(ptr, nsize);
+    }
+};
+
+/// Runs the Lua function `check` with the value as argument, in another state, and returns its result
+auto checkInOtherState(const LuaValue& value, const char* check) -> bool {
+    auto L = newLuaState();
+    EXPECT_EQ(LUA_OK, luaL_dostring(L.get(), check)) << lua_tostring(L.get(), -1);
+    value.push(L.get());
+    EXPECT_EQ(LUA_OK, lua_pcall(L.get(), 1, 1, 0)) << lua_tostring(L.get(), -1);
+    return lua_toboolean(L.get(), -1);
+}
+}  // namespace
+
+TEST(LuaValue, testScalarsRoundTrip) {
+    auto L = newLuaState();
+    std::string error;
+
+    auto nil = copyOf(L.get(), "return nil", error);
+    ASSERT_TRUE(nil);
+    EXPECT_TRUE(checkInOtherState(*nil, "return function(v) return v == nil end"));
+
+    auto boolean = copyOf(L.get(), "return false", error);
+    ASSERT_TRUE(boolean);
+    EXPECT_TRUE(checkInOtherState(*boolean, "return function(v) return v == false end"));
+
+    // Integers and floats are kept apart
+    auto integer = copyOf(L.get(), "return 9007199254740993", error);
+    ASSERT_TRUE(integer);
+    EXPECT_TRUE(checkInOtherState(*integer,
+                                  "return function(v) return math.type(v) == 'integer' and v == 9007199254740993 end"));
+
+    auto number = copyOf(L.get(), "return 2.0", error);
+    ASSERT_TRUE(number);
+    EXPECT_TRUE(checkInOtherState(*number, "return function(v) return math.type(v) == 'float' and v == 2.0 end"));
+
+    // Strings may be binary
+    auto string = copyOf(L.get(), "return 'a\\0b'", error);
+    ASSERT_TRUE(string);
+    EXPECT_TRUE(checkInOtherState(*string, "return function(v) return v == 'a\\0b' end"));
+
+    EXPECT_TRUE(checkInOtherState(LuaValue(0.5), "return function(v) return v == 0.5 end"));
+    EXPECT_TRUE(checkInOtherState(LuaValue(std::string("text")), "return function(v) return v == 'text' end"));
+    EXPECT_TRUE(error.empty());
+}
+
+TEST(LuaValue, testTablesRoundTrip) {
+    auto L = newLuaState();
+    std::string error;
+    auto table = copyOf(L.get(), "return {1, 2.5, 'three', nested = {flag = true, [false] = 'no'}, empty = {}}", error);
+    ASSERT_TRUE(table) << error;
+    EXPECT_TRUE(checkInOtherState(*table, R"(return function(v)
+        return #v == 3 and v[1] == 1 and v[2] == 2.5 and v[3] == 'three' and v.nested.flag == true
+            and v.nested[false] == 'no' and next(v.empty) == nil
+    end)"));
+
+    // Copies of a table are independent of each other
+    EXPECT_TRUE(checkInOtherState(*table, "return function(v) v[1] = 7 return true end"));
+    EXPECT_TRUE(checkInOtherState(*table, "return function(v) return v[1] == 1 end"));
+}
+
+TEST(LuaValue, testDepthLimit) {
+    auto L = newLuaState();
+    std::string error;
+
+    auto deep = copyOf(L.get(), "local t = {} for i = 2, 64 do t = {t} end return t", error);
+    ASSERT_TRUE(deep) << error;
+    EXPECT_TRUE(checkInOtherState(*deep, R"(return function(v)
+        local depth = 1
+        while v[1] do v = v[1] depth = depth + 1 end
+        return depth == 64
+    end)"));
+
+    EXPECT_FALSE(copyOf(L.get(), "local t = {} for i = 2, 65 do t = {t} end return t", error));
+    EXPECT_EQ("Tables are nested too deeply", error);
+
+    // Tables containing themselves can not be copied either
+    error.clear();
+    EXPECT_FALSE(copyOf(L.get(), "local t = {} t.self = t return t", error));
+    EXPECT_EQ("Tables are nested too deeply", error);
+}
+
+TEST(LuaValue, testRejectedTypes) {
+    auto L = newLuaState();
+    std::string error;
+
+    EXPECT_FALSE(copyOf(L.get(), "return print", error));
+    EXPECT_EQ("Values of type function can not be copied", error);
+
+    EXPECT_FALSE(copyOf(L.get(), "return coroutine.create(function() end)", error));
+    EXPECT_EQ("Values of type thread can not be copied", error);
+
+    EXPECT_FALSE(copyOf(L.get(), "return io.stdout", error));
+    EXPECT_EQ("Values of type userdata can not be copied", error);
+
+    // Also as keys, and deep inside tables: the stack is unwound (checked by copyOf)
+    EXPECT_FALSE(copyOf(L.get(), "return {[print] = 1}", error));
+    EXPECT_EQ("Values of type function can not be copied", error);
+    EXPECT_FALSE(copyOf(L.get(), "return {1, {2, {3, a = {b = print}}}}", error));
+    EXPECT_EQ("Values of type function can not be copied", error);
+}
+
+TEST(LuaValue, testProtectedCall) {
+    auto L = newLuaState();
+    ASSERT_EQ(LUA_OK, luaL_dostring(L.get(), "return function(a, b) return a .. b end"));
+    EXPECT_EQ(LUA_OK, LuaValue::pcall(L.get(), {LuaValue(std::string("a")), LuaValue(std::string("b"))}, 1));
+    EXPECT_STREQ("ab", lua_tostring(L.get(), -1));
+    lua_pop(L.get(), 1);
+    EXPECT_EQ(0, lua_gettop(L.get()));
+
+    ASSERT_EQ(LUA_OK, luaL_dostring(L.get(), "return function() error('failed', 0) end"));
+    EXPECT_EQ(LUA_ERRRUN, LuaValue::pcall(L.get(), {}, 0));
+    EXPECT_EQ("failed", LuaValue::errorMessage(L.get(), -1));
+    lua_pop(L.get(), 1);
+
+    // Error objects which are not strings
+    ASSERT_EQ(LUA_OK, luaL_dostring(L.get(), "return function() error({}) end"));
+    EXPECT_EQ(LUA_ERRRUN, LuaValue::pcall(L.get(), {}, 0));
+    EXPECT_EQ("(error object is a table value)", LuaValue::errorMessage(L.get(), -1));
+    lua_pop(L.get(), 1);
+    EXPECT_EQ(0, lua_gettop(L.get()));
+}
+
+TEST(LuaValue, testArgumentsAreCopiedInProtectedMode) {
+    Allocator allocator;
+    LuaStatePtr L(lua_newstate(Allocator::alloc, &allocator));
+    ASSERT_EQ(LUA_OK, luaL_dostring(L.get(), "return function(s) return #s end"));
+
+    // Running out of memory while copying the argument is an error of the call, instead of a panic
+    allocator.failing = true;
+    EXPECT_EQ(LUA_ERRMEM, LuaValue::pcall(L.get(), {LuaValue(std::string(1000, 'x'))}, 1));
+    allocator.failing = false;
+    EXPECT_EQ("not enough memory", LuaValue::errorMessage(L.get(), -1));
+    lua_pop(L.get(), 1);
+    EXPECT_EQ(0, lua_gettop(L.get()));
+}
+
+#endif
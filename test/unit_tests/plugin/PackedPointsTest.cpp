@@ -0,0 +1,86 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include "config-features.h"
+
+#ifdef ENABLE_PLUGINS
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "model/Point.h"
+#include "plugin/PackedPoints.h"
+
+#include "LuaTestState.h"
+
+TEST(PackedPoints, testRoundTrip) {
+    auto L = newLuaState();
+    const std::vector<Point> points = {Point(1.5, -2.25, 0.5), Point(1e10, 3e-10, -1), Point(0, 0)};
+    PackedPoints::push(L.get(), points);
+    ASSERT_EQ(LUA_TSTRING, lua_type(L.get(), -1));
+    EXPECT_EQ(points.size() * PackedPoints::POINT_SIZE, lua_rawlen(L.get(), -1));
+
+    std::vector<Point> read;
+    ASSERT_TRUE(PackedPoints::read(L.get(), -1, read));
+    ASSERT_EQ(points.size(), read.size());
+    for (size_t i = 0; i < points.size(); i++) {
+        EXPECT_EQ(points[i].x, read[i].x);
+        EXPECT_EQ(points[i].y, read[i].y);
+        EXPECT_EQ(points[i].z, read[i].z);
+    }
+
+    std::vector<Point> none;
+    PackedPoints::push(L.get(), none);
+    EXPECT_EQ(0U, lua_rawlen(L.get(), -1));
+    read.clear();
+    EXPECT_TRUE(PackedPoints::read(L.get(), -1, read));
+    EXPECT_TRUE(read.empty());
+}
+
+// The format documented for the plugins: native-endian doubles x, y, pressure
+TEST(PackedPoints, testMatchesStringPack) {
+    auto L = newLuaState();
+    ASSERT_EQ(LUA_OK, luaL_dostring(L.get(), "return string.pack('dddddd', 1, 2, 0.5, 3, 4, -1)"));
+    std::vector<Point> read;
+    ASSERT_TRUE(PackedPoints::read(L.get(), -1, read));
+    ASSERT_EQ(2U, read.size());
+    EXPECT_EQ(1.0, read[0].x);
+    EXPECT_EQ(2.0, read[0].y);
+    EXPECT_EQ(0.5, read[0].z);
+    EXPECT_EQ(3.0, read[1].x);
+    EXPECT_EQ(4.0, read[1].y);
+    EXPECT_EQ(-1.0, read[1].z);
+
+    PackedPoints::push(L.get(), read);
+    lua_setglobal(L.get(), "points");
+    ASSERT_EQ(LUA_OK, luaL_dostring(L.get(), "local x, y, p = string.unpack('ddd', points, 25); return x + y + p"));
+    EXPECT_EQ(6.0, lua_tonumber(L.get(), -1));
+}
+
+TEST(PackedPoints, testRejectsInvalidValues) {
+    auto L = newLuaState();
+    std::vector<Point> read;
+
+    // Not a whole number of points
+    lua_pushlstring(L.get(), std::string(PackedPoints::POINT_SIZE + 1, '\0').data(), PackedPoints::POINT_SIZE + 1);
+    EXPECT_FALSE(PackedPoints::read(L.get(), -1, read));
+
+    // Numbers are convertible to strings, but are not packed points
+    lua_pushnumber(L.get(), 42);
+    EXPECT_FALSE(PackedPoints::read(L.get(), -1, read));
+
+    lua_newtable(L.get());
+    EXPECT_FALSE(PackedPoints::read(L.get(), -1, read));
+}
+
+#endif
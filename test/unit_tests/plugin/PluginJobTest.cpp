@@ -0,0 +1,237 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include "config-features.h"
+
+#ifdef ENABLE_PLUGINS
+
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <glib.h>
+#include <gtest/gtest.h>
+
+#include "plugin/LuaValue.h"
+#include "plugin/Plugin.h"
+
+#include "LuaTestState.h"
+#include "filesystem.h"
+
+using namespace std::chrono_literals;
+
+namespace {
+/// The callbacks of the jobs append a line to the output file for each call
+constexpr auto MAIN_LUA = R"(
+local function write(...)
+  local args = table.pack(...)
+  for i = 1, args.n do args[i] = tostring(args[i]) end
+  local f = assert(io.open(output, "a"))
+  f:write(table.concat(args, " ", 1, args.n), "\n")
+  f:close()
+end
+function onDone(result, err)
+  if type(result) == "table" then
+    write("done", result.sum, result.text)
+  else
+    write("done", result, err)
+  end
+end
+function onProgress(fraction, message) write("progress", fraction, message) end
+function onPost(...) write("post", ...) end
+)";
+
+/// Copy of the value returned by the Lua code, made with a plain Lua state
+auto makeInput(const char* code) -> LuaValue {
+    auto L = newLuaState();
+    EXPECT_EQ(LUA_OK, luaL_dostring(L.get(), code));
+    std::string error;
+    auto value = LuaValue::fromLua(L.get(), -1, error);
+    EXPECT_TRUE(value) << error;
+    return value ? *value : LuaValue();
+}
+
+auto readLines(const fs::path& file) -> std::vector<std::string> {
+    std::vector<std::string> lines;
+    std::ifstream in(file);
+    for (std::string line; std::getline(in, line);) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+auto isDone(const fs::path& output) -> bool {
+    auto lines = readLines(output);
+    return !lines.empty() && lines.back().rfind("done", 0) == 0;
+}
+
+/// Source which is ready once a done callback wrote to the output file. It never wakes up the main loop itself: the
+/// output is checked whenever the loop was woken up by the callbacks of the jobs.
+struct DoneSource {
+    GSource source;
+    const fs::path* output;
+};
+
+GSourceFuncs doneSourceFuncs = {
+        [](GSource* source, gint* timeout) -> gboolean {
+            *timeout = -1;
+            return isDone(*reinterpret_cast<DoneSource*>(source)->output);
+        },
+        [](GSource* source) -> gboolean { return isDone(*reinterpret_cast<DoneSource*>(source)->output); },
+        [](GSource*, GSourceFunc callback, gpointer data) -> gboolean { return callback(data); },
+        nullptr,
+        nullptr,
+        nullptr};
+
+auto quitLoop(gpointer loop) -> gboolean {
+    g_main_loop_quit(static_cast<GMainLoop*>(loop));
+    return G_SOURCE_REMOVE;
+}
+}  // namespace
+
+class PluginJobTest: public ::testing::Test {
+protected:
+    void SetUp() override {
+        auto seed = ::testing::UnitTest::GetInstance()->random_seed();
+        dir = fs::temp_directory_path() / ("xournalpp-plugin-job-test-" + std::to_string(seed));
+        fs::create_directories(dir);
+        write("plugin.ini", "[default]\nenabled=true\n\n[plugin]\nmainfile=main.lua\n");
+        write("main.lua", "local output = [==[" + (dir / "output.txt").string() + "]==]\n" + MAIN_LUA);
+
+        plugin = std::make_unique<Plugin>(nullptr, "Test", dir);
+        plugin->loadScript();
+        ASSERT_TRUE(plugin->isValid());
+    }
+
+    void TearDown() override {
+        plugin.reset();
+        std::error_code ec;
+        fs::remove_all(dir, ec);
+    }
+
+    void write(const std::string& file, const std::string& content) { std::ofstream(dir / file) << content; }
+
+    /// Runs the main loop until the done callback of a job was called, or for at most the given time
+    auto runMainLoop(std::chrono::milliseconds timeout = 10s) -> std::vector<std::string> {
+        const fs::path output = dir / "output.txt";
+        GMainLoop* loop = g_main_loop_new(nullptr, false);
+
+        GSource* done = g_source_new(&doneSourceFuncs, sizeof(DoneSource));
+        reinterpret_cast<DoneSource*>(done)->output = &output;
+        g_source_set_callback(done, quitLoop, loop, nullptr);
+        g_source_attach(done, nullptr);
+
+        GSource* guard = g_timeout_source_new(static_cast<guint>(timeout.count()));
+        g_source_set_callback(guard, quitLoop, loop, nullptr);
+        g_source_attach(guard, nullptr);
+
+        g_main_loop_run(loop);
+
+        for (GSource* source: {done, guard}) {
+            g_source_destroy(source);
+            g_source_unref(source);
+        }
+        g_main_loop_unref(loop);
+        return readLines(output);
+    }
+
+    fs::path dir;
+    std::unique_ptr<Plugin> plugin;
+};
+
+TEST_F(PluginJobTest, testCallsAndResultAreDeliveredInOrder) {
+    write("sum.lua", R"(
+        local input = ...
+        local sum = 0
+        for _, v in ipairs(input.values) do sum = sum + v end
+        job.post("onPost", "half", 1, {})
+        job.progress(2, "clamped")
+        return {sum = sum, text = input.text}
+    )");
+    plugin->startJob("sum.lua", makeInput("return {values = {1, 2, 3}, text = 'abc'}"), "onDone", "onProgress");
+
+    auto lines = runMainLoop();
+    ASSERT_EQ(3U, lines.size());
+    EXPECT_EQ("post half 1 table:", lines[0].substr(0, 18));
+    EXPECT_EQ("progress 1.0 clamped", lines[1]);
+    EXPECT_EQ("done 6 abc", lines[2]);
+}
+
+TEST_F(PluginJobTest, testModulesOfThePluginCanBeRequired) {
+    write("helper.lua", "return {answer = 42}");
+    write("answer.lua", "return {sum = require('helper').answer, text = 'required'}");
+    plugin->startJob("answer.lua", LuaValue(), "onDone", "");
+
+    auto lines = runMainLoop();
+    ASSERT_EQ(1U, lines.size());
+    EXPECT_EQ("done 42 required", lines[0]);
+}
+
+TEST_F(PluginJobTest, testErrorsArePassedToTheCallback) {
+    write("error.lua", "error('boom')");
+    plugin->startJob("error.lua", LuaValue(), "onDone", "");
+    auto lines = runMainLoop();
+    ASSERT_EQ(1U, lines.size());
+    EXPECT_EQ("done nil ", lines[0].substr(0, 9));
+    EXPECT_NE(std::string::npos, lines[0].find("boom"));
+
+    // The result must be copied back to the plugin
+    fs::remove(dir / "output.txt");
+    write("function.lua", "return print");
+    plugin->startJob("function.lua", LuaValue(), "onDone", "");
+    lines = runMainLoop();
+    ASSERT_EQ(1U, lines.size());
+    EXPECT_EQ("done nil Values of type function can not be copied", lines[0]);
+
+    // So must the arguments of job.post
+    fs::remove(dir / "output.txt");
+    write("post.lua", "job.post('onPost', 1, print)");
+    plugin->startJob("post.lua", LuaValue(), "onDone", "");
+    lines = runMainLoop();
+    ASSERT_EQ(1U, lines.size());
+    EXPECT_NE(std::string::npos, lines[0].find("Argument 3: Values of type function can not be copied"));
+
+    fs::remove(dir / "output.txt");
+    plugin->startJob("missing.lua", LuaValue(), "onDone", "");
+    lines = runMainLoop();
+    ASSERT_EQ(1U, lines.size());
+    EXPECT_EQ("done nil ", lines[0].substr(0, 9));
+}
+
+TEST_F(PluginJobTest, testCancelledJobIsInterrupted) {
+    write("loop.lua", "while true do end");
+    int id = plugin->startJob("loop.lua", LuaValue(), "onDone", "");
+    EXPECT_TRUE(plugin->cancelJob(id));
+
+    auto lines = runMainLoop();
+    ASSERT_EQ(1U, lines.size());
+    EXPECT_EQ("done nil Cancelled", lines[0]);
+
+    // The job is forgotten once its callback was called
+    EXPECT_FALSE(plugin->cancelJob(id));
+}
+
+TEST_F(PluginJobTest, testDestroyingThePluginStopsItsJobs) {
+    write("loop.lua", "while true do end");
+    plugin->startJob("loop.lua", LuaValue(), "onDone", "");
+    plugin->startJob("loop.lua", LuaValue(), "onDone", "");
+
+    // Returns once the jobs are stopped
+    plugin.reset();
+
+    // Their callbacks are not called anymore
+    EXPECT_TRUE(runMainLoop(100ms).empty());
+}
+
+#endif
@@ -0,0 +1,86 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "model/Document.h"
+#include "model/Layer.h"
+#include "model/Point.h"
+#include "model/Stroke.h"
+#include "model/XojPage.h"
+#include "undo/StrokePointsUndoAction.h"
+
+namespace {
+void expectPoints(const std::vector<Point>& expected, const Stroke& stroke) {
+    const auto& points = stroke.getPointVector();
+    ASSERT_EQ(expected.size(), points.size());
+    for (size_t i = 0; i < points.size(); i++) {
+        EXPECT_DOUBLE_EQ(expected[i].x, points[i].x);
+        EXPECT_DOUBLE_EQ(expected[i].y, points[i].y);
+        EXPECT_DOUBLE_EQ(expected[i].z, points[i].z);
+    }
+}
+}  // namespace
+
+// What app.setStrokesPacked records: the old points of each stroke, the new ones being set afterwards
+TEST(StrokePointsUndoAction, testUndoRedoSwapsThePointsOfAllTheStrokes) {
+    Document doc(nullptr);
+    auto page = std::make_shared<XojPage>(200, 300);
+    doc.addPage(page);
+
+    const std::vector<Point> before1 = {Point(0, 0, 1), Point(10, 10, 1)};
+    const std::vector<Point> after1 = {Point(0, 0, 0.5), Point(5, 5, 0.5), Point(10, 10, 0.5)};
+    const std::vector<Point> before2 = {Point(20, 20), Point(30, 40)};
+    const std::vector<Point> after2 = {Point(21, 21), Point(31, 41)};
+
+    auto stroke1 = std::make_unique<Stroke>();
+    auto stroke2 = std::make_unique<Stroke>();
+    Stroke* s1 = stroke1.get();
+    Stroke* s2 = stroke2.get();
+    s1->setPointVector(before1);
+    s2->setPointVector(before2);
+    page->getSelectedLayer()->addElement(std::move(stroke1));
+    page->getSelectedLayer()->addElement(std::move(stroke2));
+
+    StrokePointsUndoAction action(page);
+    action.addStroke(s1, s1->getPointVector());
+    s1->setPointVector(after1);
+    action.addStroke(s2, s2->getPointVector());
+    s2->setPointVector(after2);
+    EXPECT_GE(action.getMemoryUsage(), (before1.size() + before2.size()) * sizeof(Point));
+
+    // Undo
+    action.swapPoints(&doc);
+    expectPoints(before1, *s1);
+    expectPoints(before2, *s2);
+
+    // Redo
+    action.swapPoints(&doc);
+    expectPoints(after1, *s1);
+    expectPoints(after2, *s2);
+
+    // Undo again
+    action.swapPoints(&doc);
+    expectPoints(before1, *s1);
+    expectPoints(before2, *s2);
+}
+
+TEST(StrokePointsUndoAction, testEmptyActionDoesNothing) {
+    Document doc(nullptr);
+    auto page = std::make_shared<XojPage>(200, 300);
+    doc.addPage(page);
+    StrokePointsUndoAction action(page);
+    action.swapPoints(&doc);
+    EXPECT_GT(action.getMemoryUsage(), 0U);
+}
@@ -0,0 +1,178 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "undo/UndoAction.h"
+#include "undo/UndoRedoHandler.h"
+
+namespace {
+/**
+ * Holds `size` bytes while done, `undoneSize` bytes while undone (like an InsertUndoAction owning the element once
+ * undone), and keeps `spilledSize` bytes once spilled
+ */
+class FakeAction: public UndoAction {
+public:
+    explicit FakeAction(size_t size, size_t undoneSize = 0):
+            UndoAction("FakeAction"), size(size), undoneSize(undoneSize) {}
+
+    bool undo(Control*) override {
+        this->undone = true;
+        this->isSpilled = false;
+        return true;
+    }
+    bool redo(Control*) override {
+        this->undone = false;
+        return true;
+    }
+    std::string getText() override { return "Fake"; }
+
+    size_t getMemoryUsage() const override {
+        if (this->undone) {
+            return this->undoneSize;
+        }
+        return this->isSpilled ? spilledSize : this->size;
+    }
+
+    size_t spill(UndoSpillFile&) override {
+        if (this->isSpilled) {
+            return 0;
+        }
+        this->isSpilled = true;
+        this->spillCount++;
+        return this->size - spilledSize;
+    }
+
+    /// Like a DeleteUndoAction filled while erasing, after it was added
+    void grow(size_t bytes) { this->size += bytes; }
+
+    static constexpr size_t spilledSize = 10;
+    int spillCount = 0;
+    bool isSpilled = false;
+
+private:
+    size_t size;
+    size_t undoneSize;
+};
+}  // namespace
+
+TEST(UndoRedoHandler, testWorksWithoutControl) {
+    // As in the benchmarks: without a budget, nothing needs the settings
+    UndoRedoHandler undo(nullptr);
+    undo.addUndoAction(std::make_unique<FakeAction>(1000));
+    undo.undo();
+    undo.redo();
+    EXPECT_EQ(1U, undo.getActionCount());
+    EXPECT_EQ(0U, undo.getSpilledSize());
+}
+
+TEST(UndoRedoHandler, testMemoryUsageFollowsTheStacks) {
+    UndoRedoHandler undo(nullptr);
+    EXPECT_EQ(0U, undo.getMemoryUsage());
+
+    undo.addUndoAction(std::make_unique<FakeAction>(100, 1));
+    undo.addUndoAction(std::make_unique<FakeAction>(200, 2));
+    EXPECT_EQ(300U, undo.getMemoryUsage());
+
+    undo.undo();
+    EXPECT_EQ(102U, undo.getMemoryUsage());
+    undo.undo();
+    EXPECT_EQ(3U, undo.getMemoryUsage());
+    undo.redo();
+    EXPECT_EQ(102U, undo.getMemoryUsage());
+
+    // Clears the redo stack
+    undo.addUndoAction(std::make_unique<FakeAction>(50));
+    EXPECT_EQ(150U, undo.getMemoryUsage());
+    EXPECT_EQ(2U, undo.getActionCount());
+
+    auto* last = new FakeAction(400);
+    undo.addUndoAction(std::unique_ptr<UndoAction>(last));
+    EXPECT_TRUE(undo.replaceUndoAction(last, std::make_unique<FakeAction>(40)));
+    EXPECT_EQ(190U, undo.getMemoryUsage());
+
+    undo.clearContents();
+    EXPECT_EQ(0U, undo.getMemoryUsage());
+}
+
+TEST(UndoRedoHandler, testBudgetSpillsTheOldestActions) {
+    UndoRedoHandler undo(nullptr);
+    undo.setMemoryBudget(2500);
+
+    FakeAction* actions[4];
+    for (auto& action: actions) {
+        action = new FakeAction(1000);
+        undo.addUndoAction(std::unique_ptr<UndoAction>(action));
+    }
+    // 4000 bytes: the two oldest actions are spilled, the last one is always kept
+    EXPECT_TRUE(actions[0]->isSpilled);
+    EXPECT_TRUE(actions[1]->isSpilled);
+    EXPECT_FALSE(actions[2]->isSpilled);
+    EXPECT_FALSE(actions[3]->isSpilled);
+    EXPECT_EQ(2000U + 2 * FakeAction::spilledSize, undo.getMemoryUsage());
+
+    // The spilled actions are not visited again
+    undo.addUndoAction(std::make_unique<FakeAction>(1000));
+    EXPECT_EQ(1, actions[0]->spillCount);
+    EXPECT_EQ(1, actions[1]->spillCount);
+    EXPECT_TRUE(actions[2]->isSpilled);
+
+    // Undone actions are reloaded and may be spilled again once redone and buried
+    undo.undo();
+    undo.undo();
+    undo.undo();
+    EXPECT_FALSE(actions[2]->isSpilled);
+    undo.redo();
+    undo.redo();
+    undo.addUndoAction(std::make_unique<FakeAction>(1000));
+    EXPECT_TRUE(actions[2]->isSpilled);
+    EXPECT_EQ(2, actions[2]->spillCount);
+    EXPECT_LE(undo.getMemoryUsage(), 2500U);
+
+    undo.clearContents();
+}
+
+TEST(UndoRedoHandler, testActionsGrowingAfterBeingAdded) {
+    UndoRedoHandler undo(nullptr);
+    undo.setMemoryBudget(2500);
+
+    auto* erase = new FakeAction(100);
+    undo.addUndoAction(std::unique_ptr<UndoAction>(erase));
+    erase->grow(900);
+    EXPECT_EQ(1000U, undo.getMemoryUsage());
+
+    // The growth is recorded when the next action is added, and counts towards the budget
+    auto* next = new FakeAction(1000);
+    undo.addUndoAction(std::unique_ptr<UndoAction>(next));
+    EXPECT_EQ(2000U, undo.getMemoryUsage());
+    next->grow(1000);
+    undo.addUndoAction(std::make_unique<FakeAction>(100));
+    EXPECT_TRUE(erase->isSpilled);
+    EXPECT_EQ(2100U + FakeAction::spilledSize, undo.getMemoryUsage());
+
+    // What was recorded is subtracted, even if the action changed in the meantime
+    undo.undo();
+    EXPECT_EQ(2000U + FakeAction::spilledSize, undo.getMemoryUsage());
+    undo.undo();
+    EXPECT_EQ(FakeAction::spilledSize, undo.getMemoryUsage());
+    undo.undo();
+    EXPECT_EQ(0U, undo.getMemoryUsage());
+    undo.redo();
+    EXPECT_EQ(1000U, undo.getMemoryUsage());
+
+    // Clearing the redo stack gives back exactly what was recorded
+    undo.addUndoAction(std::make_unique<FakeAction>(10));
+    EXPECT_EQ(1010U, undo.getMemoryUsage());
+}
@@ -0,0 +1,107 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "model/Point.h"
+#include "model/Stroke.h"
+#include "undo/UndoSpillFile.h"
+
+#include "filesystem.h"
+
+namespace {
+fs::path spillPath(const std::string& name) { return fs::temp_directory_path() / ("xournalpp-test-" + name); }
+}  // namespace
+
+TEST(UndoSpillFile, testWriteRead) {
+    const fs::path path = spillPath("spill-rw.bin");
+    {
+        UndoSpillFile file(path);
+        EXPECT_EQ(0U, file.getSize());
+        EXPECT_FALSE(fs::exists(path));
+
+        const std::string first = "first record";
+        const std::string second = "second";
+        UndoSpillFile::Record r1;
+        UndoSpillFile::Record r2;
+        ASSERT_TRUE(file.write(first.data(), first.size(), r1));
+        ASSERT_TRUE(file.write(second.data(), second.size(), r2));
+        EXPECT_EQ(first.size() + second.size(), file.getSize());
+        EXPECT_TRUE(fs::exists(path));
+
+        std::string read(second.size(), '\0');
+        ASSERT_TRUE(file.read(r2, read.data()));
+        EXPECT_EQ(second, read);
+        read.assign(first.size(), '\0');
+        ASSERT_TRUE(file.read(r1, read.data()));
+        EXPECT_EQ(first, read);
+
+        file.release(r1);
+        EXPECT_EQ(second.size(), file.getSize());
+        EXPECT_TRUE(fs::exists(path));
+
+        // The file is removed with its last record
+        file.release(r2);
+        EXPECT_EQ(0U, file.getSize());
+        EXPECT_FALSE(fs::exists(path));
+
+        // ... and created again if needed
+        UndoSpillFile::Record r3;
+        ASSERT_TRUE(file.write(first.data(), first.size(), r3));
+        EXPECT_EQ(0U, r3.offset);
+        EXPECT_TRUE(fs::exists(path));
+    }
+    EXPECT_FALSE(fs::exists(path));
+}
+
+TEST(UndoSpillFile, testSpilledStrokes) {
+    UndoSpillFile file(spillPath("spill-strokes.bin"));
+
+    Stroke stroke;
+    stroke.setWidth(2.0);
+    for (int i = 0; i < 100; i++) {
+        stroke.addPoint(Point(i, 2 * i, 0.5));
+    }
+    const std::vector<Point> points = stroke.getPointVector();
+    const auto bounds = stroke.boundingRect();
+    Stroke empty;
+
+    {
+        SpilledStrokes spilled;
+        EXPECT_TRUE(spilled.empty());
+        EXPECT_EQ(0U, spilled.spill(file, &empty));
+        EXPECT_TRUE(spilled.empty());
+
+        EXPECT_GE(spilled.spill(file, &stroke), 100 * sizeof(Point));
+        EXPECT_FALSE(spilled.empty());
+        EXPECT_EQ(0U, stroke.getPointCount());
+        EXPECT_EQ(100 * sizeof(Point), file.getSize());
+
+        ASSERT_TRUE(spilled.reload());
+        EXPECT_TRUE(spilled.empty());
+        EXPECT_EQ(0U, file.getSize());
+        ASSERT_EQ(points.size(), stroke.getPointCount());
+        for (size_t i = 0; i < points.size(); i++) {
+            EXPECT_EQ(points[i].x, stroke.getPoint(i).x);
+            EXPECT_EQ(points[i].y, stroke.getPoint(i).y);
+            EXPECT_EQ(points[i].z, stroke.getPoint(i).z);
+        }
+        EXPECT_EQ(bounds, stroke.boundingRect());
+
+        // Spilled again, then dropped with the action
+        spilled.spill(file, &stroke);
+        EXPECT_EQ(100 * sizeof(Point), file.getSize());
+    }
+    EXPECT_EQ(0U, file.getSize());
+}
@@ -0,0 +1,184 @@
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "model/LineStyle.h"
+#include "model/Stroke.h"
+#include "util/serializing/CompactInputStream.h"
+#include "util/serializing/CompactOutputStream.h"
+#include "util/serializing/InputStreamException.h"
+
+TEST(UtilCompactStream, testVersion) {
+    CompactOutputStream out(42);
+    std::string data = out.takeData();
+
+    CompactInputStream in(data.data(), data.size());
+    EXPECT_EQ(42U, in.getVersion());
+    EXPECT_TRUE(in.atEnd());
+}
+
+TEST(UtilCompactStream, testInvalidHeader) {
+    std::string data = "XojStrm1:";
+    EXPECT_THROW(CompactInputStream(data.data(), data.size()), InputStreamException);
+    EXPECT_THROW(CompactInputStream(data.data(), 2), InputStreamException);
+}
+
+TEST(UtilCompactStream, testReadValues) {
+    CompactOutputStream out(1);
+    out.write<int32_t>(-1337);
+    out.write<uint32_t>(4294967295);
+    out.write<uint64_t>(10000000000);
+    out.write(-85.2);
+    out.write<uint8_t>(255);
+    std::string data = out.takeData();
+
+    CompactInputStream in(data.data(), data.size());
+    EXPECT_EQ(-1337, in.read<int32_t>());
+    EXPECT_EQ(4294967295U, in.read<uint32_t>());
+    EXPECT_EQ(10000000000U, in.read<uint64_t>());
+    EXPECT_DOUBLE_EQ(-85.2, in.read<double>());
+    EXPECT_EQ(255, in.read<uint8_t>());
+    EXPECT_TRUE(in.atEnd());
+    EXPECT_THROW(in.read<uint8_t>(), InputStreamException);
+}
+
+TEST(UtilCompactStream, testReadString) {
+    std::vector<std::string> stringToTest{"", "Hello World", std::string("With\0null", 9), std::string(100000, 'x')};
+
+    CompactOutputStream out(1);
+    for (auto&& str: stringToTest) {
+        out.writeString(str);
+    }
+    std::string data = out.takeData();
+
+    CompactInputStream in(data.data(), data.size());
+    for (size_t i = 0; i < stringToTest.size(); i++) {
+        if (i % 2 == 0) {
+            EXPECT_EQ(stringToTest[i], in.readString());
+        } else {
+            // The view points into the buffer
+            std::string_view view = in.readStringView();
+            EXPECT_EQ(stringToTest[i], view);
+            EXPECT_TRUE(view.empty() || (view.data() > data.data() && view.data() < data.data() + data.size()));
+        }
+    }
+    EXPECT_TRUE(in.atEnd());
+}
+
+TEST(UtilCompactStream, testReadArray) {
+    struct Data {
+        bool operator==(const Data& o) const { return s == o.s && f == o.f && b == o.b; }
+        size_t s;
+        float f;
+        bool b;
+    };
+    std::vector<Data> structs{{243254, 0.4534314213f, true}, {2, -4243213.32f, false}};
+    std::vector<double> doubles{0, 42., -42., 1e50};
+    std::vector<char> empty;
+
+    CompactOutputStream out(1);
+    out.writeArray(structs);
+    out.writeArray(doubles);
+    out.writeArray(empty);
+    std::string data = out.takeData();
+
+    CompactInputStream in(data.data(), data.size());
+    std::vector<Data> structsOut;
+    in.readArray(structsOut);
+    EXPECT_EQ(structs, structsOut);
+
+    std::vector<double> doublesOut{1., 2.};
+    in.readArray(doublesOut);
+    EXPECT_EQ(doubles, doublesOut);
+
+    std::vector<char> emptyOut{'a'};
+    in.readArray(emptyOut);
+    EXPECT_TRUE(emptyOut.empty());
+    EXPECT_TRUE(in.atEnd());
+}
+
+TEST(UtilCompactStream, testTruncatedArray) {
+    CompactOutputStream out(1);
+    out.writeArray(std::vector<double>{1., 2., 3.});
+    std::string data = out.takeData();
+
+    // Drop the last byte: the array size does not match the remaining data anymore
+    CompactInputStream in(data.data(), data.size() - 1);
+    std::vector<double> output;
+    EXPECT_THROW(in.readArray(output), InputStreamException);
+
+    // A corrupted count must not be trusted
+    CompactOutputStream out2(1);
+    out2.write<uint64_t>(UINT64_MAX / 2);
+    std::string data2 = out2.takeData();
+    CompactInputStream in2(data2.data(), data2.size());
+    EXPECT_THROW(in2.readArray(output), InputStreamException);
+}
+
+TEST(UtilCompactStream, testReadStroke) {
+    std::vector<Stroke> strokes(4);
+    // strokes[0]: empty stroke
+
+    strokes[1].addPoint(Point(42, 42));
+    strokes[1].addPoint(Point(42.1, 42.1));
+    strokes[1].addPoint(Point(1312., 8));
+
+    // strokes[2]: complex stroke
+    strokes[2].addPoint(Point(-1312., 8));
+    strokes[2].addPoint(Point(-42, -42));
+    strokes[2].addPoint(Point(42.1, -42.1));
+    strokes[2].setPressure({42., 1332.});
+    strokes[2].setWidth(1337.);
+    strokes[2].setFill(128);
+    strokes[2].setColor(Color(0xff00ffU));
+    strokes[2].setToolType(StrokeTool::HIGHLIGHTER);
+    strokes[2].setAudioFilename("assets/bar.mp3");
+    strokes[2].setTimestamp(123456);
+
+    // strokes[3]: dashed stroke
+    strokes[3].addPoint(Point(0., 0.));
+    strokes[3].addPoint(Point(1., 2.));
+    LineStyle style;
+    style.setDashes({6., 3.});
+    strokes[3].setLineStyle(style);
+
+    CompactOutputStream out(1);
+    for (auto&& stroke: strokes) {
+        stroke.writeCompact(out);
+    }
+    std::string data = out.takeData();
+
+    try {
+        CompactInputStream in(data.data(), data.size());
+        for (auto&& stroke: strokes) {
+            Stroke inStroke;
+            inStroke.readCompact(in);
+
+            EXPECT_EQ(stroke.getAudioFilename(), inStroke.getAudioFilename());
+            EXPECT_EQ(stroke.getTimestamp(), inStroke.getTimestamp());
+            EXPECT_EQ(stroke.getToolType(), inStroke.getToolType());
+            EXPECT_EQ(stroke.getFill(), inStroke.getFill());
+            EXPECT_EQ(stroke.getWidth(), inStroke.getWidth());
+            EXPECT_EQ(stroke.getColor(), inStroke.getColor());
+            EXPECT_EQ(stroke.getLineStyle().getDashes(), inStroke.getLineStyle().getDashes());
+
+            const auto& points = stroke.getPointVector();
+            const auto& inPoints = inStroke.getPointVector();
+            ASSERT_EQ(points.size(), inPoints.size());
+            for (size_t i = 0; i < points.size(); ++i) {
+                EXPECT_TRUE(points[i].equalsPos(inPoints[i]));
+                EXPECT_EQ(points[i].z, inPoints[i].z);
+            }
+
+            // The bounding box is recomputed from the points
+            EXPECT_EQ(stroke.boundingRect(), inStroke.boundingRect());
+        }
+        EXPECT_TRUE(in.atEnd());
+    } catch (const InputStreamException& e) {
+        std::cerr << "InputStreamException testing compact strokes: " << e.what() << std::endl;
+        FAIL();
+    }
+}
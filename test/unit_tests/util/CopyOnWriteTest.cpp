@@ -0,0 +1,44 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "util/CopyOnWrite.h"
+
+using xoj::util::CopyOnWrite;
+
+TEST(UtilCopyOnWrite, testEmpty) {
+    CopyOnWrite<std::vector<int>> empty;
+    EXPECT_TRUE(empty->empty());
+    EXPECT_EQ(0U, empty.useCount());
+
+    CopyOnWrite<std::vector<int>> copy = empty;
+    EXPECT_FALSE(copy.sharesWith(empty));
+
+    copy.edit().push_back(1);
+    EXPECT_TRUE(empty->empty());
+    EXPECT_EQ(1U, copy->size());
+}
+
+TEST(UtilCopyOnWrite, testCopyOnEdit) {
+    CopyOnWrite<std::vector<int>> a(std::vector<int>{1, 2, 3});
+    CopyOnWrite<std::vector<int>> b = a;
+    EXPECT_TRUE(b.sharesWith(a));
+    EXPECT_EQ(2U, a.useCount());
+    EXPECT_EQ(a->data(), b->data());
+
+    b.edit()[0] = 10;
+    EXPECT_FALSE(b.sharesWith(a));
+    EXPECT_EQ(1, (*a)[0]);
+    EXPECT_EQ(10, (*b)[0]);
+    EXPECT_EQ(1U, a.useCount());
+
+    // A value which is not shared is edited in place
+    a.edit().push_back(4);
+    a.edit()[1] = 20;
+    EXPECT_EQ(20, (*a)[1]);
+    EXPECT_EQ(4U, a->size());
+    EXPECT_EQ(3U, b->size());
+
+    b = std::vector<int>{5};
+    EXPECT_EQ(1U, b->size());
+}
@@ -0,0 +1,107 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "util/LruCache.h"
+
+using xoj::util::LruCache;
+
+TEST(UtilLruCache, testEvictsLeastRecentlyStored) {
+    LruCache<int, std::string> cache(3);
+    cache.put(1, "one");
+    cache.put(2, "two");
+    cache.put(3, "three");
+    EXPECT_EQ(3U, cache.size());
+
+    // Storing 2 again makes 1 the least recently used value
+    cache.put(2, "deux");
+    cache.put(4, "four");
+    EXPECT_EQ(3U, cache.size());
+    EXPECT_FALSE(cache.contains(1));
+    EXPECT_TRUE(cache.contains(3));
+
+    cache.put(5, "five");
+    EXPECT_FALSE(cache.contains(3));
+
+    auto value = cache.take(2);
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ("deux", *value);
+    EXPECT_FALSE(cache.contains(2));
+    EXPECT_FALSE(cache.take(2).has_value());
+    EXPECT_EQ(2U, cache.size());
+}
+
+TEST(UtilLruCache, testEraseAndClear) {
+    LruCache<size_t, std::unique_ptr<int>> cache(2);
+    cache.put(0, std::make_unique<int>(0));
+    cache.put(1, std::make_unique<int>(1));
+    cache.erase(0);
+    cache.erase(7);
+    EXPECT_EQ(1U, cache.size());
+    EXPECT_EQ(1, **cache.take(1));
+
+    cache.put(2, std::make_unique<int>(2));
+    cache.clear();
+    EXPECT_EQ(0U, cache.size());
+    EXPECT_FALSE(cache.contains(2));
+
+    LruCache<int, int> disabled(0);
+    disabled.put(1, 1);
+    EXPECT_EQ(0U, disabled.size());
+}
+
+TEST(UtilLruCache, testGetMakesTheValueMostRecentlyUsed) {
+    LruCache<int, std::string> cache(3);
+    cache.put(1, "one");
+    cache.put(2, "two");
+    cache.put(3, "three");
+
+    auto* value = cache.get(1);
+    ASSERT_NE(nullptr, value);
+    EXPECT_EQ("one", *value);
+    EXPECT_EQ(nullptr, cache.get(7));
+
+    std::vector<int> order;
+    cache.forEach([&](int key, const std::string&, size_t) { order.push_back(key); });
+    EXPECT_EQ((std::vector<int>{1, 3, 2}), order);
+
+    // 2 is now the least recently used value
+    cache.put(4, "four");
+    EXPECT_FALSE(cache.contains(2));
+    EXPECT_TRUE(cache.contains(1));
+    EXPECT_TRUE(cache.contains(3));
+}
+
+TEST(UtilLruCache, testEvictsByWeight) {
+    LruCache<int, int> cache(10);
+    cache.put(1, 1, 4);
+    cache.put(2, 2, 4);
+    EXPECT_EQ(8U, cache.getWeight());
+
+    // Dropping 1 is enough to make room
+    cache.get(1);
+    cache.put(3, 3, 5);
+    EXPECT_FALSE(cache.contains(2));
+    EXPECT_TRUE(cache.contains(1));
+    EXPECT_EQ(9U, cache.getWeight());
+
+    // Replacing a value releases its weight first
+    cache.put(3, 3, 6);
+    EXPECT_EQ(10U, cache.getWeight());
+    EXPECT_EQ(2U, cache.size());
+
+    // Both values must go
+    cache.put(4, 4, 9);
+    EXPECT_EQ(1U, cache.size());
+    EXPECT_EQ(9U, cache.getWeight());
+
+    // Too heavy to be stored at all, without dropping the others
+    cache.put(5, 5, 11);
+    EXPECT_FALSE(cache.contains(5));
+    EXPECT_TRUE(cache.contains(4));
+
+    EXPECT_EQ(4, *cache.take(4));
+    EXPECT_EQ(0U, cache.getWeight());
+}
@@ -324,6 +324,40 @@ TEST(UtilObjectIOStream, testReadComplexObject) {
     }
 }
 
+TEST(UtilObjectIOStream, testSkipObject) {
+    ObjectOutputStream outStream(new BinObjectEncoding);
+    outStream.writeObject("Skipped");
+    outStream.writeInt(-1);
+    outStream.writeUInt(1);
+    outStream.writeDouble(0.5);
+    outStream.writeSizeT(12);
+    outStream.writeString("}_}");
+    outStream.writeObject("Nested");
+    outStream.writeData(std::vector<double>{1., 2., 3.});
+    outStream.writeImage(std::string("_}_}"));
+    outStream.endObject();
+    outStream.endObject();
+    outStream.writeObject("Next");
+    outStream.writeInt(42);
+    outStream.endObject();
+
+    auto gstr = outStream.getStr();
+    std::string str(gstr->str, gstr->len);
+    g_string_free(gstr, true);
+
+    try {
+        ObjectInputStream stream;
+        EXPECT_TRUE(stream.read(&str[0], str.size()));
+        stream.skipObject();
+        stream.readObject("Next");
+        EXPECT_EQ(42, stream.readInt());
+        stream.endObject();
+    } catch (const InputStreamException& e) {
+        std::cerr << "InputStreamException testing skipped object: " << e.what() << std::endl;
+        FAIL();
+    }
+}
+
 void assertStrokeEquality(const Stroke& stroke1, const Stroke& stroke2) {
     EXPECT_EQ(stroke1.getAudioFilename(), stroke2.getAudioFilename());
     EXPECT_EQ(stroke1.getToolType(), stroke2.getToolType());
@@ -0,0 +1,68 @@
+#include <cstddef>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "util/SpscRingBuffer.h"
+
+using xoj::util::SpscRingBuffer;
+
+TEST(UtilSpscRingBuffer, testFifo) {
+    SpscRingBuffer<int, 4> queue;
+    int value = -1;
+    EXPECT_FALSE(queue.pop(value));
+    EXPECT_EQ(-1, value);
+
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(queue.push(i));
+    }
+    EXPECT_FALSE(queue.push(4));
+    EXPECT_EQ(4U, queue.pushedCount());
+
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(queue.pop(value));
+        EXPECT_EQ(i, value);
+    }
+    EXPECT_FALSE(queue.pop(value));
+    EXPECT_EQ(4U, queue.poppedCount());
+
+    // Wrap around
+    for (int i = 10; i < 13; i++) {
+        EXPECT_TRUE(queue.push(i));
+    }
+    for (int i = 10; i < 13; i++) {
+        EXPECT_TRUE(queue.pop(value));
+        EXPECT_EQ(i, value);
+    }
+    EXPECT_EQ(7U, queue.pushedCount());
+    EXPECT_EQ(7U, queue.poppedCount());
+}
+
+TEST(UtilSpscRingBuffer, testConcurrentTransfer) {
+    constexpr size_t COUNT = 200000;
+    SpscRingBuffer<size_t, 64> queue;
+
+    std::thread producer([&queue] {
+        for (size_t i = 0; i < COUNT; i++) {
+            while (!queue.push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    size_t expected = 0;
+    size_t value = 0;
+    bool ordered = true;
+    while (expected < COUNT) {
+        if (queue.pop(value)) {
+            ordered = ordered && value == expected;
+            expected++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    EXPECT_TRUE(ordered);
+    EXPECT_FALSE(queue.pop(value));
+}
@@ -0,0 +1,87 @@
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "util/Tracing.h"
+
+#include "filesystem.h"
+
+namespace {
+auto readFile(const fs::path& path) -> std::string {
+    std::ifstream in(path);
+    std::stringstream content;
+    content << in.rdbuf();
+    return content.str();
+}
+}  // namespace
+
+TEST(UtilTracing, testDisabled) {
+    EXPECT_FALSE(xoj::util::trace::isEnabled());
+    { XOJ_TRACE_SCOPE("not traced"); }
+    // Stopping without starting is harmless
+    EXPECT_TRUE(xoj::util::trace::stop());
+}
+
+TEST(UtilTracing, testSpans) {
+    fs::path file = fs::temp_directory_path() / "xournalpp-test-trace.json";
+
+    { XOJ_TRACE_SCOPE("before start"); }
+
+    xoj::util::trace::start(file);
+    EXPECT_TRUE(xoj::util::trace::isEnabled());
+    xoj::util::trace::setThreadName("Test \"main\" thread");
+    {
+        XOJ_TRACE_SCOPE("outer");
+        XOJ_TRACE_SCOPE("inner");
+    }
+    std::thread worker([] {
+        xoj::util::trace::setThreadName("Test worker");
+        XOJ_TRACE_SCOPE("worker span");
+    });
+    worker.join();
+    EXPECT_TRUE(xoj::util::trace::stop());
+    EXPECT_FALSE(xoj::util::trace::isEnabled());
+
+    { XOJ_TRACE_SCOPE("after stop"); }
+
+    std::string trace = readFile(file);
+    fs::remove(file);
+
+    EXPECT_EQ(0U, trace.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0));
+    EXPECT_NE(std::string::npos, trace.find("\"name\":\"outer\""));
+    EXPECT_NE(std::string::npos, trace.find("\"name\":\"inner\""));
+    EXPECT_NE(std::string::npos, trace.find("\"name\":\"worker span\""));
+    EXPECT_NE(std::string::npos, trace.find("\"args\":{\"name\":\"Test \\\"main\\\" thread\"}"));
+    EXPECT_NE(std::string::npos, trace.find("\"args\":{\"name\":\"Test worker\"}"));
+    EXPECT_EQ(std::string::npos, trace.find("before start"));
+    EXPECT_EQ(std::string::npos, trace.find("after stop"));
+}
+
+TEST(UtilTracing, testOnlyTheLatestSpansAreKept) {
+    fs::path file = fs::temp_directory_path() / "xournalpp-test-trace-ring.json";
+
+    xoj::util::trace::start(file, 3);
+    { XOJ_TRACE_SCOPE("span 1"); }
+    { XOJ_TRACE_SCOPE("span 2"); }
+    { XOJ_TRACE_SCOPE("span 3"); }
+    { XOJ_TRACE_SCOPE("span 4"); }
+    { XOJ_TRACE_SCOPE("span 5"); }
+    EXPECT_TRUE(xoj::util::trace::stop());
+
+    std::string trace = readFile(file);
+    fs::remove(file);
+
+    EXPECT_EQ(std::string::npos, trace.find("span 1"));
+    EXPECT_EQ(std::string::npos, trace.find("span 2"));
+    // Written from the oldest to the newest
+    auto pos3 = trace.find("span 3");
+    auto pos4 = trace.find("span 4");
+    auto pos5 = trace.find("span 5");
+    ASSERT_NE(std::string::npos, pos3);
+    EXPECT_LT(pos3, pos4);
+    EXPECT_LT(pos4, pos5);
+    EXPECT_EQ(std::string::npos, trace.find("span 5", pos5 + 1));
+}
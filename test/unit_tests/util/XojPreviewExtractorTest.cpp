@@ -104,3 +104,20 @@ TEST(UtilXojPreviewExtractor, testInvalidFile) {
 
     EXPECT_EQ(PREVIEW_RESULT_ERROR_READING_PREVIEW, result);
 }
+
+TEST(UtilXojPreviewExtractor, testReuseExtractor) {
+    XojPreviewExtractor extractor;
+    EXPECT_EQ(PREVIEW_RESULT_IMAGE_READ, extractor.readFile(GET_TESTFILE("packaged_xopp/testPreview2.xopp")));
+
+    gsize dataLen = 0;
+    extractor.getData(dataLen);
+    EXPECT_EQ((std::string::size_type)804, dataLen);
+
+    EXPECT_EQ(PREVIEW_RESULT_IMAGE_READ, extractor.readFile(GET_TESTFILE("preview-test.xoj")));
+    unsigned char* imageData = extractor.getData(dataLen);
+    EXPECT_EQ(string("CppUnitTestString"), string((char*)imageData, (size_t)dataLen));
+
+    EXPECT_EQ(PREVIEW_RESULT_NO_PREVIEW, extractor.readFile(GET_TESTFILE("preview-test-no-preview.unzipped.xoj")));
+    EXPECT_EQ(nullptr, extractor.getData(dataLen));
+    EXPECT_EQ((gsize)0, dataLen);
+}
@@ -0,0 +1,126 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "view/ImageKernels.h"
+
+namespace {
+std::vector<unsigned char> randomImage(int width, int height) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> value(0, 255);
+    std::vector<unsigned char> img(4 * static_cast<size_t>(width) * static_cast<size_t>(height));
+    for (auto& v: img) {
+        v = static_cast<unsigned char>(value(gen));
+    }
+    return img;
+}
+}  // namespace
+
+TEST(ImageKernelsTest, testHalfSizeAveragesBlocks) {
+    constexpr int W = 4;
+    constexpr int H = 2;
+    // Pixel (x, y) has all its channels equal to 10 * x + 100 * y
+    std::vector<unsigned char> src(4 * W * H);
+    for (int y = 0; y < H; y++) {
+        for (int x = 0; x < W; x++) {
+            for (int c = 0; c < 4; c++) {
+                src[4 * (y * W + x) + c] = static_cast<unsigned char>(10 * x + 100 * y);
+            }
+        }
+    }
+
+    std::vector<unsigned char> dst(4 * 2);
+    ImageKernels::downsampleBox(src.data(), W, H, 4 * W, dst.data(), 2, 1, 4 * 2);
+    // (0 + 10 + 100 + 110) / 4 = 55 and (20 + 30 + 120 + 130) / 4 = 75
+    EXPECT_EQ(55, dst[0]);
+    EXPECT_EQ(55, dst[3]);
+    EXPECT_EQ(75, dst[4]);
+    EXPECT_EQ(75, dst[7]);
+}
+
+TEST(ImageKernelsTest, testUniformImageIsPreserved) {
+    constexpr int W = 37;
+    constexpr int H = 23;
+    constexpr int STRIDE = 4 * W + 12;
+    std::vector<unsigned char> src(STRIDE * H);
+    for (int y = 0; y < H; y++) {
+        for (int x = 0; x < W; x++) {
+            unsigned char* px = &src[y * STRIDE + 4 * x];
+            px[0] = 200;
+            px[1] = 13;
+            px[2] = 255;
+            px[3] = 255;
+        }
+    }
+
+    // The ratio is not an integer: source pixels are shared by two destination pixels
+    constexpr int DW = 10;
+    constexpr int DH = 7;
+    for (auto* kernel: {&ImageKernels::downsampleBox, &ImageKernels::scalar::downsampleBox}) {
+        std::vector<unsigned char> dst(4 * DW * DH, 0);
+        kernel(src.data(), W, H, STRIDE, dst.data(), DW, DH, 4 * DW);
+        for (size_t i = 0; i < dst.size(); i += 4) {
+            EXPECT_EQ(200, dst[i]);
+            EXPECT_EQ(13, dst[i + 1]);
+            EXPECT_EQ(255, dst[i + 2]);
+            EXPECT_EQ(255, dst[i + 3]);
+        }
+    }
+}
+
+TEST(ImageKernelsTest, testMatchesScalar) {
+    // A page rendered at 100% zoom shrunk to a sidebar preview
+    constexpr int W = 595;
+    constexpr int H = 842;
+    constexpr int DW = 89;
+    constexpr int DH = 126;
+    auto src = randomImage(W, H);
+
+    std::vector<unsigned char> expected(4 * DW * DH);
+    std::vector<unsigned char> actual(4 * DW * DH);
+    ImageKernels::scalar::downsampleBox(src.data(), W, H, 4 * W, expected.data(), DW, DH, 4 * DW);
+    ImageKernels::downsampleBox(src.data(), W, H, 4 * W, actual.data(), DW, DH, 4 * DW);
+    EXPECT_EQ(expected, actual);
+
+    // Same size: a copy
+    std::vector<unsigned char> copy(src.size());
+    ImageKernels::downsampleBox(src.data(), W, H, 4 * W, copy.data(), W, H, 4 * W);
+    EXPECT_EQ(src, copy);
+}
+
+TEST(ImageKernelsTest, DISABLED_benchmark) {
+    constexpr int W = 1190;
+    constexpr int H = 1684;
+    constexpr int DW = 89;
+    constexpr int DH = 126;
+    constexpr int ROUNDS = 20;
+    auto src = randomImage(W, H);
+    std::vector<unsigned char> dst(4 * DW * DH);
+
+    auto measure = [&](const char* name, auto&& kernel) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ROUNDS; i++) {
+            kernel(src.data(), W, H, 4 * W, dst.data(), DW, DH, 4 * DW);
+        }
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << name << ": " << elapsed.count() / ROUNDS << " ms/image" << std::endl;
+    };
+
+    measure("downsampleBox (scalar)", ImageKernels::scalar::downsampleBox);
+    measure("downsampleBox", ImageKernels::downsampleBox);
+}
@@ -0,0 +1,41 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "view/TexImageView.h"
+
+using xoj::view::TexImageView;
+
+TEST(TexImageView, testRasterSizesArePowersOfTheFourthRootOfTwo) {
+    EXPECT_EQ(1, TexImageView::rasterSize(1.0));
+    EXPECT_EQ(2, TexImageView::rasterSize(2.0));
+    EXPECT_EQ(16, TexImageView::rasterSize(16.0));
+    EXPECT_EQ(1024, TexImageView::rasterSize(1024.0));
+
+    // 2^4.25 = 19.03
+    EXPECT_EQ(20, TexImageView::rasterSize(16.5));
+    EXPECT_EQ(20, TexImageView::rasterSize(19.0));
+}
+
+TEST(TexImageView, testRasterSizesAreSharedByCloseZoomLevels) {
+    for (double pixels = 1.0; pixels < 4096.0; pixels *= 1.07) {
+        const int size = TexImageView::rasterSize(pixels);
+        // Never upscaled, and shrunk by a factor of at most 2^(1/4) (up to the rounding to a whole pixel)
+        EXPECT_GE(size, pixels);
+        EXPECT_LE(size, std::ceil(pixels * std::exp2(0.25)));
+        // Zooming in or out by 1% keeps the same raster, or moves to the next size
+        const int zoomedIn = TexImageView::rasterSize(pixels * 1.01);
+        EXPECT_TRUE(zoomedIn == size || zoomedIn == TexImageView::rasterSize(size * 1.01)) << pixels;
+    }
+}